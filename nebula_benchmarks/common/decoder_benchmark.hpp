@@ -0,0 +1,122 @@
+// Helpers shared by the decoder benchmarks: loading recorded scans and synthesizing streams for
+// sensors without recordings, and reporting decoding throughput.
+
+#pragma once
+
+#include "packet_synthesizers.hpp"
+
+#include <rclcpp/serialization.hpp>
+#include <rclcpp/serialized_message.hpp>
+#include <rosbag2_cpp/reader.hpp>
+#include <rosbag2_cpp/readers/sequential_reader.hpp>
+#include <rosbag2_storage/storage_options.hpp>
+
+#include <benchmark/benchmark.h>
+
+#include <builtin_interfaces/msg/time.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+/// @brief Read all messages recorded on a topic
+/// @param bag_path The bag directory
+/// @param topic The topic to read, e.g. "/pandar_packets"
+/// @throw std::runtime_error if the bag does not contain any message on the topic
+template <typename MsgT>
+std::vector<std::shared_ptr<MsgT>> readBagMessages(
+  const std::string & bag_path, const std::string & topic)
+{
+  rosbag2_storage::StorageOptions storage_options;
+  storage_options.uri = bag_path;
+  storage_options.storage_id = "sqlite3";
+  rosbag2_cpp::ConverterOptions converter_options;
+  converter_options.input_serialization_format = "cdr";
+  converter_options.output_serialization_format = "cdr";
+
+  rosbag2_cpp::Reader bag_reader(std::make_unique<rosbag2_cpp::readers::SequentialReader>());
+  bag_reader.open(storage_options, converter_options);
+
+  rclcpp::Serialization<MsgT> serialization;
+  std::vector<std::shared_ptr<MsgT>> messages;
+  while (bag_reader.has_next()) {
+    auto bag_message = bag_reader.read_next();
+    if (bag_message->topic_name != topic) {
+      continue;
+    }
+
+    auto message = std::make_shared<MsgT>();
+    rclcpp::SerializedMessage serialized_message(*bag_message->serialized_data);
+    serialization.deserialize_message(&serialized_message, message.get());
+    messages.push_back(message);
+  }
+
+  if (messages.empty()) {
+    throw std::runtime_error("No messages on " + topic + " in " + bag_path);
+  }
+  return messages;
+}
+
+/// @brief A packet of a synthetic sensor stream
+struct SynthesizedPacket
+{
+  builtin_interfaces::msg::Time stamp;
+  std::vector<uint8_t> data;
+};
+
+/// @brief Synthesize whole revolutions of a lidar's packet stream
+/// @param synthesizer The sensor's synthesizer, see `createPacketSynthesizer`
+/// @param rpm The rotation speed the synthesizer was configured with
+/// @param n_scans The number of revolutions to synthesize
+/// @return The packets of each revolution
+inline std::vector<std::vector<SynthesizedPacket>> synthesizeScans(
+  PacketSynthesizer & synthesizer, double rpm, size_t n_scans)
+{
+  constexpr uint64_t start_time_ns = 1'700'000'000'000'000'000;
+  const auto packet_period_ns = static_cast<uint64_t>(synthesizer.packetPeriod().count());
+  const auto packets_per_scan = static_cast<size_t>(60e9 / rpm / packet_period_ns);
+
+  std::vector<std::vector<SynthesizedPacket>> scans(n_scans);
+  uint64_t time_ns = start_time_ns;
+  for (auto & scan : scans) {
+    scan.resize(packets_per_scan);
+    for (auto & packet : scan) {
+      packet.stamp.sec = static_cast<int32_t>(time_ns / 1'000'000'000);
+      packet.stamp.nanosec = static_cast<uint32_t>(time_ns % 1'000'000'000);
+      packet.data.resize(synthesizer.packetSize());
+      synthesizer.writeNextPacket(packet.data.data(), time_ns);
+      time_ns += packet_period_ns;
+    }
+  }
+  return scans;
+}
+
+/// @brief Report the decoding throughput as packets/s, points/s and ns/point
+/// @param state The benchmark state, after the benchmark loop
+/// @param n_packets The number of packets decoded over all iterations
+/// @param n_points The number of points output over all iterations
+/// @param decode_time The duration of the benchmark loop
+inline void setDecodeCounters(
+  benchmark::State & state, size_t n_packets, size_t n_points,
+  std::chrono::steady_clock::duration decode_time)
+{
+  state.counters["packets_per_second"] =
+    benchmark::Counter(static_cast<double>(n_packets), benchmark::Counter::kIsRate);
+  state.counters["points_per_second"] =
+    benchmark::Counter(static_cast<double>(n_points), benchmark::Counter::kIsRate);
+  if (n_points > 0) {
+    state.counters["ns_per_point"] =
+      static_cast<double>(std::chrono::nanoseconds(decode_time).count()) / n_points;
+  }
+}
+
+}  // namespace benchmarks
+}  // namespace nebula
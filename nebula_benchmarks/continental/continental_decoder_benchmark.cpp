@@ -0,0 +1,61 @@
+// Decoding throughput of the Continental ARS548 decoder.
+//
+// Each iteration processes all packets recorded in the ARS548 test bag (see nebula_tests). The
+// decoded detections and objects are counted as points.
+
+#include "decoder_benchmark.hpp"
+#include "nebula_common/continental/continental_ars548.hpp"
+#include "nebula_decoders/nebula_decoders_continental/decoders/continental_ars548_decoder.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+void BM_ContinentalARS548Decoder(benchmark::State & state)
+{
+  auto sensor_configuration =
+    std::make_shared<drivers::continental_ars548::ContinentalARS548SensorConfiguration>();
+  sensor_configuration->sensor_model = drivers::SensorModel::CONTINENTAL_ARS548;
+  sensor_configuration->frame_id = "some_sensor_frame";
+  sensor_configuration->base_frame = "some_base_frame";
+  sensor_configuration->object_frame = "some_object_frame";
+
+  size_t n_points = 0;
+  drivers::continental_ars548::ContinentalARS548Decoder decoder(sensor_configuration);
+  decoder.RegisterDetectionListCallback(
+    [&](std::unique_ptr<continental_msgs::msg::ContinentalArs548DetectionList> msg) {
+      n_points += msg->detections.size();
+    });
+  decoder.RegisterObjectListCallback(
+    [&](std::unique_ptr<continental_msgs::msg::ContinentalArs548ObjectList> msg) {
+      n_points += msg->objects.size();
+    });
+
+  const auto packet_msgs = readBagMessages<nebula_msgs::msg::NebulaPackets>(
+    std::string(_SRC_RESOURCES_DIR_PATH) + "continental/ars548/1708578204",
+    "/sensing/radar/front_center/nebula_packets");
+
+  size_t n_packets = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (auto _ : state) {
+    for (const auto & packet_msg : packet_msgs) {
+      decoder.ProcessPackets(*packet_msg);
+      n_packets += packet_msg->packets.size();
+    }
+  }
+  setDecodeCounters(state, n_packets, n_points, std::chrono::steady_clock::now() - start);
+}
+
+BENCHMARK(BM_ContinentalARS548Decoder)->Unit(benchmark::kMicrosecond)->UseRealTime();
+
+}  // namespace benchmarks
+}  // namespace nebula
+
+BENCHMARK_MAIN();
@@ -0,0 +1,105 @@
+#include "synthesizer_common.hpp"
+
+#include "nebula_common/continental/continental_ars548.hpp"
+
+#include <cstring>
+#include <ctime>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+namespace
+{
+
+/// @brief Continental ARS548 detection lists, with detections along the walls in the radar's field
+/// of view
+class Ars548Synthesizer : public PacketSynthesizer
+{
+  typedef drivers::continental_ars548::DetectionListPacket packet_t;
+
+  static constexpr uint64_t CYCLE_TIME_NS = 50'000'000;
+  static constexpr float HORIZONTAL_FOV_DEG = 120.f;
+
+public:
+  explicit Ars548Synthesizer(const SynthesizerConfiguration & configuration)
+  : n_detections_(configuration.n_detections)
+  {
+    if (n_detections_ > drivers::continental_ars548::MAX_DETECTIONS) {
+      throw std::invalid_argument(
+        "The ARS548 sends at most " +
+        std::to_string(drivers::continental_ars548::MAX_DETECTIONS) + " detections");
+    }
+    static_assert(sizeof(packet_t) == drivers::continental_ars548::DETECTION_LIST_UDP_PAYLOAD);
+  }
+
+  std::string sensorModel() const override { return "ARS548"; }
+
+  size_t packetSize() const override { return sizeof(packet_t); }
+
+  std::chrono::nanoseconds packetPeriod() const override
+  {
+    return std::chrono::nanoseconds(CYCLE_TIME_NS);
+  }
+
+  void writeNextPacket(uint8_t * data, uint64_t time_ns) override
+  {
+    packet_t packet{};
+    packet.header.service_id = 0;
+    packet.header.method_id = drivers::continental_ars548::DETECTION_LIST_METHOD_ID;
+    packet.header.length = drivers::continental_ars548::DETECTION_LIST_PDU_LENGTH;
+    packet.header_e2ep07.sqc = sequence_counter_++;
+    packet.stamp.timestamp_seconds = static_cast<uint32_t>(time_ns / NS_PER_S);
+    packet.stamp.timestamp_nanoseconds = static_cast<uint32_t>(time_ns % NS_PER_S);
+    packet.stamp.timestamp_sync_status = drivers::continental_ars548::SYNC_OK;
+    packet.list_rad_vel_domain_min = -50.f;
+    packet.list_rad_vel_domain_max = 50.f;
+    packet.number_of_detections = static_cast<uint32_t>(n_detections_);
+
+    for (size_t i = 0; i < n_detections_; ++i) {
+      // Sweep the field of view, facing azimuth 0 of the scene
+      const float azimuth_deg =
+        HORIZONTAL_FOV_DEG * ((i + 0.5f) / std::max<size_t>(n_detections_, 1) - 0.5f);
+      const auto scene_azimuth = static_cast<uint32_t>(
+        std::lround((azimuth_deg < 0 ? azimuth_deg + 360.f : azimuth_deg) * 100)) %
+        AZIMUTH_UNITS;
+
+      auto & detection = packet.detections[i];
+      detection.azimuth_angle = degToRad(azimuth_deg);
+      detection.azimuth_angle_std = 0.005f;
+      detection.elevation_angle = degToRad(static_cast<float>(i % 5) - 2.f);
+      detection.elevation_angle_std = 0.01f;
+      detection.range = scene_.wallDistance(scene_azimuth) / std::cos(degToRad(azimuth_deg));
+      detection.range_std = 0.1f;
+      detection.range_rate = 0.f;
+      detection.range_rate_std = 0.05f;
+      detection.rcs = static_cast<int8_t>(scene_.wallReflectivity(scene_azimuth) / 4);
+      detection.measurement_id = static_cast<uint16_t>(i);
+      detection.positive_predictive_value = 100;
+      detection.classification = 0;
+      detection.multi_target_probability = 0;
+      detection.object_id = 0xffff;
+      detection.ambiguity_flag = 100;
+      detection.sort_index = static_cast<uint16_t>(i);
+    }
+
+    std::memcpy(data, &packet, sizeof(packet));
+  }
+
+private:
+  RoomScene scene_;
+  size_t n_detections_;
+  uint32_t sequence_counter_{0};
+};
+
+}  // namespace
+
+std::unique_ptr<PacketSynthesizer> createContinentalSynthesizer(
+  const SynthesizerConfiguration & configuration)
+{
+  return std::make_unique<Ars548Synthesizer>(configuration);
+}
+
+}  // namespace benchmarks
+}  // namespace nebula
@@ -0,0 +1,169 @@
+#include "synthesizer_common.hpp"
+
+#include "nebula_decoders/nebula_decoders_hesai/decoders/pandar_128e4x.hpp"
+#include "nebula_decoders/nebula_decoders_hesai/decoders/pandar_64.hpp"
+#include "nebula_decoders/nebula_decoders_hesai/decoders/pandar_xt32.hpp"
+
+#include <cstring>
+#include <ctime>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+namespace
+{
+
+template <int YearOffset>
+void setDateTime(drivers::hesai_packet::DateTime<YearOffset> & date_time, uint64_t time_ns)
+{
+  const auto seconds = static_cast<std::time_t>(time_ns / NS_PER_S);
+  std::tm tm{};
+  gmtime_r(&seconds, &tm);
+  date_time.year = static_cast<uint8_t>(tm.tm_year + 1900 - YearOffset);
+  date_time.month = static_cast<uint8_t>(tm.tm_mon + 1);
+  date_time.day = static_cast<uint8_t>(tm.tm_mday);
+  date_time.hour = static_cast<uint8_t>(tm.tm_hour);
+  date_time.minute = static_cast<uint8_t>(tm.tm_min);
+  date_time.second = static_cast<uint8_t>(tm.tm_sec);
+}
+
+void setHesaiHeader(drivers::hesai_packet::Header12B & header, size_t n_returns)
+{
+  header.return_num = static_cast<uint8_t>(n_returns);
+}
+
+void setHesaiHeader(drivers::hesai_packet::Header8B & /* header */, size_t /* n_returns */)
+{
+}
+
+struct Pandar128E4XTraits
+{
+  typedef drivers::hesai_packet::Packet128E4X packet_t;
+  static constexpr const char * MODEL = "Pandar128E4X";
+  static constexpr size_t WIRE_SIZE = 861;
+  static constexpr uint64_t FIRING_PERIOD_NS = drivers::Pandar128E4X::FIRING_CYCLE_NS;
+  static constexpr float MIN_ELEVATION = -25.f;
+  static constexpr float MAX_ELEVATION = 15.f;
+
+  static void setModelFields(packet_t & packet)
+  {
+    packet.header.protocol_major = 1;
+    packet.header.protocol_minor = 4;
+    // Standard operational state, azimuth state 0 for both blocks
+    packet.tail.operational_state = 2;
+    packet.tail.azimuth_state = 0;
+  }
+};
+
+struct PandarXT32Traits
+{
+  typedef drivers::hesai_packet::PacketXT32 packet_t;
+  static constexpr const char * MODEL = "PandarXT32";
+  static constexpr size_t WIRE_SIZE = sizeof(packet_t);
+  static constexpr uint64_t FIRING_PERIOD_NS = 50000;
+  static constexpr float MIN_ELEVATION = -16.f;
+  static constexpr float MAX_ELEVATION = 15.f;
+
+  static void setModelFields(packet_t & packet)
+  {
+    packet.header.protocol_major = 6;
+    packet.header.protocol_minor = 1;
+  }
+};
+
+struct Pandar64Traits
+{
+  typedef drivers::hesai_packet::Packet64 packet_t;
+  static constexpr const char * MODEL = "Pandar64";
+  static constexpr size_t WIRE_SIZE = sizeof(packet_t);
+  static constexpr uint64_t FIRING_PERIOD_NS = 55560;
+  static constexpr float MIN_ELEVATION = -25.f;
+  static constexpr float MAX_ELEVATION = 15.f;
+
+  static void setModelFields(packet_t & /* packet */) {}
+};
+
+/// @brief Hesai packets: each block is one firing of all channels, in dual return mode consecutive
+/// blocks hold the first and last return of the same firing
+template <typename TraitsT>
+class HesaiSynthesizer : public LidarSynthesizer
+{
+  typedef typename TraitsT::packet_t packet_t;
+  static constexpr float DISTANCE_UNIT_M = 0.004f;
+
+public:
+  explicit HesaiSynthesizer(const SynthesizerConfiguration & configuration)
+  : LidarSynthesizer(
+      configuration,
+      linearElevations(packet_t::N_CHANNELS, TraitsT::MIN_ELEVATION, TraitsT::MAX_ELEVATION),
+      TraitsT::FIRING_PERIOD_NS)
+  {
+    static_assert(sizeof(packet_t) <= TraitsT::WIRE_SIZE);
+  }
+
+  std::string sensorModel() const override { return TraitsT::MODEL; }
+
+  size_t packetSize() const override { return TraitsT::WIRE_SIZE; }
+
+  std::chrono::nanoseconds packetPeriod() const override
+  {
+    return std::chrono::nanoseconds(firing_period_ns_ * packet_t::N_BLOCKS / nReturns());
+  }
+
+  void writeNextPacket(uint8_t * data, uint64_t time_ns) override
+  {
+    packet_t packet{};
+    packet.header.sop = 0xffee;
+    packet.header.laser_num = packet_t::N_CHANNELS;
+    packet.header.block_num = packet_t::N_BLOCKS;
+    packet.header.dis_unit = static_cast<uint8_t>(DISTANCE_UNIT_M * 1000);
+    setHesaiHeader(packet.header, nReturns());
+
+    const size_t n_returns = nReturns();
+    for (size_t block_id = 0; block_id < packet_t::N_BLOCKS; block_id += n_returns) {
+      const uint32_t azimuth = azimuth_clock_.next();
+      for (size_t return_id = 0; return_id < n_returns; ++return_id) {
+        auto & block = packet.body.blocks[block_id + return_id];
+        block.azimuth = static_cast<uint16_t>(azimuth);
+        for (size_t channel = 0; channel < packet_t::N_CHANNELS; ++channel) {
+          const Return beam = beamReturn(azimuth, channel, return_id);
+          block.units[channel].distance = encodeDistance(beam.distance_m, DISTANCE_UNIT_M);
+          block.units[channel].reflectivity = beam.reflectivity;
+        }
+      }
+    }
+
+    packet.tail.return_mode = dual_return_ ? drivers::hesai_packet::return_mode::DUAL_FIRST_LAST
+                                           : drivers::hesai_packet::return_mode::SINGLE_STRONGEST;
+    packet.tail.motor_speed = static_cast<uint16_t>(rpm_);
+    setDateTime(packet.tail.date_time, time_ns);
+    packet.tail.timestamp = static_cast<uint32_t>((time_ns % NS_PER_S) / 1000);
+    TraitsT::setModelFields(packet);
+
+    std::memset(data, 0, TraitsT::WIRE_SIZE);
+    std::memcpy(data, &packet, sizeof(packet));
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<PacketSynthesizer> createHesaiSynthesizer(
+  const SynthesizerConfiguration & configuration)
+{
+  switch (configuration.n_channels) {
+    case 0:
+    case 128:
+      return std::make_unique<HesaiSynthesizer<Pandar128E4XTraits>>(configuration);
+    case 64:
+      return std::make_unique<HesaiSynthesizer<Pandar64Traits>>(configuration);
+    case 32:
+      return std::make_unique<HesaiSynthesizer<PandarXT32Traits>>(configuration);
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace benchmarks
+}  // namespace nebula
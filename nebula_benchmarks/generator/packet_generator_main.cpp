@@ -0,0 +1,385 @@
+// Sends synthetic sensor packets to local ports, to find out how many sensors the drivers can
+// sustain.
+//
+// Each simulated sensor sends from its own thread and socket, at the packet rate of the real sensor
+// scaled by --speed, or as fast as possible with --speed 0. The packets are built from the
+// decoders' packet structs and describe a room around the sensor, so that the drivers decode them
+// into plausible point clouds. The achieved send rate is reported every second and at the end. The
+// exit code is 2 if the requested rate could not be sustained, so that CI does not mistake a slow
+// generator for a fast driver.
+
+#include "packet_synthesizers.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+constexpr size_t SEND_BATCH_SIZE = 32;
+/// @brief The share of the requested rate below which the generator is considered too slow
+constexpr double MIN_RATE_RATIO = 0.95;
+
+std::atomic<bool> g_running{true};
+
+struct GeneratorOptions
+{
+  SynthesizerConfiguration synthesizer;
+  size_t n_sensors{1};
+  std::string destination_ip{"127.0.0.1"};
+  uint16_t data_port{0};
+  uint16_t info_port{7788};
+  uint16_t port_stride{1};
+  std::string source_ip{};
+  double speed{1.};
+  double duration_s{10.};
+};
+
+struct SensorCounters
+{
+  std::atomic<uint64_t> packets{0};
+  std::atomic<uint64_t> bytes{0};
+  std::atomic<uint64_t> send_errors{0};
+};
+
+void printUsage()
+{
+  std::cout
+    << "Usage: nebula_packet_generator [options]\n"
+       "  --vendor V        hesai, velodyne, robosense or continental (default hesai)\n"
+       "  --channels N      lidar channel count, selecting the model (default: vendor's largest)\n"
+       "                      hesai: 32 PandarXT32, 64 Pandar64, 128 Pandar128E4X\n"
+       "                      velodyne: 16 VLP16, 32 VLP32, 128 VLS128\n"
+       "                      robosense: 32 Helios\n"
+       "  --rpm R           lidar rotation speed (default 600)\n"
+       "  --return-mode M   single or dual (default single)\n"
+       "  --detections N    detections per ARS548 detection list (default 800)\n"
+       "  --sensors N       number of concurrent sensors (default 1)\n"
+       "  --host IP         destination address (default 127.0.0.1)\n"
+       "  --port P          data port of the first sensor (default: vendor's default)\n"
+       "  --info-port P     Robosense DIFOP port of the first sensor (default 7788)\n"
+       "  --port-stride S   port increment between sensors (default 1)\n"
+       "  --source-ip IP    source address of the first sensor, incremented per sensor\n"
+       "  --speed X         multiple of the real packet rate, 0 sends as fast as possible "
+       "(default 1)\n"
+       "  --duration S      seconds to send for, 0 sends until interrupted (default 10)\n";
+}
+
+GeneratorOptions parseOptions(int argc, char ** argv)
+{
+  GeneratorOptions options;
+  for (int i = 1; i < argc; ++i) {
+    const std::string option = argv[i];
+    if (option == "--help" || option == "-h") {
+      printUsage();
+      std::exit(0);
+    }
+    if (i + 1 >= argc) {
+      throw std::invalid_argument("Missing value for " + option);
+    }
+    const std::string value = argv[++i];
+
+    if (option == "--vendor") {
+      options.synthesizer.vendor = value;
+    } else if (option == "--channels") {
+      options.synthesizer.n_channels = std::stoul(value);
+    } else if (option == "--rpm") {
+      options.synthesizer.rpm = std::stod(value);
+    } else if (option == "--return-mode") {
+      if (value != "single" && value != "dual") {
+        throw std::invalid_argument("Unknown return mode " + value);
+      }
+      options.synthesizer.dual_return = value == "dual";
+    } else if (option == "--detections") {
+      options.synthesizer.n_detections = std::stoul(value);
+    } else if (option == "--sensors") {
+      options.n_sensors = std::max<size_t>(std::stoul(value), 1);
+    } else if (option == "--host") {
+      options.destination_ip = value;
+    } else if (option == "--port") {
+      options.data_port = static_cast<uint16_t>(std::stoul(value));
+    } else if (option == "--info-port") {
+      options.info_port = static_cast<uint16_t>(std::stoul(value));
+    } else if (option == "--port-stride") {
+      options.port_stride = static_cast<uint16_t>(std::stoul(value));
+    } else if (option == "--source-ip") {
+      options.source_ip = value;
+    } else if (option == "--speed") {
+      options.speed = std::max(std::stod(value), 0.);
+    } else if (option == "--duration") {
+      options.duration_s = std::max(std::stod(value), 0.);
+    } else {
+      throw std::invalid_argument("Unknown option " + option);
+    }
+  }
+
+  if (options.data_port == 0) {
+    const std::string & vendor = options.synthesizer.vendor;
+    options.data_port = vendor == "robosense" ? 6699 : vendor == "continental" ? 42102 : 2368;
+  }
+  return options;
+}
+
+/// @brief The address `offset` hosts after `ip`
+in_addr offsetAddress(const std::string & ip, uint32_t offset)
+{
+  in_addr address{};
+  if (inet_pton(AF_INET, ip.c_str(), &address) != 1) {
+    throw std::invalid_argument("Invalid IPv4 address " + ip);
+  }
+  address.s_addr = htonl(ntohl(address.s_addr) + offset);
+  return address;
+}
+
+/// @brief Open the socket of a sensor, bound to its source address if one is given
+int openSocket(const GeneratorOptions & options, size_t sensor_id)
+{
+  const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  if (fd < 0) {
+    throw std::runtime_error(std::string("Could not open socket: ") + std::strerror(errno));
+  }
+
+  // Radar detection lists are larger than the default send buffer
+  const int send_buffer_size = 4 << 20;
+  setsockopt(fd, SOL_SOCKET, SO_SNDBUF, &send_buffer_size, sizeof(send_buffer_size));
+
+  if (!options.source_ip.empty()) {
+    sockaddr_in source{};
+    source.sin_family = AF_INET;
+    source.sin_addr = offsetAddress(options.source_ip, sensor_id);
+    if (bind(fd, reinterpret_cast<sockaddr *>(&source), sizeof(source)) != 0) {
+      close(fd);
+      throw std::runtime_error(
+        std::string("Could not bind source address: ") + std::strerror(errno));
+    }
+    // Multicast destinations, as used by the radars, are reached through the source's interface
+    setsockopt(fd, IPPROTO_IP, IP_MULTICAST_IF, &source.sin_addr, sizeof(source.sin_addr));
+  }
+  return fd;
+}
+
+uint64_t systemTimeNs()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+           std::chrono::system_clock::now().time_since_epoch())
+    .count();
+}
+
+/// @brief Send the packets of one sensor until the duration is over or the generator is stopped
+void runSensor(
+  const GeneratorOptions & options, size_t sensor_id, std::chrono::steady_clock::time_point start,
+  SensorCounters & counters)
+{
+  auto synthesizer = createPacketSynthesizer(options.synthesizer);
+  const int fd = openSocket(options, sensor_id);
+
+  sockaddr_in data_destination{};
+  data_destination.sin_family = AF_INET;
+  data_destination.sin_addr = offsetAddress(options.destination_ip, 0);
+  data_destination.sin_port = htons(options.data_port + sensor_id * options.port_stride);
+  sockaddr_in info_destination = data_destination;
+  info_destination.sin_port = htons(options.info_port + sensor_id * options.port_stride);
+
+  const size_t packet_size = synthesizer->packetSize();
+  std::vector<uint8_t> packets(SEND_BATCH_SIZE * packet_size);
+  std::vector<iovec> iovecs(SEND_BATCH_SIZE);
+  std::vector<mmsghdr> headers(SEND_BATCH_SIZE);
+  for (size_t i = 0; i < SEND_BATCH_SIZE; ++i) {
+    iovecs[i].iov_base = packets.data() + i * packet_size;
+    iovecs[i].iov_len = packet_size;
+    headers[i].msg_hdr.msg_name = &data_destination;
+    headers[i].msg_hdr.msg_namelen = sizeof(data_destination);
+    headers[i].msg_hdr.msg_iov = &iovecs[i];
+    headers[i].msg_hdr.msg_iovlen = 1;
+  }
+  std::vector<uint8_t> info_packet(synthesizer->infoPacketSize());
+
+  // Packets carry the sensor time, which advances at the real sensor's rate whatever the speed
+  const uint64_t sensor_start_ns = systemTimeNs();
+  const auto packet_period_ns = static_cast<uint64_t>(synthesizer->packetPeriod().count());
+  const uint64_t packets_per_info = std::max<uint64_t>(1'000'000'000 / packet_period_ns, 1);
+  const auto end = start + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                             std::chrono::duration<double>(options.duration_s));
+
+  uint64_t packet_id = 0;
+  while (g_running) {
+    const auto now = std::chrono::steady_clock::now();
+    if (options.duration_s > 0 && now >= end) {
+      break;
+    }
+
+    // Send every packet that is due, at most one batch at a time
+    size_t n_due = SEND_BATCH_SIZE;
+    if (options.speed > 0) {
+      const double elapsed_ns =
+        std::chrono::duration<double, std::nano>(now - start).count() * options.speed;
+      const auto n_total_due = static_cast<uint64_t>(elapsed_ns / packet_period_ns) + 1;
+      n_due = std::min<uint64_t>(n_total_due - std::min(n_total_due, packet_id), SEND_BATCH_SIZE);
+      if (n_due == 0) {
+        const auto next_due = start + std::chrono::nanoseconds(static_cast<int64_t>(
+                                        packet_id * packet_period_ns / options.speed));
+        std::this_thread::sleep_until(next_due);
+        continue;
+      }
+    }
+
+    for (size_t i = 0; i < n_due; ++i) {
+      const uint64_t time_ns = sensor_start_ns + (packet_id + i) * packet_period_ns;
+      if (!info_packet.empty() && (packet_id + i) % packets_per_info == 0) {
+        synthesizer->writeInfoPacket(info_packet.data(), time_ns);
+        sendto(
+          fd, info_packet.data(), info_packet.size(), 0,
+          reinterpret_cast<sockaddr *>(&info_destination), sizeof(info_destination));
+      }
+      synthesizer->writeNextPacket(packets.data() + i * packet_size, time_ns);
+    }
+
+    size_t n_sent = 0;
+    while (n_sent < n_due) {
+      const int result = sendmmsg(fd, headers.data() + n_sent, n_due - n_sent, 0);
+      if (result <= 0) {
+        // The packet is lost, as a sensor would lose it on a congested link
+        counters.send_errors++;
+        n_sent++;
+        continue;
+      }
+      n_sent += result;
+      counters.packets += result;
+      counters.bytes += result * packet_size;
+    }
+    packet_id += n_due;
+  }
+
+  close(fd);
+}
+
+int run(const GeneratorOptions & options)
+{
+  const auto synthesizer = createPacketSynthesizer(options.synthesizer);
+  const double target_rate = options.speed > 0
+                               ? options.n_sensors * options.speed * 1e9 /
+                                   synthesizer->packetPeriod().count()
+                               : 0.;
+
+  std::cout << "Sending " << synthesizer->sensorModel() << " packets ("
+            << synthesizer->packetSize() << " B) of " << options.n_sensors << " sensor(s) to "
+            << options.destination_ip << ":" << options.data_port;
+  if (options.n_sensors > 1) {
+    std::cout << "+" << options.port_stride << "n";
+  }
+  if (target_rate > 0) {
+    std::cout << " at " << static_cast<uint64_t>(target_rate) << " packets/s" << std::endl;
+  } else {
+    std::cout << " as fast as possible" << std::endl;
+  }
+
+  std::vector<SensorCounters> counters(options.n_sensors);
+  std::vector<std::thread> threads;
+  const auto start = std::chrono::steady_clock::now();
+  for (size_t sensor_id = 0; sensor_id < options.n_sensors; ++sensor_id) {
+    threads.emplace_back([&, sensor_id] {
+      try {
+        runSensor(options, sensor_id, start, counters[sensor_id]);
+      } catch (const std::exception & ex) {
+        std::cerr << "Sensor " << sensor_id << ": " << ex.what() << std::endl;
+        g_running = false;
+      }
+    });
+  }
+
+  auto totals = [&counters] {
+    uint64_t packets = 0;
+    uint64_t bytes = 0;
+    uint64_t errors = 0;
+    for (const auto & sensor_counters : counters) {
+      packets += sensor_counters.packets;
+      bytes += sensor_counters.bytes;
+      errors += sensor_counters.send_errors;
+    }
+    return std::make_tuple(packets, bytes, errors);
+  };
+
+  uint64_t last_packets = 0;
+  uint64_t last_bytes = 0;
+  auto last_report = start;
+  auto running = [&] {
+    return g_running &&
+           (options.duration_s == 0 ||
+            std::chrono::steady_clock::now() - start <
+              std::chrono::duration<double>(options.duration_s));
+  };
+  while (running()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_report < std::chrono::seconds(1)) {
+      continue;
+    }
+
+    const auto [packets, bytes, errors] = totals();
+    const double interval_s = std::chrono::duration<double>(now - last_report).count();
+    std::printf(
+      "%7.1f s  %10.0f packets/s  %8.1f Mbit/s  %lu send errors\n",
+      std::chrono::duration<double>(now - start).count(), (packets - last_packets) / interval_s,
+      (bytes - last_bytes) * 8 / interval_s / 1e6, static_cast<unsigned long>(errors));
+    std::fflush(stdout);
+    last_packets = packets;
+    last_bytes = bytes;
+    last_report = now;
+  }
+
+  g_running = false;
+  for (auto & thread : threads) {
+    thread.join();
+  }
+
+  const auto [packets, bytes, errors] = totals();
+  const double elapsed_s =
+    std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  const double achieved_rate = packets / elapsed_s;
+  std::printf(
+    "Sent %lu packets in %.2f s: %.0f packets/s, %.1f Mbit/s, %lu send errors",
+    static_cast<unsigned long>(packets), elapsed_s, achieved_rate, bytes * 8 / elapsed_s / 1e6,
+    static_cast<unsigned long>(errors));
+  if (target_rate > 0) {
+    std::printf(" (%.1f %% of the requested rate)", 100. * achieved_rate / target_rate);
+  }
+  std::printf("\n");
+
+  return target_rate > 0 && achieved_rate < MIN_RATE_RATIO * target_rate ? 2 : 0;
+}
+
+}  // namespace benchmarks
+}  // namespace nebula
+
+int main(int argc, char ** argv)
+{
+  std::signal(SIGINT, [](int) { nebula::benchmarks::g_running = false; });
+  std::signal(SIGTERM, [](int) { nebula::benchmarks::g_running = false; });
+
+  try {
+    return nebula::benchmarks::run(nebula::benchmarks::parseOptions(argc, argv));
+  } catch (const std::exception & ex) {
+    std::cerr << ex.what() << std::endl;
+    nebula::benchmarks::printUsage();
+    return 1;
+  }
+}
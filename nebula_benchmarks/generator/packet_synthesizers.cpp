@@ -0,0 +1,46 @@
+#include "packet_synthesizers.hpp"
+
+#include "synthesizer_common.hpp"
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+RoomScene::RoomScene()
+: wall_distance_(AZIMUTH_UNITS), wall_reflectivity_(AZIMUTH_UNITS), fence_(AZIMUTH_UNITS)
+{
+  for (uint32_t azimuth = 0; azimuth < AZIMUTH_UNITS; ++azimuth) {
+    const float angle = degToRad(azimuth / 100.f);
+    wall_distance_[azimuth] = 12.f + 4.f * std::sin(2 * angle) + 1.5f * std::sin(5 * angle + 1);
+    wall_reflectivity_[azimuth] = std::sin(16 * angle) > 0 ? 80 : 30;
+    fence_[azimuth] = std::sin(3 * angle) > 0.5f;
+  }
+}
+
+std::unique_ptr<PacketSynthesizer> createPacketSynthesizer(
+  const SynthesizerConfiguration & configuration)
+{
+  std::unique_ptr<PacketSynthesizer> synthesizer;
+  if (configuration.vendor == "hesai") {
+    synthesizer = createHesaiSynthesizer(configuration);
+  } else if (configuration.vendor == "velodyne") {
+    synthesizer = createVelodyneSynthesizer(configuration);
+  } else if (configuration.vendor == "robosense") {
+    synthesizer = createRobosenseSynthesizer(configuration);
+  } else if (configuration.vendor == "continental") {
+    synthesizer = createContinentalSynthesizer(configuration);
+  } else {
+    throw std::invalid_argument("Unknown vendor " + configuration.vendor);
+  }
+
+  if (!synthesizer) {
+    throw std::invalid_argument(
+      "No " + configuration.vendor + " sensor with " +
+      std::to_string(configuration.n_channels) + " channels");
+  }
+  return synthesizer;
+}
+
+}  // namespace benchmarks
+}  // namespace nebula
@@ -0,0 +1,105 @@
+#ifndef NEBULA_PACKET_SYNTHESIZERS_H
+#define NEBULA_PACKET_SYNTHESIZERS_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+/// @brief The parameters of a synthetic sensor stream
+struct SynthesizerConfiguration
+{
+  /// @brief hesai, velodyne, robosense or continental
+  std::string vendor{"hesai"};
+  /// @brief The number of lidar channels, selecting the sensor model. 0 selects the vendor's
+  /// default
+  size_t n_channels{0};
+  /// @brief The lidar's rotation speed in revolutions per minute
+  double rpm{600.};
+  bool dual_return{false};
+  /// @brief The number of radar detections per detection list
+  size_t n_detections{800};
+};
+
+/// @brief A simple closed room around the sensor, whose wall distance varies with azimuth so that
+/// every beam returns and the decoded clouds have a recognizable shape.
+///
+/// The scene only depends on azimuth, so points land on the walls whatever elevations the
+/// receiving driver's calibration assigns to the channels.
+class RoomScene
+{
+public:
+  RoomScene();
+
+  /// @brief The horizontal distance to the wall in meters
+  /// @param azimuth The azimuth in 1/100 degrees, in [0, 36000)
+  float wallDistance(uint32_t azimuth) const { return wall_distance_[azimuth]; }
+
+  /// @brief The reflectivity of the wall, painted in stripes
+  uint8_t wallReflectivity(uint32_t azimuth) const { return wall_reflectivity_[azimuth]; }
+
+  /// @brief Whether the beam first passes through a semi-transparent fence, which produces a
+  /// distinct first return in dual return mode
+  /// @param azimuth The azimuth in 1/100 degrees, in [0, 36000)
+  /// @param channel The channel of the beam
+  bool hitsFence(uint32_t azimuth, size_t channel) const
+  {
+    return fence_[azimuth] && channel % 2 == 0;
+  }
+
+  /// @brief The fence's distance relative to the wall's
+  static constexpr float FENCE_DISTANCE_RATIO = 0.6f;
+  static constexpr uint8_t FENCE_REFLECTIVITY = 10;
+
+private:
+  std::vector<float> wall_distance_;
+  std::vector<uint8_t> wall_reflectivity_;
+  std::vector<bool> fence_;
+};
+
+/// @brief Produces the packet stream of one sensor, packet by packet
+class PacketSynthesizer
+{
+public:
+  virtual ~PacketSynthesizer() = default;
+
+  /// @brief The sensor model, as in the driver's `sensor_model` parameter
+  virtual std::string sensorModel() const = 0;
+
+  /// @brief The UDP payload size of each data packet in bytes
+  virtual size_t packetSize() const = 0;
+
+  /// @brief The time between two data packets at the configured rotation speed
+  virtual std::chrono::nanoseconds packetPeriod() const = 0;
+
+  /// @brief Write the next data packet of the stream
+  /// @param packet The buffer to write to, `packetSize()` bytes long
+  /// @param time_ns The sensor time of the packet in nanoseconds since epoch
+  virtual void writeNextPacket(uint8_t * packet, uint64_t time_ns) = 0;
+
+  /// @brief The UDP payload size of the packets describing the sensor, sent to the info port. 0 if
+  /// the sensor does not send any
+  virtual size_t infoPacketSize() const { return 0; }
+
+  /// @brief Write a packet describing the sensor
+  /// @param packet The buffer to write to, `infoPacketSize()` bytes long
+  /// @param time_ns The sensor time of the packet in nanoseconds since epoch
+  virtual void writeInfoPacket(uint8_t * /* packet */, uint64_t /* time_ns */) {}
+};
+
+/// @brief Create the synthesizer for the given vendor and channel count
+/// @throw std::invalid_argument if the vendor, channel count or rotation speed is not supported
+std::unique_ptr<PacketSynthesizer> createPacketSynthesizer(
+  const SynthesizerConfiguration & configuration);
+
+}  // namespace benchmarks
+}  // namespace nebula
+
+#endif  // NEBULA_PACKET_SYNTHESIZERS_H
@@ -0,0 +1,117 @@
+#include "synthesizer_common.hpp"
+
+#include "nebula_common/robosense/robosense_common.hpp"
+#include "nebula_decoders/nebula_decoders_robosense/decoders/helios.hpp"
+
+#include <cstring>
+#include <ctime>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+namespace
+{
+
+/// @brief Robosense Helios packets (MSOP) and the info packets (DIFOP) carrying their calibration
+class HeliosSynthesizer : public LidarSynthesizer
+{
+  typedef drivers::robosense_packet::helios::Packet packet_t;
+  typedef drivers::robosense_packet::helios::InfoPacket info_packet_t;
+
+  static constexpr uint64_t FIRING_PERIOD_NS = 55560;
+  static constexpr float DISTANCE_UNIT_M = 0.0025f;
+  static constexpr float MIN_ELEVATION = -55.f;
+  static constexpr float MAX_ELEVATION = 15.f;
+
+public:
+  explicit HeliosSynthesizer(const SynthesizerConfiguration & configuration)
+  : LidarSynthesizer(
+      configuration, linearElevations(packet_t::N_CHANNELS, MIN_ELEVATION, MAX_ELEVATION),
+      FIRING_PERIOD_NS)
+  {
+  }
+
+  std::string sensorModel() const override { return "Helios"; }
+
+  size_t packetSize() const override { return sizeof(packet_t); }
+
+  std::chrono::nanoseconds packetPeriod() const override
+  {
+    return std::chrono::nanoseconds(firing_period_ns_ * packet_t::N_BLOCKS / nReturns());
+  }
+
+  void writeNextPacket(uint8_t * data, uint64_t time_ns) override
+  {
+    packet_t packet{};
+    packet.header.header_id = 0x55aa055a;
+    packet.header.range_resolution = 1;  // 0.25 cm
+    setTimestamp(packet.header.timestamp, time_ns);
+
+    for (size_t block_id = 0; block_id < packet_t::N_BLOCKS; block_id += nReturns()) {
+      const uint32_t azimuth = azimuth_clock_.next();
+      for (size_t return_id = 0; return_id < nReturns(); ++return_id) {
+        auto & block = packet.body.blocks[block_id + return_id];
+        block.flag = 0xffee;
+        block.azimuth = static_cast<uint16_t>(azimuth);
+        for (size_t channel = 0; channel < packet_t::N_CHANNELS; ++channel) {
+          const Return beam = beamReturn(azimuth, channel, return_id);
+          block.units[channel].distance = encodeDistance(beam.distance_m, DISTANCE_UNIT_M);
+          block.units[channel].reflectivity = beam.reflectivity;
+        }
+      }
+    }
+
+    std::memcpy(data, &packet, sizeof(packet));
+  }
+
+  size_t infoPacketSize() const override { return sizeof(info_packet_t); }
+
+  void writeInfoPacket(uint8_t * data, uint64_t time_ns) override
+  {
+    constexpr uint8_t dual_return_flag = 0x00;
+    constexpr uint8_t strongest_return_flag = 0x04;
+    constexpr uint8_t sync_status_ptp_success_flag = 0x02;
+
+    info_packet_t packet{};
+    packet.header = 0xa5ff005a11115555;
+    packet.motor_speed = static_cast<uint16_t>(rpm_);
+    packet.fov_setting.fov_start = 0;
+    packet.fov_setting.fov_end = AZIMUTH_UNITS;
+    packet.return_mode = dual_return_ ? dual_return_flag : strongest_return_flag;
+    packet.sync_status = sync_status_ptp_success_flag;
+    setTimestamp(packet.time, time_ns);
+
+    const auto elevations = linearElevations(packet_t::N_CHANNELS, MIN_ELEVATION, MAX_ELEVATION);
+    for (size_t channel = 0; channel < packet_t::N_CHANNELS; ++channel) {
+      auto & angle = packet.sensor_calibration.corrected_vertical_angle.angles[channel];
+      angle.sign = elevations[channel] < 0 ? 1 : drivers::robosense_packet::ANGLE_SIGN_FLAG;
+      angle.angle = static_cast<uint16_t>(std::round(std::abs(elevations[channel]) * 100));
+    }
+    packet.tail = 0x0f0f;
+
+    std::memcpy(data, &packet, sizeof(packet));
+  }
+
+private:
+  static void setTimestamp(drivers::robosense_packet::Timestamp & timestamp, uint64_t time_ns)
+  {
+    timestamp.seconds = time_ns / NS_PER_S;
+    timestamp.microseconds = static_cast<uint32_t>((time_ns % NS_PER_S) / 1000);
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<PacketSynthesizer> createRobosenseSynthesizer(
+  const SynthesizerConfiguration & configuration)
+{
+  if (configuration.n_channels == 0 || configuration.n_channels == 32) {
+    return std::make_unique<HeliosSynthesizer>(configuration);
+  }
+  return nullptr;
+}
+
+}  // namespace benchmarks
+}  // namespace nebula
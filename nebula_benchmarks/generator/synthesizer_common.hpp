@@ -0,0 +1,132 @@
+#ifndef NEBULA_SYNTHESIZER_COMMON_H
+#define NEBULA_SYNTHESIZER_COMMON_H
+
+#include "packet_synthesizers.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+/// @brief The number of azimuth steps of a revolution: azimuths are in 1/100 degrees
+inline constexpr uint32_t AZIMUTH_UNITS = 36000;
+inline constexpr uint64_t NS_PER_S = 1'000'000'000;
+
+inline float degToRad(float degrees)
+{
+  return degrees * static_cast<float>(M_PI) / 180.f;
+}
+
+/// @brief Nominal channel elevations, spread evenly from the top (channel 0) to the bottom of the
+/// vertical field of view
+inline std::vector<float> linearElevations(size_t n_channels, float min_deg, float max_deg)
+{
+  std::vector<float> elevations(n_channels);
+  for (size_t channel = 0; channel < n_channels; ++channel) {
+    elevations[channel] =
+      max_deg - (max_deg - min_deg) * channel / std::max<size_t>(n_channels - 1, 1);
+  }
+  return elevations;
+}
+
+/// @brief Encode a distance in the packet's distance unit, saturating at the largest value
+inline uint16_t encodeDistance(float distance_m, float unit_m)
+{
+  const float raw = std::round(distance_m / unit_m);
+  return static_cast<uint16_t>(
+    std::min(raw, static_cast<float>(std::numeric_limits<uint16_t>::max())));
+}
+
+/// @brief Advances the azimuth by the rotation between two firings
+class AzimuthClock
+{
+public:
+  AzimuthClock(double rpm, uint64_t firing_period_ns)
+  : step_(rpm / 60. * AZIMUTH_UNITS * firing_period_ns / NS_PER_S)
+  {
+  }
+
+  /// @brief The azimuth of the next firing in 1/100 degrees
+  uint32_t next()
+  {
+    const auto azimuth = static_cast<uint32_t>(azimuth_) % AZIMUTH_UNITS;
+    azimuth_ = std::fmod(azimuth_ + step_, static_cast<double>(AZIMUTH_UNITS));
+    return azimuth;
+  }
+
+private:
+  double step_;
+  double azimuth_{0.};
+};
+
+/// @brief A single return of a beam
+struct Return
+{
+  float distance_m;
+  uint8_t reflectivity;
+};
+
+/// @brief Common parts of the rotating lidars: the scene, the channel geometry and the returns
+class LidarSynthesizer : public PacketSynthesizer
+{
+public:
+  LidarSynthesizer(
+    const SynthesizerConfiguration & configuration, std::vector<float> elevations_deg,
+    uint64_t firing_period_ns)
+  : rpm_(configuration.rpm),
+    dual_return_(configuration.dual_return),
+    firing_period_ns_(firing_period_ns),
+    azimuth_clock_(configuration.rpm, firing_period_ns)
+  {
+    if (configuration.rpm <= 0) {
+      throw std::invalid_argument("The rotation speed must be positive");
+    }
+    for (float elevation : elevations_deg) {
+      inverse_cosines_.push_back(1.f / std::cos(degToRad(elevation)));
+    }
+  }
+
+protected:
+  RoomScene scene_;
+  double rpm_;
+  bool dual_return_;
+  uint64_t firing_period_ns_;
+  AzimuthClock azimuth_clock_;
+  /// @brief Converts horizontal distances into distances along each channel's beam
+  std::vector<float> inverse_cosines_;
+
+  size_t nReturns() const { return dual_return_ ? 2 : 1; }
+
+  /// @brief The return of a beam. In dual return mode, return 0 is the first and return 1 the last
+  /// return. In single return mode, the only return is the strongest, i.e. the wall
+  Return beamReturn(uint32_t azimuth, size_t channel, size_t return_id) const
+  {
+    const float wall_distance = scene_.wallDistance(azimuth) * inverse_cosines_[channel];
+    if (dual_return_ && return_id == 0 && scene_.hitsFence(azimuth, channel)) {
+      return {wall_distance * RoomScene::FENCE_DISTANCE_RATIO, RoomScene::FENCE_REFLECTIVITY};
+    }
+    return {wall_distance, scene_.wallReflectivity(azimuth)};
+  }
+};
+
+// The vendors' packet definitions cannot share a translation unit (e.g. Hesai and Robosense both
+// define an `AngleCorrector`), so each vendor's synthesizers live in their own
+
+std::unique_ptr<PacketSynthesizer> createHesaiSynthesizer(
+  const SynthesizerConfiguration & configuration);
+std::unique_ptr<PacketSynthesizer> createVelodyneSynthesizer(
+  const SynthesizerConfiguration & configuration);
+std::unique_ptr<PacketSynthesizer> createRobosenseSynthesizer(
+  const SynthesizerConfiguration & configuration);
+std::unique_ptr<PacketSynthesizer> createContinentalSynthesizer(
+  const SynthesizerConfiguration & configuration);
+
+}  // namespace benchmarks
+}  // namespace nebula
+
+#endif  // NEBULA_SYNTHESIZER_COMMON_H
@@ -0,0 +1,229 @@
+#include "synthesizer_common.hpp"
+
+#include "nebula_decoders/nebula_decoders_velodyne/decoders/velodyne_scan_decoder.hpp"
+
+#include <cstring>
+#include <ctime>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+namespace
+{
+
+/// @brief VLP-32C vertical angles in degrees, by channel
+constexpr float VLP32_ELEVATIONS[32] = {
+  -25.f,    -1.f,   -1.667f, -15.639f, -11.31f, 0.f,    -0.667f, -8.843f, -7.254f, 0.333f, -0.333f,
+  -6.148f, -5.333f, 1.333f,  0.667f,   -4.f,    -4.667f, 1.667f, 1.f,     -3.667f, -3.333f, 3.333f,
+  2.333f,  -2.667f, -3.f,    7.f,      4.667f,  -2.333f, -2.f,   15.f,    10.333f, -1.333f};
+
+/// @brief Velodyne packets: 12 blocks of 32 returns in the `raw_packet_t` layout
+class VelodyneSynthesizer : public LidarSynthesizer
+{
+  static constexpr size_t TIMESTAMP_INDEX = 1200;
+  static constexpr size_t PRODUCT_ID_INDEX = 1205;
+
+public:
+  enum class Model { VLP16, VLP32, VLS128 };
+
+  VelodyneSynthesizer(const SynthesizerConfiguration & configuration, Model model)
+  : LidarSynthesizer(configuration, elevations(model), firingPeriodNs(model)), model_(model)
+  {
+  }
+
+  std::string sensorModel() const override
+  {
+    switch (model_) {
+      case Model::VLP16:
+        return "VLP16";
+      case Model::VLP32:
+        return "VLP32";
+      default:
+        return "VLS128";
+    }
+  }
+
+  size_t packetSize() const override { return drivers::PACKET_SIZE; }
+
+  std::chrono::nanoseconds packetPeriod() const override
+  {
+    return std::chrono::nanoseconds(firing_period_ns_ * firingsPerPacket());
+  }
+
+  void writeNextPacket(uint8_t * data, uint64_t time_ns) override
+  {
+    drivers::raw_packet_t packet{};
+    switch (model_) {
+      case Model::VLP16:
+        writeVlp16Blocks(packet);
+        break;
+      case Model::VLP32:
+        writeVlp32Blocks(packet);
+        break;
+      case Model::VLS128:
+        writeVls128Blocks(packet);
+        break;
+    }
+
+    std::memcpy(data, &packet, sizeof(packet));
+    // Microseconds since the top of the hour, followed by the return mode and product ID
+    const auto us_of_hour = static_cast<uint32_t>((time_ns / 1000) % 3'600'000'000ULL);
+    std::memcpy(data + TIMESTAMP_INDEX, &us_of_hour, sizeof(us_of_hour));
+    data[drivers::RETURN_MODE_INDEX] =
+      dual_return_ ? drivers::RETURN_MODE_DUAL : drivers::RETURN_MODE_STRONGEST;
+    data[PRODUCT_ID_INDEX] = productId();
+  }
+
+private:
+  Model model_;
+
+  static std::vector<float> elevations(Model model)
+  {
+    switch (model) {
+      case Model::VLP16: {
+        // Channels alternate between the lower and upper half of the field of view
+        std::vector<float> elevations(16);
+        for (size_t channel = 0; channel < elevations.size(); ++channel) {
+          elevations[channel] = channel % 2 ? channel : -15.f + channel;
+        }
+        return elevations;
+      }
+      case Model::VLP32:
+        return {std::begin(VLP32_ELEVATIONS), std::end(VLP32_ELEVATIONS)};
+      default:
+        return linearElevations(128, -25.f, 15.f);
+    }
+  }
+
+  /// @brief The time between two azimuths: a block of two firings for the VLP-16, a firing
+  /// for the VLP-32 and a firing sequence of all four banks for the VLS-128
+  static uint64_t firingPeriodNs(Model model)
+  {
+    switch (model) {
+      case Model::VLP16:
+        return static_cast<uint64_t>(drivers::VLP16_BLOCK_DURATION * 1000);
+      case Model::VLP32:
+        return 55296;
+      default:
+        return static_cast<uint64_t>(drivers::VLS128_SEQ_DURATION * 1000);
+    }
+  }
+
+  size_t firingsPerPacket() const
+  {
+    if (model_ == Model::VLS128) {
+      // Three sequences of four banks, or one sequence of four banks with two returns each
+      return dual_return_ ? 1 : 3;
+    }
+    return drivers::BLOCKS_PER_PACKET / nReturns();
+  }
+
+  uint8_t productId() const
+  {
+    switch (model_) {
+      case Model::VLP16:
+        return 0x22;
+      case Model::VLP32:
+        return 0x28;
+      default:
+        return 0xa1;
+    }
+  }
+
+  /// @brief Write a block's returns for the given channels. In dual return mode, even blocks hold
+  /// the last and odd blocks the first return
+  void writeBlock(
+    drivers::raw_block_t & block, uint16_t header, uint32_t azimuth, size_t first_channel,
+    size_t n_channels, size_t return_id, float distance_unit_m, size_t first_unit = 0) const
+  {
+    block.header = header;
+    block.rotation = static_cast<uint16_t>(azimuth);
+    for (size_t i = 0; i < n_channels; ++i) {
+      const Return beam = beamReturn(azimuth, first_channel + i, return_id);
+      const uint16_t distance = encodeDistance(beam.distance_m, distance_unit_m);
+      uint8_t * unit = block.data + (first_unit + i) * drivers::RAW_SCAN_SIZE;
+      std::memcpy(unit, &distance, sizeof(distance));
+      unit[2] = beam.reflectivity;
+    }
+  }
+
+  size_t blockReturnId(size_t block_id) const
+  {
+    return dual_return_ ? (block_id % 2 == 0 ? 1 : 0) : 0;
+  }
+
+  void writeVlp16Blocks(drivers::raw_packet_t & packet)
+  {
+    constexpr float distance_unit_m = 0.002f;
+    for (size_t block_id = 0; block_id < drivers::BLOCKS_PER_PACKET; block_id += nReturns()) {
+      const uint32_t azimuth = azimuth_clock_.next();
+      for (size_t return_id = 0; return_id < nReturns(); ++return_id) {
+        auto & block = packet.blocks[block_id + return_id];
+        // Both firings of a block see (almost) the same azimuth
+        for (size_t firing = 0; firing < drivers::VLP16_FIRINGS_PER_BLOCK; ++firing) {
+          writeBlock(
+            block, drivers::UPPER_BANK, azimuth, 0, drivers::VLP16_SCANS_PER_FIRING,
+            blockReturnId(block_id + return_id), distance_unit_m,
+            firing * drivers::VLP16_SCANS_PER_FIRING);
+        }
+      }
+    }
+  }
+
+  void writeVlp32Blocks(drivers::raw_packet_t & packet)
+  {
+    constexpr float distance_unit_m = 0.004f;
+    for (size_t block_id = 0; block_id < drivers::BLOCKS_PER_PACKET; block_id += nReturns()) {
+      const uint32_t azimuth = azimuth_clock_.next();
+      for (size_t return_id = 0; return_id < nReturns(); ++return_id) {
+        writeBlock(
+          packet.blocks[block_id + return_id], drivers::UPPER_BANK, azimuth, 0,
+          drivers::SCANS_PER_BLOCK, blockReturnId(block_id + return_id), distance_unit_m);
+      }
+    }
+  }
+
+  void writeVls128Blocks(drivers::raw_packet_t & packet)
+  {
+    constexpr uint16_t bank_headers[4] = {
+      drivers::VLS128_BANK_1, drivers::VLS128_BANK_2, drivers::VLS128_BANK_3,
+      drivers::VLS128_BANK_4};
+    const size_t blocks_per_sequence = 4 * nReturns();
+    for (size_t sequence = 0; sequence < firingsPerPacket(); ++sequence) {
+      const uint32_t azimuth = azimuth_clock_.next();
+      for (size_t i = 0; i < blocks_per_sequence; ++i) {
+        const size_t block_id = sequence * blocks_per_sequence + i;
+        const size_t bank = i / nReturns();
+        writeBlock(
+          packet.blocks[block_id], bank_headers[bank], azimuth, bank * drivers::SCANS_PER_BLOCK,
+          drivers::SCANS_PER_BLOCK, blockReturnId(block_id), drivers::VLP128_DISTANCE_RESOLUTION);
+      }
+    }
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<PacketSynthesizer> createVelodyneSynthesizer(
+  const SynthesizerConfiguration & configuration)
+{
+  switch (configuration.n_channels) {
+    case 0:
+    case 128:
+      return std::make_unique<VelodyneSynthesizer>(
+        configuration, VelodyneSynthesizer::Model::VLS128);
+    case 32:
+      return std::make_unique<VelodyneSynthesizer>(
+        configuration, VelodyneSynthesizer::Model::VLP32);
+    case 16:
+      return std::make_unique<VelodyneSynthesizer>(
+        configuration, VelodyneSynthesizer::Model::VLP16);
+    default:
+      return nullptr;
+  }
+}
+
+}  // namespace benchmarks
+}  // namespace nebula
@@ -0,0 +1,79 @@
+// Compares the full-table and compact calibration-based angle correctors.
+//
+// The access pattern mimics decoding: the block azimuth advances by one firing step per iteration
+// and all channels are looked up at that azimuth. Several sensors (i.e. correctors) are served
+// round-robin to reproduce the cache pressure of multiple lidars decoded on the same ECU.
+//
+// Cache misses can be reported by Google Benchmark if it has been built with libpfm:
+//   hesai_angle_corrector_benchmark --benchmark_perf_counters=CACHE-MISSES,CYCLES
+
+#include "nebula_common/hesai/hesai_common.hpp"
+#include "nebula_decoders/nebula_decoders_hesai/decoders/angle_corrector_calibration_based.hpp"
+#include "nebula_decoders/nebula_decoders_hesai/decoders/angle_corrector_calibration_based_compact.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+constexpr size_t N_CHANNELS = 128;
+constexpr size_t ANGLE_UNIT = 100;
+constexpr uint32_t MAX_AZIMUTH = 360 * ANGLE_UNIT;
+// 0.1 deg, the horizontal resolution of Pandar128E4X at 10 Hz
+constexpr uint32_t AZIMUTH_STEP = 10;
+
+using FullTableCorrector = drivers::AngleCorrectorCalibrationBased<N_CHANNELS, ANGLE_UNIT>;
+using CompactCorrector = drivers::AngleCorrectorCalibrationBasedCompact<N_CHANNELS, ANGLE_UNIT>;
+
+std::shared_ptr<drivers::HesaiCalibrationConfiguration> loadCalibration()
+{
+  auto calibration = std::make_shared<drivers::HesaiCalibrationConfiguration>();
+  auto status =
+    calibration->LoadFromFile(std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/Pandar128E4X.csv");
+  if (status != Status::OK) {
+    throw std::runtime_error("Could not load Pandar128E4X calibration");
+  }
+  return calibration;
+}
+
+template <typename CorrectorT>
+void BM_AngleCorrectorSweep(benchmark::State & state)
+{
+  const size_t n_sensors = state.range(0);
+  auto calibration = loadCalibration();
+
+  std::vector<std::unique_ptr<CorrectorT>> correctors;
+  std::vector<uint32_t> azimuths;
+  for (size_t i = 0; i < n_sensors; ++i) {
+    correctors.emplace_back(std::make_unique<CorrectorT>(calibration, nullptr));
+    // Sensors are not phase-locked to each other
+    azimuths.push_back((i * MAX_AZIMUTH / n_sensors) % MAX_AZIMUTH);
+  }
+
+  for (auto _ : state) {
+    for (size_t i = 0; i < n_sensors; ++i) {
+      for (uint32_t channel_id = 0; channel_id < N_CHANNELS; ++channel_id) {
+        auto angles = correctors[i]->getCorrectedAngleData(azimuths[i], channel_id);
+        benchmark::DoNotOptimize(angles);
+      }
+      azimuths[i] = (azimuths[i] + AZIMUTH_STEP) % MAX_AZIMUTH;
+    }
+  }
+
+  state.SetItemsProcessed(state.iterations() * n_sensors * N_CHANNELS);
+  state.counters["table_bytes_per_sensor"] = sizeof(CorrectorT);
+}
+
+BENCHMARK_TEMPLATE(BM_AngleCorrectorSweep, FullTableCorrector)->Arg(1)->Arg(6);
+BENCHMARK_TEMPLATE(BM_AngleCorrectorSweep, CompactCorrector)->Arg(1)->Arg(6);
+
+}  // namespace benchmarks
+}  // namespace nebula
+
+BENCHMARK_MAIN();
@@ -0,0 +1,163 @@
+// Decoding throughput of the Hesai driver, per sensor model.
+//
+// Each iteration converts all scans recorded in the model's test bag (see nebula_tests) into point
+// clouds. Models without a recording are fed a synthetic stream of whole revolutions instead.
+
+#include "decoder_benchmark.hpp"
+#include "nebula_common/hesai/hesai_common.hpp"
+#include "nebula_decoders/nebula_decoders_hesai/hesai_driver.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+struct HesaiBenchmarkConfig
+{
+  std::string sensor_model;
+  std::string return_mode;
+  std::string calibration_file;
+  /// @brief Relative to the Hesai test data directory, empty to decode a synthetic stream
+  std::string bag_path;
+  std::string correction_file = "";
+  double min_range = 0.3;
+  double max_range = 300.;
+};
+
+const HesaiBenchmarkConfig BENCHMARK_CONFIGS[] = {
+  {"Pandar40P", "Dual", "Pandar40P.csv", "40p/1673400149412331409"},
+  {"Pandar64", "Dual", "Pandar64.csv", "64/1673403880599376836"},
+  {"PandarAT128", "LastStrongest", "PandarAT128.csv", "at128/1679653308406038376",
+   "PandarAT128.dat", 1., 180.},
+  {"PandarQT64", "Dual", "PandarQT64.csv", "qt64/1673401195788312575", "", 0.1, 60.},
+  {"PandarXT32", "Dual", "PandarXT32.csv", "xt32/1673400677802009732"},
+  {"PandarXT32M", "LastStrongest", "PandarXT32M.csv", "xt32m/1660893203042895158", "", 0.5},
+  {"Pandar128E4X", "Strongest", "Pandar128E4X.csv", ""},
+};
+
+constexpr double SYNTHETIC_RPM = 600.;
+constexpr size_t SYNTHETIC_SCANS = 10;
+
+std::unique_ptr<drivers::HesaiDriver> createDriver(const HesaiBenchmarkConfig & config)
+{
+  const std::string calibration_dir = std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/";
+
+  auto sensor_configuration = std::make_shared<drivers::HesaiSensorConfiguration>();
+  sensor_configuration->sensor_model = drivers::SensorModelFromString(config.sensor_model);
+  sensor_configuration->return_mode =
+    drivers::ReturnModeFromStringHesai(config.return_mode, sensor_configuration->sensor_model);
+  sensor_configuration->frame_id = "hesai";
+  sensor_configuration->min_range = config.min_range;
+  sensor_configuration->max_range = config.max_range;
+  sensor_configuration->dual_return_distance_threshold = 0.1;
+
+  auto calibration_configuration = std::make_shared<drivers::HesaiCalibrationConfiguration>();
+  if (calibration_configuration->LoadFromFile(calibration_dir + config.calibration_file) !=
+      Status::OK) {
+    throw std::runtime_error("Could not load " + config.calibration_file);
+  }
+
+  std::shared_ptr<drivers::HesaiCorrection> correction_configuration;
+  if (!config.correction_file.empty()) {
+    correction_configuration = std::make_shared<drivers::HesaiCorrection>();
+    if (correction_configuration->LoadFromFile(calibration_dir + config.correction_file) !=
+        Status::OK) {
+      throw std::runtime_error("Could not load " + config.correction_file);
+    }
+  }
+
+  return std::make_unique<drivers::HesaiDriver>(
+    sensor_configuration, calibration_configuration, correction_configuration);
+}
+
+/// @brief Whole revolutions of the model's synthetic packet stream
+std::vector<std::shared_ptr<nebula_msgs::msg::NebulaPackets>> loadSyntheticScans(
+  const HesaiBenchmarkConfig & config)
+{
+  SynthesizerConfiguration synthesizer_configuration;
+  synthesizer_configuration.vendor = "hesai";
+  synthesizer_configuration.rpm = SYNTHETIC_RPM;
+  auto synthesizer = createPacketSynthesizer(synthesizer_configuration);
+  if (synthesizer->sensorModel() != config.sensor_model) {
+    throw std::runtime_error("No synthetic stream for " + config.sensor_model);
+  }
+
+  std::vector<std::shared_ptr<nebula_msgs::msg::NebulaPackets>> scans;
+  for (auto & packets : synthesizeScans(*synthesizer, SYNTHETIC_RPM, SYNTHETIC_SCANS)) {
+    auto scan = std::make_shared<nebula_msgs::msg::NebulaPackets>();
+    for (auto & packet : packets) {
+      nebula_msgs::msg::NebulaPacket packet_msg;
+      packet_msg.stamp = packet.stamp;
+      packet_msg.data = std::move(packet.data);
+      scan->packets.push_back(std::move(packet_msg));
+    }
+    scans.push_back(scan);
+  }
+  return scans;
+}
+
+template <typename ScanMsgT>
+void decodeScans(
+  benchmark::State & state, drivers::HesaiDriver & driver,
+  const std::vector<std::shared_ptr<ScanMsgT>> & scans)
+{
+  // The first scan message may not complete a cloud as there is no scan in progress yet, so it is
+  // decoded once before timing
+  driver.ConvertScanToPointcloud(scans.front());
+
+  size_t n_packets = 0;
+  size_t n_points = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (auto _ : state) {
+    for (const auto & scan : scans) {
+      auto pointcloud = std::get<0>(driver.ConvertScanToPointcloud(scan));
+      n_packets += scan->packets.size();
+      n_points += pointcloud ? pointcloud->size() : 0;
+    }
+  }
+  setDecodeCounters(state, n_packets, n_points, std::chrono::steady_clock::now() - start);
+}
+
+void BM_HesaiDecoder(benchmark::State & state, const HesaiBenchmarkConfig & config)
+{
+  auto driver = createDriver(config);
+  if (driver->GetStatus() != Status::OK) {
+    state.SkipWithError("Could not initialize the driver");
+    return;
+  }
+
+  if (config.bag_path.empty()) {
+    decodeScans(state, *driver, loadSyntheticScans(config));
+  } else {
+    decodeScans(
+      state, *driver,
+      readBagMessages<pandar_msgs::msg::PandarScan>(
+        std::string(_SRC_RESOURCES_DIR_PATH) + "hesai/" + config.bag_path, "/pandar_packets"));
+  }
+}
+
+}  // namespace benchmarks
+}  // namespace nebula
+
+int main(int argc, char ** argv)
+{
+  for (const auto & config : nebula::benchmarks::BENCHMARK_CONFIGS) {
+    benchmark::RegisterBenchmark(
+      ("BM_HesaiDecoder/" + config.sensor_model).c_str(), nebula::benchmarks::BM_HesaiDecoder,
+      config)
+      ->Unit(benchmark::kMillisecond)
+      ->UseRealTime();
+  }
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
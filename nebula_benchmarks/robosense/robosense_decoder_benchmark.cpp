@@ -0,0 +1,100 @@
+// Decoding throughput of the Robosense driver.
+//
+// There are no Robosense recordings in nebula_tests, so the driver is fed a synthetic Helios
+// stream of whole revolutions. The calibration is decoded from a synthetic DIFOP packet, as the
+// driver does with the sensor's.
+
+#include "decoder_benchmark.hpp"
+#include "nebula_common/robosense/robosense_common.hpp"
+#include "nebula_decoders/nebula_decoders_robosense/robosense_driver.hpp"
+#include "nebula_decoders/nebula_decoders_robosense/robosense_info_driver.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+constexpr double SYNTHETIC_RPM = 600.;
+constexpr size_t SYNTHETIC_SCANS = 10;
+
+void BM_RobosenseDecoder(benchmark::State & state, bool dual_return)
+{
+  SynthesizerConfiguration synthesizer_configuration;
+  synthesizer_configuration.vendor = "robosense";
+  synthesizer_configuration.rpm = SYNTHETIC_RPM;
+  synthesizer_configuration.dual_return = dual_return;
+  auto synthesizer = createPacketSynthesizer(synthesizer_configuration);
+
+  auto sensor_configuration = std::make_shared<drivers::RobosenseSensorConfiguration>();
+  sensor_configuration->sensor_model = drivers::SensorModelFromString(synthesizer->sensorModel());
+  sensor_configuration->frame_id = "robosense";
+  sensor_configuration->min_range = 0.3;
+  sensor_configuration->max_range = 300.;
+  sensor_configuration->dual_return_distance_threshold = 0.1;
+
+  drivers::RobosenseInfoDriver info_driver(sensor_configuration);
+  std::vector<uint8_t> info_packet(synthesizer->infoPacketSize());
+  synthesizer->writeInfoPacket(info_packet.data(), 0);
+  if (info_driver.DecodeInfoPacket(info_packet) != Status::OK) {
+    state.SkipWithError("Could not decode the DIFOP packet");
+    return;
+  }
+  sensor_configuration->return_mode = info_driver.GetReturnMode();
+  auto calibration_configuration = std::make_shared<drivers::RobosenseCalibrationConfiguration>(
+    info_driver.GetSensorCalibration());
+  calibration_configuration->CreateCorrectedChannels();
+
+  drivers::RobosenseDriver driver(sensor_configuration, calibration_configuration);
+  if (driver.GetStatus() != Status::OK) {
+    state.SkipWithError("Could not initialize the driver");
+    return;
+  }
+
+  std::vector<std::shared_ptr<robosense_msgs::msg::RobosenseScan>> scans;
+  for (const auto & packets : synthesizeScans(*synthesizer, SYNTHETIC_RPM, SYNTHETIC_SCANS)) {
+    auto scan = std::make_shared<robosense_msgs::msg::RobosenseScan>();
+    for (const auto & packet : packets) {
+      robosense_msgs::msg::RobosensePacket packet_msg;
+      packet_msg.stamp = packet.stamp;
+      std::copy(packet.data.begin(), packet.data.end(), packet_msg.data.begin());
+      scan->packets.push_back(packet_msg);
+    }
+    scans.push_back(scan);
+  }
+
+  // The first scan message may not complete a cloud as there is no scan in progress yet, so it is
+  // decoded once before timing
+  driver.ConvertScanToPointcloud(scans.front());
+
+  size_t n_packets = 0;
+  size_t n_points = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (auto _ : state) {
+    for (const auto & scan : scans) {
+      auto pointcloud = std::get<0>(driver.ConvertScanToPointcloud(scan));
+      n_packets += scan->packets.size();
+      n_points += pointcloud ? pointcloud->size() : 0;
+    }
+  }
+  setDecodeCounters(state, n_packets, n_points, std::chrono::steady_clock::now() - start);
+}
+
+BENCHMARK_CAPTURE(BM_RobosenseDecoder, Helios, false)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+BENCHMARK_CAPTURE(BM_RobosenseDecoder, HeliosDual, true)
+  ->Unit(benchmark::kMillisecond)
+  ->UseRealTime();
+
+}  // namespace benchmarks
+}  // namespace nebula
+
+BENCHMARK_MAIN();
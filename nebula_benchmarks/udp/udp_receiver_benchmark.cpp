@@ -0,0 +1,190 @@
+// Compares the asio-based UDP receiver used by the hardware interfaces with the batched
+// recvmmsg-based UdpBatchReceiver.
+//
+// A local sender stands in for the sensor: every iteration, it sends a burst of packets of a
+// realistic size to the loopback interface with sendmmsg, and the iteration ends once all of them
+// have been received or no more packets arrived for a while. The sender's cost is the same for all
+// receivers, so differences in the reported packets/s are due to the receivers.
+//
+// Loopback delivery happens on the sending thread, so packets are dropped once the socket buffer
+// is full if the receiver cannot keep up. Both receivers use the default socket buffer size. The
+// fraction of dropped packets is reported as `drop_ratio`.
+
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/udp_batch_receiver.hpp"
+
+#include <boost_udp_driver/udp_driver.hpp>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+constexpr char HOST_IP[] = "127.0.0.1";
+// The size of a Pandar128E4X packet with all optional fields
+constexpr size_t PACKET_SIZE = 1117;
+// Small enough to fit into the default socket receive buffer, so that no packets are dropped as
+// long as the receiver drains the socket between bursts
+constexpr size_t PACKETS_PER_ITERATION = 64;
+constexpr size_t SEND_BATCH_SIZE = 64;
+constexpr std::chrono::milliseconds DRAIN_TIMEOUT{20};
+
+/// @brief Sends bursts of equally sized packets to a local port
+class PacketSender
+{
+public:
+  explicit PacketSender(uint16_t port)
+  : fd_(socket(AF_INET, SOCK_DGRAM, 0)),
+    payload_(SEND_BATCH_SIZE * PACKET_SIZE, 0xA5),
+    iovecs_(SEND_BATCH_SIZE),
+    headers_(SEND_BATCH_SIZE)
+  {
+    if (fd_ < 0) {
+      throw std::runtime_error("Could not open sender socket");
+    }
+
+    destination_.sin_family = AF_INET;
+    destination_.sin_port = htons(port);
+    inet_pton(AF_INET, HOST_IP, &destination_.sin_addr);
+
+    for (size_t i = 0; i < SEND_BATCH_SIZE; ++i) {
+      iovecs_[i].iov_base = payload_.data() + i * PACKET_SIZE;
+      iovecs_[i].iov_len = PACKET_SIZE;
+      headers_[i].msg_hdr.msg_name = &destination_;
+      headers_[i].msg_hdr.msg_namelen = sizeof(destination_);
+      headers_[i].msg_hdr.msg_iov = &iovecs_[i];
+      headers_[i].msg_hdr.msg_iovlen = 1;
+    }
+  }
+
+  ~PacketSender() { close(fd_); }
+
+  void send(size_t n_packets)
+  {
+    while (n_packets > 0) {
+      const size_t n_batch = std::min(n_packets, SEND_BATCH_SIZE);
+      const int n_sent = sendmmsg(fd_, headers_.data(), n_batch, 0);
+      if (n_sent <= 0) {
+        continue;
+      }
+      n_packets -= n_sent;
+    }
+  }
+
+private:
+  int fd_;
+  sockaddr_in destination_{};
+  std::vector<uint8_t> payload_;
+  std::vector<iovec> iovecs_;
+  std::vector<mmsghdr> headers_;
+};
+
+/// @brief Send a burst per iteration and wait until the receiver has counted all packets or has
+/// stopped making progress
+void runBursts(benchmark::State & state, uint16_t port, const std::atomic<uint64_t> & n_received)
+{
+  PacketSender sender(port);
+  uint64_t n_sent = 0;
+  const uint64_t n_received_before = n_received;
+
+  for (auto _ : state) {
+    const uint64_t target = n_received + PACKETS_PER_ITERATION;
+    sender.send(PACKETS_PER_ITERATION);
+    n_sent += PACKETS_PER_ITERATION;
+
+    uint64_t last_count = n_received;
+    auto last_progress = std::chrono::steady_clock::now();
+    while (n_received < target) {
+      std::this_thread::yield();
+      const uint64_t count = n_received;
+      const auto now = std::chrono::steady_clock::now();
+      if (count != last_count) {
+        last_count = count;
+        last_progress = now;
+      } else if (now - last_progress > DRAIN_TIMEOUT) {
+        break;
+      }
+    }
+  }
+
+  const double n_delivered = static_cast<double>(n_received - n_received_before);
+  state.counters["packets_per_s"] = benchmark::Counter(n_delivered, benchmark::Counter::kIsRate);
+  state.counters["drop_ratio"] = n_sent > 0 ? 1.0 - n_delivered / n_sent : 0.0;
+  state.SetBytesProcessed(static_cast<int64_t>(n_delivered) * PACKET_SIZE);
+}
+
+/// @brief The receiver currently used by the hardware interfaces: one syscall and one vector per
+/// packet
+void BM_AsioReceiver(benchmark::State & state)
+{
+  constexpr uint16_t port = 23681;
+  std::atomic<uint64_t> n_received{0};
+
+  ::drivers::common::IoContext io_context(1);
+  {
+    ::drivers::udp_driver::UdpDriver driver(io_context);
+    driver.init_receiver(HOST_IP, port);
+    driver.receiver()->open();
+    driver.receiver()->bind();
+    driver.receiver()->asyncReceive([&](const std::vector<uint8_t> & buffer) {
+      benchmark::DoNotOptimize(buffer.data());
+      n_received++;
+    });
+
+    runBursts(state, port, n_received);
+    driver.receiver()->close();
+  }
+}
+
+void BM_BatchReceiver(benchmark::State & state)
+{
+  constexpr uint16_t port = 23682;
+  const size_t batch_size = state.range(0);
+  const auto batch_timeout = std::chrono::microseconds(state.range(1));
+  std::atomic<uint64_t> n_received{0};
+
+  drivers::UdpBatchReceiver receiver(batch_size, batch_timeout);
+  receiver.open(HOST_IP, port);
+  receiver.start([&](const drivers::UdpPacketView * packets, size_t n_packets) {
+    benchmark::DoNotOptimize(packets[0].data);
+    n_received += n_packets;
+  });
+
+  runBursts(state, port, n_received);
+  receiver.stop();
+
+  state.counters["packets_per_batch"] =
+    receiver.batches() > 0 ? static_cast<double>(receiver.packets()) / receiver.batches() : 0.0;
+}
+
+BENCHMARK(BM_AsioReceiver)->UseRealTime()->Unit(benchmark::kMicrosecond);
+BENCHMARK(BM_BatchReceiver)
+  ->ArgNames({"batch_size", "timeout_us"})
+  ->Args({1, 0})
+  ->Args({8, 1000})
+  ->Args({32, 1000})
+  ->Args({64, 1000})
+  ->Args({64, 0})
+  ->UseRealTime()
+  ->Unit(benchmark::kMicrosecond);
+
+}  // namespace benchmarks
+}  // namespace nebula
+
+BENCHMARK_MAIN();
@@ -0,0 +1,100 @@
+// Decoding throughput of the Velodyne driver, per sensor model.
+//
+// Each iteration converts all scans recorded in the model's test bag (see nebula_tests) into point
+// clouds, over the full field of view.
+
+#include "decoder_benchmark.hpp"
+#include "nebula_common/velodyne/velodyne_common.hpp"
+#include "nebula_decoders/nebula_decoders_velodyne/velodyne_driver.hpp"
+
+#include <benchmark/benchmark.h>
+
+#include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace nebula
+{
+namespace benchmarks
+{
+
+struct VelodyneBenchmarkConfig
+{
+  std::string sensor_model;
+  std::string return_mode;
+  std::string calibration_file;
+  /// @brief Relative to the Velodyne test data directory
+  std::string bag_path;
+  std::string topic = "/velodyne_packets";
+};
+
+const VelodyneBenchmarkConfig BENCHMARK_CONFIGS[] = {
+  {"VLP16", "Dual", "VLP16.yaml", "vlp16/1673400471837873222"},
+  {"VLP32", "SingleStrongest", "VLP32.yaml", "vlp32/1713492677464078412",
+   "/sensing/lidar/front/velodyne_packets"},
+  {"VLS128", "Dual", "VLS128.yaml", "vls128/1614315746471294674"},
+};
+
+void BM_VelodyneDecoder(benchmark::State & state, const VelodyneBenchmarkConfig & config)
+{
+  auto sensor_configuration = std::make_shared<drivers::VelodyneSensorConfiguration>();
+  sensor_configuration->sensor_model = drivers::SensorModelFromString(config.sensor_model);
+  sensor_configuration->return_mode = drivers::ReturnModeFromString(config.return_mode);
+  sensor_configuration->frame_id = "velodyne";
+  sensor_configuration->min_range = 0.3;
+  sensor_configuration->max_range = 300.;
+  sensor_configuration->cloud_min_angle = 0;
+  sensor_configuration->cloud_max_angle = 359;
+
+  auto calibration_configuration = std::make_shared<drivers::VelodyneCalibrationConfiguration>();
+  if (calibration_configuration->LoadFromFile(
+        std::string(_SRC_CALIBRATION_DIR_PATH) + "velodyne/" + config.calibration_file) !=
+      Status::OK) {
+    throw std::runtime_error("Could not load " + config.calibration_file);
+  }
+
+  drivers::VelodyneDriver driver(sensor_configuration, calibration_configuration);
+  if (driver.GetStatus() != Status::OK) {
+    state.SkipWithError("Could not initialize the driver");
+    return;
+  }
+
+  const auto scans = readBagMessages<velodyne_msgs::msg::VelodyneScan>(
+    std::string(_SRC_RESOURCES_DIR_PATH) + "velodyne/" + config.bag_path, config.topic);
+
+  // The first scan message may not complete a cloud as there is no scan in progress yet, so it is
+  // decoded once before timing
+  driver.ConvertScanToPointcloud(scans.front());
+
+  size_t n_packets = 0;
+  size_t n_points = 0;
+  const auto start = std::chrono::steady_clock::now();
+  for (auto _ : state) {
+    for (const auto & scan : scans) {
+      auto pointcloud = std::get<0>(driver.ConvertScanToPointcloud(scan));
+      n_packets += scan->packets.size();
+      n_points += pointcloud ? pointcloud->size() : 0;
+    }
+  }
+  setDecodeCounters(state, n_packets, n_points, std::chrono::steady_clock::now() - start);
+}
+
+}  // namespace benchmarks
+}  // namespace nebula
+
+int main(int argc, char ** argv)
+{
+  for (const auto & config : nebula::benchmarks::BENCHMARK_CONFIGS) {
+    benchmark::RegisterBenchmark(
+      ("BM_VelodyneDecoder/" + config.sensor_model).c_str(),
+      nebula::benchmarks::BM_VelodyneDecoder, config)
+      ->Unit(benchmark::kMillisecond)
+      ->UseRealTime();
+  }
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
@@ -26,6 +26,8 @@ struct HesaiSensorConfiguration : LidarConfigurationBase
   uint8_t ptp_domain;
   PtpTransportType ptp_transport_type;
   PtpSwitchType ptp_switch_type;
+  /// @brief The number of threads converting the packets of a scan message. 1 decodes serially
+  uint16_t decode_threads{1};
 };
 /// @brief Convert HesaiSensorConfiguration to string (Overloading the << operator)
 /// @param os
@@ -39,7 +41,7 @@ inline std::ostream & operator<<(std::ostream & os, HesaiSensorConfiguration con
      << ", DualReturnDistanceThreshold:" << arg.dual_return_distance_threshold
      << ", PtpProfile:" << arg.ptp_profile << ", PtpDomain:" << std::to_string(arg.ptp_domain)
      << ", PtpTransportType:" << arg.ptp_transport_type
-     << ", PtpSwitchType:" << arg.ptp_switch_type;
+     << ", PtpSwitchType:" << arg.ptp_switch_type << ", DecodeThreads:" << arg.decode_threads;
   return os;
 }
 
@@ -361,6 +361,48 @@ enum class PtpSwitchType {
   UNKNOWN_SWITCH
 };
 
+/// @brief Which packet to drop when the packet ring between the receive and decode threads is full
+enum class PacketOverflowPolicy {
+  DROP_OLDEST = 0,
+  DROP_NEWEST,
+  UNKNOWN_POLICY
+};
+
+/// @brief Converts String to PacketOverflowPolicy
+/// @param overflow_policy Policy as String
+/// @return Corresponding PacketOverflowPolicy
+inline PacketOverflowPolicy PacketOverflowPolicyFromString(const std::string & overflow_policy)
+{
+  auto tmp_str = overflow_policy;
+  std::transform(tmp_str.begin(), tmp_str.end(), tmp_str.begin(),
+                 [](unsigned char c){ return std::tolower(c); });
+  if (tmp_str == "drop_oldest") return PacketOverflowPolicy::DROP_OLDEST;
+  if (tmp_str == "drop_newest") return PacketOverflowPolicy::DROP_NEWEST;
+
+  return PacketOverflowPolicy::UNKNOWN_POLICY;
+}
+
+/// @brief Convert PacketOverflowPolicy enum to string (Overloading the << operator)
+/// @param os
+/// @param arg
+/// @return stream
+inline std::ostream & operator<<(
+  std::ostream & os, nebula::drivers::PacketOverflowPolicy const & arg)
+{
+  switch (arg) {
+    case PacketOverflowPolicy::DROP_OLDEST:
+      os << "drop_oldest";
+      break;
+    case PacketOverflowPolicy::DROP_NEWEST:
+      os << "drop_newest";
+      break;
+    case PacketOverflowPolicy::UNKNOWN_POLICY:
+      os << "UNKNOWN";
+      break;
+  }
+  return os;
+}
+
 /// @brief not used?
 struct PointField
 {
@@ -460,6 +502,17 @@ struct EthernetSensorConfigurationBase : SensorConfigurationBase
   std::string host_ip;
   std::string sensor_ip;
   uint16_t data_port;
+  /// @brief Stamp data packets with the time the kernel received them instead of the time they
+  /// were processed
+  bool use_kernel_timestamps{false};
+  /// @brief The requested receive buffer size of the data socket in bytes. 0 keeps the system
+  /// default
+  uint32_t receive_buffer_size{0};
+  /// @brief Replay the data packets of this PCAP capture instead of receiving them from the
+  /// sensor. Empty receives from the sensor
+  std::string pcap_file{};
+  /// @brief The replay speed as a multiple of the recorded speed. 0 replays as fast as possible
+  double pcap_replay_speed{1.};
 };
 
 /// @brief Base struct for Lidar configuration
@@ -474,6 +527,15 @@ struct LidarConfigurationBase : EthernetSensorConfigurationBase
   bool remove_nans;  /// todo: consider changing to only_finite
   std::vector<PointField> fields;
   bool use_sensor_time{false};
+  /// @brief The maximum number of packets received per syscall. 1 receives packets one by one
+  uint16_t receive_batch_size{1};
+  /// @brief The maximum time in microseconds to wait for a batch of packets to fill up
+  uint32_t receive_batch_timeout_us{1000};
+  /// @brief The number of packets buffered between the receive thread and the thread assembling
+  /// scans. 0 assembles scans on the receive thread
+  uint32_t packet_ring_size{0};
+  /// @brief Which packet to drop when the packet ring is full
+  PacketOverflowPolicy packet_overflow_policy{PacketOverflowPolicy::DROP_OLDEST};
 };
 
 /// @brief Convert SensorConfigurationBase to string (Overloading the << operator)
@@ -493,7 +555,12 @@ inline std::ostream & operator<<(std::ostream & os, SensorConfigurationBase cons
 inline std::ostream & operator<<(std::ostream & os, EthernetSensorConfigurationBase const & arg)
 {
   os << (SensorConfigurationBase)(arg) << ", HostIP: " << arg.host_ip
-     << ", SensorIP: " << arg.sensor_ip << ", DataPort: " << arg.data_port;
+     << ", SensorIP: " << arg.sensor_ip << ", DataPort: " << arg.data_port
+     << ", UseKernelTimestamps: " << arg.use_kernel_timestamps
+     << ", ReceiveBufferSize: " << arg.receive_buffer_size;
+  if (!arg.pcap_file.empty()) {
+    os << ", PcapFile: " << arg.pcap_file << ", PcapReplaySpeed: " << arg.pcap_replay_speed;
+  }
   return os;
 }
 
@@ -506,7 +573,11 @@ inline std::ostream & operator<<(
 {
   os << (EthernetSensorConfigurationBase)(arg) << ", ReturnMode: " << arg.return_mode
      << ", Frequency: " << arg.frequency_ms << ", MTU: " << arg.packet_mtu_size
-     << ", Use sensor time: " << arg.use_sensor_time;
+     << ", Use sensor time: " << arg.use_sensor_time
+     << ", ReceiveBatchSize: " << arg.receive_batch_size
+     << ", ReceiveBatchTimeout(us): " << arg.receive_batch_timeout_us
+     << ", PacketRingSize: " << arg.packet_ring_size
+     << ", PacketOverflowPolicy: " << arg.packet_overflow_policy;
   return os;
 }
 
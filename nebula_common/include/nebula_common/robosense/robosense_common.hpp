@@ -55,7 +55,7 @@ inline ReturnMode ReturnModeFromStringRobosense(const std::string & return_mode)
   return ReturnMode::UNKNOWN;
 }
 
-size_t GetChannelSize(const SensorModel & model)
+inline size_t GetChannelSize(const SensorModel & model)
 {
   switch (model) {
     case SensorModel::ROBOSENSE_BPEARL_V3:
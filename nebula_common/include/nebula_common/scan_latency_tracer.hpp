@@ -0,0 +1,214 @@
+#ifndef NEBULA_SCAN_LATENCY_TRACER_H
+#define NEBULA_SCAN_LATENCY_TRACER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief The points of the pipeline from packet reception to point cloud publication at which a
+/// scan is traced, in pipeline order
+enum class ScanStage : uint8_t {
+  /// @brief The first packet of the scan has been received
+  FIRST_PACKET_RECEIVED,
+  /// @brief The last packet of the scan has been received
+  LAST_PACKET_RECEIVED,
+  /// @brief The hardware interface has detected that the scan is complete
+  SCAN_COMPLETED,
+  /// @brief The scan's packets have been published
+  PACKETS_PUBLISHED,
+  /// @brief The decoder has started converting the scan's packets
+  DECODE_STARTED,
+  /// @brief The decoder has finished converting the scan's packets
+  DECODE_FINISHED,
+  /// @brief The decoded scan has been serialized into PointCloud2 messages
+  CLOUD_SERIALIZED,
+  /// @brief The PointCloud2 messages have been published
+  CLOUD_PUBLISHED
+};
+
+constexpr size_t N_SCAN_STAGES = static_cast<size_t>(ScanStage::CLOUD_PUBLISHED) + 1;
+
+/// @brief Converts ScanStage to String
+/// @param stage The stage
+/// @return The stage's name in snake case, e.g. "decode_finished"
+inline const char * ScanStageToString(ScanStage stage)
+{
+  switch (stage) {
+    case ScanStage::FIRST_PACKET_RECEIVED:
+      return "first_packet_received";
+    case ScanStage::LAST_PACKET_RECEIVED:
+      return "last_packet_received";
+    case ScanStage::SCAN_COMPLETED:
+      return "scan_completed";
+    case ScanStage::PACKETS_PUBLISHED:
+      return "packets_published";
+    case ScanStage::DECODE_STARTED:
+      return "decode_started";
+    case ScanStage::DECODE_FINISHED:
+      return "decode_finished";
+    case ScanStage::CLOUD_SERIALIZED:
+      return "cloud_serialized";
+    case ScanStage::CLOUD_PUBLISHED:
+      return "cloud_published";
+  }
+  return "unknown";
+}
+
+/// @brief Get the ID scans are traced by from the stamp of their first packet, which is also the
+/// stamp of the scan's packets message
+/// @param stamp A builtin_interfaces::msg::Time
+/// @return The stamp in nanoseconds since the epoch
+template <typename StampT>
+uint64_t ScanIdFromStamp(const StampT & stamp)
+{
+  return static_cast<uint64_t>(stamp.sec) * 1'000'000'000 + stamp.nanosec;
+}
+
+/// @brief Traces the latency of a sensor's scans through the pipeline, from the reception of their
+/// first packet to the publication of their point clouds.
+///
+/// The hardware interface, decoder and ROS wrappers record when a scan reaches each `ScanStage`.
+/// Scans are identified by the receive time of their first packet (see `ScanIdFromStamp`), which
+/// travels with the scan's packets message, so that stages recorded in different nodes and threads
+/// are correlated. The time between a stage and the previous stage recorded for the same scan in
+/// this process is accumulated in a histogram per stage, along with the end-to-end latency from the
+/// first packet to the point cloud publication.
+///
+/// If nebula_common was built with LTTng-UST, every recorded stage is also emitted as a
+/// `nebula:scan_stage` tracepoint, e.g. to be recorded along ros2_tracing's events with
+/// `ros2 trace -u 'ros2:*' 'nebula:*'`.
+///
+/// Tracing is disabled by default. A disabled tracer costs one relaxed atomic load per stage.
+class ScanLatencyTracer
+{
+public:
+  /// @brief The number of bins of the latency histograms
+  static constexpr size_t N_BINS = 13;
+  /// @brief The inclusive upper bounds of all but the last histogram bin, which is unbounded
+  static constexpr std::array<std::chrono::microseconds, N_BINS - 1> BIN_UPPER_BOUNDS = {
+    std::chrono::microseconds(100),     std::chrono::microseconds(200),
+    std::chrono::microseconds(500),     std::chrono::microseconds(1'000),
+    std::chrono::microseconds(2'000),   std::chrono::microseconds(5'000),
+    std::chrono::microseconds(10'000),  std::chrono::microseconds(20'000),
+    std::chrono::microseconds(50'000),  std::chrono::microseconds(100'000),
+    std::chrono::microseconds(200'000), std::chrono::microseconds(500'000)};
+
+  /// @brief The distribution of a latency
+  struct Histogram
+  {
+    /// @brief The number of samples in each bin, see `BIN_UPPER_BOUNDS`
+    std::array<uint64_t, N_BINS> bin_counts{};
+    uint64_t count{0};
+    std::chrono::nanoseconds sum{0};
+    std::chrono::nanoseconds max{0};
+
+    /// @brief Add a sample
+    /// @param latency The latency, negative latencies (e.g. due to clock adjustments) count as 0
+    void add(std::chrono::nanoseconds latency);
+  };
+
+  /// @brief The histograms accumulated between two calls to `collect`
+  struct Summary
+  {
+    /// @brief The time from the previous stage recorded for the same scan to each stage. As the
+    /// origin of all scans, FIRST_PACKET_RECEIVED is always empty
+    std::array<Histogram, N_SCAN_STAGES> stages;
+    /// @brief The time from the first packet of a scan to the publication of its point clouds
+    Histogram end_to_end;
+  };
+
+  /// @brief Get the tracer of a sensor, shared by all nodes of this process
+  /// @param sensor_name The name the sensor's events are emitted with, e.g. its frame ID
+  /// @return The sensor's tracer, created disabled on first use
+  static std::shared_ptr<ScanLatencyTracer> forSensor(const std::string & sensor_name);
+
+  explicit ScanLatencyTracer(std::string sensor_name);
+
+  /// @brief Enable or disable tracing
+  void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+
+  bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+  /// @brief Record that a scan reached a stage now
+  /// @param stage The stage
+  /// @param scan_id The scan's ID, see `ScanIdFromStamp`
+  void record(ScanStage stage, uint64_t scan_id)
+  {
+    if (isEnabled()) {
+      recordEnabled(stage, scan_id, nowNs());
+    }
+  }
+
+  /// @brief Record that a scan reached a stage at the given time
+  /// @param stage The stage
+  /// @param scan_id The scan's ID, see `ScanIdFromStamp`
+  /// @param time_ns The time the stage was reached in nanoseconds since the epoch, e.g. the kernel
+  /// receive time of a packet
+  void record(ScanStage stage, uint64_t scan_id, uint64_t time_ns)
+  {
+    if (isEnabled()) {
+      recordEnabled(stage, scan_id, time_ns);
+    }
+  }
+
+  /// @brief Get the histograms accumulated since the last call and reset them
+  Summary collect();
+
+  /// @brief Claim collecting the histograms. As `collect` resets them, only one collector per
+  /// tracer, e.g. one of the nodes sharing it, should collect them
+  /// @param collector Identifies the collector
+  /// @return Whether the collector holds the claim, i.e. no other collector held it
+  bool claimCollection(const void * collector);
+
+  /// @brief Release the claim to collect the histograms, if the collector holds it, so that another
+  /// collector can take over
+  /// @param collector Identifies the collector
+  void releaseCollection(const void * collector);
+
+  /// @brief The current time in nanoseconds since the epoch, on the clock stages are recorded with
+  static uint64_t nowNs()
+  {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::system_clock::now().time_since_epoch())
+      .count();
+  }
+
+private:
+  /// @brief The number of scans whose last recorded stage is remembered. Scans overlap in the
+  /// pipeline by a few scans at most
+  static constexpr size_t N_TRACKED_SCANS = 8;
+
+  struct TrackedScan
+  {
+    uint64_t scan_id{0};
+    uint64_t last_stage_time_ns{0};
+  };
+
+  void recordEnabled(ScanStage stage, uint64_t scan_id, uint64_t time_ns);
+
+  const std::string sensor_name_;
+  std::atomic<bool> enabled_{false};
+
+  std::mutex mutex_;
+  std::array<TrackedScan, N_TRACKED_SCANS> tracked_scans_{};
+  /// @brief The slot of `tracked_scans_` the next new scan replaces
+  size_t next_tracked_scan_{0};
+  Summary summary_;
+  /// @brief The collector holding the claim to collect the histograms, if any
+  const void * collector_{nullptr};
+};
+
+}  // namespace drivers
+}  // namespace nebula
+
+#endif  // NEBULA_SCAN_LATENCY_TRACER_H
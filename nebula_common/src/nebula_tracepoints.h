@@ -0,0 +1,30 @@
+// LTTng-UST tracepoint provider of nebula, only compiled if LTTng-UST is available
+
+#undef TRACEPOINT_PROVIDER
+#define TRACEPOINT_PROVIDER nebula
+
+#undef TRACEPOINT_INCLUDE
+#define TRACEPOINT_INCLUDE "nebula_tracepoints.h"
+
+#if !defined(NEBULA_TRACEPOINTS_H) || defined(TRACEPOINT_HEADER_MULTI_READ)
+#define NEBULA_TRACEPOINTS_H
+
+#include <lttng/tracepoint.h>
+
+#include <stdint.h>
+
+// A scan of a sensor reached a stage of the pipeline, see nebula::drivers::ScanLatencyTracer
+TRACEPOINT_EVENT(
+  nebula, scan_stage,
+  TP_ARGS(const char *, sensor_name, uint64_t, scan_id, uint8_t, stage, const char *, stage_name,
+          uint64_t, time_ns),
+  TP_FIELDS(
+    ctf_string(sensor_name, sensor_name)
+    ctf_integer(uint64_t, scan_id, scan_id)
+    ctf_integer(uint8_t, stage, stage)
+    ctf_string(stage_name, stage_name)
+    ctf_integer(uint64_t, time_ns, time_ns)))
+
+#endif  // NEBULA_TRACEPOINTS_H
+
+#include <lttng/tracepoint-event.h>
@@ -0,0 +1,99 @@
+#include "nebula_common/scan_latency_tracer.hpp"
+
+#ifdef NEBULA_WITH_LTTNG
+#define TRACEPOINT_CREATE_PROBES
+#define TRACEPOINT_DEFINE
+#include "nebula_tracepoints.h"
+#endif
+
+#include <algorithm>
+#include <map>
+#include <utility>
+
+namespace nebula
+{
+namespace drivers
+{
+
+void ScanLatencyTracer::Histogram::add(std::chrono::nanoseconds latency)
+{
+  latency = std::max(latency, std::chrono::nanoseconds::zero());
+  const auto bin = std::lower_bound(BIN_UPPER_BOUNDS.begin(), BIN_UPPER_BOUNDS.end(), latency) -
+                   BIN_UPPER_BOUNDS.begin();
+  bin_counts[bin]++;
+  count++;
+  sum += latency;
+  max = std::max(max, latency);
+}
+
+std::shared_ptr<ScanLatencyTracer> ScanLatencyTracer::forSensor(const std::string & sensor_name)
+{
+  static std::mutex tracers_mutex;
+  static std::map<std::string, std::shared_ptr<ScanLatencyTracer>> tracers;
+
+  std::lock_guard<std::mutex> lock(tracers_mutex);
+  auto & tracer = tracers[sensor_name];
+  if (!tracer) {
+    tracer = std::make_shared<ScanLatencyTracer>(sensor_name);
+  }
+  return tracer;
+}
+
+ScanLatencyTracer::ScanLatencyTracer(std::string sensor_name) : sensor_name_(std::move(sensor_name))
+{
+}
+
+void ScanLatencyTracer::recordEnabled(ScanStage stage, uint64_t scan_id, uint64_t time_ns)
+{
+#ifdef NEBULA_WITH_LTTNG
+  tracepoint(
+    nebula, scan_stage, sensor_name_.c_str(), scan_id, static_cast<uint8_t>(stage),
+    ScanStageToString(stage), time_ns);
+#endif
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto scan = std::find_if(
+    tracked_scans_.begin(), tracked_scans_.end(),
+    [scan_id](const TrackedScan & tracked_scan) { return tracked_scan.scan_id == scan_id; });
+  if (scan == tracked_scans_.end()) {
+    // The scan's ID is the receive time of its first packet, which is the origin of all stages
+    scan = tracked_scans_.begin() + next_tracked_scan_;
+    next_tracked_scan_ = (next_tracked_scan_ + 1) % N_TRACKED_SCANS;
+    *scan = {scan_id, scan_id};
+  }
+
+  if (stage != ScanStage::FIRST_PACKET_RECEIVED) {
+    summary_.stages[static_cast<size_t>(stage)].add(
+      std::chrono::nanoseconds(static_cast<int64_t>(time_ns - scan->last_stage_time_ns)));
+  }
+  if (stage == ScanStage::CLOUD_PUBLISHED) {
+    summary_.end_to_end.add(std::chrono::nanoseconds(static_cast<int64_t>(time_ns - scan_id)));
+  }
+  scan->last_stage_time_ns = time_ns;
+}
+
+ScanLatencyTracer::Summary ScanLatencyTracer::collect()
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::exchange(summary_, Summary{});
+}
+
+bool ScanLatencyTracer::claimCollection(const void * collector)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!collector_) {
+    collector_ = collector;
+  }
+  return collector_ == collector;
+}
+
+void ScanLatencyTracer::releaseCollection(const void * collector)
+{
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (collector_ == collector) {
+    collector_ = nullptr;
+  }
+}
+
+}  // namespace drivers
+}  // namespace nebula
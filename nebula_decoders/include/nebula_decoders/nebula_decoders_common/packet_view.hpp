@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief Read-only view of a packed packet struct, placed over a raw byte buffer (e.g. the `data`
+/// field of a packet message). This allows decoding packets in place instead of copying them.
+///
+/// The view does not own the buffer. It is only valid as long as the buffer it was reset to is
+/// alive and unchanged.
+/// @tparam PacketT The packet struct. Has to be trivially copyable and should be packed, so that
+/// it can be laid over buffers at arbitrary addresses.
+template <typename PacketT>
+class PacketView
+{
+  static_assert(
+    std::is_trivially_copyable<PacketT>::value && std::is_standard_layout<PacketT>::value,
+    "Packet structs have to be trivially copyable and standard-layout to be read in place");
+
+private:
+  const PacketT * packet_{nullptr};
+
+public:
+  /// @brief Point the view to the given buffer.
+  /// @param data The start of the packet's data
+  /// @param size The number of valid bytes in the buffer
+  /// @return Whether the buffer is large enough and suitably aligned to hold a PacketT. If not,
+  /// the view is empty afterwards.
+  bool reset(const uint8_t * data, size_t size)
+  {
+    packet_ = nullptr;
+
+    if (data == nullptr || size < sizeof(PacketT)) {
+      return false;
+    }
+
+    if (reinterpret_cast<std::uintptr_t>(data) % alignof(PacketT) != 0) {
+      return false;
+    }
+
+    packet_ = reinterpret_cast<const PacketT *>(data);
+    return true;
+  }
+
+  /// @brief Detach the view from its buffer
+  void clear() { packet_ = nullptr; }
+
+  /// @brief Whether the view currently points to a packet
+  explicit operator bool() const { return packet_ != nullptr; }
+
+  const PacketT & operator*() const { return *packet_; }
+  const PacketT * operator->() const { return packet_; }
+};
+
+}  // namespace drivers
+}  // namespace nebula
@@ -0,0 +1,265 @@
+#pragma once
+
+#include "nebula_common/nebula_common.hpp"
+#include "nebula_common/point_types.hpp"
+
+#include <pcl/common/io.h>
+#include <pcl/point_cloud.h>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <std_msgs/msg/header.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <optional>
+#include <vector>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief The PointCloud2 field layout of a PCL-registered point type. The layout is identical to
+/// the one produced by `pcl::toROSMsg` but is only computed once per type instead of on every
+/// conversion.
+/// @return The fields of `PointT`, ordered as registered with `POINT_CLOUD_REGISTER_POINT_STRUCT`
+template <typename PointT>
+const std::vector<sensor_msgs::msg::PointField> & getPointCloud2Fields()
+{
+  static const std::vector<sensor_msgs::msg::PointField> fields = [] {
+    std::vector<sensor_msgs::msg::PointField> result;
+    for (const auto & pcl_field : pcl::getFields<PointT>()) {
+      sensor_msgs::msg::PointField field;
+      field.name = pcl_field.name;
+      field.offset = pcl_field.offset;
+      field.datatype = pcl_field.datatype;
+      field.count = pcl_field.count;
+      result.push_back(field);
+    }
+    return result;
+  }();
+
+  return fields;
+}
+
+/// @brief Writes points of type `PointT` directly into the data buffer of a PointCloud2 message.
+/// Points are stored with `point_step == sizeof(PointT)`, so the result is byte-identical to
+/// `pcl::toROSMsg` without the intermediate `pcl::PointCloud` and `pcl::PCLPointCloud2` copies.
+/// The header of the message is left to the caller.
+template <typename PointT>
+class PointCloud2Builder
+{
+private:
+  sensor_msgs::msg::PointCloud2 & msg_;
+  size_t n_points_{0};
+
+  /// @brief Make room for `n_points` more points and return the address to write them to
+  uint8_t * grow(size_t n_points)
+  {
+    const size_t offset = n_points_ * sizeof(PointT);
+    const size_t required_size = offset + n_points * sizeof(PointT);
+    if (required_size > msg_.data.size()) {
+      msg_.data.resize(std::max(required_size, 2 * msg_.data.size()));
+    }
+    n_points_ += n_points;
+    return msg_.data.data() + offset;
+  }
+
+public:
+  /// @brief Prepare `msg` for writing up to `capacity` points. Previous content is discarded.
+  /// @param msg The message to write to. Has to outlive the builder
+  /// @param capacity The number of points to reserve space for. Exceeding it reallocates the
+  /// data buffer
+  PointCloud2Builder(sensor_msgs::msg::PointCloud2 & msg, size_t capacity) : msg_(msg)
+  {
+    msg_.fields = getPointCloud2Fields<PointT>();
+    msg_.is_bigendian = false;
+    msg_.point_step = sizeof(PointT);
+    msg_.is_dense = true;
+    msg_.data.resize(capacity * sizeof(PointT));
+    msg_.height = 1;
+    msg_.width = 0;
+    msg_.row_step = 0;
+  }
+
+  /// @brief Append a single point to the message
+  void push_back(const PointT & point)
+  {
+    uint8_t * dst = grow(1);
+    std::memcpy(dst, &point, sizeof(PointT));
+  }
+
+  /// @brief Append a contiguous range of points to the message with a single copy
+  void append(const PointT * points, size_t n_points)
+  {
+    if (n_points == 0) {
+      return;
+    }
+
+    uint8_t * dst = grow(n_points);
+    std::memcpy(dst, points, n_points * sizeof(PointT));
+  }
+
+  /// @brief Mark the message as (not) dense, i.e. whether it contains invalid points
+  void setDense(bool is_dense) { msg_.is_dense = is_dense; }
+
+  /// @brief The number of points written so far
+  size_t size() const { return n_points_; }
+
+  /// @brief Update the message's dimensions to the points written so far and trim unused
+  /// capacity. Has to be called after the last point has been written.
+  void finalize()
+  {
+    msg_.data.resize(n_points_ * sizeof(PointT));
+    msg_.height = 1;
+    msg_.width = n_points_;
+    msg_.row_step = n_points_ * sizeof(PointT);
+  }
+};
+
+/// @brief Serialize a point cloud to PointCloud2 in a single copy. The result is unorganized, i.e.
+/// has a height of 1.
+/// @param input_pointcloud The point cloud
+/// @param msg The message to write to
+template <typename PointT>
+void toPointCloud2(
+  const pcl::PointCloud<PointT> & input_pointcloud, sensor_msgs::msg::PointCloud2 & msg)
+{
+  PointCloud2Builder<PointT> builder(msg, input_pointcloud.size());
+  builder.append(input_pointcloud.points.data(), input_pointcloud.size());
+  builder.setDense(input_pointcloud.is_dense);
+  builder.finalize();
+}
+
+/// @brief Convert a NebulaPointCloud to the Autoware PointXYZIR layout, writing directly into
+/// `msg`. Equivalent to `pcl::toROSMsg(*convertPointXYZIRCAEDTToPointXYZIR(cloud), msg)`.
+/// @param input_pointcloud The decoded point cloud
+/// @param msg The message to write to
+inline void toPointCloud2XYZIR(
+  const NebulaPointCloud & input_pointcloud, sensor_msgs::msg::PointCloud2 & msg)
+{
+  PointCloud2Builder<PointXYZIR> builder(msg, input_pointcloud.size());
+  PointXYZIR point{};
+  for (const auto & p : input_pointcloud.points) {
+    point.x = p.x;
+    point.y = p.y;
+    point.z = p.z;
+    point.intensity = p.intensity;
+    point.ring = p.channel;
+    builder.push_back(point);
+  }
+  builder.finalize();
+}
+
+/// @brief Convert a NebulaPointCloud to the Autoware PointXYZIRADT layout, writing directly into
+/// `msg`. Equivalent to `pcl::toROSMsg(*convertPointXYZIRCAEDTToPointXYZIRADT(cloud, stamp), msg)`.
+/// @param input_pointcloud The decoded point cloud
+/// @param stamp The scan timestamp in seconds that point timestamps are relative to
+/// @param msg The message to write to
+inline void toPointCloud2XYZIRADT(
+  const NebulaPointCloud & input_pointcloud, double stamp, sensor_msgs::msg::PointCloud2 & msg)
+{
+  PointCloud2Builder<PointXYZIRADT> builder(msg, input_pointcloud.size());
+  PointXYZIRADT point{};
+  for (const auto & p : input_pointcloud.points) {
+    point.x = p.x;
+    point.y = p.y;
+    point.z = p.z;
+    point.intensity = p.intensity;
+    point.ring = p.channel;
+    point.azimuth = rad2deg(p.azimuth) * 100.0;
+    point.distance = p.distance;
+    point.time_stamp = stamp + static_cast<double>(p.time_stamp) * 1e-9;
+    builder.push_back(point);
+  }
+  builder.finalize();
+}
+
+/// @brief The messages to be filled by `toPointCloud2FanOut`. Layouts whose message is nullptr,
+/// e.g. because their topic has no subscribers, are skipped.
+struct PointCloud2Outputs
+{
+  /// @brief Output in the native NebulaPoint layout
+  sensor_msgs::msg::PointCloud2 * nebula_points{nullptr};
+  /// @brief Output in the Autoware PointXYZIR layout
+  sensor_msgs::msg::PointCloud2 * xyzir{nullptr};
+  /// @brief Output in the Autoware PointXYZIRADT layout
+  sensor_msgs::msg::PointCloud2 * xyziradt{nullptr};
+
+  bool empty() const { return !nebula_points && !xyzir && !xyziradt; }
+};
+
+/// @brief Serialize a NebulaPointCloud to all requested layouts in a single pass over the points.
+/// Equivalent to calling `toPointCloud2`, `toPointCloud2XYZIR` and `toPointCloud2XYZIRADT`
+/// separately, but every input point is only read once.
+/// @param input_pointcloud The decoded point cloud
+/// @param stamp The scan timestamp in seconds that point timestamps are relative to
+/// @param header The header shared by all outputs
+/// @param outputs The messages to write to
+inline void toPointCloud2FanOut(
+  const NebulaPointCloud & input_pointcloud, double stamp, const std_msgs::msg::Header & header,
+  const PointCloud2Outputs & outputs)
+{
+  if (outputs.empty()) {
+    return;
+  }
+
+  const size_t n_points = input_pointcloud.size();
+  std::optional<PointCloud2Builder<NebulaPoint>> nebula_builder;
+  std::optional<PointCloud2Builder<PointXYZIR>> xyzir_builder;
+  std::optional<PointCloud2Builder<PointXYZIRADT>> xyziradt_builder;
+  if (outputs.nebula_points) {
+    nebula_builder.emplace(*outputs.nebula_points, n_points);
+  }
+  if (outputs.xyzir) {
+    xyzir_builder.emplace(*outputs.xyzir, n_points);
+  }
+  if (outputs.xyziradt) {
+    xyziradt_builder.emplace(*outputs.xyziradt, n_points);
+  }
+
+  PointXYZIR xyzir_point{};
+  PointXYZIRADT xyziradt_point{};
+  for (const auto & p : input_pointcloud.points) {
+    if (nebula_builder) {
+      nebula_builder->push_back(p);
+    }
+    if (xyzir_builder) {
+      xyzir_point.x = p.x;
+      xyzir_point.y = p.y;
+      xyzir_point.z = p.z;
+      xyzir_point.intensity = p.intensity;
+      xyzir_point.ring = p.channel;
+      xyzir_builder->push_back(xyzir_point);
+    }
+    if (xyziradt_builder) {
+      xyziradt_point.x = p.x;
+      xyziradt_point.y = p.y;
+      xyziradt_point.z = p.z;
+      xyziradt_point.intensity = p.intensity;
+      xyziradt_point.ring = p.channel;
+      xyziradt_point.azimuth = rad2deg(p.azimuth) * 100.0;
+      xyziradt_point.distance = p.distance;
+      xyziradt_point.time_stamp = stamp + static_cast<double>(p.time_stamp) * 1e-9;
+      xyziradt_builder->push_back(xyziradt_point);
+    }
+  }
+
+  if (nebula_builder) {
+    nebula_builder->setDense(input_pointcloud.is_dense);
+    nebula_builder->finalize();
+    outputs.nebula_points->header = header;
+  }
+  if (xyzir_builder) {
+    xyzir_builder->finalize();
+    outputs.xyzir->header = header;
+  }
+  if (xyziradt_builder) {
+    xyziradt_builder->finalize();
+    outputs.xyziradt->header = header;
+  }
+}
+
+}  // namespace drivers
+}  // namespace nebula
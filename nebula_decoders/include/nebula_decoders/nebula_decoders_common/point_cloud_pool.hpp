@@ -0,0 +1,97 @@
+#pragma once
+
+#include "nebula_common/point_types.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief The default number of point clouds per decoder: one being decoded, one held by the
+/// decoder as its latest output, and two for consumers that have not released older outputs yet
+constexpr size_t POINT_CLOUD_POOL_SIZE = 4;
+
+/// @brief A bounded pool of reusable point clouds.
+///
+/// `acquire()` hands out an empty point cloud that the caller owns exclusively until it shares the
+/// pointer. Once shared, e.g. by returning it from `getPointcloud()`, the cloud must not be mutated
+/// anymore. It is reused by a later `acquire()` only after all other references have been dropped,
+/// so consumers can hold on to a cloud for as long as they need without it being overwritten.
+///
+/// The pool keeps one reference to each of its clouds and checks whether it is the only owner left.
+/// Acquiring and releasing clouds thus neither allocates nor takes a lock. Clouds are reserved when
+/// they are handed out, which only allocates if a cloud has never been reserved for as many points
+/// before, so spare clouds that are never needed do not take up memory. Clouds keep their capacity
+/// when they are reused. If all clouds are in use, a new cloud outside of the pool is allocated and
+/// counted.
+///
+/// `acquire()` must only be called from one thread at a time. Clouds can be released from any
+/// thread.
+class PointCloudPool
+{
+private:
+  std::vector<NebulaPointCloudPtr> clouds_;
+  size_t reserved_points_;
+  std::atomic<uint64_t> n_overflows_{0};
+
+public:
+  /// @brief Constructor
+  /// @param n_clouds The number of clouds in the pool
+  /// @param reserved_points The number of points to reserve per cloud
+  explicit PointCloudPool(
+    size_t n_clouds = POINT_CLOUD_POOL_SIZE, size_t reserved_points = 0)
+  : reserved_points_(reserved_points)
+  {
+    clouds_.reserve(n_clouds);
+    for (size_t i = 0; i < n_clouds; ++i) {
+      clouds_.emplace_back(new NebulaPointCloud);
+    }
+  }
+
+  PointCloudPool(const PointCloudPool &) = delete;
+  PointCloudPool & operator=(const PointCloudPool &) = delete;
+
+  /// @brief Get an empty point cloud that is not referenced anywhere else, reserved for the number
+  /// of points given at construction
+  /// @return The point cloud. Allocated anew if all clouds of the pool are in use
+  NebulaPointCloudPtr acquire() { return acquire(reserved_points_); }
+
+  /// @brief Get an empty point cloud that is not referenced anywhere else
+  /// @param reserved_points The number of points to reserve
+  /// @return The point cloud. Allocated anew if all clouds of the pool are in use
+  NebulaPointCloudPtr acquire(size_t reserved_points)
+  {
+    for (const auto & cloud : clouds_) {
+      if (cloud.use_count() != 1) {
+        continue;
+      }
+
+      // Synchronize with the release of the last other reference, so that the previous owner's
+      // accesses to the cloud happen before it is cleared and refilled. ThreadSanitizer does not
+      // model standalone fences and reports a false positive here
+      std::atomic_thread_fence(std::memory_order_acquire);
+      cloud->clear();
+      cloud->reserve(reserved_points);
+      return cloud;
+    }
+
+    n_overflows_++;
+    NebulaPointCloudPtr cloud(new NebulaPointCloud);
+    cloud->reserve(reserved_points);
+    return cloud;
+  }
+
+  /// @brief The number of clouds in the pool
+  size_t size() const { return clouds_.size(); }
+
+  /// @brief The number of times a cloud had to be allocated because all clouds were in use
+  uint64_t overflows() const { return n_overflows_; }
+};
+
+}  // namespace drivers
+}  // namespace nebula
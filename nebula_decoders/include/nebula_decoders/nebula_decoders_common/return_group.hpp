@@ -0,0 +1,41 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <cstddef>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief The units of one channel across all blocks of a return group (e.g. 2 units for dual
+/// return). Has a fixed capacity so that it can be built for every channel without allocating.
+/// @tparam UnitT The unit type of the packet
+/// @tparam MaxReturns The maximum number of returns, i.e. `PacketT::MAX_RETURNS`
+template <typename UnitT, size_t MaxReturns>
+class ReturnGroup
+{
+private:
+  std::array<const UnitT *, MaxReturns> units_{};
+  size_t size_{0};
+
+public:
+  void clear() { size_ = 0; }
+
+  void push_back(const UnitT * unit)
+  {
+    assert(size_ < MaxReturns);
+    units_[size_++] = unit;
+  }
+
+  size_t size() const { return size_; }
+
+  const UnitT * operator[](size_t return_idx) const { return units_[return_idx]; }
+
+  const UnitT * const * begin() const { return units_.data(); }
+  const UnitT * const * end() const { return units_.data() + size_; }
+};
+
+}  // namespace drivers
+}  // namespace nebula
@@ -0,0 +1,156 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief An azimuth range of a scan for which no data was received
+struct AzimuthGap
+{
+  /// @brief Azimuth of the last return group received before the gap, in degrees
+  float start_azimuth_deg;
+  /// @brief Azimuth of the first return group received after the gap, in degrees
+  float end_azimuth_deg;
+  /// @brief The estimated number of packets lost in the gap
+  uint32_t n_missing_packets;
+};
+
+/// @brief Packet loss statistics of one scan
+struct ScanCompleteness
+{
+  /// @brief The number of packets that contributed return groups to the scan
+  uint32_t n_received_packets{0};
+  /// @brief The estimated number of packets lost within the scan
+  uint32_t n_missing_packets{0};
+  /// @brief The number of gaps in the scan. Can exceed `gaps.size()`, see `MAX_REPORTED_GAPS`
+  uint32_t n_gaps{0};
+  /// @brief The gaps in the scan, in the order they were detected
+  std::vector<AzimuthGap> gaps;
+  /// @brief The fraction of expected return groups that were received, in [0, 1]
+  double completeness{1.};
+};
+
+/// @brief Detects lost packets from the azimuth step between consecutive return groups.
+///
+/// Consecutive return groups of a spinning sensor are one firing cycle apart, so their azimuth
+/// step only depends on the rotation speed. A step of more than 1.5 times the expected step means
+/// that at least one return group, and thus at least one packet, was lost. The lost groups are
+/// counted towards the scan in progress, or the scan that is being completed if the gap spans the
+/// scan boundary. Steps of more than half a rotation are treated as a restart of the stream (e.g. a
+/// rosbag being looped) rather than a gap, as the amount of lost data cannot be determined.
+///
+/// The gap buffers are swapped between the scan in progress and the completed scan, so no
+/// allocations happen once the first `MAX_REPORTED_GAPS` gaps have been recorded.
+class ScanGapDetector
+{
+public:
+  /// @brief The maximum number of gaps whose positions are stored per scan
+  static constexpr size_t MAX_REPORTED_GAPS = 32;
+
+  /// @brief Constructor
+  /// @param max_azimuth The number of azimuth units in one rotation (360 * degree subdivisions)
+  explicit ScanGapDetector(uint32_t max_azimuth) : max_azimuth_(max_azimuth)
+  {
+    decode_scan_.gaps.reserve(MAX_REPORTED_GAPS);
+    completed_scan_.gaps.reserve(MAX_REPORTED_GAPS);
+  }
+
+  /// @brief The expected azimuth step between consecutive return groups
+  /// @param rpm The rotation speed in revolutions per minute
+  /// @param firing_cycle_ns The time between consecutive return groups in nanoseconds
+  /// @param degree_subdivisions The number of azimuth units per degree
+  /// @return The expected step in azimuth units
+  static double expectedAzimuthStep(double rpm, double firing_cycle_ns, double degree_subdivisions)
+  {
+    return rpm / 60. * 360. * degree_subdivisions * firing_cycle_ns * 1e-9;
+  }
+
+  /// @brief Count a packet towards the scan in progress
+  void addPacket() { decode_scan_.n_received_packets++; }
+
+  /// @brief Check the step from the previous return group to this one and record a gap if return
+  /// groups are missing in between. Has to be called before completing a scan at this group
+  /// @param azimuth The azimuth of the return group in azimuth units
+  /// @param expected_step The expected step since the previous group, see `expectedAzimuthStep`.
+  /// Gaps are not checked for if it is not positive (e.g. the sensor reports no rotation speed)
+  /// @param groups_per_packet The number of return groups per packet in the current return mode
+  void addReturnGroup(uint32_t azimuth, double expected_step, uint32_t groups_per_packet)
+  {
+    n_received_groups_++;
+
+    const bool had_last_azimuth = has_last_azimuth_;
+    const uint32_t last_azimuth = last_azimuth_;
+    has_last_azimuth_ = true;
+    last_azimuth_ = azimuth;
+
+    if (!had_last_azimuth || expected_step <= 0) {
+      return;
+    }
+
+    const uint32_t step = (max_azimuth_ + azimuth - last_azimuth) % max_azimuth_;
+    if (step <= 1.5 * expected_step || step > max_azimuth_ / 2) {
+      return;
+    }
+
+    const auto n_missing_groups = static_cast<uint32_t>(std::lround(step / expected_step)) - 1;
+    const uint32_t n_missing_packets = std::max<uint32_t>(
+      (n_missing_groups + groups_per_packet / 2) / std::max<uint32_t>(groups_per_packet, 1), 1);
+
+    n_missing_groups_ += n_missing_groups;
+    decode_scan_.n_missing_packets += n_missing_packets;
+    decode_scan_.n_gaps++;
+    if (decode_scan_.gaps.size() < MAX_REPORTED_GAPS) {
+      decode_scan_.gaps.push_back(
+        {toDegrees(last_azimuth), toDegrees(azimuth), n_missing_packets});
+    }
+  }
+
+  /// @brief Finish the scan in progress and start a new one. The return group that completed the
+  /// scan belongs to the new scan, its packet is counted towards both scans
+  void completeScan()
+  {
+    // The completing group has already been counted towards the finished scan
+    const uint64_t n_expected_groups = n_received_groups_ - 1 + n_missing_groups_;
+    decode_scan_.completeness =
+      n_expected_groups > 0 ? static_cast<double>(n_received_groups_ - 1) / n_expected_groups : 1.;
+
+    std::swap(completed_scan_, decode_scan_);
+    decode_scan_.n_received_packets = 1;
+    decode_scan_.n_missing_packets = 0;
+    decode_scan_.n_gaps = 0;
+    decode_scan_.gaps.clear();
+    decode_scan_.completeness = 1.;
+    n_received_groups_ = 1;
+    n_missing_groups_ = 0;
+  }
+
+  /// @brief The statistics of the last completed scan. Only modified by `completeScan`
+  const ScanCompleteness & completedScan() const { return completed_scan_; }
+
+private:
+  float toDegrees(uint32_t azimuth) const
+  {
+    return static_cast<float>(azimuth) * 360.f / static_cast<float>(max_azimuth_);
+  }
+
+  uint32_t max_azimuth_;
+  bool has_last_azimuth_{false};
+  uint32_t last_azimuth_{0};
+  /// @brief Return groups received in the scan in progress
+  uint64_t n_received_groups_{0};
+  /// @brief Return groups estimated to be missing from the scan in progress
+  uint64_t n_missing_groups_{0};
+
+  ScanCompleteness decode_scan_;
+  ScanCompleteness completed_scan_;
+};
+
+}  // namespace drivers
+}  // namespace nebula
@@ -0,0 +1,125 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief A fixed set of threads that execute the same job in parallel, each with its own worker
+/// index. The thread calling `run` participates as worker 0, so a pool of N workers only spawns
+/// N - 1 threads. Threads are started once and reused, so running a job does not allocate.
+class WorkerPool
+{
+private:
+  typedef void (*JobFn)(void * job, size_t worker_id);
+
+  std::vector<std::thread> threads_;
+
+  std::mutex mutex_;
+  std::condition_variable job_available_;
+  std::condition_variable job_finished_;
+
+  JobFn job_fn_{nullptr};
+  void * job_{nullptr};
+  /// @brief Incremented for every job so that each thread runs each job exactly once
+  uint64_t generation_{0};
+  /// @brief The number of spawned threads that have not yet finished the current job
+  size_t n_pending_{0};
+  bool stopping_{false};
+
+  template <typename JobT>
+  static void invoke(void * job, size_t worker_id)
+  {
+    (*static_cast<JobT *>(job))(worker_id);
+  }
+
+  void workerLoop(size_t worker_id)
+  {
+    uint64_t last_generation = 0;
+
+    while (true) {
+      JobFn job_fn;
+      void * job;
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        job_available_.wait(lock, [&] { return stopping_ || generation_ != last_generation; });
+        if (stopping_) {
+          return;
+        }
+
+        last_generation = generation_;
+        job_fn = job_fn_;
+        job = job_;
+      }
+
+      job_fn(job, worker_id);
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        n_pending_--;
+      }
+      job_finished_.notify_one();
+    }
+  }
+
+public:
+  /// @brief Constructor
+  /// @param n_workers The number of workers including the calling thread. Values below 1 are
+  /// treated as 1, i.e. jobs are run on the calling thread only.
+  explicit WorkerPool(size_t n_workers)
+  {
+    for (size_t worker_id = 1; worker_id < n_workers; ++worker_id) {
+      threads_.emplace_back(&WorkerPool::workerLoop, this, worker_id);
+    }
+  }
+
+  WorkerPool(const WorkerPool &) = delete;
+  WorkerPool & operator=(const WorkerPool &) = delete;
+
+  ~WorkerPool()
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+    }
+    job_available_.notify_all();
+
+    for (auto & thread : threads_) {
+      thread.join();
+    }
+  }
+
+  /// @brief The number of workers, including the calling thread
+  size_t size() const { return threads_.size() + 1; }
+
+  /// @brief Call `job(worker_id)` once for every worker ID in [0, size()) in parallel and wait for
+  /// all of them to return. Must not be called concurrently or from within a job.
+  /// @param job A callable taking the worker ID. It has to outlive the call and must not throw.
+  template <typename JobT>
+  void run(JobT & job)
+  {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      job_fn_ = &WorkerPool::invoke<JobT>;
+      job_ = &job;
+      n_pending_ = threads_.size();
+      generation_++;
+    }
+    job_available_.notify_all();
+
+    job(0);
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    job_finished_.wait(lock, [&] { return n_pending_ == 0; });
+  }
+};
+
+}  // namespace drivers
+}  // namespace nebula
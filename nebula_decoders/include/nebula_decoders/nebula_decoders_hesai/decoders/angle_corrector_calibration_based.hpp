@@ -11,7 +11,7 @@ namespace drivers
 {
 
 template <size_t ChannelN, size_t AngleUnit>
-class AngleCorrectorCalibrationBased : public AngleCorrector
+class AngleCorrectorCalibrationBased final : public AngleCorrector
 {
 private:
   static constexpr size_t MAX_AZIMUTH_LEN = 360 * AngleUnit;
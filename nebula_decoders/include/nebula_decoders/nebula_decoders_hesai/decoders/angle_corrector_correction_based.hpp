@@ -13,7 +13,7 @@ namespace drivers
 {
 
 template <size_t ChannelN, size_t AngleUnit>
-class AngleCorrectorCorrectionBased : public AngleCorrector
+class AngleCorrectorCorrectionBased final : public AngleCorrector
 {
 private:
   static constexpr size_t MAX_AZIMUTH_LENGTH = 360 * AngleUnit;
@@ -0,0 +1,308 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NEBULA_HESAI_KERNEL_X86
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#define NEBULA_HESAI_KERNEL_NEON
+#include <arm_neon.h>
+#endif
+
+namespace nebula
+{
+namespace drivers
+{
+namespace block_conversion
+{
+
+/// @brief The instruction set used to convert blocks
+enum class Isa { SCALAR, SSE2, AVX2, NEON };
+
+/// @brief Per-channel angle data of one return group, stored as structure of arrays so that a whole
+/// block can be converted at once
+/// @tparam ChannelN The number of channels per block
+template <size_t ChannelN>
+struct BlockAngles
+{
+  std::array<float, ChannelN> azimuth_rad;
+  std::array<float, ChannelN> elevation_rad;
+  std::array<float, ChannelN> sin_azimuth;
+  std::array<float, ChannelN> cos_azimuth;
+  std::array<float, ChannelN> sin_elevation;
+  std::array<float, ChannelN> cos_elevation;
+};
+
+/// @brief Input and output buffers for the conversion of one block
+/// @tparam ChannelN The number of channels per block
+template <size_t ChannelN>
+struct ConvertedBlock
+{
+  /// @brief Raw distance values of the block's units, in the packet's distance unit
+  std::array<uint16_t, ChannelN> raw_distance;
+
+  /// @brief Distance in meters. Computed for all units, including those masked out
+  std::array<float, ChannelN> distance;
+  std::array<float, ChannelN> x;
+  std::array<float, ChannelN> y;
+  std::array<float, ChannelN> z;
+  /// @brief 1 if the unit has a non-zero distance within the range limits, 0 otherwise
+  std::array<uint8_t, ChannelN> valid;
+};
+
+/// @brief Pointers to the structure of arrays a kernel reads from and writes to
+struct KernelArgs
+{
+  const uint16_t * raw_distance;
+  const float * sin_azimuth;
+  const float * cos_azimuth;
+  const float * sin_elevation;
+  const float * cos_elevation;
+
+  float * distance;
+  float * x;
+  float * y;
+  float * z;
+  uint8_t * valid;
+
+  /// @brief Distance unit in meters, as returned by `hesai_packet::get_dis_unit`
+  double dis_unit;
+  /// @brief Smallest valid distance, see `range_lower_bound`
+  float min_range;
+  /// @brief Largest valid distance, see `range_upper_bound`
+  float max_range;
+};
+
+typedef void (*KernelFn)(const KernelArgs & args, size_t begin, size_t end);
+
+/// @brief Returns the smallest float f such that for all floats d: `d < value` <=> `d < f`.
+/// This allows range checks against double-precision limits to be done in single precision
+/// without changing their result.
+inline float range_lower_bound(double value)
+{
+  float f = static_cast<float>(value);
+  if (static_cast<double>(f) < value) {
+    f = std::nextafter(f, INFINITY);
+  }
+  return f;
+}
+
+/// @brief Returns the largest float f such that for all floats d: `value < d` <=> `f < d`
+inline float range_upper_bound(double value)
+{
+  float f = static_cast<float>(value);
+  if (static_cast<double>(f) > value) {
+    f = std::nextafter(f, -INFINITY);
+  }
+  return f;
+}
+
+/// @brief Reference implementation, also used for the channels that do not fill a whole vector.
+/// All kernels have to produce bit-identical results to this one: distances are scaled in double
+/// precision and rounded to float (like `HesaiDecoder::getDistance`), all other products are
+/// computed in single precision in the same order.
+inline void convert_block_scalar(const KernelArgs & args, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; ++i) {
+    float distance = static_cast<float>(args.raw_distance[i] * args.dis_unit);
+    float xy_distance = distance * args.cos_elevation[i];
+
+    args.distance[i] = distance;
+    args.x[i] = xy_distance * args.sin_azimuth[i];
+    args.y[i] = xy_distance * args.cos_azimuth[i];
+    args.z[i] = distance * args.sin_elevation[i];
+    args.valid[i] = args.raw_distance[i] != 0 && args.min_range <= distance &&
+                    distance <= args.max_range;
+  }
+}
+
+#ifdef NEBULA_HESAI_KERNEL_X86
+
+__attribute__((target("sse2"))) inline void convert_block_sse2(
+  const KernelArgs & args, size_t begin, size_t end)
+{
+  const __m128d dis_unit = _mm_set1_pd(args.dis_unit);
+  const __m128 min_range = _mm_set1_ps(args.min_range);
+  const __m128 max_range = _mm_set1_ps(args.max_range);
+  const __m128i zero = _mm_setzero_si128();
+
+  size_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    __m128i raw16 =
+      _mm_loadl_epi64(reinterpret_cast<const __m128i *>(args.raw_distance + i));
+    __m128i raw32 = _mm_unpacklo_epi16(raw16, zero);
+
+    __m128d lo = _mm_mul_pd(_mm_cvtepi32_pd(raw32), dis_unit);
+    __m128d hi = _mm_mul_pd(_mm_cvtepi32_pd(_mm_shuffle_epi32(raw32, 0x4e)), dis_unit);
+    __m128 distance = _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+
+    __m128 xy_distance = _mm_mul_ps(distance, _mm_loadu_ps(args.cos_elevation + i));
+    _mm_storeu_ps(args.distance + i, distance);
+    _mm_storeu_ps(args.x + i, _mm_mul_ps(xy_distance, _mm_loadu_ps(args.sin_azimuth + i)));
+    _mm_storeu_ps(args.y + i, _mm_mul_ps(xy_distance, _mm_loadu_ps(args.cos_azimuth + i)));
+    _mm_storeu_ps(args.z + i, _mm_mul_ps(distance, _mm_loadu_ps(args.sin_elevation + i)));
+
+    __m128 non_zero = _mm_castsi128_ps(_mm_xor_si128(
+      _mm_cmpeq_epi32(raw32, zero), _mm_set1_epi32(-1)));
+    __m128 in_range =
+      _mm_and_ps(_mm_cmple_ps(min_range, distance), _mm_cmple_ps(distance, max_range));
+    int mask = _mm_movemask_ps(_mm_and_ps(non_zero, in_range));
+
+    for (size_t lane = 0; lane < 4; ++lane) {
+      args.valid[i + lane] = (mask >> lane) & 1;
+    }
+  }
+
+  convert_block_scalar(args, i, end);
+}
+
+__attribute__((target("avx2"))) inline void convert_block_avx2(
+  const KernelArgs & args, size_t begin, size_t end)
+{
+  const __m256d dis_unit = _mm256_set1_pd(args.dis_unit);
+  const __m256 min_range = _mm256_set1_ps(args.min_range);
+  const __m256 max_range = _mm256_set1_ps(args.max_range);
+
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    __m128i raw16 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(args.raw_distance + i));
+    __m256i raw32 = _mm256_cvtepu16_epi32(raw16);
+
+    __m256d lo = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_castsi256_si128(raw32)), dis_unit);
+    __m256d hi = _mm256_mul_pd(_mm256_cvtepi32_pd(_mm256_extracti128_si256(raw32, 1)), dis_unit);
+    __m256 distance =
+      _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(lo)), _mm256_cvtpd_ps(hi), 1);
+
+    __m256 xy_distance = _mm256_mul_ps(distance, _mm256_loadu_ps(args.cos_elevation + i));
+    _mm256_storeu_ps(args.distance + i, distance);
+    _mm256_storeu_ps(
+      args.x + i, _mm256_mul_ps(xy_distance, _mm256_loadu_ps(args.sin_azimuth + i)));
+    _mm256_storeu_ps(
+      args.y + i, _mm256_mul_ps(xy_distance, _mm256_loadu_ps(args.cos_azimuth + i)));
+    _mm256_storeu_ps(
+      args.z + i, _mm256_mul_ps(distance, _mm256_loadu_ps(args.sin_elevation + i)));
+
+    __m256 is_zero =
+      _mm256_castsi256_ps(_mm256_cmpeq_epi32(raw32, _mm256_setzero_si256()));
+    __m256 in_range = _mm256_and_ps(
+      _mm256_cmp_ps(min_range, distance, _CMP_LE_OQ),
+      _mm256_cmp_ps(distance, max_range, _CMP_LE_OQ));
+    int mask = _mm256_movemask_ps(_mm256_andnot_ps(is_zero, in_range));
+
+    for (size_t lane = 0; lane < 8; ++lane) {
+      args.valid[i + lane] = (mask >> lane) & 1;
+    }
+  }
+
+  convert_block_scalar(args, i, end);
+}
+
+#endif
+
+#ifdef NEBULA_HESAI_KERNEL_NEON
+
+inline void convert_block_neon(const KernelArgs & args, size_t begin, size_t end)
+{
+  const float64x2_t dis_unit = vdupq_n_f64(args.dis_unit);
+  const float32x4_t min_range = vdupq_n_f32(args.min_range);
+  const float32x4_t max_range = vdupq_n_f32(args.max_range);
+
+  size_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    uint32x4_t raw32 = vmovl_u16(vld1_u16(args.raw_distance + i));
+
+    float64x2_t lo = vmulq_f64(vcvtq_f64_u64(vmovl_u32(vget_low_u32(raw32))), dis_unit);
+    float64x2_t hi = vmulq_f64(vcvtq_f64_u64(vmovl_u32(vget_high_u32(raw32))), dis_unit);
+    float32x4_t distance = vcombine_f32(vcvt_f32_f64(lo), vcvt_f32_f64(hi));
+
+    float32x4_t xy_distance = vmulq_f32(distance, vld1q_f32(args.cos_elevation + i));
+    vst1q_f32(args.distance + i, distance);
+    vst1q_f32(args.x + i, vmulq_f32(xy_distance, vld1q_f32(args.sin_azimuth + i)));
+    vst1q_f32(args.y + i, vmulq_f32(xy_distance, vld1q_f32(args.cos_azimuth + i)));
+    vst1q_f32(args.z + i, vmulq_f32(distance, vld1q_f32(args.sin_elevation + i)));
+
+    uint32x4_t valid = vandq_u32(
+      vtstq_u32(raw32, raw32),
+      vandq_u32(vcleq_f32(min_range, distance), vcleq_f32(distance, max_range)));
+    uint16x4_t valid16 = vmovn_u32(valid);
+    uint8x8_t valid8 = vand_u8(vmovn_u16(vcombine_u16(valid16, valid16)), vdup_n_u8(1));
+    vst1_lane_u32(
+      reinterpret_cast<uint32_t *>(args.valid + i), vreinterpret_u32_u8(valid8), 0);
+  }
+
+  convert_block_scalar(args, i, end);
+}
+
+#endif
+
+/// @brief Whether the given instruction set can be used on the current CPU
+inline bool is_supported(Isa isa)
+{
+  switch (isa) {
+    case Isa::SCALAR:
+      return true;
+#ifdef NEBULA_HESAI_KERNEL_X86
+    case Isa::SSE2:
+      return __builtin_cpu_supports("sse2");
+    case Isa::AVX2:
+      return __builtin_cpu_supports("avx2");
+#endif
+#ifdef NEBULA_HESAI_KERNEL_NEON
+    case Isa::NEON:
+      return true;
+#endif
+    default:
+      return false;
+  }
+}
+
+/// @brief Get the kernel for the given instruction set
+/// @return The kernel, or the scalar kernel if the instruction set is not supported
+inline KernelFn get_kernel(Isa isa)
+{
+  if (!is_supported(isa)) {
+    return &convert_block_scalar;
+  }
+
+  switch (isa) {
+#ifdef NEBULA_HESAI_KERNEL_X86
+    case Isa::SSE2:
+      return &convert_block_sse2;
+    case Isa::AVX2:
+      return &convert_block_avx2;
+#endif
+#ifdef NEBULA_HESAI_KERNEL_NEON
+    case Isa::NEON:
+      return &convert_block_neon;
+#endif
+    default:
+      return &convert_block_scalar;
+  }
+}
+
+/// @brief Get the best instruction set supported by the current CPU
+inline Isa detect_isa()
+{
+  for (Isa isa : {Isa::AVX2, Isa::SSE2, Isa::NEON}) {
+    if (is_supported(isa)) {
+      return isa;
+    }
+  }
+
+  return Isa::SCALAR;
+}
+
+/// @brief Get the fastest kernel for the current CPU. The CPU is only queried on the first call.
+inline KernelFn get_best_kernel()
+{
+  static const KernelFn kernel = get_kernel(detect_isa());
+  return kernel;
+}
+
+}  // namespace block_conversion
+}  // namespace drivers
+}  // namespace nebula
@@ -1,13 +1,24 @@
 #pragma once
 
+#include "nebula_decoders/nebula_decoders_common/packet_view.hpp"
+#include "nebula_decoders/nebula_decoders_common/point_cloud_pool.hpp"
+#include "nebula_decoders/nebula_decoders_common/scan_gap_detector.hpp"
+#include "nebula_decoders/nebula_decoders_common/worker_pool.hpp"
+#include "nebula_decoders/nebula_decoders_hesai/decoders/block_conversion_kernel.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/decoders/hesai_scan_decoder.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
+#include "nebula_msgs/msg/nebula_packet.hpp"
+#include "nebula_msgs/msg/nebula_packets.hpp"
 #include "pandar_msgs/msg/pandar_packet.hpp"
 #include "pandar_msgs/msg/pandar_scan.hpp"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 namespace nebula
 {
 namespace drivers
@@ -17,6 +28,40 @@ template <typename SensorT>
 class HesaiDecoder : public HesaiScanDecoder
 {
 protected:
+  /// @brief Scratch buffers for converting one return group. Every thread converting return groups
+  /// needs its own instance
+  struct ConversionBuffers
+  {
+    /// @brief Corrected angles of the return group currently being converted
+    block_conversion::BlockAngles<SensorT::packet_t::N_CHANNELS> block_angles;
+    /// @brief Distances and coordinates of each block of the return group currently being
+    /// converted
+    std::array<
+      block_conversion::ConvertedBlock<SensorT::packet_t::N_CHANNELS>,
+      SensorT::packet_t::MAX_RETURNS>
+      converted_blocks;
+  };
+
+  /// @brief A return group of a scan message, to be converted by `unpackScan`
+  struct ReturnGroupTask
+  {
+    const typename SensorT::packet_t * packet;
+    uint32_t start_block_id;
+    uint32_t n_blocks;
+    /// @brief The timestamp of the scan the return group belongs to
+    uint64_t scan_timestamp_ns;
+  };
+
+  /// @brief The state of one worker of `unpackScan`
+  struct WorkerState
+  {
+    ConversionBuffers buffers;
+    /// @brief Points of the worker's return groups that belong to the last completed scan
+    NebulaPointCloud completed_scan_points;
+    /// @brief Points of the worker's return groups that belong to the scan in progress
+    NebulaPointCloud decode_scan_points;
+  };
+
   /// @brief Configuration for this decoder
   const std::shared_ptr<drivers::HesaiSensorConfiguration> sensor_configuration_;
 
@@ -26,13 +71,17 @@ protected:
   /// @brief Decodes azimuth/elevation angles given calibration/correction data
   typename SensorT::angle_corrector_t angle_corrector_;
 
+  /// @brief The point clouds that decode_pc_ is taken from. A cloud is only reused once all
+  /// references handed out by `getPointcloud()` have been dropped
+  PointCloudPool point_cloud_pool_{POINT_CLOUD_POOL_SIZE, SensorT::MAX_SCAN_BUFFER_POINTS};
   /// @brief The point cloud new points get added to
   NebulaPointCloudPtr decode_pc_;
-  /// @brief The point cloud that is returned when a scan is complete
+  /// @brief The point cloud that is returned when a scan is complete. Never modified once set
   NebulaPointCloudPtr output_pc_;
 
-  /// @brief The last decoded packet
-  typename SensorT::packet_t packet_;
+  /// @brief View of the packet currently being decoded. Points into the incoming message and is
+  /// only valid during `unpack`
+  PacketView<typename SensorT::packet_t> packet_;
   /// @brief The last azimuth processed
   int last_phase_;
   /// @brief The timestamp of the last completed scan in nanoseconds
@@ -41,9 +90,27 @@ protected:
   uint64_t decode_scan_timestamp_ns_;
   /// @brief Whether a full scan has been processed
   bool has_scanned_;
+  /// @brief Detects packets lost between consecutive return groups
+  ScanGapDetector gap_detector_{360 * SensorT::packet_t::DEGREE_SUBDIVISIONS};
 
   rclcpp::Logger logger_;
 
+  /// @brief The block conversion kernel for the instruction set of the current CPU
+  block_conversion::KernelFn convert_block_;
+  /// @brief Smallest valid distance in meters, combining sensor and configuration limits
+  float min_range_;
+  /// @brief Largest valid distance in meters, combining sensor and configuration limits
+  float max_range_;
+  /// @brief Conversion buffers used by `unpack`
+  ConversionBuffers buffers_;
+
+  /// @brief Threads converting the return groups of a scan message in `unpackScan`
+  std::unique_ptr<WorkerPool> worker_pool_;
+  /// @brief One state per worker of worker_pool_
+  std::vector<std::unique_ptr<WorkerState>> worker_states_;
+  /// @brief The return groups of the scan message currently processed by `unpackScan`
+  std::vector<ReturnGroupTask> return_group_tasks_;
+
   /// @brief For each channel, its firing offset relative to the block in nanoseconds
   std::array<int, SensorT::packet_t::N_CHANNELS> channel_firing_offset_ns_;
   /// @brief For each return mode, the firing offset of each block relative to its packet in
@@ -51,38 +118,119 @@ protected:
   std::array<std::array<int, SensorT::packet_t::N_BLOCKS>, SensorT::packet_t::MAX_RETURNS>
     block_firing_offset_ns_;
 
-  /// @brief Validates and parse PandarPacket. Currently only checks size, not checksums etc.
-  /// @param pandar_packet The incoming PandarPacket
+  /// @brief Validates and parse a packet. Currently only checks size and alignment, not
+  /// checksums etc. The packet is not copied, but decoded in place from the message's data buffer
+  /// @param data The packet's data
+  /// @param size The number of valid bytes in data
   /// @return Whether the packet was parsed successfully
-  bool parsePacket(const pandar_msgs::msg::PandarPacket & pandar_packet)
+  bool parsePacket(const uint8_t * data, size_t size)
   {
-    if (pandar_packet.size < sizeof(typename SensorT::packet_t)) {
+    if (size < sizeof(typename SensorT::packet_t)) {
       RCLCPP_ERROR_STREAM(
-        logger_, "Packet size mismatch:" << pandar_packet.size << " | Expected at least:"
+        logger_, "Packet size mismatch:" << size << " | Expected at least:"
                                          << sizeof(typename SensorT::packet_t));
       return false;
     }
-    if (std::memcpy(&packet_, pandar_packet.data.data(), sizeof(typename SensorT::packet_t))) {
-      // FIXME(mojomex) do validation?
-      // RCLCPP_DEBUG(logger_, "Packet parsed successfully");
-      return true;
+
+    if (!packet_.reset(data, size)) {
+      RCLCPP_ERROR(logger_, "Packet buffer is misaligned");
+      return false;
     }
 
-    RCLCPP_ERROR(logger_, "Packet memcopy failed");
-    return false;
+    return true;
+  }
+
+  /// @brief Parse a PandarPacket, whose data array is padded to 1500 bytes
+  bool parsePacket(const pandar_msgs::msg::PandarPacket & pandar_packet)
+  {
+    return parsePacket(
+      pandar_packet.data.data(), std::min<size_t>(pandar_packet.size, pandar_packet.data.size()));
+  }
+
+  /// @brief Parse a NebulaPacket, whose data is exactly as long as the packet
+  bool parsePacket(const nebula_msgs::msg::NebulaPacket & nebula_packet)
+  {
+    return parsePacket(nebula_packet.data.data(), nebula_packet.data.size());
+  }
+
+  /// @brief Computes distance, validity and coordinates of all units in the given block at once
+  /// @param packet The packet containing the block
+  /// @param block_id The block to convert
+  /// @param block_angles The corrected angles of the block's units
+  /// @param converted The buffers to write the results to
+  void convertBlock(
+    const typename SensorT::packet_t & packet, size_t block_id,
+    const block_conversion::BlockAngles<SensorT::packet_t::N_CHANNELS> & block_angles,
+    block_conversion::ConvertedBlock<SensorT::packet_t::N_CHANNELS> & converted) const
+  {
+    const auto & block = packet.body.blocks[block_id];
+    for (size_t channel_id = 0; channel_id < SensorT::packet_t::N_CHANNELS; ++channel_id) {
+      converted.raw_distance[channel_id] = block.units[channel_id].distance;
+    }
+
+    block_conversion::KernelArgs args{
+      converted.raw_distance.data(),
+      block_angles.sin_azimuth.data(),
+      block_angles.cos_azimuth.data(),
+      block_angles.sin_elevation.data(),
+      block_angles.cos_elevation.data(),
+      converted.distance.data(),
+      converted.x.data(),
+      converted.y.data(),
+      converted.z.data(),
+      converted.valid.data(),
+      hesai_packet::get_dis_unit(packet),
+      min_range_,
+      max_range_};
+
+    convert_block_(args, 0, SensorT::packet_t::N_CHANNELS);
   }
 
   /// @brief Converts a group of returns (i.e. 1 for single return, 2 for dual return, etc.) to
-  /// points and appends them to the point cloud
+  /// points and appends them to the point cloud. Does not modify the decoder, so that return
+  /// groups can be converted in parallel given separate buffers and point clouds.
+  /// @param packet The packet containing the return group
   /// @param start_block_id The first block in the group of returns
   /// @param n_blocks The number of returns in the group (has to align with the `n_returns` field in
   /// the packet footer)
-  void convertReturns(size_t start_block_id, size_t n_blocks)
+  /// @param scan_timestamp_ns The timestamp of the scan the return group belongs to
+  /// @param buffers The scratch buffers to use for the conversion
+  /// @param pointcloud The point cloud to append the points to. Its capacity should be reserved for
+  /// the whole scan, as every call temporarily grows it by one point per unit of the return group
+  void convertReturns(
+    const typename SensorT::packet_t & packet, size_t start_block_id, size_t n_blocks,
+    uint64_t scan_timestamp_ns, ConversionBuffers & buffers, NebulaPointCloud & pointcloud)
   {
-    uint64_t packet_timestamp_ns = hesai_packet::get_timestamp_ns(packet_);
-    uint32_t raw_azimuth = packet_.body.blocks[start_block_id].get_azimuth();
+    uint64_t packet_timestamp_ns = hesai_packet::get_timestamp_ns(packet);
+    uint32_t raw_azimuth = packet.body.blocks[start_block_id].get_azimuth();
+    auto & block_angles = buffers.block_angles;
+    auto & converted_blocks = buffers.converted_blocks;
+
+    // All returns of the group share the same azimuth, so angles only have to be corrected once
+    for (size_t channel_id = 0; channel_id < SensorT::packet_t::N_CHANNELS; ++channel_id) {
+      auto corrected_angle_data = angle_corrector_.getCorrectedAngleData(raw_azimuth, channel_id);
+      block_angles.azimuth_rad[channel_id] = corrected_angle_data.azimuth_rad;
+      block_angles.elevation_rad[channel_id] = corrected_angle_data.elevation_rad;
+      block_angles.sin_azimuth[channel_id] = corrected_angle_data.sin_azimuth;
+      block_angles.cos_azimuth[channel_id] = corrected_angle_data.cos_azimuth;
+      block_angles.sin_elevation[channel_id] = corrected_angle_data.sin_elevation;
+      block_angles.cos_elevation[channel_id] = corrected_angle_data.cos_elevation;
+    }
+
+    for (size_t block_offset = 0; block_offset < n_blocks; ++block_offset) {
+      convertBlock(
+        packet, block_offset + start_block_id, block_angles, converted_blocks[block_offset]);
+    }
+
+    typename SensorT::return_group_t return_units;
 
-    std::vector<const typename SensorT::packet_t::body_t::block_t::unit_t *> return_units;
+    // The points are written to a range of the point cloud that can hold all units of the return
+    // group, which is shrunk to the points actually written at the end. This keeps the points in
+    // channel order without growing the cloud point by point
+    const size_t first_point = pointcloud.size();
+    pointcloud.resize(first_point + SensorT::packet_t::N_CHANNELS * n_blocks);
+    NebulaPoint * points = &pointcloud.points[first_point];
+    size_t n_points = 0;
 
     for (size_t channel_id = 0; channel_id < SensorT::packet_t::N_CHANNELS; ++channel_id) {
       // Find the units corresponding to the same return group as the current one.
@@ -90,27 +238,20 @@ protected:
       return_units.clear();
       for (size_t block_offset = 0; block_offset < n_blocks; ++block_offset) {
         return_units.push_back(
-          &packet_.body.blocks[block_offset + start_block_id].units[channel_id]);
+          &packet.body.blocks[block_offset + start_block_id].units[channel_id]);
       }
 
       for (size_t block_offset = 0; block_offset < n_blocks; ++block_offset) {
-        auto & unit = *return_units[block_offset];
+        const auto & converted = converted_blocks[block_offset];
 
-        if (unit.distance == 0) {
+        if (!converted.valid[channel_id]) {
           continue;
         }
 
-        auto distance = getDistance(unit);
-
-        if (
-          distance < SensorT::MIN_RANGE || SensorT::MAX_RANGE < distance ||
-          distance < sensor_configuration_->min_range ||
-          sensor_configuration_->max_range < distance) {
-          continue;
-        }
+        auto distance = converted.distance[channel_id];
 
         auto return_type = sensor_.getReturnType(
-          static_cast<hesai_packet::return_mode::ReturnMode>(packet_.tail.return_mode),
+          static_cast<hesai_packet::return_mode::ReturnMode>(packet.tail.return_mode),
           block_offset, return_units);
 
         // Keep only last of multiple identical points
@@ -128,7 +269,7 @@ protected:
             }
 
             if (
-              fabsf(getDistance(*return_units[return_idx]) - distance) <
+              fabsf(converted_blocks[return_idx].distance[channel_id] - distance) <
               sensor_configuration_->dual_return_distance_threshold) {
               is_below_multi_return_threshold = true;
               break;
@@ -140,31 +281,29 @@ protected:
           }
         }
 
-        NebulaPoint point;
+        NebulaPoint & point = points[n_points++];
         point.distance = distance;
-        point.intensity = unit.reflectivity;
-        point.time_stamp =
-          getPointTimeRelative(packet_timestamp_ns, block_offset + start_block_id, channel_id);
+        point.intensity = return_units[block_offset]->reflectivity;
+        point.time_stamp = getPointTimeRelative(
+          packet, packet_timestamp_ns, scan_timestamp_ns, block_offset + start_block_id,
+          channel_id);
 
         point.return_type = static_cast<uint8_t>(return_type);
         point.channel = channel_id;
 
-        auto corrected_angle_data = angle_corrector_.getCorrectedAngleData(raw_azimuth, channel_id);
-
         // The raw_azimuth and channel are only used as indices, sin/cos functions use the precise
         // corrected angles
-        float xyDistance = distance * corrected_angle_data.cos_elevation;
-        point.x = xyDistance * corrected_angle_data.sin_azimuth;
-        point.y = xyDistance * corrected_angle_data.cos_azimuth;
-        point.z = distance * corrected_angle_data.sin_elevation;
+        point.x = converted.x[channel_id];
+        point.y = converted.y[channel_id];
+        point.z = converted.z[channel_id];
 
         // The driver wrapper converts to degrees, expects radians
-        point.azimuth = corrected_angle_data.azimuth_rad;
-        point.elevation = corrected_angle_data.elevation_rad;
-
-        decode_pc_->emplace_back(point);
+        point.azimuth = block_angles.azimuth_rad[channel_id];
+        point.elevation = block_angles.elevation_rad[channel_id];
       }
     }
+
+    pointcloud.resize(first_point + n_points);
   }
 
   /// @brief Checks whether the last processed block was the last block of a scan
@@ -177,23 +316,36 @@ protected:
     return angle_corrector_.hasScanned(current_phase, last_phase_, sync_phase);
   }
 
+  /// @brief The azimuth step between consecutive return groups of the given packet, for the motor
+  /// speed reported in it and the sensor's firing cycle
+  /// @param packet The packet
+  /// @return The expected step in azimuth units, 0 if the motor is not spinning
+  static double getExpectedAzimuthStep(const typename SensorT::packet_t & packet)
+  {
+    return ScanGapDetector::expectedAzimuthStep(
+      packet.tail.motor_speed, SensorT::FIRING_CYCLE_NS, SensorT::packet_t::DEGREE_SUBDIVISIONS);
+  }
+
   /// @brief Get the distance of the given unit in meters
   float getDistance(const typename SensorT::packet_t::body_t::block_t::unit_t & unit)
   {
-    return unit.distance * hesai_packet::get_dis_unit(packet_);
+    return unit.distance * hesai_packet::get_dis_unit(*packet_);
   }
 
   /// @brief Get timestamp of point in nanoseconds, relative to scan timestamp. Includes firing time
   /// offset correction for channel and block
-  /// @param packet_timestamp_ns The timestamp of the current PandarPacket in nanoseconds
+  /// @param packet The packet containing the point
+  /// @param packet_timestamp_ns The timestamp of the packet in nanoseconds
+  /// @param scan_timestamp_ns The timestamp of the scan the point belongs to in nanoseconds
   /// @param block_id The block index of the point
   /// @param channel_id The channel index of the point
-  uint32_t getPointTimeRelative(uint64_t packet_timestamp_ns, size_t block_id, size_t channel_id)
+  uint32_t getPointTimeRelative(
+    const typename SensorT::packet_t & packet, uint64_t packet_timestamp_ns,
+    uint64_t scan_timestamp_ns, size_t block_id, size_t channel_id)
   {
     auto point_to_packet_offset_ns =
-      sensor_.getPacketRelativePointTimeOffset(block_id, channel_id, packet_);
-    auto packet_to_scan_offset_ns =
-      static_cast<uint32_t>(packet_timestamp_ns - decode_scan_timestamp_ns_);
+      sensor_.getPacketRelativePointTimeOffset(block_id, channel_id, packet);
+    auto packet_to_scan_offset_ns = static_cast<uint32_t>(packet_timestamp_ns - scan_timestamp_ns);
     return packet_to_scan_offset_ns + point_to_packet_offset_ns;
   }
 
@@ -210,62 +362,198 @@ public:
     const std::shared_ptr<HesaiCorrection> & correction_configuration)
   : sensor_configuration_(sensor_configuration),
     angle_corrector_(calibration_configuration, correction_configuration),
-    logger_(rclcpp::get_logger("HesaiDecoder"))
+    logger_(rclcpp::get_logger("HesaiDecoder")),
+    convert_block_(block_conversion::get_best_kernel()),
+    min_range_(std::max(
+      SensorT::MIN_RANGE, block_conversion::range_lower_bound(sensor_configuration->min_range))),
+    max_range_(std::min(
+      SensorT::MAX_RANGE, block_conversion::range_upper_bound(sensor_configuration->max_range)))
   {
     logger_.set_level(rclcpp::Logger::Level::Debug);
     RCLCPP_INFO_STREAM(logger_, sensor_configuration_);
 
-    decode_pc_.reset(new NebulaPointCloud);
-    output_pc_.reset(new NebulaPointCloud);
+    decode_pc_ = point_cloud_pool_.acquire();
+    output_pc_ = point_cloud_pool_.acquire();
 
-    decode_pc_->reserve(SensorT::MAX_SCAN_BUFFER_POINTS);
-    output_pc_->reserve(SensorT::MAX_SCAN_BUFFER_POINTS);
+    worker_pool_ = std::make_unique<WorkerPool>(sensor_configuration_->decode_threads);
+    for (size_t worker_id = 0; worker_id < worker_pool_->size(); ++worker_id) {
+      worker_states_.emplace_back(std::make_unique<WorkerState>());
+    }
   }
 
-  int unpack(const pandar_msgs::msg::PandarPacket & pandar_packet) override
+protected:
+  /// @brief Decode the packet that has just been parsed into `packet_`, see `unpack`
+  /// @return The last azimuth processed
+  int unpackParsedPacket()
   {
-    if (!parsePacket(pandar_packet)) {
-      return -1;
-    }
-
     if (decode_scan_timestamp_ns_ == 0) {
-      decode_scan_timestamp_ns_ = hesai_packet::get_timestamp_ns(packet_);
+      decode_scan_timestamp_ns_ = hesai_packet::get_timestamp_ns(*packet_);
     }
 
     if (has_scanned_) {
       has_scanned_ = false;
     }
 
-    const size_t n_returns = hesai_packet::get_n_returns(packet_.tail.return_mode);
+    const size_t n_returns = hesai_packet::get_n_returns(packet_->tail.return_mode);
+    const double expected_azimuth_step = getExpectedAzimuthStep(*packet_);
     uint32_t current_azimuth;
+    gap_detector_.addPacket();
 
     for (size_t block_id = 0; block_id < SensorT::packet_t::N_BLOCKS; block_id += n_returns) {
-      current_azimuth = packet_.body.blocks[block_id].get_azimuth();
+      current_azimuth = packet_->body.blocks[block_id].get_azimuth();
+      gap_detector_.addReturnGroup(
+        current_azimuth, expected_azimuth_step, SensorT::packet_t::N_BLOCKS / n_returns);
 
       bool scan_completed = checkScanCompleted(
         current_azimuth,
         sensor_configuration_->scan_phase * SensorT::packet_t::DEGREE_SUBDIVISIONS);
 
       if (scan_completed) {
-        std::swap(decode_pc_, output_pc_);
-        decode_pc_->clear();
+        output_pc_ = std::move(decode_pc_);
+        decode_pc_ = point_cloud_pool_.acquire();
         has_scanned_ = true;
         output_scan_timestamp_ns_ = decode_scan_timestamp_ns_;
+        gap_detector_.completeScan();
 
         // A new scan starts within the current packet, so the new scan's timestamp must be
         // calculated as the packet timestamp plus the lowest time offset of any point in the
         // remainder of the packet
-        decode_scan_timestamp_ns_ = hesai_packet::get_timestamp_ns(packet_) +
-                                    sensor_.getEarliestPointTimeOffsetForBlock(block_id, packet_);
+        decode_scan_timestamp_ns_ = hesai_packet::get_timestamp_ns(*packet_) +
+                                    sensor_.getEarliestPointTimeOffsetForBlock(block_id, *packet_);
       }
 
-      convertReturns(block_id, n_returns);
+      convertReturns(
+        *packet_, block_id, n_returns, decode_scan_timestamp_ns_, buffers_, *decode_pc_);
       last_phase_ = current_azimuth;
     }
 
     return last_phase_;
   }
 
+  /// @brief Implementation of `unpackScan` for both scan message types
+  /// @param scan_msg A PandarScan or NebulaPackets message
+  /// @return The last azimuth processed
+  template <typename ScanMsgT>
+  int unpackScanMsg(const ScanMsgT & scan_msg)
+  {
+    // First pass: find the scan boundaries and timestamps exactly like `unpack` would, and collect
+    // the return groups to convert
+    return_group_tasks_.clear();
+    size_t n_scans_completed = 0;
+    // Return groups before this index belong to scans that are superseded by a later scan in the
+    // same message. They would never be output and are thus not converted
+    size_t first_task_id = 0;
+    // Return groups from this index on belong to the scan in progress
+    size_t decode_scan_task_id = 0;
+
+    for (const auto & packet_msg : scan_msg.packets) {
+      if (!parsePacket(packet_msg)) {
+        continue;
+      }
+
+      const auto & packet = *packet_;
+      if (decode_scan_timestamp_ns_ == 0) {
+        decode_scan_timestamp_ns_ = hesai_packet::get_timestamp_ns(packet);
+      }
+
+      const size_t n_returns = hesai_packet::get_n_returns(packet.tail.return_mode);
+      const double expected_azimuth_step = getExpectedAzimuthStep(packet);
+      gap_detector_.addPacket();
+
+      for (size_t block_id = 0; block_id < SensorT::packet_t::N_BLOCKS; block_id += n_returns) {
+        uint32_t current_azimuth = packet.body.blocks[block_id].get_azimuth();
+        gap_detector_.addReturnGroup(
+          current_azimuth, expected_azimuth_step, SensorT::packet_t::N_BLOCKS / n_returns);
+
+        bool scan_completed = checkScanCompleted(
+          current_azimuth,
+          sensor_configuration_->scan_phase * SensorT::packet_t::DEGREE_SUBDIVISIONS);
+
+        if (scan_completed) {
+          if (n_scans_completed > 0) {
+            first_task_id = decode_scan_task_id;
+          }
+          decode_scan_task_id = return_group_tasks_.size();
+          n_scans_completed++;
+
+          output_scan_timestamp_ns_ = decode_scan_timestamp_ns_;
+          gap_detector_.completeScan();
+          decode_scan_timestamp_ns_ = hesai_packet::get_timestamp_ns(packet) +
+                                      sensor_.getEarliestPointTimeOffsetForBlock(block_id, packet);
+        }
+
+        return_group_tasks_.push_back(
+          {&packet, static_cast<uint32_t>(block_id), static_cast<uint32_t>(n_returns),
+           decode_scan_timestamp_ns_});
+        last_phase_ = current_azimuth;
+      }
+    }
+
+    // Second pass: convert contiguous ranges of return groups in parallel, each worker into its
+    // own point clouds
+    const size_t n_workers = worker_pool_->size();
+    const size_t n_tasks = return_group_tasks_.size() - first_task_id;
+
+    auto convert_tasks = [&](size_t worker_id) {
+      auto & state = *worker_states_[worker_id];
+      state.completed_scan_points.clear();
+      state.decode_scan_points.clear();
+
+      size_t begin = first_task_id + n_tasks * worker_id / n_workers;
+      size_t end = first_task_id + n_tasks * (worker_id + 1) / n_workers;
+      for (size_t task_id = begin; task_id < end; ++task_id) {
+        const auto & task = return_group_tasks_[task_id];
+        auto & pointcloud = task_id < decode_scan_task_id ? state.completed_scan_points
+                                                          : state.decode_scan_points;
+        convertReturns(
+          *task.packet, task.start_block_id, task.n_blocks, task.scan_timestamp_ns, state.buffers,
+          pointcloud);
+      }
+    };
+    worker_pool_->run(convert_tasks);
+
+    // Stitch the workers' points together in packet order. If more than one scan was completed,
+    // only the last one is output, like `unpack` would do
+    if (n_scans_completed > 0) {
+      output_pc_ = std::move(decode_pc_);
+      if (n_scans_completed > 1) {
+        output_pc_->clear();
+      }
+      for (const auto & state : worker_states_) {
+        *output_pc_ += state->completed_scan_points;
+      }
+      decode_pc_ = point_cloud_pool_.acquire();
+    }
+
+    for (const auto & state : worker_states_) {
+      *decode_pc_ += state->decode_scan_points;
+    }
+
+    has_scanned_ = n_scans_completed > 0;
+    return last_phase_;
+  }
+
+public:
+  int unpack(const pandar_msgs::msg::PandarPacket & pandar_packet) override
+  {
+    return parsePacket(pandar_packet) ? unpackParsedPacket() : -1;
+  }
+
+  int unpack(const nebula_msgs::msg::NebulaPacket & nebula_packet) override
+  {
+    return parsePacket(nebula_packet) ? unpackParsedPacket() : -1;
+  }
+
+  int unpackScan(const pandar_msgs::msg::PandarScan & pandar_scan) override
+  {
+    return unpackScanMsg(pandar_scan);
+  }
+
+  int unpackScan(const nebula_msgs::msg::NebulaPackets & nebula_packets) override
+  {
+    return unpackScanMsg(nebula_packets);
+  }
+
   bool hasScanned() override { return has_scanned_; }
 
   std::tuple<drivers::NebulaPointCloudPtr, double> getPointcloud() override
@@ -273,6 +561,8 @@ public:
     double scan_timestamp_s = static_cast<double>(output_scan_timestamp_ns_) * 1e-9;
     return std::make_pair(output_pc_, scan_timestamp_s);
   }
+
+  const ScanCompleteness & getScanCompleteness() override { return gap_detector_.completedScan(); }
 };
 
 }  // namespace drivers
@@ -3,7 +3,10 @@
 
 #include "nebula_common/hesai/hesai_common.hpp"
 #include "nebula_common/point_types.hpp"
+#include "nebula_decoders/nebula_decoders_common/scan_gap_detector.hpp"
 
+#include "nebula_msgs/msg/nebula_packet.hpp"
+#include "nebula_msgs/msg/nebula_packets.hpp"
 #include "pandar_msgs/msg/pandar_packet.hpp"
 #include "pandar_msgs/msg/pandar_scan.hpp"
 
@@ -30,13 +33,36 @@ public:
   /// @return The last azimuth processed
   virtual int unpack(const pandar_msgs::msg::PandarPacket & pandar_packet) = 0;
 
-  /// @brief Indicates whether one full scan is ready
+  /// @brief Parses a size-exact NebulaPacket and add its points to the point cloud
+  /// @param nebula_packet The incoming NebulaPacket
+  /// @return The last azimuth processed
+  virtual int unpack(const nebula_msgs::msg::NebulaPacket & nebula_packet) = 0;
+
+  /// @brief Parses all packets of a PandarScan and adds their points to the point cloud. The output
+  /// is identical to calling `unpack` for each packet, but return groups are converted on the
+  /// number of threads given by `HesaiSensorConfiguration::decode_threads`
+  /// @param pandar_scan The incoming PandarScan
+  /// @return The last azimuth processed
+  virtual int unpackScan(const pandar_msgs::msg::PandarScan & pandar_scan) = 0;
+
+  /// @brief Parses all packets of a NebulaPackets message, see `unpackScan(PandarScan)`
+  /// @param nebula_packets The incoming NebulaPackets
+  /// @return The last azimuth processed
+  virtual int unpackScan(const nebula_msgs::msg::NebulaPackets & nebula_packets) = 0;
+
+  /// @brief Indicates whether one full scan is ready. After `unpackScan`, whether at least one scan
+  /// has been completed in the PandarScan
   /// @return Whether a scan is ready
   virtual bool hasScanned() = 0;
 
   /// @brief Returns the point cloud and timestamp of the last scan
   /// @return A tuple of point cloud and timestamp in nanoseconds
   virtual std::tuple<drivers::NebulaPointCloudPtr, double> getPointcloud() = 0;
+
+  /// @brief Returns the packet loss statistics of the last scan, i.e. which azimuth ranges of the
+  /// point cloud returned by `getPointcloud` contain no data because packets were lost
+  /// @return The statistics of the last scan
+  virtual const ScanCompleteness & getScanCompleteness() = 0;
 };
 }  // namespace drivers
 }  // namespace nebula
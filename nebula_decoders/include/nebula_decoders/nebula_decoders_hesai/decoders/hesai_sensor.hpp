@@ -1,7 +1,9 @@
 #pragma once
 
 #include "nebula_common/nebula_common.hpp"
+#include "nebula_decoders/nebula_decoders_common/return_group.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/decoders/angle_corrector_calibration_based.hpp"
+#include "nebula_decoders/nebula_decoders_hesai/decoders/angle_corrector_calibration_based_compact.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/decoders/angle_corrector_correction_based.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/decoders/hesai_packet.hpp"
 
@@ -12,25 +14,32 @@ namespace nebula
 namespace drivers
 {
 
-enum class AngleCorrectionType { CALIBRATION, CORRECTION };
+/// @brief The angle correction approach of a sensor.
+/// CALIBRATION_COMPACT is calibration-based as well, but trades a few multiplications per point for
+/// much smaller lookup tables (see @ref AngleCorrectorCalibrationBasedCompact)
+enum class AngleCorrectionType { CALIBRATION, CALIBRATION_COMPACT, CORRECTION };
 
-/// @brief Base class for all sensor definitions
+/// @brief Base class for all sensor definitions. Besides the virtual functions, each sensor defines
+/// its MIN_RANGE, MAX_RANGE, MAX_SCAN_BUFFER_POINTS and FIRING_CYCLE_NS, the time between two
+/// consecutive return groups
 /// @tparam PacketT The packet type of the sensor
 template <typename PacketT, AngleCorrectionType AngleCorrection = AngleCorrectionType::CALIBRATION>
 class HesaiSensor
 {
+public:
+  /// @brief The units of one channel in all blocks of a return group
+  typedef ReturnGroup<typename PacketT::body_t::block_t::unit_t, PacketT::MAX_RETURNS>
+    return_group_t;
+
 private:
   /// @brief Whether the unit given by return_idx is the strongest (in terms of intensity) among all
   /// return_units
   /// @param return_idx The index of the unit in return_units
-  /// @param return_units The vector of all the units corresponding to the same return group (i.e.
-  /// length 2 for dual-return with both units having the same channel but coming from different
-  /// blocks)
+  /// @param return_units All the units corresponding to the same return group (i.e. length 2 for
+  /// dual-return with both units having the same channel but coming from different blocks)
   /// @return true if the reflectivity of the unit is strictly greater than that of all other units
   /// in return_units, false otherwise
-  static bool is_strongest(
-    uint32_t return_idx,
-    const std::vector<const typename PacketT::body_t::block_t::unit_t *> & return_units)
+  static bool is_strongest(uint32_t return_idx, const return_group_t & return_units)
   {
     for (unsigned int i = 0; i < return_units.size(); ++i) {
       if (i == return_idx) {
@@ -46,14 +55,11 @@ private:
   };
 
   /// @brief Whether the unit given by return_idx is a duplicate of any other unit in return_units
-  /// @param return_idx The unit's index in the return_units vector
-  /// @param return_units The vector of all the units corresponding to the same return group (i.e.
-  /// length 2 for dual-return with both units having the same channel but coming from different
-  /// blocks)
+  /// @param return_idx The unit's index in return_units
+  /// @param return_units All the units corresponding to the same return group (i.e. length 2 for
+  /// dual-return with both units having the same channel but coming from different blocks)
   /// @return true if the unit is identical to any other one in return_units, false otherwise
-  static bool is_duplicate(
-    uint32_t return_idx,
-    const std::vector<const typename PacketT::body_t::block_t::unit_t *> & return_units)
+  static bool is_duplicate(uint32_t return_idx, const return_group_t & return_units)
   {
     for (unsigned int i = 0; i < return_units.size(); ++i) {
       if (i == return_idx) {
@@ -75,7 +81,10 @@ public:
   typedef typename std::conditional<
     (AngleCorrection == AngleCorrectionType::CALIBRATION),
     AngleCorrectorCalibrationBased<PacketT::N_CHANNELS, PacketT::DEGREE_SUBDIVISIONS>,
-    AngleCorrectorCorrectionBased<PacketT::N_CHANNELS, PacketT::DEGREE_SUBDIVISIONS>>::type
+    typename std::conditional<
+      (AngleCorrection == AngleCorrectionType::CALIBRATION_COMPACT),
+      AngleCorrectorCalibrationBasedCompact<PacketT::N_CHANNELS, PacketT::DEGREE_SUBDIVISIONS>,
+      AngleCorrectorCorrectionBased<PacketT::N_CHANNELS, PacketT::DEGREE_SUBDIVISIONS>>::type>::type
     angle_corrector_t;
 
   HesaiSensor() = default;
@@ -127,7 +136,7 @@ public:
   /// @return The return type of the point
   virtual ReturnType getReturnType(
     hesai_packet::return_mode::ReturnMode return_mode, unsigned int return_idx,
-    const std::vector<const typename PacketT::body_t::block_t::unit_t *> & return_units)
+    const return_group_t & return_units)
   {
     if (is_duplicate(return_idx, return_units)) {
       return ReturnType::IDENTICAL;
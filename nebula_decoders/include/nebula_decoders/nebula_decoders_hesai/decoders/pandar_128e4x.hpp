@@ -69,6 +69,7 @@ public:
   static constexpr float MIN_RANGE = 0.1;
   static constexpr float MAX_RANGE = 230.0;
   static constexpr size_t MAX_SCAN_BUFFER_POINTS = 691200;
+  static constexpr uint32_t FIRING_CYCLE_NS = 55556;
 
   int getPacketRelativePointTimeOffset(
     uint32_t block_id, uint32_t channel_id, const packet_t & packet)
@@ -100,9 +101,9 @@ public:
 
   ReturnType getReturnType(
     hesai_packet::return_mode::ReturnMode return_mode, unsigned int return_idx,
-    const std::vector<const typename packet_t::body_t::block_t::unit_t *> & return_units) override
+    const return_group_t & return_units) override
   {
-    auto return_type = HesaiSensor<packet_t>::getReturnType(return_mode, return_idx, return_units);
+    auto return_type = HesaiSensor::getReturnType(return_mode, return_idx, return_units);
     if (return_type == ReturnType::IDENTICAL) {
       return return_type;
     }
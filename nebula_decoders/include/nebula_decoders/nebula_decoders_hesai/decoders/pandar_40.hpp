@@ -42,7 +42,7 @@ struct Packet40P : public PacketBase<10, 40, 2, 100>
 /// packet type without a header.
 /// @return 0.004 (4mm)
 template <>
-double get_dis_unit<Packet40P>(const Packet40P & /* packet */)
+inline double get_dis_unit<Packet40P>(const Packet40P & /* packet */)
 {
   return 4 / 1000.;
 }
@@ -62,6 +62,7 @@ public:
   static constexpr float MIN_RANGE = 0.3f;
   static constexpr float MAX_RANGE = 200.f;
   static constexpr size_t MAX_SCAN_BUFFER_POINTS = 144000;
+  static constexpr uint32_t FIRING_CYCLE_NS = 55560;
 
   int getPacketRelativePointTimeOffset(
     uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
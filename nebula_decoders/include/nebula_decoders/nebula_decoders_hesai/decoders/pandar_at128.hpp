@@ -68,6 +68,7 @@ public:
   static constexpr float MIN_RANGE = 1.f;
   static constexpr float MAX_RANGE = 180.0f;
   static constexpr size_t MAX_SCAN_BUFFER_POINTS = 307200;
+  static constexpr uint32_t FIRING_CYCLE_NS = 41666;
 
   int getPacketRelativePointTimeOffset(
     uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
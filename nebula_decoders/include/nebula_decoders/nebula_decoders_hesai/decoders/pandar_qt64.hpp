@@ -51,6 +51,7 @@ public:
   static constexpr float MIN_RANGE = 0.1f;
   static constexpr float MAX_RANGE = 60.f;
   static constexpr size_t MAX_SCAN_BUFFER_POINTS = 76800;
+  static constexpr uint32_t FIRING_CYCLE_NS = 166667;
 
   int getPacketRelativePointTimeOffset(
     uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
@@ -42,6 +42,7 @@ public:
   static constexpr float MIN_RANGE = 0.05f;
   static constexpr float MAX_RANGE = 120.0f;
   static constexpr size_t MAX_SCAN_BUFFER_POINTS = 256000;
+  static constexpr uint32_t FIRING_CYCLE_NS = 50000;
 
   int getPacketRelativePointTimeOffset(
     uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
@@ -54,7 +55,7 @@ public:
 
   ReturnType getReturnType(
     hesai_packet::return_mode::ReturnMode return_mode, unsigned int return_idx,
-    const std::vector<const typename packet_t::body_t::block_t::unit_t *> & return_units) override
+    const return_group_t & return_units) override
   {
     auto return_type = HesaiSensor<packet_t>::getReturnType(return_mode, return_idx, return_units);
     if (return_type == ReturnType::IDENTICAL) {
@@ -34,6 +34,7 @@ public:
   static constexpr float MIN_RANGE = 0.5f;
   static constexpr float MAX_RANGE = 300.0f;
   static constexpr size_t MAX_SCAN_BUFFER_POINTS = 384000;
+  static constexpr uint32_t FIRING_CYCLE_NS = 50000;
 
   int getPacketRelativePointTimeOffset(
     uint32_t block_id, uint32_t channel_id, const packet_t & packet) override
@@ -5,9 +5,12 @@
 #include "nebula_common/nebula_common.hpp"
 #include "nebula_common/nebula_status.hpp"
 #include "nebula_common/point_types.hpp"
+#include "nebula_common/scan_latency_tracer.hpp"
 #include "nebula_decoders/nebula_decoders_common/nebula_driver_base.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/decoders/hesai_decoder.hpp"
 
+#include "nebula_msgs/msg/nebula_packet.hpp"
+#include "nebula_msgs/msg/nebula_packets.hpp"
 #include "pandar_msgs/msg/pandar_packet.hpp"
 #include "pandar_msgs/msg/pandar_scan.hpp"
 
@@ -29,6 +32,22 @@ private:
   Status driver_status_;
   /// @brief Decoder according to the model
   std::shared_ptr<HesaiScanDecoder> scan_decoder_;
+  /// @brief Whether scans are decoded on multiple threads
+  bool parallel_decode_;
+  /// @brief Traces the decoding of scan messages
+  std::shared_ptr<ScanLatencyTracer> scan_tracer_;
+
+  /// @brief Implementation of `ConvertScanToPointcloud` for both scan message types
+  /// @param scan_msg A PandarScan or NebulaPackets message
+  /// @return tuple of Point cloud and timestamp
+  template <typename ScanMsgT>
+  std::tuple<drivers::NebulaPointCloudPtr, double> ConvertScanMsg(const ScanMsgT & scan_msg);
+
+  /// @brief Implementation of `ParseCloudPacket` for both packet message types
+  /// @param packet_msg A PandarPacket or NebulaPacket message
+  /// @return tuple of Point cloud and timestamp
+  template <typename PacketMsgT>
+  std::tuple<drivers::NebulaPointCloudPtr, double> ParsePacketMsg(const PacketMsgT & packet_msg);
 
 public:
   HesaiDriver() = delete;
@@ -56,6 +75,31 @@ public:
   /// @return tuple of Point cloud and timestamp
   std::tuple<drivers::NebulaPointCloudPtr, double> ConvertScanToPointcloud(
     const std::shared_ptr<pandar_msgs::msg::PandarScan> & pandar_scan);
+
+  /// @brief Convert NebulaPackets message to point cloud
+  /// @param nebula_packets Message
+  /// @return tuple of Point cloud and timestamp
+  std::tuple<drivers::NebulaPointCloudPtr, double> ConvertScanToPointcloud(
+    const std::shared_ptr<nebula_msgs::msg::NebulaPackets> & nebula_packets);
+
+  /// @brief Decode a single PandarPacket as soon as it has been received
+  /// @param pandar_packet Message
+  /// @return tuple of Point cloud and timestamp. The point cloud is only set if the packet
+  /// completed a scan, and nullptr otherwise
+  std::tuple<drivers::NebulaPointCloudPtr, double> ParseCloudPacket(
+    const pandar_msgs::msg::PandarPacket & pandar_packet);
+
+  /// @brief Decode a single NebulaPacket as soon as it has been received
+  /// @param nebula_packet Message
+  /// @return tuple of Point cloud and timestamp. The point cloud is only set if the packet
+  /// completed a scan, and nullptr otherwise
+  std::tuple<drivers::NebulaPointCloudPtr, double> ParseCloudPacket(
+    const nebula_msgs::msg::NebulaPacket & nebula_packet);
+
+  /// @brief Get the packet loss statistics of the scan last returned by `ConvertScanToPointcloud`
+  /// or `ParseCloudPacket`. Only valid until the next packet is decoded
+  /// @return The statistics of the last scan
+  const ScanCompleteness & GetScanCompleteness();
 };
 
 }  // namespace drivers
@@ -0,0 +1,97 @@
+#pragma once
+
+#include "nebula_common/robosense/robosense_common.hpp"
+#include "nebula_decoders/nebula_decoders_robosense/decoders/angle_corrector.hpp"
+
+#include <cstdint>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief Calibration-based angle corrector with small lookup tables.
+///
+/// Instead of a sin/cos table over all azimuth/channel combinations like
+/// @ref AngleCorrectorCalibrationBased, only the block azimuth and the per-channel azimuth offset
+/// are tabulated. The corrected azimuth's sin/cos are computed with the angle addition identities:
+/// `sin(a + b) = sin(a)cos(b) + cos(a)sin(b)` and `cos(a + b) = cos(a)cos(b) - sin(a)sin(b)`.
+/// For 32 channels at 1/100 deg resolution, this reduces the table size from ~9MB to ~430kB,
+/// which fits into L2 cache, at the cost of a few multiplications per lookup and an error of a
+/// few ULP in the resulting sin/cos values.
+template <size_t ChannelN, size_t AngleUnit>
+class AngleCorrectorCalibrationBasedCompact final : public AngleCorrector
+{
+private:
+  static constexpr size_t MAX_AZIMUTH_LEN = 360 * AngleUnit;
+
+  std::array<float, ChannelN> elevation_angle_rad_{};
+  std::array<float, ChannelN> azimuth_offset_rad_{};
+  std::array<float, MAX_AZIMUTH_LEN> block_azimuth_rad_{};
+
+  std::array<float, ChannelN> elevation_cos_{};
+  std::array<float, ChannelN> elevation_sin_{};
+  std::array<float, ChannelN> azimuth_offset_cos_{};
+  std::array<float, ChannelN> azimuth_offset_sin_{};
+  std::array<float, MAX_AZIMUTH_LEN> block_azimuth_cos_{};
+  std::array<float, MAX_AZIMUTH_LEN> block_azimuth_sin_{};
+
+public:
+  explicit AngleCorrectorCalibrationBasedCompact(
+    const std::shared_ptr<RobosenseCalibrationConfiguration> & sensor_calibration)
+  : AngleCorrector(sensor_calibration)
+  {
+    if (sensor_calibration == nullptr) {
+      throw std::runtime_error(
+        "Cannot instantiate AngleCorrectorCalibrationBasedCompact without calibration data");
+    }
+
+    for (size_t channel_id = 0; channel_id < ChannelN; ++channel_id) {
+      const auto correction = sensor_calibration->GetCorrection(channel_id);
+      float elevation_angle_deg = correction.elevation;
+      float azimuth_offset_deg = correction.azimuth;
+
+      elevation_angle_rad_[channel_id] = deg2rad(elevation_angle_deg);
+      azimuth_offset_rad_[channel_id] = deg2rad(azimuth_offset_deg);
+
+      elevation_cos_[channel_id] = cosf(elevation_angle_rad_[channel_id]);
+      elevation_sin_[channel_id] = sinf(elevation_angle_rad_[channel_id]);
+      azimuth_offset_cos_[channel_id] = cosf(azimuth_offset_rad_[channel_id]);
+      azimuth_offset_sin_[channel_id] = sinf(azimuth_offset_rad_[channel_id]);
+    }
+
+    for (size_t block_azimuth = 0; block_azimuth < MAX_AZIMUTH_LEN; block_azimuth++) {
+      block_azimuth_rad_[block_azimuth] = deg2rad(block_azimuth / static_cast<double>(AngleUnit));
+      block_azimuth_cos_[block_azimuth] = cosf(block_azimuth_rad_[block_azimuth]);
+      block_azimuth_sin_[block_azimuth] = sinf(block_azimuth_rad_[block_azimuth]);
+    }
+  }
+
+  CorrectedAngleData getCorrectedAngleData(uint32_t block_azimuth, uint32_t channel_id) override
+  {
+    float azimuth_rad = block_azimuth_rad_[block_azimuth] + azimuth_offset_rad_[channel_id];
+    float elevation_rad = elevation_angle_rad_[channel_id];
+
+    float block_sin = block_azimuth_sin_[block_azimuth];
+    float block_cos = block_azimuth_cos_[block_azimuth];
+    float offset_sin = azimuth_offset_sin_[channel_id];
+    float offset_cos = azimuth_offset_cos_[channel_id];
+
+    return {
+      azimuth_rad,
+      elevation_rad,
+      block_sin * offset_cos + block_cos * offset_sin,
+      block_cos * offset_cos - block_sin * offset_sin,
+      elevation_sin_[channel_id],
+      elevation_cos_[channel_id],
+      sensor_calibration_->calibration[channel_id].channel};
+  }
+
+  bool hasScanned(int current_azimuth, int last_azimuth) override
+  {
+    return current_azimuth < last_azimuth;
+  }
+};
+
+}  // namespace drivers
+}  // namespace nebula
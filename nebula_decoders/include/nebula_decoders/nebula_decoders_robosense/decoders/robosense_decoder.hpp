@@ -1,6 +1,9 @@
 #pragma once
 
 #include "nebula_common/robosense/robosense_common.hpp"
+#include "nebula_decoders/nebula_decoders_common/packet_view.hpp"
+#include "nebula_decoders/nebula_decoders_common/point_cloud_pool.hpp"
+#include "nebula_decoders/nebula_decoders_common/scan_gap_detector.hpp"
 #include "nebula_decoders/nebula_decoders_robosense/decoders/robosense_packet.hpp"
 #include "nebula_decoders/nebula_decoders_robosense/decoders/robosense_scan_decoder.hpp"
 
@@ -26,13 +29,17 @@ protected:
   /// @brief Decodes azimuth/elevation angles given calibration/correction data
   typename SensorT::angle_corrector_t angle_corrector_;
 
+  /// @brief The point clouds that decode_pc_ is taken from. A cloud is only reused once all
+  /// references handed out by `getPointcloud()` have been dropped
+  PointCloudPool point_cloud_pool_{POINT_CLOUD_POOL_SIZE, SensorT::MAX_SCAN_BUFFER_POINTS};
   /// @brief The point cloud new points get added to
   NebulaPointCloudPtr decode_pc_;
-  /// @brief The point cloud that is returned when a scan is complete
+  /// @brief The point cloud that is returned when a scan is complete. Never modified once set
   NebulaPointCloudPtr output_pc_;
 
-  /// @brief The last decoded packet
-  typename SensorT::packet_t packet_;
+  /// @brief View of the packet currently being decoded. Points into the incoming message and is
+  /// only valid during `unpack`
+  PacketView<typename SensorT::packet_t> packet_;
   /// @brief The last azimuth processed
   int last_phase_;
   /// @brief The timestamp of the last completed scan in nanoseconds
@@ -41,10 +48,13 @@ protected:
   uint64_t decode_scan_timestamp_ns_;
   /// @brief Whether a full scan has been processed
   bool has_scanned_;
+  /// @brief Detects packets lost between consecutive return groups
+  ScanGapDetector gap_detector_{360 * SensorT::packet_t::DEGREE_SUBDIVISIONS};
 
   rclcpp::Logger logger_;
 
-  /// @brief Validates and parses MsopPacket. Currently only checks size, not checksums etc.
+  /// @brief Validates and parses MsopPacket. Currently only checks size and alignment, not
+  /// checksums etc. The packet is not copied, but decoded in place from the message's data buffer
   /// @param msop_packet The incoming MsopPacket
   /// @return Whether the packet was parsed successfully
   bool parsePacket(const robosense_msgs::msg::RobosensePacket & msop_packet)
@@ -55,12 +65,13 @@ protected:
                                          << sizeof(typename SensorT::packet_t));
       return false;
     }
-    if (std::memcpy(&packet_, msop_packet.data.data(), sizeof(typename SensorT::packet_t))) {
-      return true;
+
+    if (!packet_.reset(msop_packet.data.data(), msop_packet.data.size())) {
+      RCLCPP_ERROR(logger_, "Packet buffer is misaligned");
+      return false;
     }
 
-    RCLCPP_ERROR(logger_, "Packet memcopy failed");
-    return false;
+    return true;
   }
 
   /// @brief Converts a group of returns (i.e. 1 for single return, 2 for dual return, etc.) to
@@ -69,10 +80,10 @@ protected:
   /// @param n_blocks The number of returns in the group
   void convertReturns(size_t start_block_id, size_t n_blocks)
   {
-    uint64_t packet_timestamp_ns = robosense_packet::get_timestamp_ns(packet_);
-    uint32_t raw_azimuth = packet_.body.blocks[start_block_id].get_azimuth();
+    uint64_t packet_timestamp_ns = robosense_packet::get_timestamp_ns(*packet_);
+    uint32_t raw_azimuth = packet_->body.blocks[start_block_id].get_azimuth();
 
-    std::vector<const typename SensorT::packet_t::body_t::block_t::unit_t *> return_units;
+    typename SensorT::return_group_t return_units;
 
     for (size_t channel_id = 0; channel_id < SensorT::packet_t::N_CHANNELS; ++channel_id) {
       // Find the units corresponding to the same return group as the current one.
@@ -80,7 +91,7 @@ protected:
       return_units.clear();
       for (size_t block_offset = 0; block_offset < n_blocks; ++block_offset) {
         return_units.push_back(
-          &packet_.body.blocks[block_offset + start_block_id].units[channel_id]);
+          &packet_->body.blocks[block_offset + start_block_id].units[channel_id]);
       }
 
       for (size_t block_offset = 0; block_offset < n_blocks; ++block_offset) {
@@ -161,12 +172,31 @@ protected:
     return angle_corrector_.hasScanned(current_phase, last_phase_);
   }
 
+  /// @brief The azimuth step between consecutive return groups of the current packet. MSOP packets
+  /// do not contain the rotation speed, but each packet spans several firing cycles, so the average
+  /// step within it reflects the current rotation speed and return mode
+  /// @param n_returns The number of returns per return group
+  /// @return The expected step in azimuth units
+  double getExpectedAzimuthStep(size_t n_returns)
+  {
+    constexpr uint32_t max_azimuth = 360 * SensorT::packet_t::DEGREE_SUBDIVISIONS;
+    const size_t n_steps = SensorT::packet_t::N_BLOCKS / n_returns - 1;
+    if (n_steps == 0) {
+      return 0;
+    }
+
+    const uint32_t first_azimuth = packet_->body.blocks[0].get_azimuth();
+    const uint32_t last_azimuth = packet_->body.blocks[n_steps * n_returns].get_azimuth();
+    return static_cast<double>((max_azimuth + last_azimuth - first_azimuth) % max_azimuth) /
+           n_steps;
+  }
+
   /// @brief Get the distance of the given unit in meters
   /// @param unit The unit to get the distance from
   /// @return The distance in meters
   float getDistance(const typename SensorT::packet_t::body_t::block_t::unit_t & unit)
   {
-    return unit.distance.value() * robosense_packet::get_dis_unit(packet_);
+    return unit.distance.value() * robosense_packet::get_dis_unit(*packet_);
   }
 
   /// @brief Get timestamp of point in nanoseconds, relative to scan timestamp. Includes firing time
@@ -198,11 +228,8 @@ public:
     logger_.set_level(rclcpp::Logger::Level::Debug);
     RCLCPP_INFO_STREAM(logger_, sensor_configuration_);
 
-    decode_pc_.reset(new NebulaPointCloud);
-    output_pc_.reset(new NebulaPointCloud);
-
-    decode_pc_->reserve(SensorT::MAX_SCAN_BUFFER_POINTS);
-    output_pc_->reserve(SensorT::MAX_SCAN_BUFFER_POINTS);
+    decode_pc_ = point_cloud_pool_.acquire();
+    output_pc_ = point_cloud_pool_.acquire();
   }
 
   int unpack(const robosense_msgs::msg::RobosensePacket & msop_packet) override
@@ -212,7 +239,7 @@ public:
     }
 
     if (decode_scan_timestamp_ns_ == 0) {
-      decode_scan_timestamp_ns_ = robosense_packet::get_timestamp_ns(packet_);
+      decode_scan_timestamp_ns_ = robosense_packet::get_timestamp_ns(*packet_);
     }
 
     if (has_scanned_) {
@@ -223,28 +250,34 @@ public:
     // return. For the single return mode, the packet contains only one block per azimuth.
     // So, if the return mode is dual, we process two blocks per iteration, otherwise one.
     const size_t n_returns = robosense_packet::get_n_returns(sensor_configuration_->return_mode);
+    const double expected_azimuth_step = getExpectedAzimuthStep(n_returns);
     int current_azimuth;
+    gap_detector_.addPacket();
 
     for (size_t block_id = 0; block_id < SensorT::packet_t::N_BLOCKS; block_id += n_returns) {
       current_azimuth =
         (360 * SensorT::packet_t::DEGREE_SUBDIVISIONS +
-         packet_.body.blocks[block_id].get_azimuth() -
+         packet_->body.blocks[block_id].get_azimuth() -
          static_cast<int>(
            sensor_configuration_->scan_phase * SensorT::packet_t::DEGREE_SUBDIVISIONS)) %
         (360 * SensorT::packet_t::DEGREE_SUBDIVISIONS);
 
+      gap_detector_.addReturnGroup(
+        current_azimuth, expected_azimuth_step, SensorT::packet_t::N_BLOCKS / n_returns);
+
       bool scan_completed = checkScanCompleted(current_azimuth);
       if (scan_completed) {
-        std::swap(decode_pc_, output_pc_);
-        decode_pc_->clear();
+        output_pc_ = std::move(decode_pc_);
+        decode_pc_ = point_cloud_pool_.acquire();
         has_scanned_ = true;
         output_scan_timestamp_ns_ = decode_scan_timestamp_ns_;
+        gap_detector_.completeScan();
 
         // A new scan starts within the current packet, so the new scan's timestamp must be
         // calculated as the packet timestamp plus the lowest time offset of any point in the
         // remainder of the packet
         decode_scan_timestamp_ns_ =
-          robosense_packet::get_timestamp_ns(packet_) +
+          robosense_packet::get_timestamp_ns(*packet_) +
           sensor_.getEarliestPointTimeOffsetForBlock(block_id, sensor_configuration_);
       }
 
@@ -262,6 +295,8 @@ public:
     double scan_timestamp_s = static_cast<double>(output_scan_timestamp_ns_) * 1e-9;
     return std::make_pair(output_pc_, scan_timestamp_s);
   }
+
+  const ScanCompleteness & getScanCompleteness() override { return gap_detector_.completedScan(); }
 };
 
 }  // namespace drivers
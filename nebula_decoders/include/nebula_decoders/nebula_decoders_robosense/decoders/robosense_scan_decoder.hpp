@@ -2,6 +2,7 @@
 
 #include "nebula_common/point_types.hpp"
 #include "nebula_common/robosense/robosense_common.hpp"
+#include "nebula_decoders/nebula_decoders_common/scan_gap_detector.hpp"
 
 #include "robosense_msgs/msg/robosense_packet.hpp"
 #include "robosense_msgs/msg/robosense_scan.hpp"
@@ -36,6 +37,11 @@ public:
   /// @brief Returns the point cloud and timestamp of the last scan
   /// @return A tuple of point cloud and timestamp in nanoseconds
   virtual std::tuple<drivers::NebulaPointCloudPtr, double> getPointcloud() = 0;
+
+  /// @brief Returns the packet loss statistics of the last scan, i.e. which azimuth ranges of the
+  /// point cloud returned by `getPointcloud` contain no data because packets were lost
+  /// @return The statistics of the last scan
+  virtual const ScanCompleteness & getScanCompleteness() = 0;
 };
 
 }  // namespace drivers
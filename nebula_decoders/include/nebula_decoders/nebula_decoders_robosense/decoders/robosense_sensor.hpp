@@ -1,7 +1,9 @@
 #pragma once
 
 #include "nebula_common/nebula_common.hpp"
+#include "nebula_decoders/nebula_decoders_common/return_group.hpp"
 #include "nebula_decoders/nebula_decoders_robosense/decoders/angle_corrector_calibration_based.hpp"
+#include "nebula_decoders/nebula_decoders_robosense/decoders/angle_corrector_calibration_based_compact.hpp"
 #include "nebula_decoders/nebula_decoders_robosense/decoders/robosense_packet.hpp"
 
 #include <cstdint>
@@ -12,16 +14,31 @@ namespace nebula
 namespace drivers
 {
 
+/// @brief The angle correction approach of a sensor.
+/// CALIBRATION_COMPACT trades a few multiplications per point for much smaller lookup tables (see
+/// @ref AngleCorrectorCalibrationBasedCompact)
+enum class AngleCorrectionType { CALIBRATION, CALIBRATION_COMPACT };
+
 /// @brief Base class for all sensor definitions
 /// @tparam PacketT The packet type of the sensor
-template <typename PacketT, typename InfoPacketT>
+/// @tparam InfoPacketT The info (DIFOP) packet type of the sensor
+/// @tparam AngleCorrection The angle correction approach used by the sensor
+template <
+  typename PacketT, typename InfoPacketT,
+  AngleCorrectionType AngleCorrection = AngleCorrectionType::CALIBRATION>
 class RobosenseSensor
 {
 private:
 public:
   typedef PacketT packet_t;
   typedef InfoPacketT info_t;
-  typedef class AngleCorrectorCalibrationBased<PacketT::N_CHANNELS, PacketT::DEGREE_SUBDIVISIONS>
+  /// @brief The units of one channel in all blocks of a return group
+  typedef ReturnGroup<typename PacketT::body_t::block_t::unit_t, PacketT::MAX_RETURNS>
+    return_group_t;
+  typedef typename std::conditional<
+    (AngleCorrection == AngleCorrectionType::CALIBRATION),
+    AngleCorrectorCalibrationBased<PacketT::N_CHANNELS, PacketT::DEGREE_SUBDIVISIONS>,
+    AngleCorrectorCalibrationBasedCompact<PacketT::N_CHANNELS, PacketT::DEGREE_SUBDIVISIONS>>::type
     angle_corrector_t;
 
   RobosenseSensor() = default;
@@ -62,14 +79,11 @@ public:
   }
 
   /// @brief Whether the unit given by return_idx is a duplicate of any other unit in return_units
-  /// @param return_idx The unit's index in the return_units vector
-  /// @param return_units The vector of all the units corresponding to the same return group (i.e.
-  /// length 2 for dual-return with both units having the same channel but coming from different
-  /// blocks)
+  /// @param return_idx The unit's index in return_units
+  /// @param return_units All the units corresponding to the same return group (i.e. length 2 for
+  /// dual-return with both units having the same channel but coming from different blocks)
   /// @return true if the unit is identical to any other one in return_units, false otherwise
-  static bool is_duplicate(
-    uint32_t return_idx,
-    const std::vector<const typename PacketT::body_t::block_t::unit_t *> & return_units)
+  static bool is_duplicate(uint32_t return_idx, const return_group_t & return_units)
   {
     for (unsigned int i = 0; i < return_units.size(); ++i) {
       if (i == return_idx) {
@@ -95,8 +109,7 @@ public:
   /// from the same column across adjascent blocks.
   /// @return The return type of the point
   virtual ReturnType getReturnType(
-    ReturnMode return_mode, unsigned int return_idx,
-    const std::vector<const typename PacketT::body_t::block_t::unit_t *> & return_units)
+    ReturnMode return_mode, unsigned int return_idx, const return_group_t & return_units)
   {
     if (is_duplicate(return_idx, return_units)) {
       return ReturnType::IDENTICAL;
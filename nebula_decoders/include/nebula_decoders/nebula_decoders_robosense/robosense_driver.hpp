@@ -55,6 +55,11 @@ public:
   /// @return tuple of Point cloud and timestamp
   std::tuple<drivers::NebulaPointCloudPtr, double> ConvertScanToPointcloud(
     const std::shared_ptr<robosense_msgs::msg::RobosenseScan> & robosense_scan);
+
+  /// @brief Get the packet loss statistics of the scan last returned by `ConvertScanToPointcloud`.
+  /// Only valid until the next packet is decoded
+  /// @return The statistics of the last scan
+  const ScanCompleteness & GetScanCompleteness();
 };
 
 }  // namespace drivers
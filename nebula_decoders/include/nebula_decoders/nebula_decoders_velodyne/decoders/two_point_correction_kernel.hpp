@@ -0,0 +1,470 @@
+#pragma once
+
+#include "nebula_common/velodyne/velodyne_calibration_decoder.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define NEBULA_VELODYNE_KERNEL_X86
+#include <immintrin.h>
+#endif
+
+namespace nebula
+{
+namespace drivers
+{
+namespace two_point_correction
+{
+
+/// @brief The instruction set used to convert firings
+enum class Isa { SCALAR, SSE2, AVX2 };
+
+/// @brief The X and Y distances at which the two-point distance corrections of the calibration
+/// apply in full, in meters. Between them, the correction is interpolated linearly
+constexpr double NEAR_X = 2.4;
+constexpr double NEAR_Y = 1.93;
+constexpr double FAR_XY = 25.04;
+
+/// @brief The calibration of all lasers, stored as structure of arrays so that a whole firing can
+/// be converted at once. Packed from the calibration file when the decoder is constructed
+/// @tparam LaserN The number of lasers
+template <size_t LaserN>
+struct LaserCalibration
+{
+  std::array<float, LaserN> cos_rot_correction;
+  std::array<float, LaserN> sin_rot_correction;
+  std::array<float, LaserN> cos_vert_correction;
+  std::array<float, LaserN> sin_vert_correction;
+  std::array<float, LaserN> horiz_offset_correction;
+  std::array<float, LaserN> vert_offset_correction;
+  std::array<float, LaserN> dist_correction;
+  std::array<float, LaserN> dist_correction_x;
+  std::array<float, LaserN> dist_correction_y;
+  /// @brief `dist_correction - dist_correction_x`, the slope of the X correction times the
+  /// interpolation interval
+  std::array<float, LaserN> dist_correction_diff_x;
+  /// @brief `dist_correction - dist_correction_y`
+  std::array<float, LaserN> dist_correction_diff_y;
+  /// @brief All bits set if the laser has a two-point distance correction, 0 otherwise
+  std::array<uint32_t, LaserN> two_pt_correction_mask;
+};
+
+/// @brief Pack the calibration of the lasers for the kernels
+/// @param laser_corrections The calibration of each laser, as read from the calibration file.
+/// Lasers missing from it are left zeroed
+template <size_t LaserN>
+LaserCalibration<LaserN> pack_calibration(
+  const std::vector<VelodyneLaserCorrection> & laser_corrections)
+{
+  LaserCalibration<LaserN> calibration{};
+  const size_t n_lasers = std::min(LaserN, laser_corrections.size());
+  for (size_t laser = 0; laser < n_lasers; ++laser) {
+    const VelodyneLaserCorrection & corrections = laser_corrections[laser];
+    calibration.cos_rot_correction[laser] = corrections.cos_rot_correction;
+    calibration.sin_rot_correction[laser] = corrections.sin_rot_correction;
+    calibration.cos_vert_correction[laser] = corrections.cos_vert_correction;
+    calibration.sin_vert_correction[laser] = corrections.sin_vert_correction;
+    calibration.horiz_offset_correction[laser] = corrections.horiz_offset_correction;
+    calibration.vert_offset_correction[laser] = corrections.vert_offset_correction;
+    calibration.dist_correction[laser] = corrections.dist_correction;
+    calibration.dist_correction_x[laser] = corrections.dist_correction_x;
+    calibration.dist_correction_y[laser] = corrections.dist_correction_y;
+    calibration.dist_correction_diff_x[laser] =
+      corrections.dist_correction - corrections.dist_correction_x;
+    calibration.dist_correction_diff_y[laser] =
+      corrections.dist_correction - corrections.dist_correction_y;
+    calibration.two_pt_correction_mask[laser] =
+      corrections.two_pt_correction_available ? UINT32_MAX : 0;
+  }
+  return calibration;
+}
+
+/// @brief Input and output buffers for the conversion of one firing
+/// @tparam ChannelN The number of lasers per firing
+template <size_t ChannelN>
+struct ConvertedFiring
+{
+  /// @brief Distance in meters, corrected by the laser's distance correction
+  std::array<float, ChannelN> distance;
+  /// @brief Coordinates in the ROS coordinate system. Computed for all lasers, including those
+  /// without a return
+  std::array<float, ChannelN> x;
+  std::array<float, ChannelN> y;
+  std::array<float, ChannelN> z;
+};
+
+/// @brief Pointers to the structure of arrays a kernel reads from and writes to. The calibration
+/// pointers point to the firing's first laser, so that all arrays are indexed by channel
+struct KernelArgs
+{
+  const float * distance;
+  const float * cos_rot_correction;
+  const float * sin_rot_correction;
+  const float * cos_vert_correction;
+  const float * sin_vert_correction;
+  const float * horiz_offset_correction;
+  const float * vert_offset_correction;
+  const float * dist_correction;
+  const float * dist_correction_x;
+  const float * dist_correction_y;
+  const float * dist_correction_diff_x;
+  const float * dist_correction_diff_y;
+  const uint32_t * two_pt_correction_mask;
+
+  float * x;
+  float * y;
+  float * z;
+
+  /// @brief The cos and sin of the azimuth shared by all lasers of the firing
+  float cos_azimuth;
+  float sin_azimuth;
+};
+
+typedef void (*KernelFn)(const KernelArgs & args, size_t begin, size_t end);
+
+/// @brief Get the kernel arguments for converting a firing
+/// @param calibration The packed calibration of all lasers
+/// @param first_laser The laser of the firing's first channel
+/// @param firing The firing's distances and output buffers
+/// @param cos_azimuth The cos of the firing's azimuth
+/// @param sin_azimuth The sin of the firing's azimuth
+template <size_t LaserN, size_t ChannelN>
+KernelArgs make_kernel_args(
+  const LaserCalibration<LaserN> & calibration, size_t first_laser,
+  ConvertedFiring<ChannelN> & firing, float cos_azimuth, float sin_azimuth)
+{
+  return {
+    firing.distance.data(),
+    calibration.cos_rot_correction.data() + first_laser,
+    calibration.sin_rot_correction.data() + first_laser,
+    calibration.cos_vert_correction.data() + first_laser,
+    calibration.sin_vert_correction.data() + first_laser,
+    calibration.horiz_offset_correction.data() + first_laser,
+    calibration.vert_offset_correction.data() + first_laser,
+    calibration.dist_correction.data() + first_laser,
+    calibration.dist_correction_x.data() + first_laser,
+    calibration.dist_correction_y.data() + first_laser,
+    calibration.dist_correction_diff_x.data() + first_laser,
+    calibration.dist_correction_diff_y.data() + first_laser,
+    calibration.two_pt_correction_mask.data() + first_laser,
+    firing.x.data(),
+    firing.y.data(),
+    firing.z.data(),
+    cos_azimuth,
+    sin_azimuth};
+}
+
+/// @brief Reference implementation, also used for the channels that do not fill a whole vector.
+/// All kernels have to produce bit-identical results to this one: the two-point interpolation is
+/// computed in double precision and rounded to float, all other products are computed in single
+/// precision in the same order.
+inline void convert_scalar(const KernelArgs & args, size_t begin, size_t end)
+{
+  for (size_t i = begin; i < end; ++i) {
+    const float distance = args.distance[i];
+    const float cos_vert_angle = args.cos_vert_correction[i];
+    const float sin_vert_angle = args.sin_vert_correction[i];
+    const float horiz_offset = args.horiz_offset_correction[i];
+    const float vert_offset = args.vert_offset_correction[i];
+
+    // The azimuth corrected by the laser's rotation correction
+    const float cos_rot_angle = args.cos_azimuth * args.cos_rot_correction[i] +
+                                args.sin_azimuth * args.sin_rot_correction[i];
+    const float sin_rot_angle = args.sin_azimuth * args.cos_rot_correction[i] -
+                                args.cos_azimuth * args.sin_rot_correction[i];
+
+    // Compute the distance in the xy plane (w/o accounting for rotation)
+    float xy_distance = distance * cos_vert_angle - vert_offset * sin_vert_angle;
+
+    // Calculate temporal X and Y, use absolute values
+    float xx = xy_distance * sin_rot_angle - horiz_offset * cos_rot_angle;
+    float yy = xy_distance * cos_rot_angle + horiz_offset * sin_rot_angle;
+    if (xx < 0) {
+      xx = -xx;
+    }
+    if (yy < 0) {
+      yy = -yy;
+    }
+
+    // Linear interpolation of the distance corrections for X and Y, that means distance
+    // correction use different value at different distance
+    float distance_corr_x = 0;
+    float distance_corr_y = 0;
+    if (args.two_pt_correction_mask[i]) {
+      distance_corr_x = static_cast<float>(
+        args.dist_correction_diff_x[i] * (xx - NEAR_X) / (FAR_XY - NEAR_X) +
+        args.dist_correction_x[i]);
+      distance_corr_x -= args.dist_correction[i];
+      distance_corr_y = static_cast<float>(
+        args.dist_correction_diff_y[i] * (yy - NEAR_Y) / (FAR_XY - NEAR_Y) +
+        args.dist_correction_y[i]);
+      distance_corr_y -= args.dist_correction[i];
+    }
+
+    const float distance_x = distance + distance_corr_x;
+    xy_distance = distance_x * cos_vert_angle - vert_offset * sin_vert_angle;
+    const float x = xy_distance * sin_rot_angle - horiz_offset * cos_rot_angle;
+
+    // Using distance_y for z is not symmetric, but the velodyne manual does this
+    const float distance_y = distance + distance_corr_y;
+    xy_distance = distance_y * cos_vert_angle - vert_offset * sin_vert_angle;
+    const float y = xy_distance * cos_rot_angle + horiz_offset * sin_rot_angle;
+    const float z = distance_y * sin_vert_angle + vert_offset * cos_vert_angle;
+
+    // Use standard ROS coordinate system (right-hand rule)
+    args.x[i] = y;
+    args.y[i] = -x;
+    args.z[i] = z;
+  }
+}
+
+#ifdef NEBULA_VELODYNE_KERNEL_X86
+
+/// @brief The two-point correction `diff * (d - near) / range + correction` of 4 lanes, computed in
+/// double precision and rounded to float
+__attribute__((target("sse2"))) inline __m128 interpolate_sse2(
+  __m128 diff, __m128 d, __m128 correction, __m128d near, __m128d range)
+{
+  const __m128d lo = _mm_add_pd(
+    _mm_div_pd(_mm_mul_pd(_mm_cvtps_pd(diff), _mm_sub_pd(_mm_cvtps_pd(d), near)), range),
+    _mm_cvtps_pd(correction));
+  const __m128d hi = _mm_add_pd(
+    _mm_div_pd(
+      _mm_mul_pd(
+        _mm_cvtps_pd(_mm_movehl_ps(diff, diff)),
+        _mm_sub_pd(_mm_cvtps_pd(_mm_movehl_ps(d, d)), near)),
+      range),
+    _mm_cvtps_pd(_mm_movehl_ps(correction, correction)));
+  return _mm_movelh_ps(_mm_cvtpd_ps(lo), _mm_cvtpd_ps(hi));
+}
+
+__attribute__((target("sse2"))) inline void convert_sse2(
+  const KernelArgs & args, size_t begin, size_t end)
+{
+  const __m128 cos_azimuth = _mm_set1_ps(args.cos_azimuth);
+  const __m128 sin_azimuth = _mm_set1_ps(args.sin_azimuth);
+  const __m128 sign = _mm_set1_ps(-0.f);
+  const __m128d near_x = _mm_set1_pd(NEAR_X);
+  const __m128d near_y = _mm_set1_pd(NEAR_Y);
+  const __m128d range_x = _mm_set1_pd(FAR_XY - NEAR_X);
+  const __m128d range_y = _mm_set1_pd(FAR_XY - NEAR_Y);
+
+  size_t i = begin;
+  for (; i + 4 <= end; i += 4) {
+    const __m128 distance = _mm_loadu_ps(args.distance + i);
+    const __m128 cos_vert_angle = _mm_loadu_ps(args.cos_vert_correction + i);
+    const __m128 sin_vert_angle = _mm_loadu_ps(args.sin_vert_correction + i);
+    const __m128 horiz_offset = _mm_loadu_ps(args.horiz_offset_correction + i);
+    const __m128 vert_offset = _mm_loadu_ps(args.vert_offset_correction + i);
+    const __m128 cos_rot_correction = _mm_loadu_ps(args.cos_rot_correction + i);
+    const __m128 sin_rot_correction = _mm_loadu_ps(args.sin_rot_correction + i);
+
+    const __m128 cos_rot_angle = _mm_add_ps(
+      _mm_mul_ps(cos_azimuth, cos_rot_correction), _mm_mul_ps(sin_azimuth, sin_rot_correction));
+    const __m128 sin_rot_angle = _mm_sub_ps(
+      _mm_mul_ps(sin_azimuth, cos_rot_correction), _mm_mul_ps(cos_azimuth, sin_rot_correction));
+    const __m128 vert_offset_sin = _mm_mul_ps(vert_offset, sin_vert_angle);
+    const __m128 horiz_offset_cos = _mm_mul_ps(horiz_offset, cos_rot_angle);
+    const __m128 horiz_offset_sin = _mm_mul_ps(horiz_offset, sin_rot_angle);
+
+    __m128 xy_distance = _mm_sub_ps(_mm_mul_ps(distance, cos_vert_angle), vert_offset_sin);
+    const __m128 xx =
+      _mm_andnot_ps(sign, _mm_sub_ps(_mm_mul_ps(xy_distance, sin_rot_angle), horiz_offset_cos));
+    const __m128 yy =
+      _mm_andnot_ps(sign, _mm_add_ps(_mm_mul_ps(xy_distance, cos_rot_angle), horiz_offset_sin));
+
+    const __m128 dist_correction = _mm_loadu_ps(args.dist_correction + i);
+    const __m128 two_pt_correction =
+      _mm_loadu_ps(reinterpret_cast<const float *>(args.two_pt_correction_mask + i));
+    const __m128 distance_corr_x = _mm_and_ps(
+      two_pt_correction, _mm_sub_ps(
+                           interpolate_sse2(
+                             _mm_loadu_ps(args.dist_correction_diff_x + i), xx,
+                             _mm_loadu_ps(args.dist_correction_x + i), near_x, range_x),
+                           dist_correction));
+    const __m128 distance_corr_y = _mm_and_ps(
+      two_pt_correction, _mm_sub_ps(
+                           interpolate_sse2(
+                             _mm_loadu_ps(args.dist_correction_diff_y + i), yy,
+                             _mm_loadu_ps(args.dist_correction_y + i), near_y, range_y),
+                           dist_correction));
+
+    const __m128 distance_x = _mm_add_ps(distance, distance_corr_x);
+    xy_distance = _mm_sub_ps(_mm_mul_ps(distance_x, cos_vert_angle), vert_offset_sin);
+    const __m128 x = _mm_sub_ps(_mm_mul_ps(xy_distance, sin_rot_angle), horiz_offset_cos);
+
+    const __m128 distance_y = _mm_add_ps(distance, distance_corr_y);
+    xy_distance = _mm_sub_ps(_mm_mul_ps(distance_y, cos_vert_angle), vert_offset_sin);
+    const __m128 y = _mm_add_ps(_mm_mul_ps(xy_distance, cos_rot_angle), horiz_offset_sin);
+    const __m128 z = _mm_add_ps(
+      _mm_mul_ps(distance_y, sin_vert_angle), _mm_mul_ps(vert_offset, cos_vert_angle));
+
+    _mm_storeu_ps(args.x + i, y);
+    _mm_storeu_ps(args.y + i, _mm_xor_ps(x, sign));
+    _mm_storeu_ps(args.z + i, z);
+  }
+
+  convert_scalar(args, i, end);
+}
+
+/// @brief The two-point correction of 8 lanes, see `interpolate_sse2`
+__attribute__((target("avx2"))) inline __m256 interpolate_avx2(
+  __m256 diff, __m256 d, __m256 correction, __m256d near, __m256d range)
+{
+  const __m256d lo = _mm256_add_pd(
+    _mm256_div_pd(
+      _mm256_mul_pd(
+        _mm256_cvtps_pd(_mm256_castps256_ps128(diff)),
+        _mm256_sub_pd(_mm256_cvtps_pd(_mm256_castps256_ps128(d)), near)),
+      range),
+    _mm256_cvtps_pd(_mm256_castps256_ps128(correction)));
+  const __m256d hi = _mm256_add_pd(
+    _mm256_div_pd(
+      _mm256_mul_pd(
+        _mm256_cvtps_pd(_mm256_extractf128_ps(diff, 1)),
+        _mm256_sub_pd(_mm256_cvtps_pd(_mm256_extractf128_ps(d, 1)), near)),
+      range),
+    _mm256_cvtps_pd(_mm256_extractf128_ps(correction, 1)));
+  return _mm256_insertf128_ps(
+    _mm256_castps128_ps256(_mm256_cvtpd_ps(lo)), _mm256_cvtpd_ps(hi), 1);
+}
+
+__attribute__((target("avx2"))) inline void convert_avx2(
+  const KernelArgs & args, size_t begin, size_t end)
+{
+  const __m256 cos_azimuth = _mm256_set1_ps(args.cos_azimuth);
+  const __m256 sin_azimuth = _mm256_set1_ps(args.sin_azimuth);
+  const __m256 sign = _mm256_set1_ps(-0.f);
+  const __m256d near_x = _mm256_set1_pd(NEAR_X);
+  const __m256d near_y = _mm256_set1_pd(NEAR_Y);
+  const __m256d range_x = _mm256_set1_pd(FAR_XY - NEAR_X);
+  const __m256d range_y = _mm256_set1_pd(FAR_XY - NEAR_Y);
+
+  size_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    const __m256 distance = _mm256_loadu_ps(args.distance + i);
+    const __m256 cos_vert_angle = _mm256_loadu_ps(args.cos_vert_correction + i);
+    const __m256 sin_vert_angle = _mm256_loadu_ps(args.sin_vert_correction + i);
+    const __m256 horiz_offset = _mm256_loadu_ps(args.horiz_offset_correction + i);
+    const __m256 vert_offset = _mm256_loadu_ps(args.vert_offset_correction + i);
+    const __m256 cos_rot_correction = _mm256_loadu_ps(args.cos_rot_correction + i);
+    const __m256 sin_rot_correction = _mm256_loadu_ps(args.sin_rot_correction + i);
+
+    const __m256 cos_rot_angle = _mm256_add_ps(
+      _mm256_mul_ps(cos_azimuth, cos_rot_correction),
+      _mm256_mul_ps(sin_azimuth, sin_rot_correction));
+    const __m256 sin_rot_angle = _mm256_sub_ps(
+      _mm256_mul_ps(sin_azimuth, cos_rot_correction),
+      _mm256_mul_ps(cos_azimuth, sin_rot_correction));
+    const __m256 vert_offset_sin = _mm256_mul_ps(vert_offset, sin_vert_angle);
+    const __m256 horiz_offset_cos = _mm256_mul_ps(horiz_offset, cos_rot_angle);
+    const __m256 horiz_offset_sin = _mm256_mul_ps(horiz_offset, sin_rot_angle);
+
+    __m256 xy_distance =
+      _mm256_sub_ps(_mm256_mul_ps(distance, cos_vert_angle), vert_offset_sin);
+    const __m256 xx = _mm256_andnot_ps(
+      sign, _mm256_sub_ps(_mm256_mul_ps(xy_distance, sin_rot_angle), horiz_offset_cos));
+    const __m256 yy = _mm256_andnot_ps(
+      sign, _mm256_add_ps(_mm256_mul_ps(xy_distance, cos_rot_angle), horiz_offset_sin));
+
+    const __m256 dist_correction = _mm256_loadu_ps(args.dist_correction + i);
+    const __m256 two_pt_correction =
+      _mm256_loadu_ps(reinterpret_cast<const float *>(args.two_pt_correction_mask + i));
+    const __m256 distance_corr_x = _mm256_and_ps(
+      two_pt_correction, _mm256_sub_ps(
+                           interpolate_avx2(
+                             _mm256_loadu_ps(args.dist_correction_diff_x + i), xx,
+                             _mm256_loadu_ps(args.dist_correction_x + i), near_x, range_x),
+                           dist_correction));
+    const __m256 distance_corr_y = _mm256_and_ps(
+      two_pt_correction, _mm256_sub_ps(
+                           interpolate_avx2(
+                             _mm256_loadu_ps(args.dist_correction_diff_y + i), yy,
+                             _mm256_loadu_ps(args.dist_correction_y + i), near_y, range_y),
+                           dist_correction));
+
+    const __m256 distance_x = _mm256_add_ps(distance, distance_corr_x);
+    xy_distance = _mm256_sub_ps(_mm256_mul_ps(distance_x, cos_vert_angle), vert_offset_sin);
+    const __m256 x =
+      _mm256_sub_ps(_mm256_mul_ps(xy_distance, sin_rot_angle), horiz_offset_cos);
+
+    const __m256 distance_y = _mm256_add_ps(distance, distance_corr_y);
+    xy_distance = _mm256_sub_ps(_mm256_mul_ps(distance_y, cos_vert_angle), vert_offset_sin);
+    const __m256 y =
+      _mm256_add_ps(_mm256_mul_ps(xy_distance, cos_rot_angle), horiz_offset_sin);
+    const __m256 z = _mm256_add_ps(
+      _mm256_mul_ps(distance_y, sin_vert_angle), _mm256_mul_ps(vert_offset, cos_vert_angle));
+
+    _mm256_storeu_ps(args.x + i, y);
+    _mm256_storeu_ps(args.y + i, _mm256_xor_ps(x, sign));
+    _mm256_storeu_ps(args.z + i, z);
+  }
+
+  convert_scalar(args, i, end);
+}
+
+#endif
+
+/// @brief Whether the given instruction set can be used on the current CPU
+inline bool is_supported(Isa isa)
+{
+  switch (isa) {
+    case Isa::SCALAR:
+      return true;
+#ifdef NEBULA_VELODYNE_KERNEL_X86
+    case Isa::SSE2:
+      return __builtin_cpu_supports("sse2");
+    case Isa::AVX2:
+      return __builtin_cpu_supports("avx2");
+#endif
+    default:
+      return false;
+  }
+}
+
+/// @brief Get the kernel for the given instruction set
+/// @return The kernel, or the scalar kernel if the instruction set is not supported
+inline KernelFn get_kernel(Isa isa)
+{
+  if (!is_supported(isa)) {
+    return &convert_scalar;
+  }
+
+  switch (isa) {
+#ifdef NEBULA_VELODYNE_KERNEL_X86
+    case Isa::SSE2:
+      return &convert_sse2;
+    case Isa::AVX2:
+      return &convert_avx2;
+#endif
+    default:
+      return &convert_scalar;
+  }
+}
+
+/// @brief Get the best instruction set supported by the current CPU
+inline Isa detect_isa()
+{
+  for (Isa isa : {Isa::AVX2, Isa::SSE2}) {
+    if (is_supported(isa)) {
+      return isa;
+    }
+  }
+
+  return Isa::SCALAR;
+}
+
+/// @brief Get the fastest kernel for the current CPU. The CPU is only queried on the first call.
+inline KernelFn get_best_kernel()
+{
+  static const KernelFn kernel = get_kernel(detect_isa());
+  return kernel;
+}
+
+}  // namespace two_point_correction
+}  // namespace drivers
+}  // namespace nebula
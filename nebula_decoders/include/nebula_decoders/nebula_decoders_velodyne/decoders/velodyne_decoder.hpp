@@ -0,0 +1,564 @@
+#pragma once
+
+#include "nebula_decoders/nebula_decoders_velodyne/decoders/two_point_correction_kernel.hpp"
+#include "nebula_decoders/nebula_decoders_velodyne/decoders/velodyne_scan_decoder.hpp"
+#include "nebula_decoders/nebula_decoders_velodyne/decoders/velodyne_sensor.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include <velodyne_msgs/msg/velodyne_packet.hpp>
+#include <velodyne_msgs/msg/velodyne_scan.hpp>
+
+#include <angles/angles.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief Velodyne LiDAR decoder. The packet layout, bank mapping, azimuth interpolation and
+/// firing timing of the sensor are given by SensorT (see `VelodyneSensor`), and the point loop is
+/// instantiated per sensor and return mode
+/// @tparam SensorT The sensor definition, e.g. `Vlp16`
+template <typename SensorT>
+class VelodyneDecoder : public VelodyneScanDecoder
+{
+private:
+  static constexpr uint32_t POINTS_PER_BLOCK =
+    SensorT::FIRINGS_PER_BLOCK * SensorT::LASERS_PER_FIRING;
+  static_assert(
+    !SensorT::FULL_CALIBRATION_MODEL || !SensorT::INTERPOLATE_AZIMUTH,
+    "The full calibration model converts whole firings, which have to share the block's azimuth");
+
+  /// @brief The cos and sin of the rotation of a point
+  struct rotation_t
+  {
+    float cos_rot_angle;
+    float sin_rot_angle;
+  };
+
+  float sin_rot_table_[ROTATION_MAX_UNITS];
+  float cos_rot_table_[ROTATION_MAX_UNITS];
+  float rotation_radians_[ROTATION_MAX_UNITS];
+  /// @brief The rotations of all azimuths for each distinct rotation correction of the calibration,
+  /// ROTATION_MAX_UNITS entries per table. Empty if rotations are computed per point
+  std::vector<rotation_t> rotation_tables_;
+  /// @brief The offset of each laser's table in `rotation_tables_`
+  std::array<uint32_t, SensorT::N_LASERS> rotation_table_offsets_{};
+  /// @brief The calibration of all lasers for the full calibration model, packed for
+  /// `convert_firing_`. Empty for other sensors
+  two_point_correction::LaserCalibration<SensorT::FULL_CALIBRATION_MODEL ? SensorT::N_LASERS : 0>
+    laser_calibration_{};
+  /// @brief The kernel converting the returns of a firing with the full calibration model
+  two_point_correction::KernelFn convert_firing_;
+  int max_pts_{0};
+  /// @brief Whether the scan being decoded has reached the half rotation opposite the scan phase.
+  /// From then on, points just past the scan phase belong to the next scan
+  bool scan_in_second_half_{false};
+
+  /// @brief Whether the azimuth is in the configured field of view
+  /// @param azimuth Azimuth in 1/100 degrees
+  bool isInFieldOfView(uint16_t azimuth) const
+  {
+    return (azimuth >= sensor_configuration_->cloud_min_angle * 100 &&
+            azimuth <= sensor_configuration_->cloud_max_angle * 100 &&
+            sensor_configuration_->cloud_min_angle < sensor_configuration_->cloud_max_angle) ||
+           (sensor_configuration_->cloud_min_angle > sensor_configuration_->cloud_max_angle &&
+            (azimuth <= sensor_configuration_->cloud_max_angle * 100 ||
+             azimuth >= sensor_configuration_->cloud_min_angle * 100));
+  }
+
+  /// @brief The rotation of a point, i.e. its azimuth corrected by its laser's rotation correction
+  /// @param azimuth The point's azimuth in 1/100 degrees
+  /// @param corrections The calibration of the point's laser
+  rotation_t computeRotation(uint16_t azimuth, const VelodyneLaserCorrection & corrections) const
+  {
+    return {
+      cos_rot_table_[azimuth] * corrections.cos_rot_correction +
+        sin_rot_table_[azimuth] * corrections.sin_rot_correction,
+      sin_rot_table_[azimuth] * corrections.cos_rot_correction -
+        cos_rot_table_[azimuth] * corrections.sin_rot_correction};
+  }
+
+  /// @brief Precompute the rotation tables for all distinct rotation corrections of the
+  /// calibration. Leaves `rotation_tables_` empty if there are more than MAX_ROTATION_TABLES
+  void initRotationTables()
+  {
+    const auto & laser_corrections =
+      calibration_configuration_->velodyne_calibration.laser_corrections;
+    const size_t n_lasers = std::min<size_t>(SensorT::N_LASERS, laser_corrections.size());
+
+    // The first laser of each table
+    std::vector<size_t> table_lasers;
+    for (size_t laser = 0; laser < n_lasers; ++laser) {
+      const VelodyneLaserCorrection & corrections = laser_corrections[laser];
+      size_t table = 0;
+      while (table < table_lasers.size() &&
+             (laser_corrections[table_lasers[table]].cos_rot_correction !=
+                corrections.cos_rot_correction ||
+              laser_corrections[table_lasers[table]].sin_rot_correction !=
+                corrections.sin_rot_correction)) {
+        ++table;
+      }
+      if (table == table_lasers.size()) {
+        if (table_lasers.size() == SensorT::MAX_ROTATION_TABLES) {
+          return;
+        }
+        table_lasers.push_back(laser);
+      }
+      rotation_table_offsets_[laser] = static_cast<uint32_t>(table * ROTATION_MAX_UNITS);
+    }
+
+    rotation_tables_.resize(table_lasers.size() * ROTATION_MAX_UNITS);
+    for (size_t table = 0; table < table_lasers.size(); ++table) {
+      const VelodyneLaserCorrection & corrections = laser_corrections[table_lasers[table]];
+      for (uint16_t azimuth = 0; azimuth < ROTATION_MAX_UNITS; ++azimuth) {
+        rotation_tables_[table * ROTATION_MAX_UNITS + azimuth] =
+          computeRotation(azimuth, corrections);
+      }
+    }
+  }
+
+  /// @brief Decode the points of one packet
+  /// @tparam DualReturn Whether the packet is in dual return mode, where consecutive blocks hold
+  /// the two returns of the same firing
+  /// @param velodyne_packet The packet
+  /// @param single_return_type The return type of all points in single return mode
+  template <bool DualReturn>
+  void unpackPacket(
+    const velodyne_msgs::msg::VelodynePacket & velodyne_packet, ReturnType single_return_type)
+  {
+    constexpr uint32_t n_blocks =
+      DualReturn ? SensorT::N_DUAL_RETURN_BLOCKS : SensorT::N_SINGLE_RETURN_BLOCKS;
+    // The block holding the next firing sequence
+    constexpr uint32_t next_sequence_offset = DualReturn ? 2 : 1;
+
+    const raw_packet_t * raw = (const raw_packet_t *)&velodyne_packet.data[0];
+    const int64_t packet_timestamp_ns = rclcpp::Time(velodyne_packet.stamp).nanoseconds();
+    const auto & calibration = calibration_configuration_->velodyne_calibration;
+    const float distance_resolution = SensorT::getDistanceResolution(calibration);
+    const rotation_t * rotation_tables =
+      rotation_tables_.empty() ? nullptr : rotation_tables_.data();
+    // The complement of the scan phase, which turns an azimuth into its rotation since the phase
+    const uint32_t scan_phase_complement =
+      ROTATION_MAX_UNITS -
+      static_cast<uint32_t>(std::round(sensor_configuration_->scan_phase * 100)) %
+        ROTATION_MAX_UNITS;
+
+    auto & scan_points = scan_pc_->points;
+    auto & next_scan_points = next_scan_pc_->points;
+    bool scan_in_second_half = scan_in_second_half_;
+    bool crossed_scan_phase = false;
+    // The next scan starts with this packet if none of its points have been decoded yet
+    const int64_t packet_time_in_next_scan_ns =
+      next_scan_timestamp_ns_ < 0 ? 0 : packet_timestamp_ns - next_scan_timestamp_ns_;
+
+    float last_azimuth_diff = 0;
+    uint16_t azimuth_next = 0;
+
+    for (uint32_t block = 0; block < n_blocks; block++) {
+      // Cache block for use.
+      const raw_block_t & current_block = raw->blocks[block];
+      // The block holding the other return of the same firing in dual return mode
+      const raw_block_t & other_block = raw->blocks[block ^ 1];
+
+      const int32_t bank_origin = SensorT::getBankOrigin(current_block.header);
+      if (bank_origin < 0) {
+        break;  // bad packet: skip the rest
+      }
+
+      // Apply timestamp if this is the first new packet in the scan.
+      if (scan_timestamp_ns_ < 0) {
+        scan_timestamp_ns_ = packet_timestamp_ns;
+      }
+      const int64_t packet_time_in_scan_ns = packet_timestamp_ns - scan_timestamp_ns_;
+
+      uint16_t azimuth = current_block.rotation;
+      float azimuth_diff = 0;
+      if constexpr (SensorT::INTERPOLATE_AZIMUTH) {
+        if (block > 0) {
+          azimuth = azimuth_next;
+        }
+        if (block + next_sequence_offset < BLOCKS_PER_PACKET) {
+          // Get the next block rotation to calculate how far we rotate between blocks
+          azimuth_next = raw->blocks[block + next_sequence_offset].rotation;
+
+          // Finds the difference between two successive blocks
+          azimuth_diff = static_cast<float>((36000 + azimuth_next - azimuth) % 36000);
+
+          // This is used when the last block is next to predict rotation amount
+          last_azimuth_diff = azimuth_diff;
+        } else if (block + next_sequence_offset > BLOCKS_PER_PACKET) {
+          // This makes the assumption the difference between the last block and the next packet is
+          // the same as the last to the second to last.
+          // Assumes RPM doesn't change much between blocks.
+          azimuth_diff = last_azimuth_diff;
+        }
+      }
+
+      // Azimuths are below ROTATION_MAX_UNITS in valid blocks, so that the corrected azimuth can be
+      // wrapped by a single subtraction and used as a table index
+      if (azimuth >= ROTATION_MAX_UNITS) {
+        continue;
+      }
+
+      // Cut the scan at the scan phase by the block azimuth, before any point is filtered, so that
+      // scans are completed even if no point near the scan phase is in the field of view or range
+      uint32_t block_phase_rotation = azimuth + scan_phase_complement;
+      if (block_phase_rotation >= ROTATION_MAX_UNITS) {
+        block_phase_rotation -= ROTATION_MAX_UNITS;
+      }
+      const bool block_in_second_half = block_phase_rotation >= ROTATION_MAX_UNITS / 2;
+      crossed_scan_phase |= scan_in_second_half && !block_in_second_half;
+      scan_in_second_half |= block_in_second_half;
+
+      // Condition added to avoid calculating points which are not in the interesting defined area
+      // (cloud_min_angle < area < cloud_max_angle).
+      const bool block_in_field_of_view =
+        (sensor_configuration_->cloud_min_angle < sensor_configuration_->cloud_max_angle &&
+         azimuth >= sensor_configuration_->cloud_min_angle * 100 &&
+         azimuth <= sensor_configuration_->cloud_max_angle * 100) ||
+        (sensor_configuration_->cloud_min_angle > sensor_configuration_->cloud_max_angle);
+      if (!block_in_field_of_view) {
+        continue;
+      }
+
+      for (uint32_t firing = 0; firing < SensorT::FIRINGS_PER_BLOCK; ++firing) {
+        const int32_t * firing_time_offsets_ns =
+          &SensorT::FIRING_TIME_OFFSETS_NS
+             [SensorT::getFiringSequence(block, firing, DualReturn) * SensorT::N_FIRING_GROUPS];
+
+        // With the full calibration model, the distances and coordinates of all lasers of the
+        // firing are computed up front, so that the kernel can vectorize across lasers
+        [[maybe_unused]] two_point_correction::ConvertedFiring<SensorT::LASERS_PER_FIRING>
+          converted_firing;
+        if constexpr (SensorT::FULL_CALIBRATION_MODEL) {
+          for (uint32_t channel = 0; channel < SensorT::LASERS_PER_FIRING; ++channel) {
+            const size_t k = (firing * SensorT::LASERS_PER_FIRING + channel) * RAW_SCAN_SIZE;
+            union two_bytes current_return {
+            };
+            current_return.bytes[0] = current_block.data[k];
+            current_return.bytes[1] = current_block.data[k + 1];
+
+            float distance = current_return.uint * distance_resolution;
+            if (distance > 1e-6) {
+              distance += laser_calibration_.dist_correction[bank_origin + channel];
+            }
+            converted_firing.distance[channel] = distance;
+          }
+          convert_firing_(
+            two_point_correction::make_kernel_args(
+              laser_calibration_, bank_origin, converted_firing, cos_rot_table_[azimuth],
+              sin_rot_table_[azimuth]),
+            0, SensorT::LASERS_PER_FIRING);
+        }
+
+        for (uint32_t channel = 0; channel < SensorT::LASERS_PER_FIRING; ++channel) {
+          const size_t k = (firing * SensorT::LASERS_PER_FIRING + channel) * RAW_SCAN_SIZE;
+
+          union two_bytes current_return {
+          };
+          union two_bytes other_return {
+          };
+          // Distance extraction.
+          current_return.bytes[0] = current_block.data[k];
+          current_return.bytes[1] = current_block.data[k + 1];
+          if constexpr (DualReturn) {
+            other_return.bytes[0] = other_block.data[k];
+            other_return.bytes[1] = other_block.data[k + 1];
+          }
+          // Do not process if there is no return, or in dual return mode and the first and last
+          // echos are the same.
+          if (
+            current_return.uint == 0 ||
+            (DualReturn && block % 2 && other_return.uint == current_return.uint)) {
+            continue;
+          }
+
+          // Offset the laser in this block by which bank it's in
+          const uint32_t laser_number = bank_origin + channel;
+          const VelodyneLaserCorrection & corrections =
+            calibration.laser_corrections[laser_number];
+
+          float distance;
+          if constexpr (SensorT::FULL_CALIBRATION_MODEL) {
+            distance = converted_firing.distance[channel];
+          } else {
+            distance = current_return.uint * distance_resolution;
+            if (distance > 1e-6) {
+              distance += corrections.dist_correction;
+            }
+          }
+
+          if (
+            distance <= sensor_configuration_->min_range ||
+            distance >= sensor_configuration_->max_range) {
+            continue;
+          }
+
+          uint16_t azimuth_corrected = azimuth;
+          if constexpr (SensorT::INTERPOLATE_AZIMUTH) {
+            // Correct for the laser rotation as a function of timing during the firings. The offset
+            // is non-negative and less than a rotation, so rounding to the nearest integer and
+            // wrapping need neither round() nor a modulo
+            const float azimuth_corrected_f =
+              azimuth + SensorT::getAzimuthOffset(azimuth_diff, firing, laser_number);
+            uint32_t azimuth_rounded = static_cast<uint32_t>(azimuth_corrected_f + 0.5f);
+            if (azimuth_rounded >= ROTATION_MAX_UNITS) {
+              azimuth_rounded -= ROTATION_MAX_UNITS;
+            }
+            azimuth_corrected = static_cast<uint16_t>(azimuth_rounded);
+          }
+
+          // Condition added to avoid calculating points which are not in the interesting defined
+          // area (cloud_min_angle < area < cloud_max_angle).
+          if (!isInFieldOfView(azimuth_corrected)) {
+            continue;
+          }
+
+          // Assign the point to its scan by its own azimuth: once the scan has reached its second
+          // half, points in the half rotation following the phase belong to the next scan
+          uint32_t phase_rotation = azimuth_corrected + scan_phase_complement;
+          if (phase_rotation >= ROTATION_MAX_UNITS) {
+            phase_rotation -= ROTATION_MAX_UNITS;
+          }
+          const bool in_second_half = phase_rotation >= ROTATION_MAX_UNITS / 2;
+          scan_in_second_half |= in_second_half;
+          const bool in_next_scan = scan_in_second_half && !in_second_half;
+
+          // Convert polar coordinates to Euclidean XYZ.
+          const float sin_vert_angle = corrections.sin_vert_correction;
+
+          float x_coord, y_coord, z_coord;
+          uint8_t intensity = current_block.data[k + 2];
+          if constexpr (SensorT::FULL_CALIBRATION_MODEL) {
+            x_coord = converted_firing.x[channel];
+            y_coord = converted_firing.y[channel];
+            z_coord = converted_firing.z[channel];
+
+            /** Intensity Calculation */
+            const float min_intensity = corrections.min_intensity;
+            const float max_intensity = corrections.max_intensity;
+            const float focal_offset = 256 * (1 - corrections.focal_distance / 13100) *
+                                       (1 - corrections.focal_distance / 13100);
+            const float focal_slope = corrections.focal_slope;
+            float sqr = (1 - static_cast<float>(current_return.uint) / 65535) *
+                        (1 - static_cast<float>(current_return.uint) / 65535);
+            intensity += focal_slope * (std::abs(focal_offset - 256 * sqr));
+            intensity = (intensity < min_intensity) ? min_intensity : intensity;
+            intensity = (intensity > max_intensity) ? max_intensity : intensity;
+          } else {
+            rotation_t rotation;
+            if (SensorT::PRECOMPUTED_ROTATION_TABLES && rotation_tables) {
+              rotation =
+                rotation_tables[rotation_table_offsets_[laser_number] + azimuth_corrected];
+            } else {
+              rotation = computeRotation(azimuth_corrected, corrections);
+            }
+            const float cos_rot_angle = rotation.cos_rot_angle;
+            const float sin_rot_angle = rotation.sin_rot_angle;
+
+            // Compute the distance in the xy plane (w/o accounting for rotation).
+            const float xy_distance = distance * corrections.cos_vert_correction;
+
+            // Use standard ROS coordinate system (right-hand rule).
+            x_coord = xy_distance * cos_rot_angle;     // velodyne y
+            y_coord = -(xy_distance * sin_rot_angle);  // velodyne x
+            z_coord = distance * sin_vert_angle;       // velodyne z
+          }
+
+          ReturnType return_type = single_return_type;
+          if constexpr (DualReturn) {
+            return_type = getDualReturnType(
+              current_return.uint, other_return.uint, intensity, other_block.data[k + 2]);
+          }
+
+          drivers::NebulaPoint current_point{};
+          current_point.x = x_coord;
+          current_point.y = y_coord;
+          current_point.z = z_coord;
+          current_point.return_type = static_cast<uint8_t>(return_type);
+          current_point.channel = corrections.laser_ring;
+          current_point.azimuth = rotation_radians_[azimuth_corrected];
+          current_point.elevation = sin_vert_angle;
+          current_point.distance = distance;
+          const int64_t point_ts_ns =
+            (in_next_scan ? packet_time_in_next_scan_ns : packet_time_in_scan_ns) +
+            firing_time_offsets_ns[SensorT::getFiringGroup(laser_number)];
+          current_point.time_stamp = static_cast<uint32_t>(std::max<int64_t>(point_ts_ns, 0));
+          current_point.intensity = intensity;
+          (in_next_scan ? next_scan_points : scan_points).emplace_back(current_point);
+        }
+      }
+    }
+
+    scan_in_second_half_ = scan_in_second_half;
+    if (!crossed_scan_phase && next_scan_points.empty()) {
+      return;
+    }
+
+    // The packet crossed the scan phase, so the scan is complete. It is handed out right away, so
+    // that scans do not depend on where the messages are cut
+    next_scan_timestamp_ns_ = next_scan_points.empty() ? -1 : packet_timestamp_ns;
+    completeScan();
+  }
+
+  /// @brief Make the scan being decoded the output scan and continue with the next scan
+  void completeScan()
+  {
+    // The previous output scan might still be in use by whoever called `get_pointcloud()`, so
+    // continue in a cloud that is not referenced anymore instead of clearing it
+    output_pc_ = std::move(scan_pc_);
+    output_timestamp_ns_ = scan_timestamp_ns_;
+    scan_pc_ = std::move(next_scan_pc_);
+    scan_timestamp_ns_ = next_scan_timestamp_ns_;
+    scan_pc_->points.reserve(max_pts_);
+    scan_in_second_half_ = false;
+    // Only the points of the packet crossing the scan phase are written to the next scan
+    next_scan_pc_ = point_cloud_pool_.acquire(pointsPerPacket());
+    next_scan_timestamp_ns_ = -1;
+    has_scanned_ = true;
+  }
+
+  /// @brief Classify a return in dual return mode
+  /// @param distance The return's raw distance
+  /// @param other_distance The raw distance of the other return of the same firing
+  /// @param intensity The return's intensity
+  /// @param other_intensity The raw intensity of the other return of the same firing
+  static ReturnType getDualReturnType(
+    uint16_t distance, uint16_t other_distance, uint8_t intensity, uint8_t other_intensity)
+  {
+    if (other_distance == 0 || other_distance == distance) {
+      return ReturnType::IDENTICAL;
+    }
+
+    const bool first = other_distance >= distance;
+    bool strongest = other_intensity < intensity;
+    if (other_intensity == intensity) {
+      strongest = !first;
+    }
+
+    if (first) {
+      return strongest ? ReturnType::FIRST_STRONGEST : ReturnType::FIRST_WEAK;
+    }
+    return strongest ? ReturnType::LAST_STRONGEST : ReturnType::LAST_WEAK;
+  }
+
+  /// @brief Parsing VelodynePacket based on packet structure
+  /// @param velodyne_packet
+  /// @return Resulting flag
+  bool parsePacket([[maybe_unused]] const velodyne_msgs::msg::VelodynePacket & velodyne_packet)
+    override
+  {
+    return false;
+  }
+
+public:
+  /// @brief Constructor
+  /// @param sensor_configuration SensorConfiguration for this decoder
+  /// @param calibration_configuration Calibration for this decoder
+  explicit VelodyneDecoder(
+    const std::shared_ptr<drivers::VelodyneSensorConfiguration> & sensor_configuration,
+    const std::shared_ptr<drivers::VelodyneCalibrationConfiguration> & calibration_configuration)
+  : convert_firing_(two_point_correction::get_best_kernel())
+  {
+    sensor_configuration_ = sensor_configuration;
+    calibration_configuration_ = calibration_configuration;
+
+    scan_pc_ = point_cloud_pool_.acquire();
+    next_scan_pc_ = point_cloud_pool_.acquire();
+    output_pc_ = point_cloud_pool_.acquire();
+
+    // Set up cached values for sin and cos of all the possible headings
+    for (uint16_t rot_index = 0; rot_index < ROTATION_MAX_UNITS; ++rot_index) {
+      float rotation = angles::from_degrees(ROTATION_RESOLUTION * rot_index);
+      rotation_radians_[rot_index] = rotation;
+      cos_rot_table_[rot_index] = cosf(rotation);
+      sin_rot_table_[rot_index] = sinf(rotation);
+    }
+
+    if constexpr (SensorT::PRECOMPUTED_ROTATION_TABLES) {
+      initRotationTables();
+    }
+
+    if constexpr (SensorT::FULL_CALIBRATION_MODEL) {
+      laser_calibration_ = two_point_correction::pack_calibration<SensorT::N_LASERS>(
+        calibration_configuration_->velodyne_calibration.laser_corrections);
+    }
+  }
+
+  /// @brief Parsing and shaping VelodynePacket
+  /// @param velodyne_packet
+  void unpack(const velodyne_msgs::msg::VelodynePacket & velodyne_packet) override
+  {
+    has_scanned_ = false;
+    switch (velodyne_packet.data[RETURN_MODE_INDEX]) {
+      case RETURN_MODE_DUAL:
+        unpackPacket<true>(velodyne_packet, ReturnType::UNKNOWN);
+        break;
+      case RETURN_MODE_STRONGEST:
+        unpackPacket<false>(velodyne_packet, ReturnType::STRONGEST);
+        break;
+      case RETURN_MODE_LAST:
+        unpackPacket<false>(velodyne_packet, ReturnType::LAST);
+        break;
+      default:
+        unpackPacket<false>(velodyne_packet, ReturnType::UNKNOWN);
+    }
+  }
+
+  /// @brief Get the flag indicating whether one cycle is ready
+  /// @return Readied
+  bool hasScanned() override { return has_scanned_; }
+
+  /// @brief Calculation of points in each packet
+  /// @return # of points
+  int pointsPerPacket() override { return BLOCKS_PER_PACKET * POINTS_PER_BLOCK; }
+
+  /// @brief Get the last completed scan
+  /// @return tuple of Point cloud and timestamp
+  std::tuple<drivers::NebulaPointCloudPtr, double> get_pointcloud() override
+  {
+    if (!output_pc_->points.empty()) {
+      output_pc_->width = output_pc_->points.size();
+      output_pc_->height = 1;
+    }
+    const double scan_timestamp_s =
+      output_timestamp_ns_ < 0 ? -1 : static_cast<double>(output_timestamp_ns_) * 1e-9;
+    return std::make_tuple(output_pc_, scan_timestamp_s);
+  }
+
+  /// @brief Prepare for decoding the packets of a message
+  /// @param n_pts # of packets of the message
+  /// @param time_stamp_ns Timestamp of the first packet of the message in nanoseconds
+  void reset_pointcloud(size_t n_pts, int64_t time_stamp_ns) override
+  {
+    // Detect cases where there is an unacceptable time difference between the last point of the
+    // scan being decoded and the first packet of the message. In that case, there was probably a
+    // packet drop so it is better to ignore the points decoded so far
+    if (
+      !scan_pc_->points.empty() &&
+      time_stamp_ns - (scan_timestamp_ns_ + scan_pc_->points.back().time_stamp) > 50'000'000) {
+      scan_pc_->clear();
+      scan_timestamp_ns_ = -1;
+      scan_in_second_half_ = false;
+    }
+
+    // The hardware interface cuts messages at the packet that crosses the scan phase, so the scan
+    // being decoded usually gets all points of the message. Scans completed in the middle of a
+    // message, e.g. when replaying recordings cut by packet count, are reserved the same way
+    max_pts_ = n_pts * pointsPerPacket();
+    scan_pc_->points.reserve(max_pts_);
+  }
+};
+
+}  // namespace drivers
+}  // namespace nebula
@@ -15,6 +15,7 @@
 #include "nebula_common/point_types.hpp"
 #include "nebula_common/velodyne/velodyne_calibration_decoder.hpp"
 #include "nebula_common/velodyne/velodyne_common.hpp"
+#include "nebula_decoders/nebula_decoders_common/point_cloud_pool.hpp"
 
 #include <velodyne_msgs/msg/velodyne_packet.hpp>
 #include <velodyne_msgs/msg/velodyne_scan.hpp>
@@ -133,17 +134,31 @@ enum RETURN_TYPE {
 class VelodyneScanDecoder
 {
 protected:
-  /// @brief Decoded point cloud
+  /// @brief The point clouds that scan_pc_ is taken from. A cloud is only reused once all
+  /// references handed out by `get_pointcloud()` have been dropped
+  PointCloudPool point_cloud_pool_;
+  /// @brief The scan being decoded
   drivers::NebulaPointCloudPtr scan_pc_;
-  /// @brief Point cloud overflowing from one cycle
-  drivers::NebulaPointCloudPtr overflow_pc_;
+  /// @brief Points of the next scan, i.e. past the scan phase, decoded from the packet that
+  /// completes the current scan
+  drivers::NebulaPointCloudPtr next_scan_pc_;
+  /// @brief The last completed scan, returned by `get_pointcloud()`
+  drivers::NebulaPointCloudPtr output_pc_;
 
   uint16_t scan_phase_{};
   uint16_t last_phase_{};
-  bool has_scanned_ = true;
+  /// @brief Whether the last unpacked packet completed a scan
+  bool has_scanned_ = false;
   double dual_return_distance_threshold_{};  // Velodyne does this internally, this will not be
                                              // implemented here
-  double scan_timestamp_{};
+  /// @brief Timestamp of the scan being decoded in nanoseconds, or -1 if no packet of it has been
+  /// decoded yet
+  int64_t scan_timestamp_ns_{-1};
+  /// @brief Timestamp of the next scan in nanoseconds, i.e. that of the packet its first point was
+  /// decoded from, or -1 if `next_scan_pc_` is empty
+  int64_t next_scan_timestamp_ns_{-1};
+  /// @brief Timestamp of the last completed scan in nanoseconds, or -1 if it is empty
+  int64_t output_timestamp_ns_{-1};
 
   /// @brief SensorConfiguration for this decoder
   std::shared_ptr<drivers::VelodyneSensorConfiguration> sensor_configuration_;
@@ -167,21 +182,21 @@ public:
   /// @return Resulting flag
   virtual bool parsePacket(const velodyne_msgs::msg::VelodynePacket & velodyne_packet) = 0;
 
-  /// @brief Virtual function for getting the flag indicating whether one cycle is ready
+  /// @brief Virtual function for getting the flag indicating whether the last unpacked packet
+  /// completed a scan
   /// @return Readied
   virtual bool hasScanned() = 0;
   /// @brief Calculation of points in each packet
   /// @return # of points
   virtual int pointsPerPacket() = 0;
 
-  /// @brief Virtual function for getting the constructed point cloud
+  /// @brief Virtual function for getting the last completed scan
   /// @return tuple of Point cloud and timestamp
   virtual std::tuple<drivers::NebulaPointCloudPtr, double> get_pointcloud() = 0;
-  /// @brief Resetting point cloud buffer
-  /// @param n_pts # of points
-  virtual void reset_pointcloud(size_t n_pts, double time_stamp) = 0;
-  /// @brief Resetting overflowed point cloud buffer
-  virtual void reset_overflow(double time_stamp) = 0;
+  /// @brief Prepare for decoding the packets of a message, continuing the scan being decoded
+  /// @param n_pts # of packets of the message
+  /// @param time_stamp_ns Timestamp of the first packet of the message in nanoseconds
+  virtual void reset_pointcloud(size_t n_pts, int64_t time_stamp_ns) = 0;
 };
 
 }  // namespace drivers
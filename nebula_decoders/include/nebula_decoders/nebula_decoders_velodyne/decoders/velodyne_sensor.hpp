@@ -0,0 +1,94 @@
+#pragma once
+
+#include "nebula_common/velodyne/velodyne_calibration_decoder.hpp"
+#include "nebula_decoders/nebula_decoders_velodyne/decoders/velodyne_scan_decoder.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief Build the flat table of the time offsets of all firing groups of all firing sequences of
+/// a packet, indexed by `sequence * NFiringGroups + firing_group`
+/// @tparam NSequences The number of firing sequences in a packet
+/// @tparam NFiringGroups The number of firing groups (lasers firing at the same time) in a
+/// sequence, including any idle periods
+/// @param sequence_duration_ns The time between two firing sequences in nanoseconds
+/// @param firing_group_duration_ns The time between two firing groups in nanoseconds
+/// @param packet_offset_ns The time of the first firing group relative to the packet timestamp in
+/// nanoseconds
+/// @return The time offset of each firing group relative to the packet timestamp in nanoseconds
+template <size_t NSequences, size_t NFiringGroups>
+constexpr std::array<int32_t, NSequences * NFiringGroups> makeFiringTimeOffsets(
+  int32_t sequence_duration_ns, int32_t firing_group_duration_ns, int32_t packet_offset_ns = 0)
+{
+  std::array<int32_t, NSequences * NFiringGroups> offsets{};
+  for (size_t sequence = 0; sequence < NSequences; ++sequence) {
+    for (size_t firing_group = 0; firing_group < NFiringGroups; ++firing_group) {
+      offsets[sequence * NFiringGroups + firing_group] =
+        static_cast<int32_t>(sequence) * sequence_duration_ns +
+        static_cast<int32_t>(firing_group) * firing_group_duration_ns + packet_offset_ns;
+    }
+  }
+  return offsets;
+}
+
+/// @brief Base class for all sensor definitions of `VelodyneDecoder`. Everything is static and
+/// resolved at compile time: sensors shadow the defaults below that do not apply to them.
+///
+/// All sensors share the `raw_packet_t` layout of BLOCKS_PER_PACKET blocks of SCANS_PER_BLOCK
+/// returns. A block holds FIRINGS_PER_BLOCK firings of LASERS_PER_FIRING lasers each, fired by the
+/// bank of lasers given by the block header. Besides the defaults, each sensor defines:
+/// - `N_LASERS`, the number of laser IDs its packets address
+/// - `int32_t getBankOrigin(uint16_t block_header)`, the ID of the first laser of the bank that
+///   fired the block, or -1 if the header is invalid, which drops the rest of the packet
+/// - `float getAzimuthOffset(float azimuth_diff, uint32_t firing, uint32_t laser)`, the rotation in
+///   1/100 degrees between the block's azimuth and the given firing of the given laser, with
+///   `azimuth_diff` being the rotation until the next firing sequence. Only used if
+///   INTERPOLATE_AZIMUTH
+/// - `FIRING_TIME_OFFSETS_NS`, the time of each firing group of each firing sequence relative to
+///   the packet timestamp in nanoseconds, built with `makeFiringTimeOffsets` from the timing tables
+///   of the sensor's manual, and `N_FIRING_GROUPS`, its number of firing groups per sequence
+/// - `uint32_t getFiringSequence(uint32_t block, uint32_t firing, bool dual)`, the index of the
+///   firing sequence of the given firing of the given block
+/// - `uint32_t getFiringGroup(uint32_t laser)`, the index of the firing group of the given laser
+///   within its sequence
+class VelodyneSensor
+{
+public:
+  /// @brief The number of firings per block
+  static constexpr uint32_t FIRINGS_PER_BLOCK = 1;
+  /// @brief The number of lasers per firing
+  static constexpr uint32_t LASERS_PER_FIRING = SCANS_PER_BLOCK;
+  /// @brief The number of blocks holding returns in single return mode
+  static constexpr uint32_t N_SINGLE_RETURN_BLOCKS = BLOCKS_PER_PACKET;
+  /// @brief The number of blocks holding returns in dual return mode. Both returns of a firing are
+  /// in consecutive blocks
+  static constexpr uint32_t N_DUAL_RETURN_BLOCKS = BLOCKS_PER_PACKET;
+  /// @brief Whether the azimuth of each point is interpolated from the rotation between its block
+  /// and the next firing sequence. Otherwise, all points of a block have the block's azimuth
+  static constexpr bool INTERPOLATE_AZIMUTH = true;
+  /// @brief Whether to apply the offset, two-point distance and intensity corrections of the
+  /// calibration file, or only its distance and angle corrections
+  static constexpr bool FULL_CALIBRATION_MODEL = false;
+  /// @brief Whether to look up the rotation of each point, corrected by its laser's rotation
+  /// correction, in tables precomputed from the calibration instead of computing it per point.
+  /// Lasers with identical rotation corrections share a table
+  static constexpr bool PRECOMPUTED_ROTATION_TABLES = false;
+  /// @brief The maximum number of rotation tables (288 kB each) to precompute. If the calibration
+  /// has more distinct rotation corrections, the rotation is computed per point
+  static constexpr size_t MAX_ROTATION_TABLES = 8;
+
+  /// @brief The distance represented by one unit of a return's distance field in meters
+  static float getDistanceResolution(const VelodyneCalibration & calibration)
+  {
+    return calibration.distance_resolution_m;
+  }
+};
+
+}  // namespace drivers
+}  // namespace nebula
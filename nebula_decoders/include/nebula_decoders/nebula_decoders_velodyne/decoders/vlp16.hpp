@@ -0,0 +1,47 @@
+#pragma once
+
+#include "nebula_decoders/nebula_decoders_velodyne/decoders/velodyne_sensor.hpp"
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief VLP-16: each block holds two firings of all 16 lasers
+class Vlp16 : public VelodyneSensor
+{
+public:
+  static constexpr uint32_t N_LASERS = 16;
+  static constexpr uint32_t FIRINGS_PER_BLOCK = VLP16_FIRINGS_PER_BLOCK;
+  static constexpr uint32_t LASERS_PER_FIRING = VLP16_SCANS_PER_FIRING;
+  static constexpr bool PRECOMPUTED_ROTATION_TABLES = true;
+
+  static int32_t getBankOrigin(uint16_t block_header)
+  {
+    return block_header == UPPER_BANK ? 0 : -1;
+  }
+
+  static float getAzimuthOffset(float azimuth_diff, uint32_t firing, uint32_t laser)
+  {
+    return azimuth_diff * ((laser * VLP16_DSR_TOFFSET) + (firing * VLP16_FIRING_TOFFSET)) /
+           VLP16_BLOCK_DURATION;
+  }
+
+  static constexpr uint32_t N_FIRING_GROUPS = 16;
+
+  // Timing from the velodyne user manual p.64: 55.296 us firing cycles of 16 2.304 us firings
+  static constexpr auto FIRING_TIME_OFFSETS_NS =
+    makeFiringTimeOffsets<BLOCKS_PER_PACKET * VLP16_FIRINGS_PER_BLOCK, N_FIRING_GROUPS>(
+      55'296, 2'304);
+
+  static uint32_t getFiringSequence(uint32_t block, uint32_t firing, bool dual_return)
+  {
+    // In dual return mode, both blocks of a pair hold the returns of the same two firings
+    return dual_return ? (block - (block % 2)) + firing : (block * 2) + firing;
+  }
+
+  static uint32_t getFiringGroup(uint32_t laser) { return laser; }
+};
+
+}  // namespace drivers
+}  // namespace nebula
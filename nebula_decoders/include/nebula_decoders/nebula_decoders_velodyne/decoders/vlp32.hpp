@@ -0,0 +1,43 @@
+#pragma once
+
+#include "nebula_decoders/nebula_decoders_velodyne/decoders/velodyne_sensor.hpp"
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief VLP-32, also used for the HDL-32 and HDL-64, which share its packet layout and whose
+/// calibration files have offset and two-point distance corrections. Blocks hold one firing of
+/// the upper or lower bank of 32 lasers
+class Vlp32 : public VelodyneSensor
+{
+public:
+  static constexpr uint32_t N_LASERS = 2 * SCANS_PER_BLOCK;
+  static constexpr bool INTERPOLATE_AZIMUTH = false;
+  static constexpr bool FULL_CALIBRATION_MODEL = true;
+
+  static int32_t getBankOrigin(uint16_t block_header)
+  {
+    // Lower bank lasers are [32..63]
+    return block_header == LOWER_BANK ? 32 : 0;
+  }
+
+  static constexpr uint32_t N_FIRING_GROUPS = SCANS_PER_BLOCK / 2;
+
+  // 55.296 us firing cycles of 16 2.304 us firings
+  static constexpr auto FIRING_TIME_OFFSETS_NS =
+    makeFiringTimeOffsets<BLOCKS_PER_PACKET, N_FIRING_GROUPS>(55'296, 2'304);
+
+  static uint32_t getFiringSequence(
+    uint32_t block, [[maybe_unused]] uint32_t firing, bool dual_return)
+  {
+    return dual_return ? block / 2 : block;
+  }
+
+  // Lasers fire in pairs
+  static uint32_t getFiringGroup(uint32_t laser) { return (laser % SCANS_PER_BLOCK) / 2; }
+};
+
+}  // namespace drivers
+}  // namespace nebula
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "nebula_decoders/nebula_decoders_velodyne/decoders/velodyne_sensor.hpp"
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief VLS-128: blocks hold one firing of one of four banks of 32 lasers, fired 8 at a time.
+/// In dual return mode, only the first 8 blocks hold returns
+class Vls128 : public VelodyneSensor
+{
+public:
+  static constexpr uint32_t N_LASERS = 4 * SCANS_PER_BLOCK;
+  static constexpr uint32_t N_DUAL_RETURN_BLOCKS = BLOCKS_PER_PACKET - 4;
+  static constexpr bool PRECOMPUTED_ROTATION_TABLES = true;
+
+  static float getDistanceResolution([[maybe_unused]] const VelodyneCalibration & calibration)
+  {
+    return VLP128_DISTANCE_RESOLUTION;
+  }
+
+  static int32_t getBankOrigin(uint16_t block_header)
+  {
+    switch (block_header) {
+      case VLS128_BANK_1:
+        return 0;
+      case VLS128_BANK_2:
+        return 32;
+      case VLS128_BANK_3:
+        return 64;
+      case VLS128_BANK_4:
+        return 96;
+      default:
+        return -1;
+    }
+  }
+
+  static float getAzimuthOffset(
+    float azimuth_diff, [[maybe_unused]] uint32_t firing, uint32_t laser)
+  {
+    // A recharge period follows the 8th firing group of a sequence
+    const uint32_t firing_group = laser / 8;
+    return azimuth_diff * ((VLS128_CHANNEL_DURATION / VLS128_SEQ_DURATION) *
+                           (firing_group + firing_group / 8));
+  }
+
+  /// @brief 16 firing groups of 8 lasers, plus the maintenance time after firing group 8
+  static constexpr uint32_t N_FIRING_GROUPS = 17;
+
+  // Timing from the velodyne user manual p.64: 53.3 us firing sequences of 2.665 us firing groups,
+  // the first firing 8.7 us before the packet timestamp
+  static constexpr auto FIRING_TIME_OFFSETS_NS =
+    makeFiringTimeOffsets<BLOCKS_PER_PACKET / 4, N_FIRING_GROUPS>(53'300, 2'665, -8'700);
+
+  static uint32_t getFiringSequence(
+    uint32_t block, [[maybe_unused]] uint32_t firing, [[maybe_unused]] bool dual_return)
+  {
+    return block / 4;
+  }
+
+  // +1 for the maintenance time after firing group 8
+  static uint32_t getFiringGroup(uint32_t laser) { return laser / 8 + laser / 64; }
+};
+
+}  // namespace drivers
+}  // namespace nebula
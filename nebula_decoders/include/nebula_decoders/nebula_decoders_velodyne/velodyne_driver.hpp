@@ -51,7 +51,8 @@ public:
 
   /// @brief Convert VelodyneScan message to point cloud
   /// @param velodyne_scan Message
-  /// @return tuple of Point cloud and timestamp
+  /// @return tuple of the last scan completed by the message and its timestamp. The point cloud is
+  /// null if the message did not cross the scan phase
   std::tuple<drivers::NebulaPointCloudPtr, double> ConvertScanToPointcloud(
     const std::shared_ptr<velodyne_msgs::msg::VelodyneScan> & velodyne_scan);
 };
@@ -24,6 +24,8 @@ HesaiDriver::HesaiDriver(
 {
   // initialize proper parser from cloud config's model and echo mode
   driver_status_ = nebula::Status::OK;
+  parallel_decode_ = sensor_configuration->decode_threads > 1;
+  scan_tracer_ = ScanLatencyTracer::forSensor(sensor_configuration->frame_id);
   switch (sensor_configuration->sensor_model) {
     case SensorModel::UNKNOWN:
       driver_status_ = nebula::Status::INVALID_SENSOR_MODEL;
@@ -72,35 +74,98 @@ HesaiDriver::HesaiDriver(
   }
 }
 
-std::tuple<drivers::NebulaPointCloudPtr, double> HesaiDriver::ConvertScanToPointcloud(
-  const std::shared_ptr<pandar_msgs::msg::PandarScan> & pandar_scan)
+template <typename ScanMsgT>
+std::tuple<drivers::NebulaPointCloudPtr, double> HesaiDriver::ConvertScanMsg(
+  const ScanMsgT & scan_msg)
 {
   std::tuple<drivers::NebulaPointCloudPtr, double> pointcloud;
-  auto logger = rclcpp::get_logger("HesaiDriver");
 
+  // The logger is only looked up on errors as doing so allocates
   if (driver_status_ != nebula::Status::OK) {
-    RCLCPP_ERROR(logger, "Driver not OK.");
+    RCLCPP_ERROR(rclcpp::get_logger("HesaiDriver"), "Driver not OK.");
     return pointcloud;
   }
 
+  const uint64_t scan_id = ScanIdFromStamp(scan_msg.header.stamp);
+  scan_tracer_->record(ScanStage::DECODE_STARTED, scan_id);
+
   int cnt = 0, last_azimuth = 0;
-  for (auto & packet : pandar_scan->packets) {
-    last_azimuth = scan_decoder_->unpack(packet);
+  if (parallel_decode_) {
+    last_azimuth = scan_decoder_->unpackScan(scan_msg);
     if (scan_decoder_->hasScanned()) {
       pointcloud = scan_decoder_->getPointcloud();
       cnt++;
     }
+  } else {
+    for (auto & packet : scan_msg.packets) {
+      last_azimuth = scan_decoder_->unpack(packet);
+      if (scan_decoder_->hasScanned()) {
+        pointcloud = scan_decoder_->getPointcloud();
+        cnt++;
+      }
+    }
   }
+  scan_tracer_->record(ScanStage::DECODE_FINISHED, scan_id);
 
   if (cnt == 0) {
     RCLCPP_ERROR_STREAM(
-      logger, "Scanned " << pandar_scan->packets.size() << " packets, but no "
-                         << "pointclouds were generated. Last azimuth: " << last_azimuth);
+      rclcpp::get_logger("HesaiDriver"), "Scanned " << scan_msg.packets.size()
+                                << " packets, but no pointclouds were generated. Last azimuth: "
+                                << last_azimuth);
   }
 
   return pointcloud;
 }
 
+template <typename PacketMsgT>
+std::tuple<drivers::NebulaPointCloudPtr, double> HesaiDriver::ParsePacketMsg(
+  const PacketMsgT & packet_msg)
+{
+  std::tuple<drivers::NebulaPointCloudPtr, double> pointcloud;
+
+  if (driver_status_ != nebula::Status::OK) {
+    RCLCPP_ERROR(rclcpp::get_logger("HesaiDriver"), "Driver not OK.");
+    return pointcloud;
+  }
+
+  scan_decoder_->unpack(packet_msg);
+  if (scan_decoder_->hasScanned()) {
+    pointcloud = scan_decoder_->getPointcloud();
+  }
+
+  return pointcloud;
+}
+
+std::tuple<drivers::NebulaPointCloudPtr, double> HesaiDriver::ConvertScanToPointcloud(
+  const std::shared_ptr<pandar_msgs::msg::PandarScan> & pandar_scan)
+{
+  return ConvertScanMsg(*pandar_scan);
+}
+
+std::tuple<drivers::NebulaPointCloudPtr, double> HesaiDriver::ConvertScanToPointcloud(
+  const std::shared_ptr<nebula_msgs::msg::NebulaPackets> & nebula_packets)
+{
+  return ConvertScanMsg(*nebula_packets);
+}
+
+std::tuple<drivers::NebulaPointCloudPtr, double> HesaiDriver::ParseCloudPacket(
+  const pandar_msgs::msg::PandarPacket & pandar_packet)
+{
+  return ParsePacketMsg(pandar_packet);
+}
+
+std::tuple<drivers::NebulaPointCloudPtr, double> HesaiDriver::ParseCloudPacket(
+  const nebula_msgs::msg::NebulaPacket & nebula_packet)
+{
+  return ParsePacketMsg(nebula_packet);
+}
+
+const ScanCompleteness & HesaiDriver::GetScanCompleteness()
+{
+  static const ScanCompleteness no_scan{};
+  return scan_decoder_ ? scan_decoder_->getScanCompleteness() : no_scan;
+}
+
 Status HesaiDriver::SetCalibrationConfiguration(
   const CalibrationConfigurationBase & calibration_configuration)
 {
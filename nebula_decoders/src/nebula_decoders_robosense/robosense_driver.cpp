@@ -50,14 +50,20 @@ Status RobosenseDriver::SetCalibrationConfiguration(
     calibration_configuration.calibration_file + ")");
 }
 
+const ScanCompleteness & RobosenseDriver::GetScanCompleteness()
+{
+  static const ScanCompleteness no_scan{};
+  return scan_decoder_ ? scan_decoder_->getScanCompleteness() : no_scan;
+}
+
 std::tuple<drivers::NebulaPointCloudPtr, double> RobosenseDriver::ConvertScanToPointcloud(
   const std::shared_ptr<robosense_msgs::msg::RobosenseScan> & robosense_scan)
 {
   std::tuple<drivers::NebulaPointCloudPtr, double> pointcloud;
-  auto logger = rclcpp::get_logger("RobosenseDriver");
 
+  // The logger is only looked up on errors as doing so allocates
   if (driver_status_ != nebula::Status::OK) {
-    RCLCPP_ERROR(logger, "Driver not OK.");
+    RCLCPP_ERROR(rclcpp::get_logger("RobosenseDriver"), "Driver not OK.");
     return pointcloud;
   }
 
@@ -72,8 +78,9 @@ std::tuple<drivers::NebulaPointCloudPtr, double> RobosenseDriver::ConvertScanToP
 
   if (cnt == 0) {
     RCLCPP_ERROR_STREAM(
-      logger, "Scanned " << robosense_scan->packets.size() << " packets, but no "
-                         << "pointclouds were generated. Last azimuth: " << last_azimuth);
+      rclcpp::get_logger("RobosenseDriver"), "Scanned " << robosense_scan->packets.size()
+                                << " packets, but no pointclouds were generated. Last azimuth: "
+                                << last_azimuth);
   }
 
   return pointcloud;
@@ -1,8 +1,9 @@
 #include "nebula_decoders/nebula_decoders_velodyne/velodyne_driver.hpp"
 
-#include "nebula_decoders/nebula_decoders_velodyne/decoders/vlp16_decoder.hpp"
-#include "nebula_decoders/nebula_decoders_velodyne/decoders/vlp32_decoder.hpp"
-#include "nebula_decoders/nebula_decoders_velodyne/decoders/vls128_decoder.hpp"
+#include "nebula_decoders/nebula_decoders_velodyne/decoders/velodyne_decoder.hpp"
+#include "nebula_decoders/nebula_decoders_velodyne/decoders/vlp16.hpp"
+#include "nebula_decoders/nebula_decoders_velodyne/decoders/vlp32.hpp"
+#include "nebula_decoders/nebula_decoders_velodyne/decoders/vls128.hpp"
 
 namespace nebula
 {
@@ -20,17 +21,17 @@ VelodyneDriver::VelodyneDriver(
       break;
     case SensorModel::VELODYNE_VLS128:
       scan_decoder_.reset(
-        new drivers::vls128::Vls128Decoder(sensor_configuration, calibration_configuration));
+        new VelodyneDecoder<Vls128>(sensor_configuration, calibration_configuration));
       break;
     case SensorModel::VELODYNE_VLP32:
     case SensorModel::VELODYNE_HDL64:
     case SensorModel::VELODYNE_HDL32:
       scan_decoder_.reset(
-        new drivers::vlp32::Vlp32Decoder(sensor_configuration, calibration_configuration));
+        new VelodyneDecoder<Vlp32>(sensor_configuration, calibration_configuration));
       break;
     case SensorModel::VELODYNE_VLP16:
       scan_decoder_.reset(
-        new drivers::vlp16::Vlp16Decoder(sensor_configuration, calibration_configuration));
+        new VelodyneDecoder<Vlp16>(sensor_configuration, calibration_configuration));
       break;
     default:
       driver_status_ = nebula::Status::INVALID_SENSOR_MODEL;
@@ -52,11 +53,16 @@ std::tuple<drivers::NebulaPointCloudPtr, double> VelodyneDriver::ConvertScanToPo
   std::tuple<drivers::NebulaPointCloudPtr, double> pointcloud;
   if (driver_status_ == nebula::Status::OK) {
     scan_decoder_->reset_pointcloud(
-      velodyne_scan->packets.size(), rclcpp::Time(velodyne_scan->packets.front().stamp).seconds());
+      velodyne_scan->packets.size(),
+      rclcpp::Time(velodyne_scan->packets.front().stamp).nanoseconds());
+    // A scan is completed by the packet crossing the scan phase, which need not be the last packet
+    // of the message. If a message completes several scans, only the last one is returned
     for (auto & packet : velodyne_scan->packets) {
       scan_decoder_->unpack(packet);
+      if (scan_decoder_->hasScanned()) {
+        pointcloud = scan_decoder_->get_pointcloud();
+      }
     }
-    pointcloud = scan_decoder_->get_pointcloud();
   } else {
     std::cout << "not ok driver_status_ = " << driver_status_ << std::endl;
   }
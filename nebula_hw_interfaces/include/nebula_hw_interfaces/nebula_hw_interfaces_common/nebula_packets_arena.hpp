@@ -0,0 +1,149 @@
+#ifndef NEBULA_PACKETS_ARENA_H
+#define NEBULA_PACKETS_ARENA_H
+
+#include "nebula_msgs/msg/nebula_packet.hpp"
+#include "nebula_msgs/msg/nebula_packets.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief Recycles NebulaPackets scans and the data buffers of their packets.
+///
+/// Each packet's data is exactly as long as the datagram it was copied from, so serializing a scan
+/// does not carry any padding. Scans are reserved for the number of packets expected per scan,
+/// which is learned from the largest scan completed so far, so that the packet vector does not
+/// grow while a scan is assembled.
+///
+/// Scans that are handed back with `recycle` keep their capacity, and the data buffers of their
+/// packets are reused for later packets. Once every scan is recycled, assembling scans does not
+/// allocate anymore. Scans that are not recycled, e.g. because they were published by
+/// `std::unique_ptr`, are simply freed by their owner.
+class NebulaPacketsArena
+{
+public:
+  /// @brief Constructor
+  /// @param max_packet_size The capacity that new packet data buffers are reserved for
+  /// @param max_free_scans The number of recycled scans kept for reuse
+  explicit NebulaPacketsArena(size_t max_packet_size, size_t max_free_scans = 2)
+  : max_packet_size_(max_packet_size), max_free_scans_(max_free_scans)
+  {
+  }
+
+  NebulaPacketsArena(const NebulaPacketsArena &) = delete;
+  NebulaPacketsArena & operator=(const NebulaPacketsArena &) = delete;
+
+  /// @brief Get an empty scan, reserved for the expected number of packets
+  /// @return The scan, recycled if possible
+  std::unique_ptr<nebula_msgs::msg::NebulaPackets> acquireScan()
+  {
+    std::unique_ptr<nebula_msgs::msg::NebulaPackets> scan;
+    size_t expected_packets_per_scan;
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      expected_packets_per_scan = expected_packets_per_scan_;
+      if (!free_scans_.empty()) {
+        scan = std::move(free_scans_.back());
+        free_scans_.pop_back();
+      }
+    }
+
+    if (!scan) {
+      scan = std::make_unique<nebula_msgs::msg::NebulaPackets>();
+    }
+    scan->packets.reserve(expected_packets_per_scan);
+    return scan;
+  }
+
+  /// @brief Append a copy of a packet to a scan, reusing a recycled data buffer if possible
+  /// @param scan The scan to append to
+  /// @param data The packet data
+  /// @param size The packet size in bytes
+  /// @return The appended packet, its stamp is left for the caller to fill
+  nebula_msgs::msg::NebulaPacket & append(
+    nebula_msgs::msg::NebulaPackets & scan, const uint8_t * data, size_t size)
+  {
+    scan.packets.emplace_back();
+    auto & packet = scan.packets.back();
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (!free_buffers_.empty()) {
+        packet.data = std::move(free_buffers_.back());
+        free_buffers_.pop_back();
+      }
+    }
+
+    if (packet.data.capacity() < size) {
+      packet.data.reserve(std::max(size, max_packet_size_));
+    }
+    packet.data.assign(data, data + size);
+    return packet;
+  }
+
+  /// @brief Note that a scan has been completed, so that later scans are reserved for at least as
+  /// many packets
+  /// @param scan The completed scan
+  void completeScan(const nebula_msgs::msg::NebulaPackets & scan)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    expected_packets_per_scan_ = std::max(expected_packets_per_scan_, scan.packets.size());
+  }
+
+  /// @brief Hand back a scan that is not needed anymore. Its packet buffers and the scan itself
+  /// are reused by later calls to `append` and `acquireScan`
+  /// @param scan The scan to recycle
+  void recycle(std::unique_ptr<nebula_msgs::msg::NebulaPackets> scan)
+  {
+    if (!scan) {
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    // Keep at most enough buffers for two scans, so that a single huge scan does not pin memory
+    const size_t max_free_buffers = 2 * std::max<size_t>(expected_packets_per_scan_, 1);
+    if (free_buffers_.capacity() < max_free_buffers) {
+      free_buffers_.reserve(max_free_buffers);
+    }
+    for (auto & packet : scan->packets) {
+      if (free_buffers_.size() == max_free_buffers) {
+        break;
+      }
+      free_buffers_.emplace_back(std::move(packet.data));
+    }
+
+    if (free_scans_.size() < max_free_scans_) {
+      scan->packets.clear();
+      free_scans_.emplace_back(std::move(scan));
+    }
+  }
+
+  /// @brief The number of packets new scans are reserved for
+  size_t expectedPacketsPerScan() const
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return expected_packets_per_scan_;
+  }
+
+private:
+  size_t max_packet_size_;
+  size_t max_free_scans_;
+  size_t expected_packets_per_scan_{0};
+
+  mutable std::mutex mutex_;
+  std::vector<std::unique_ptr<nebula_msgs::msg::NebulaPackets>> free_scans_;
+  std::vector<std::vector<uint8_t>> free_buffers_;
+};
+
+}  // namespace drivers
+}  // namespace nebula
+
+#endif  // NEBULA_PACKETS_ARENA_H
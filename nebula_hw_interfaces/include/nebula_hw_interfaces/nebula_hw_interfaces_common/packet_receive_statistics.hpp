@@ -0,0 +1,102 @@
+#ifndef NEBULA_PACKET_RECEIVE_STATISTICS_H
+#define NEBULA_PACKET_RECEIVE_STATISTICS_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief Accumulates statistics about received packets on the receiver thread, until they are
+/// collected, e.g. by a diagnostics task on another thread
+class PacketReceiveStatistics
+{
+public:
+  /// @brief The statistics accumulated between two calls to `collect`
+  struct Summary
+  {
+    /// @brief The number of packets that had a kernel receive timestamp
+    uint64_t n_timestamped_packets{0};
+    /// @brief The mean time between the kernel receiving a packet and the driver processing it
+    std::chrono::nanoseconds mean_queueing_delay{0};
+    /// @brief The maximum time between the kernel receiving a packet and the driver processing it
+    std::chrono::nanoseconds max_queueing_delay{0};
+    /// @brief The number of packets dropped because the packet ring was full
+    uint64_t n_dropped_packets{0};
+    /// @brief The number of packets the kernel dropped because the socket buffer was full
+    uint64_t n_kernel_dropped_packets{0};
+  };
+
+  /// @brief Get the time to stamp a packet with, and record its queueing delay if the kernel
+  /// timestamped it
+  /// @param kernel_receive_time_ns The time the kernel received the packet in nanoseconds since the
+  /// epoch, or 0 if unknown
+  /// @return The kernel receive time if known, otherwise the current time
+  std::chrono::system_clock::time_point stampPacket(uint64_t kernel_receive_time_ns)
+  {
+    const auto now = std::chrono::system_clock::now();
+    if (kernel_receive_time_ns == 0) {
+      return now;
+    }
+
+    const std::chrono::system_clock::time_point receive_time(
+      std::chrono::duration_cast<std::chrono::system_clock::duration>(
+        std::chrono::nanoseconds(kernel_receive_time_ns)));
+    addQueueingDelay(now - receive_time);
+    return receive_time;
+  }
+
+  /// @brief Record the queueing delay of a packet
+  /// @param delay The time between the kernel receiving the packet and the driver processing it
+  void addQueueingDelay(std::chrono::nanoseconds delay)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    n_timestamped_packets_++;
+    queueing_delay_sum_ += delay;
+    max_queueing_delay_ = std::max(max_queueing_delay_, delay);
+  }
+
+  /// @brief Update the number of packets the kernel dropped on the receiving socket
+  /// @param total_kernel_drops The total number of drops since the socket was opened
+  void setKernelDrops(uint64_t total_kernel_drops)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    total_kernel_drops_ = total_kernel_drops;
+  }
+
+  /// @brief Get the statistics accumulated since the last call and reset them
+  Summary collect()
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    Summary summary;
+    summary.n_timestamped_packets = n_timestamped_packets_;
+    if (n_timestamped_packets_ > 0) {
+      summary.mean_queueing_delay = queueing_delay_sum_ / n_timestamped_packets_;
+    }
+    summary.max_queueing_delay = max_queueing_delay_;
+    summary.n_kernel_dropped_packets = total_kernel_drops_ - reported_kernel_drops_;
+
+    n_timestamped_packets_ = 0;
+    queueing_delay_sum_ = std::chrono::nanoseconds::zero();
+    max_queueing_delay_ = std::chrono::nanoseconds::zero();
+    reported_kernel_drops_ = total_kernel_drops_;
+    return summary;
+  }
+
+private:
+  std::mutex mutex_;
+  uint64_t n_timestamped_packets_{0};
+  std::chrono::nanoseconds queueing_delay_sum_{0};
+  std::chrono::nanoseconds max_queueing_delay_{0};
+  uint64_t total_kernel_drops_{0};
+  uint64_t reported_kernel_drops_{0};
+};
+
+}  // namespace drivers
+}  // namespace nebula
+
+#endif  // NEBULA_PACKET_RECEIVE_STATISTICS_H
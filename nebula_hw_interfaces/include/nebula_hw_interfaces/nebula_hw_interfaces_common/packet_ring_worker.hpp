@@ -0,0 +1,87 @@
+#ifndef NEBULA_PACKET_RING_WORKER_H
+#define NEBULA_PACKET_RING_WORKER_H
+
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/spsc_packet_ring.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief Decouples packet reception from scan assembly: the receive thread pushes packets into an
+/// SpscPacketRing and a dedicated thread drains it. Pushing never blocks, so a slow consumer leads
+/// to counted drops according to the overflow policy instead of a backed up socket.
+class PacketRingWorker
+{
+public:
+  /// @brief Called on the worker thread for every packet, in the order they were pushed
+  typedef std::function<void(const uint8_t * data, size_t size, uint64_t receive_time_ns)>
+    PacketCallback;
+
+  /// @brief Constructor
+  /// @param capacity The maximum number of queued packets
+  /// @param overflow_policy Which packet to drop when the ring is full
+  /// @param max_packet_size The size of each packet slot
+  PacketRingWorker(
+    size_t capacity, PacketOverflowPolicy overflow_policy, size_t max_packet_size = 1500);
+
+  PacketRingWorker(const PacketRingWorker &) = delete;
+  PacketRingWorker & operator=(const PacketRingWorker &) = delete;
+
+  /// @brief Stops the worker thread
+  ~PacketRingWorker();
+
+  /// @brief Start draining the ring on a new thread
+  /// @param callback The callback receiving each packet
+  void start(PacketCallback callback);
+
+  /// @brief Stop the worker thread after the packet it is currently processing. Queued packets are
+  /// discarded
+  void stop();
+
+  /// @brief Queue a packet for the worker thread. Receive thread only, never blocks
+  /// @param data The packet data
+  /// @param size The packet size in bytes
+  /// @param receive_time_ns The time the packet was received in nanoseconds since the epoch
+  /// @return True if the packet was queued, false if it was dropped
+  bool push(const uint8_t * data, size_t size, uint64_t receive_time_ns);
+
+  /// @brief The total number of packets dropped
+  uint64_t dropped() const { return ring_.dropped(); }
+
+  /// @brief Get the number of packets dropped since the last call. Not thread-safe with respect to
+  /// other calls of this function
+  uint64_t takeDropped();
+
+  /// @brief The number of currently queued packets
+  size_t queued() const { return ring_.size(); }
+
+private:
+  SpscPacketRing ring_;
+
+  PacketCallback callback_;
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+
+  std::mutex wakeup_mutex_;
+  std::condition_variable wakeup_;
+  /// @brief Set while the worker thread is about to sleep, so that `push` only notifies when needed
+  std::atomic<bool> sleeping_{false};
+
+  uint64_t n_reported_drops_{0};
+
+  void processLoop();
+};
+
+}  // namespace drivers
+}  // namespace nebula
+
+#endif  // NEBULA_PACKET_RING_WORKER_H
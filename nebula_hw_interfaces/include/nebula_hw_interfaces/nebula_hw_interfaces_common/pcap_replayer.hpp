@@ -0,0 +1,135 @@
+#ifndef NEBULA_PCAP_REPLAYER_H
+#define NEBULA_PCAP_REPLAYER_H
+
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/udp_batch_receiver.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief Replays the UDP datagrams of a PCAP capture as if they were received from the network.
+///
+/// Datagrams are delivered through the same callback as `UdpBatchReceiver`'s, one datagram per
+/// call, so that hardware interfaces can assemble scans from a capture exactly like they do from a
+/// socket. `receive_time_ns` is set to the time of delivery.
+///
+/// Classic PCAP files with microsecond or nanosecond timestamps are supported, captured on
+/// Ethernet (optionally VLAN tagged), Linux cooked (SLL and SLL2), raw IP or loopback links. Only
+/// IPv4 is supported. Fragmented datagrams are reassembled if their fragments were captured in
+/// order, as is the case for the large datagrams of some radars.
+class PcapReplayer
+{
+public:
+  typedef UdpBatchReceiver::BatchCallback BatchCallback;
+
+  /// @brief Constructor
+  /// @param pcap_file The capture to replay
+  /// @param speed The replay speed as a multiple of the recorded speed. 0 replays as fast as
+  /// possible
+  /// @throw std::runtime_error if the file cannot be opened or is not a supported capture
+  PcapReplayer(const std::string & pcap_file, double speed);
+
+  PcapReplayer(const PcapReplayer &) = delete;
+  PcapReplayer & operator=(const PcapReplayer &) = delete;
+
+  /// @brief Stops replaying and closes the file
+  ~PcapReplayer();
+
+  /// @brief Only replay datagrams sent to the given port
+  /// @param port The destination port. 0 replays datagrams to all ports
+  void setPortFilter(uint16_t port) { port_filter_ = port; }
+
+  /// @brief Only replay datagrams sent from the given address, e.g. the sensor's, as a capture
+  /// can hold the traffic of several sensors sending to the same port
+  /// @param sender_ip The source IPv4 address in dotted decimal notation. "" replays datagrams
+  /// from all addresses
+  /// @throw std::runtime_error if the address is not a valid IPv4 address
+  void setSenderFilter(const std::string & sender_ip);
+
+  /// @brief Start replaying on a new thread, from the start of the capture
+  /// @param callback The callback receiving each datagram. It is called from the replay thread
+  void start(BatchCallback callback);
+
+  /// @brief Stop the replay thread, waiting for the current callback to return
+  void stop();
+
+  /// @brief Whether the whole capture has been replayed
+  bool finished() const { return finished_; }
+
+  /// @brief The total number of datagrams delivered
+  uint64_t packets() const { return n_packets_; }
+
+  /// @brief The total number of datagrams that were dropped because some of their fragments were
+  /// missing or out of order
+  uint64_t incomplete() const { return n_incomplete_; }
+
+private:
+  double speed_;
+  uint16_t port_filter_{0};
+  /// @brief The source address in network byte order, 0 if datagrams are not filtered by source
+  uint32_t sender_filter_{0};
+
+  std::FILE * file_{nullptr};
+  /// @brief Whether the capture was written with the opposite byte order
+  bool swapped_{false};
+  bool nanosecond_timestamps_{false};
+  uint32_t link_type_{0};
+  /// @brief Where the first record starts in the file
+  long first_record_offset_{0};
+
+  /// @brief The data of the current record
+  std::vector<uint8_t> record_;
+  /// @brief The payload of the datagram being reassembled from fragments
+  std::vector<uint8_t> reassembly_;
+  /// @brief The source, identification and payload offset expected from the next fragment
+  uint32_t reassembly_source_{0};
+  uint16_t reassembly_id_{0};
+  size_t reassembly_offset_{0};
+  bool reassembling_{false};
+
+  BatchCallback callback_;
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+  std::atomic<bool> finished_{false};
+  /// @brief Wakes the replay thread up when it is stopped while waiting for a datagram's time
+  std::mutex wait_mutex_;
+  std::condition_variable wait_cv_;
+
+  std::atomic<uint64_t> n_packets_{0};
+  std::atomic<uint64_t> n_incomplete_{0};
+
+  void replayLoop();
+
+  /// @brief Read records until the next UDP datagram passing the port and sender filters
+  /// @param packet The datagram, pointing into `record_` or `reassembly_`
+  /// @param capture_time_ns The time the datagram was captured in nanoseconds
+  /// @return Whether a datagram was read, false at the end of the capture
+  bool readDatagram(UdpPacketView & packet, uint64_t & capture_time_ns);
+
+  /// @brief Extract the UDP datagram from an IPv4 packet, reassembling fragments
+  /// @param ip The IPv4 packet
+  /// @param size The captured size of the IPv4 packet
+  /// @param packet The datagram, if the packet completed one
+  /// @return Whether the packet completed a datagram passing the port and sender filters
+  bool parseIpv4(const uint8_t * ip, size_t size, UdpPacketView & packet);
+
+  /// @brief Wait until the given time, or until the replayer is stopped
+  /// @return Whether the replayer is still running
+  bool waitUntil(std::chrono::steady_clock::time_point time);
+};
+
+}  // namespace drivers
+}  // namespace nebula
+
+#endif  // NEBULA_PCAP_REPLAYER_H
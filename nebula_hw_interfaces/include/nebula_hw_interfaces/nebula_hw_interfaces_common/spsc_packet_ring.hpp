@@ -0,0 +1,196 @@
+#ifndef NEBULA_SPSC_PACKET_RING_H
+#define NEBULA_SPSC_PACKET_RING_H
+
+#include "nebula_common/nebula_common.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief A packet stored in SpscPacketRing. Points into the ring's packet slots and is only valid
+/// until the consumer callback returns.
+struct RingPacketView
+{
+  const uint8_t * data;
+  size_t size;
+  /// @brief The receive time passed to `push`, in nanoseconds since the epoch
+  uint64_t receive_time_ns;
+};
+
+/// @brief A bounded, lock-free single-producer/single-consumer queue of packets.
+///
+/// Packets are copied into a fixed pool of preallocated slots, so neither `push` nor `pop`
+/// allocate or block. The queue itself only passes slot indices: the producer takes free slots
+/// from a second index ring that the consumer returns them to once it has processed them. This
+/// way, the producer can drop the oldest queued packet by claiming its slot, without ever writing
+/// to the slot the consumer is currently reading.
+///
+/// `push` must only be called from one thread, and `pop` from one other thread.
+class SpscPacketRing
+{
+public:
+  /// @brief Constructor
+  /// @param capacity The maximum number of queued packets. Values below 1 are treated as 1
+  /// @param slot_size The maximum packet size. Longer packets are dropped
+  /// @param overflow_policy Which packet to drop when `capacity` packets are queued
+  SpscPacketRing(size_t capacity, size_t slot_size, PacketOverflowPolicy overflow_policy)
+  : capacity_(std::max<size_t>(capacity, 1)),
+    slot_size_(slot_size),
+    // One slot can be in use by the consumer and one by the producer in addition to the queued ones
+    n_slots_(capacity_ + 2),
+    overflow_policy_(overflow_policy),
+    storage_(n_slots_ * slot_size_),
+    sizes_(n_slots_),
+    receive_times_(n_slots_)
+  {
+    size_t index_ring_size = 1;
+    while (index_ring_size < n_slots_) {
+      index_ring_size <<= 1;
+    }
+    mask_ = index_ring_size - 1;
+    queue_ = std::make_unique<std::atomic<uint32_t>[]>(index_ring_size);
+    free_ = std::make_unique<std::atomic<uint32_t>[]>(index_ring_size);
+    for (size_t i = 0; i < n_slots_; ++i) {
+      free_[i].store(static_cast<uint32_t>(i), std::memory_order_relaxed);
+    }
+    free_head_.store(n_slots_, std::memory_order_release);
+  }
+
+  SpscPacketRing(const SpscPacketRing &) = delete;
+  SpscPacketRing & operator=(const SpscPacketRing &) = delete;
+
+  /// @brief Copy a packet into the ring. Producer thread only, never blocks
+  /// @param data The packet data
+  /// @param size The packet size in bytes
+  /// @param receive_time_ns The time the packet was received in nanoseconds since the epoch
+  /// @return True if the packet was queued, false if it was dropped
+  bool push(const uint8_t * data, size_t size, uint64_t receive_time_ns)
+  {
+    if (size > slot_size_) {
+      n_dropped_.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    }
+
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    uint32_t slot = 0;
+    bool has_slot = false;
+
+    if (head - tail >= capacity_) {
+      if (overflow_policy_ != PacketOverflowPolicy::DROP_OLDEST) {
+        n_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      // Claim the oldest queued packet's slot. If the consumer claims it first, there is room in
+      // the queue again and a free slot is about to be returned
+      const uint32_t oldest = queue_[tail & mask_].load(std::memory_order_relaxed);
+      if (tail_.compare_exchange_strong(
+            tail, tail + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        slot = oldest;
+        has_slot = true;
+        n_dropped_.fetch_add(1, std::memory_order_relaxed);
+      }
+    }
+
+    if (!has_slot) {
+      const uint64_t free_tail = free_tail_.load(std::memory_order_relaxed);
+      if (free_tail == free_head_.load(std::memory_order_acquire)) {
+        // Only reachable while the consumer is between claiming a packet and returning its
+        // predecessor's slot, which it never does
+        n_dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+      slot = free_[free_tail & mask_].load(std::memory_order_relaxed);
+      free_tail_.store(free_tail + 1, std::memory_order_release);
+    }
+
+    std::memcpy(&storage_[slot * slot_size_], data, size);
+    sizes_[slot] = size;
+    receive_times_[slot] = receive_time_ns;
+    queue_[head & mask_].store(slot, std::memory_order_relaxed);
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief Process the oldest queued packet in place. Consumer thread only, never blocks
+  /// @param callback Called with a RingPacketView of the packet. The packet's slot is reused once
+  /// the callback returns
+  /// @return True if a packet was processed, false if the ring was empty
+  template <typename Callback>
+  bool pop(Callback && callback)
+  {
+    uint64_t tail = tail_.load(std::memory_order_acquire);
+    uint32_t slot = 0;
+    while (true) {
+      if (tail == head_.load(std::memory_order_acquire)) {
+        return false;
+      }
+      slot = queue_[tail & mask_].load(std::memory_order_relaxed);
+      // Fails if the producer dropped the packet in the meantime, `tail` is then reloaded
+      if (tail_.compare_exchange_weak(
+            tail, tail + 1, std::memory_order_acq_rel, std::memory_order_acquire)) {
+        break;
+      }
+    }
+
+    callback(RingPacketView{&storage_[slot * slot_size_], sizes_[slot], receive_times_[slot]});
+
+    const uint64_t free_head = free_head_.load(std::memory_order_relaxed);
+    free_[free_head & mask_].store(slot, std::memory_order_relaxed);
+    free_head_.store(free_head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// @brief The number of queued packets. Only a snapshot if called while packets are pushed or
+  /// popped
+  size_t size() const
+  {
+    const uint64_t tail = tail_.load(std::memory_order_acquire);
+    return head_.load(std::memory_order_acquire) - tail;
+  }
+
+  /// @brief Whether no packets are queued
+  bool empty() const { return size() == 0; }
+
+  /// @brief The maximum number of queued packets
+  size_t capacity() const { return capacity_; }
+
+  /// @brief The total number of packets dropped because the ring was full or they were too long
+  uint64_t dropped() const { return n_dropped_.load(std::memory_order_relaxed); }
+
+private:
+  size_t capacity_;
+  size_t slot_size_;
+  size_t n_slots_;
+  PacketOverflowPolicy overflow_policy_;
+  size_t mask_{0};
+
+  std::vector<uint8_t> storage_;
+  std::vector<size_t> sizes_;
+  std::vector<uint64_t> receive_times_;
+
+  /// @brief Slot indices of queued packets. Written by the producer, claimed by both threads
+  std::unique_ptr<std::atomic<uint32_t>[]> queue_;
+  /// @brief Slot indices of free slots. Returned by the consumer, taken by the producer
+  std::unique_ptr<std::atomic<uint32_t>[]> free_;
+
+  alignas(64) std::atomic<uint64_t> head_{0};
+  alignas(64) std::atomic<uint64_t> tail_{0};
+  alignas(64) std::atomic<uint64_t> free_head_{0};
+  alignas(64) std::atomic<uint64_t> free_tail_{0};
+  alignas(64) std::atomic<uint64_t> n_dropped_{0};
+};
+
+}  // namespace drivers
+}  // namespace nebula
+
+#endif  // NEBULA_SPSC_PACKET_RING_H
@@ -0,0 +1,176 @@
+#ifndef NEBULA_UDP_BATCH_RECEIVER_H
+#define NEBULA_UDP_BATCH_RECEIVER_H
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nebula
+{
+namespace drivers
+{
+
+/// @brief The default size of a packet slot. Longer datagrams are truncated and dropped
+constexpr size_t UDP_BATCH_RECEIVER_MAX_PACKET_SIZE = 1500;
+
+/// @brief A datagram received by UdpBatchReceiver. Points into the receiver's packet slots and is
+/// only valid until the batch callback returns.
+struct UdpPacketView
+{
+  const uint8_t * data;
+  size_t size;
+  /// @brief The time the kernel received the datagram in nanoseconds since the epoch, or 0 if
+  /// kernel timestamps are not enabled
+  uint64_t receive_time_ns;
+  /// @brief The address the datagram was sent from
+  sockaddr_in sender;
+};
+
+/// @brief Format the IP a datagram was sent from, e.g. "192.168.1.201"
+/// @param packet The received datagram
+/// @return The sender IP in dotted decimal notation
+std::string senderIp(const UdpPacketView & packet);
+
+/// @brief Receives UDP datagrams in batches with `recvmmsg` on a dedicated thread.
+///
+/// Datagrams are read directly into a preallocated ring of packet slots, so receiving does not
+/// allocate. Once `batch_size` datagrams have been received, or `batch_timeout` has passed since
+/// the first datagram of the batch arrived, the batch is passed to the callback and its slots are
+/// reused for the next batch.
+class UdpBatchReceiver
+{
+public:
+  /// @brief Called with the datagrams of each batch in the order they were received
+  typedef std::function<void(const UdpPacketView * packets, size_t n_packets)> BatchCallback;
+
+  /// @brief Called with a warning about the socket's configuration, e.g. to log it
+  typedef std::function<void(const std::string & warning)> WarningCallback;
+
+  /// @brief Constructor
+  /// @param batch_size The maximum number of datagrams per batch. Values below 1 are treated as 1
+  /// @param batch_timeout The maximum time to wait for a batch to fill up after its first datagram
+  /// has been received. Zero delivers whatever one `recvmmsg` call returned
+  /// @param max_packet_size The size of each packet slot
+  UdpBatchReceiver(
+    size_t batch_size, std::chrono::microseconds batch_timeout,
+    size_t max_packet_size = UDP_BATCH_RECEIVER_MAX_PACKET_SIZE);
+
+  UdpBatchReceiver(const UdpBatchReceiver &) = delete;
+  UdpBatchReceiver & operator=(const UdpBatchReceiver &) = delete;
+
+  /// @brief Stops receiving and closes the socket
+  ~UdpBatchReceiver();
+
+  /// @brief Open a UDP socket and bind it to the given address
+  /// @param host_ip The IP to bind to
+  /// @param port The port to bind to
+  /// @throw std::runtime_error if the socket cannot be opened or bound
+  void open(const std::string & host_ip, uint16_t port);
+
+  /// @brief Join a multicast group on the given interface. `open` has to have been called before
+  /// @param group_ip The multicast group to join
+  /// @param interface_ip The IP of the interface to join the group on
+  /// @throw std::runtime_error if the group cannot be joined
+  void joinMulticast(const std::string & group_ip, const std::string & interface_ip);
+
+  /// @brief Have the kernel timestamp each datagram when it is received (`SO_TIMESTAMPNS`). The
+  /// timestamps are passed in `UdpPacketView::receive_time_ns`. `open` has to have been called
+  /// before
+  /// @throw std::runtime_error if the socket option cannot be set
+  void enableKernelTimestamps();
+
+  /// @brief Set the size of the socket's receive buffer. `SO_RCVBUFFORCE` is tried first, which
+  /// is not limited by `net.core.rmem_max` but requires `CAP_NET_ADMIN`, then `SO_RCVBUF`. `open`
+  /// has to have been called before
+  /// @param size The requested size in bytes
+  /// @param warn Called with a warning if the kernel granted less than `size`
+  /// @return The size the kernel granted, which is half of `receiveBufferSize` as the kernel
+  /// doubles the requested size for its own bookkeeping
+  /// @throw std::runtime_error if the buffer size cannot be set
+  size_t setReceiveBufferSize(size_t size, const WarningCallback & warn = nullptr);
+
+  /// @brief The size the kernel allocated for the socket's receive buffer in bytes
+  /// @throw std::runtime_error if the size cannot be read
+  size_t receiveBufferSize() const;
+
+  /// @brief Have the kernel report how many datagrams it dropped on this socket (`SO_RXQ_OVFL`).
+  /// The count is available through `kernelDrops`. `open` has to have been called before
+  /// @throw std::runtime_error if the socket option cannot be set
+  void enableDropCounter();
+
+  /// @brief Start receiving on a new thread. `open` has to have been called before
+  /// @param callback The callback receiving each batch. It is called from the receiver thread
+  void start(BatchCallback callback);
+
+  /// @brief Stop the receiver thread, waiting for the current callback to return
+  void stop();
+
+  /// @brief The file descriptor of the socket, e.g. for setting additional socket options
+  int fd() const { return fd_; }
+
+  /// @brief The maximum number of datagrams per batch
+  size_t batchSize() const { return batch_size_; }
+
+  /// @brief The total number of datagrams delivered
+  uint64_t packets() const { return n_packets_; }
+
+  /// @brief The total number of batches delivered
+  uint64_t batches() const { return n_batches_; }
+
+  /// @brief The total number of datagrams dropped because they did not fit into a packet slot
+  uint64_t truncated() const { return n_truncated_; }
+
+  /// @brief The total number of datagrams the kernel dropped because the socket's receive buffer
+  /// was full, as reported with the last received datagram. Requires `enableDropCounter`
+  uint64_t kernelDrops() const { return n_kernel_drops_; }
+
+private:
+  size_t batch_size_;
+  std::chrono::microseconds batch_timeout_;
+  size_t max_packet_size_;
+
+  int fd_{-1};
+  /// @brief Written to by `stop` to wake the receiver thread up
+  int wakeup_fd_{-1};
+
+  std::vector<uint8_t> slots_;
+  std::vector<iovec> iovecs_;
+  std::vector<mmsghdr> headers_;
+  /// @brief Per-slot buffers for the ancillary data the kernel attaches to each datagram
+  std::vector<uint8_t> control_;
+  std::vector<sockaddr_in> senders_;
+  std::vector<UdpPacketView> batch_;
+
+  BatchCallback callback_;
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+
+  std::atomic<uint64_t> n_packets_{0};
+  std::atomic<uint64_t> n_batches_{0};
+  std::atomic<uint64_t> n_truncated_{0};
+  std::atomic<uint64_t> n_kernel_drops_{0};
+  /// @brief The last `SO_RXQ_OVFL` counter received. The kernel counter is 32 bits wide and wraps
+  uint32_t last_drop_counter_{0};
+
+  void receiveLoop();
+
+  /// @brief Receive until the batch is full, its timeout expires or the receiver is stopped
+  /// @return The number of datagrams received into the slots
+  size_t receiveBatch();
+
+  void deliverBatch(size_t n_received);
+};
+
+}  // namespace drivers
+}  // namespace nebula
+
+#endif  // NEBULA_UDP_BATCH_RECEIVER_H
@@ -29,6 +29,10 @@
 #include <boost_udp_driver/udp_driver.hpp>
 #include <nebula_common/continental/continental_ars548.hpp>
 #include <nebula_hw_interfaces/nebula_hw_interfaces_common/nebula_hw_interface_base.hpp>
+#include <nebula_hw_interfaces/nebula_hw_interfaces_common/nebula_packets_arena.hpp>
+#include <nebula_hw_interfaces/nebula_hw_interfaces_common/packet_receive_statistics.hpp>
+#include <nebula_hw_interfaces/nebula_hw_interfaces_common/pcap_replayer.hpp>
+#include <nebula_hw_interfaces/nebula_hw_interfaces_common/udp_batch_receiver.hpp>
 #include <rclcpp/rclcpp.hpp>
 
 #include <nebula_msgs/msg/nebula_packet.hpp>
@@ -56,7 +60,9 @@ private:
   std::unique_ptr<::drivers::common::IoContext> sensor_io_context_;
   std::unique_ptr<::drivers::udp_driver::UdpDriver> sensor_udp_driver_;
   std::shared_ptr<ContinentalARS548SensorConfiguration> sensor_configuration_;
-  std::unique_ptr<nebula_msgs::msg::NebulaPackets> nebula_packets_ptr_;
+  /// @brief Provides the NebulaPackets each data packet is copied into, and reuses their buffers
+  /// once recycled
+  NebulaPacketsArena packets_arena_{DETECTION_LIST_UDP_PAYLOAD};
   std::function<void(std::unique_ptr<nebula_msgs::msg::NebulaPackets> buffer)>
     nebula_packets_reception_callback_;
 
@@ -83,17 +89,36 @@ private:
   /// @param bytes Target byte vector
   void PrintDebug(const std::vector<uint8_t> & bytes);
 
+  PacketReceiveStatistics receive_statistics_;
+
+  /// @brief Receives data packets if kernel timestamps are enabled or receive_buffer_size is set.
+  /// Declared last so that its thread is stopped before any state it calls into is destroyed
+  std::unique_ptr<UdpBatchReceiver> sensor_batch_receiver_;
+  /// @brief Replays data packets instead if pcap_file is set. Declared last for the same reason
+  std::unique_ptr<PcapReplayer> pcap_replayer_;
+
+  /// @brief Process a single packet, regardless of how it has been received
+  /// @param buffer Buffer containing the data received from the UDP socket
+  /// @param size The size of the packet in bytes
+  /// @param receive_time_ns The time the kernel received the packet in nanoseconds since the
+  /// epoch, or 0 to stamp the packet with the current time
+  void ReceiveSensorPacket(const uint8_t * buffer, size_t size, uint64_t receive_time_ns);
+
 public:
   /// @brief Constructor
   ContinentalARS548HwInterface();
 
   /// @brief Process a new filter status packet
   /// @param buffer The buffer containing the status packet
-  void ProcessFilterStatusPacket(const std::vector<uint8_t> & buffer);
+  /// @param size The size of the packet in bytes
+  void ProcessFilterStatusPacket(const uint8_t * buffer, size_t size);
 
   /// @brief Process a new data packet
   /// @param buffer The buffer containing the data packet
-  void ProcessDataPacket(const std::vector<uint8_t> & buffer);
+  /// @param size The size of the packet in bytes
+  /// @param receive_time_ns The time the kernel received the packet in nanoseconds since the
+  /// epoch, or 0 to stamp the packet with the current time
+  void ProcessDataPacket(const uint8_t * buffer, size_t size, uint64_t receive_time_ns = 0);
 
   /// @brief Callback function to receive the Cloud Packet data from the UDP Driver
   /// @param buffer Buffer containing the data received from the UDP socket
@@ -104,6 +129,10 @@ public:
   /// @param buffer Buffer containing the data received from the UDP socket
   void ReceiveSensorPacketCallback(const std::vector<uint8_t> & buffer) final;
 
+  /// @brief Get the packet reception statistics accumulated since the last call
+  /// @return The statistics, empty unless kernel timestamps are enabled
+  PacketReceiveStatistics::Summary GetReceiveStatistics();
+
   /// @brief Starting the interface that handles UDP streams
   /// @return Resulting status
   Status SensorInterfaceStart() final;
@@ -129,6 +158,11 @@ public:
   Status RegisterScanCallback(
     std::function<void(std::unique_ptr<nebula_msgs::msg::NebulaPackets>)> scan_callback);
 
+  /// @brief Hand back a message passed to the scan callback once it is not needed anymore, so
+  /// that its buffers are reused for later packets instead of being allocated again
+  /// @param scan The message to recycle
+  void RecycleScan(std::unique_ptr<nebula_msgs::msg::NebulaPackets> scan);
+
   /// @brief Set the sensor mounting parameters
   /// @param longitudinal_autosar Desired longitudinal value in autosar coordinates
   /// @param lateral_autosar Desired lateral value in autosar coordinates
@@ -15,13 +15,19 @@
 #include "boost_udp_driver/udp_driver.hpp"
 #include "nebula_common/hesai/hesai_common.hpp"
 #include "nebula_common/hesai/hesai_status.hpp"
+#include "nebula_common/scan_latency_tracer.hpp"
 #include "nebula_hw_interfaces/nebula_hw_interfaces_common/nebula_hw_interface_base.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/nebula_packets_arena.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/packet_receive_statistics.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/pcap_replayer.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/packet_ring_worker.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/udp_batch_receiver.hpp"
 #include "nebula_hw_interfaces/nebula_hw_interfaces_hesai/hesai_cmd_response.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
-#include "pandar_msgs/msg/pandar_packet.hpp"
-#include "pandar_msgs/msg/pandar_scan.hpp"
+#include "nebula_msgs/msg/nebula_packet.hpp"
+#include "nebula_msgs/msg/nebula_packets.hpp"
 
 #include <boost/algorithm/string.hpp>
 #include <boost/property_tree/json_parser.hpp>
@@ -99,11 +105,22 @@ private:
   std::shared_ptr<HesaiCalibrationConfiguration> calibration_configuration_;
   size_t azimuth_index_{};
   size_t mtu_size_{};
-  std::unique_ptr<pandar_msgs::msg::PandarScan> scan_cloud_ptr_;
+  /// @brief Provides the scans packets are buffered into, and reuses their buffers once recycled
+  NebulaPacketsArena packets_arena_{MTU_SIZE};
+  std::unique_ptr<nebula_msgs::msg::NebulaPackets> scan_cloud_ptr_;
+  /// @brief Traces the reception and completion of scans, obtained for the configured frame ID
+  /// when the interface is started. Stays a private, disabled tracer if scan tracing is off
+  std::shared_ptr<ScanLatencyTracer> scan_tracer_;
+  /// @brief Whether the reception of scans is traced, see `SetScanTracing`
+  bool trace_scans_{true};
+  /// @brief The packet handed to the packet callback if packets are not buffered into scans
+  nebula_msgs::msg::NebulaPacket unbuffered_packet_;
   std::function<bool(size_t)>
     is_valid_packet_; /*Lambda Function Array to verify proper packet size*/
-  std::function<void(std::unique_ptr<pandar_msgs::msg::PandarScan> buffer)>
+  std::function<void(std::unique_ptr<nebula_msgs::msg::NebulaPackets> buffer)>
     scan_reception_callback_; /**This function pointer is called when the scan is complete*/
+  std::function<void(const nebula_msgs::msg::NebulaPacket & packet)>
+    packet_reception_callback_; /**This function pointer is called for every valid packet*/
 
   int prev_phase_{};
 
@@ -141,6 +158,34 @@ private:
   /// @param bytes Target byte vector
   void PrintDebug(const std::vector<uint8_t> & bytes);
 
+  PacketReceiveStatistics receive_statistics_;
+
+  /// @brief Assembles scans on its own thread if packet_ring_size > 0. Declared after the state its
+  /// thread calls into, so that it is stopped before that state is destroyed
+  std::unique_ptr<PacketRingWorker> packet_ring_;
+
+  /// @brief Receives cloud packets if receive_batch_size > 1, kernel timestamps are enabled or
+  /// receive_buffer_size is set.
+  /// Declared last so that its thread is stopped before any state it calls into is destroyed
+  std::unique_ptr<UdpBatchReceiver> cloud_batch_receiver_;
+  /// @brief Replays data packets instead if pcap_file is set. Declared last for the same reason
+  std::unique_ptr<PcapReplayer> pcap_replayer_;
+
+  /// @brief Process a single cloud packet, regardless of how it has been received
+  /// @param buffer The packet data
+  /// @param size The packet size in bytes
+  /// @param receive_time_ns The time the kernel received the packet in nanoseconds since the
+  /// epoch, or 0 to stamp the packet with the current time
+  void ReceiveSensorPacket(const uint8_t * buffer, size_t size, uint64_t receive_time_ns);
+
+  /// @brief Queue a received cloud packet in the packet ring if there is one, or process it
+  /// directly otherwise
+  /// @param buffer The packet data
+  /// @param size The packet size in bytes
+  /// @param receive_time_ns The time the kernel received the packet in nanoseconds since the
+  /// epoch, or 0 if unknown
+  void EnqueueSensorPacket(const uint8_t * buffer, size_t size, uint64_t receive_time_ns);
+
   /// @brief Send a PTC request with an optional payload, and return the full response payload.
   /// Blocking.
   /// @param command_id PTC command number.
@@ -169,6 +214,12 @@ public:
   /// @brief Callback function to receive the Cloud Packet data from the UDP Driver
   /// @param buffer Buffer containing the data received from the UDP socket
   void ReceiveSensorPacketCallback(const std::vector<uint8_t> & buffer) final;
+  /// @brief Get the packet reception statistics accumulated since the last call
+  /// @return The statistics, empty unless kernel timestamps are enabled
+  PacketReceiveStatistics::Summary GetReceiveStatistics();
+  /// @brief Get the total number of cloud packets the kernel dropped since the interface started
+  /// @return The number of drops, 0 unless packets are received with the batched receiver
+  uint64_t GetKernelDrops() const;
   /// @brief Starting the interface that handles UDP streams
   /// @return Resulting status
   Status SensorInterfaceStart() final;
@@ -188,11 +239,29 @@ public:
   /// @return Resulting status
   Status SetSensorConfiguration(
     std::shared_ptr<SensorConfigurationBase> sensor_configuration) final;
-  /// @brief Registering callback for PandarScan
+  /// @brief Registering callback for NebulaPackets containing one scan each. The packets' data is
+  /// exactly as long as the received datagrams
   /// @param scan_callback Callback function
   /// @return Resulting status
   Status RegisterScanCallback(
-    std::function<void(std::unique_ptr<pandar_msgs::msg::PandarScan>)> scan_callback);
+    std::function<void(std::unique_ptr<nebula_msgs::msg::NebulaPackets>)> scan_callback);
+  /// @brief Registering callback that is called for every valid NebulaPacket as soon as it has
+  /// been received. Packets are only buffered into NebulaPackets if a scan callback is registered
+  /// as well
+  /// @param packet_callback Callback function
+  /// @return Resulting status
+  Status RegisterPacketCallback(
+    std::function<void(const nebula_msgs::msg::NebulaPacket &)> packet_callback);
+  /// @brief Hand back a scan passed to the scan callback once it is not needed anymore, so that
+  /// its buffers are reused for later scans instead of being allocated again
+  /// @param scan The scan to recycle
+  void RecycleScan(std::unique_ptr<nebula_msgs::msg::NebulaPackets> scan);
+  /// @brief Set whether the reception and completion of scans is traced with the sensor's
+  /// ScanLatencyTracer. Disable this if the packets are decoded one by one in the same process:
+  /// the decoder cuts scans at a different packet, so the stages recorded here would belong to
+  /// different scan IDs than the decoder's. Has to be called before `SensorInterfaceStart`
+  /// @param enabled Whether to trace scans, true by default
+  void SetScanTracing(bool enabled);
   /// @brief Getting data with PTC_COMMAND_GET_LIDAR_CALIBRATION
   /// @return Resulting status
   std::string GetLidarCalibrationString();
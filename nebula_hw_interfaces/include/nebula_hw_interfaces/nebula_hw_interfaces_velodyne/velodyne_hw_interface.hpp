@@ -16,6 +16,10 @@
 #include "nebula_common/velodyne/velodyne_common.hpp"
 #include "nebula_common/velodyne/velodyne_status.hpp"
 #include "nebula_hw_interfaces/nebula_hw_interfaces_common/nebula_hw_interface_base.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/packet_receive_statistics.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/pcap_replayer.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/packet_ring_worker.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/udp_batch_receiver.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 
@@ -100,6 +104,34 @@ private:
   /// @param debug Target string
   void PrintDebug(std::string debug);
 
+  PacketReceiveStatistics receive_statistics_;
+
+  /// @brief Assembles scans on its own thread if packet_ring_size > 0. Declared after the state its
+  /// thread calls into, so that it is stopped before that state is destroyed
+  std::unique_ptr<PacketRingWorker> packet_ring_;
+
+  /// @brief Receives cloud packets if receive_batch_size > 1, kernel timestamps are enabled or
+  /// receive_buffer_size is set.
+  /// Declared last so that its thread is stopped before any state it calls into is destroyed
+  std::unique_ptr<UdpBatchReceiver> cloud_batch_receiver_;
+  /// @brief Replays data packets instead if pcap_file is set. Declared last for the same reason
+  std::unique_ptr<PcapReplayer> pcap_replayer_;
+
+  /// @brief Process a single cloud packet, regardless of how it has been received
+  /// @param buffer The packet data
+  /// @param size The packet size in bytes
+  /// @param receive_time_ns The time the kernel received the packet in nanoseconds since the
+  /// epoch, or 0 to stamp the packet with the current time
+  void ReceiveSensorPacket(const uint8_t * buffer, size_t size, uint64_t receive_time_ns);
+
+  /// @brief Queue a received cloud packet in the packet ring if there is one, or process it
+  /// directly otherwise
+  /// @param buffer The packet data
+  /// @param size The packet size in bytes
+  /// @param receive_time_ns The time the kernel received the packet in nanoseconds since the
+  /// epoch, or 0 if unknown
+  void EnqueueSensorPacket(const uint8_t * buffer, size_t size, uint64_t receive_time_ns);
+
 public:
   /// @brief Constructor
   VelodyneHwInterface();
@@ -107,6 +139,9 @@ public:
   /// @brief Callback function to receive the Cloud Packet data from the UDP Driver
   /// @param buffer Buffer containing the data received from the UDP socket
   void ReceiveSensorPacketCallback(const std::vector<uint8_t> & buffer) final;
+  /// @brief Get the packet reception statistics accumulated since the last call
+  /// @return The statistics, empty unless kernel timestamps are enabled
+  PacketReceiveStatistics::Summary GetReceiveStatistics();
   /// @brief Starting the interface that handles UDP streams
   /// @return Resulting status
   Status SensorInterfaceStart() final;
@@ -26,8 +26,7 @@ namespace continental_ars548
 {
 ContinentalARS548HwInterface::ContinentalARS548HwInterface()
 : sensor_io_context_{new ::drivers::common::IoContext(1)},
-  sensor_udp_driver_{new ::drivers::udp_driver::UdpDriver(*sensor_io_context_)},
-  nebula_packets_ptr_{std::make_unique<nebula_msgs::msg::NebulaPackets>()}
+  sensor_udp_driver_{new ::drivers::udp_driver::UdpDriver(*sensor_io_context_)}
 {
 }
 
@@ -51,15 +50,57 @@ Status ContinentalARS548HwInterface::SetSensorConfiguration(
 Status ContinentalARS548HwInterface::SensorInterfaceStart()
 {
   try {
-    sensor_udp_driver_->init_receiver(
-      sensor_configuration_->multicast_ip, sensor_configuration_->data_port,
-      sensor_configuration_->host_ip, sensor_configuration_->data_port, 2 << 16);
-    sensor_udp_driver_->receiver()->setMulticast(true);
-    sensor_udp_driver_->receiver()->open();
-    sensor_udp_driver_->receiver()->bind();
-    sensor_udp_driver_->receiver()->asyncReceiveWithSender(std::bind(
-      &ContinentalARS548HwInterface::ReceiveSensorPacketCallbackWithSender, this,
-      std::placeholders::_1, std::placeholders::_2));
+    if (!sensor_configuration_->pcap_file.empty()) {
+      // There is no sensor to configure, so the configuration sender is not opened
+      pcap_replayer_ = std::make_unique<PcapReplayer>(
+        sensor_configuration_->pcap_file, sensor_configuration_->pcap_replay_speed);
+      pcap_replayer_->setPortFilter(sensor_configuration_->data_port);
+      pcap_replayer_->setSenderFilter(sensor_configuration_->sensor_ip);
+      pcap_replayer_->start([this](const UdpPacketView * packets, size_t n_packets) {
+        for (size_t i = 0; i < n_packets; ++i) {
+          ReceiveSensorPacket(packets[i].data, packets[i].size, packets[i].receive_time_ns);
+        }
+      });
+      return Status::OK;
+    }
+
+    if (
+      sensor_configuration_->use_kernel_timestamps ||
+      sensor_configuration_->receive_buffer_size > 0) {
+      // Packets are delivered one by one, as they are not split into scans
+      sensor_batch_receiver_ = std::make_unique<UdpBatchReceiver>(
+        1, std::chrono::microseconds::zero(), DETECTION_LIST_UDP_PAYLOAD);
+      sensor_batch_receiver_->open(
+        sensor_configuration_->multicast_ip, sensor_configuration_->data_port);
+      sensor_batch_receiver_->joinMulticast(
+        sensor_configuration_->multicast_ip, sensor_configuration_->host_ip);
+      if (sensor_configuration_->receive_buffer_size > 0) {
+        sensor_batch_receiver_->setReceiveBufferSize(
+          sensor_configuration_->receive_buffer_size,
+          [this](const std::string & warning) { PrintError(warning); });
+      }
+      sensor_batch_receiver_->enableDropCounter();
+      if (sensor_configuration_->use_kernel_timestamps) {
+        sensor_batch_receiver_->enableKernelTimestamps();
+      }
+      sensor_batch_receiver_->start([this](const UdpPacketView * packets, size_t n_packets) {
+        for (size_t i = 0; i < n_packets; ++i) {
+          if (senderIp(packets[i]) == sensor_configuration_->sensor_ip) {
+            ReceiveSensorPacket(packets[i].data, packets[i].size, packets[i].receive_time_ns);
+          }
+        }
+      });
+    } else {
+      sensor_udp_driver_->init_receiver(
+        sensor_configuration_->multicast_ip, sensor_configuration_->data_port,
+        sensor_configuration_->host_ip, sensor_configuration_->data_port, 2 << 16);
+      sensor_udp_driver_->receiver()->setMulticast(true);
+      sensor_udp_driver_->receiver()->open();
+      sensor_udp_driver_->receiver()->bind();
+      sensor_udp_driver_->receiver()->asyncReceiveWithSender(std::bind(
+        &ContinentalARS548HwInterface::ReceiveSensorPacketCallbackWithSender, this,
+        std::placeholders::_1, std::placeholders::_2));
+    }
 
     sensor_udp_driver_->init_sender(
       sensor_configuration_->sensor_ip, sensor_configuration_->configuration_sensor_port,
@@ -68,7 +109,7 @@ Status ContinentalARS548HwInterface::SensorInterfaceStart()
     sensor_udp_driver_->sender()->open();
     sensor_udp_driver_->sender()->bind();
 
-    if (!sensor_udp_driver_->sender()->isOpen()) {
+    if (!sensor_udp_driver_->sender() || !sensor_udp_driver_->sender()->isOpen()) {
       return Status::ERROR_1;
     }
   } catch (const std::exception & ex) {
@@ -87,6 +128,12 @@ Status ContinentalARS548HwInterface::RegisterScanCallback(
   return Status::OK;
 }
 
+void ContinentalARS548HwInterface::RecycleScan(
+  std::unique_ptr<nebula_msgs::msg::NebulaPackets> scan)
+{
+  packets_arena_.recycle(std::move(scan));
+}
+
 void ContinentalARS548HwInterface::ReceiveSensorPacketCallbackWithSender(
   const std::vector<uint8_t> & buffer, const std::string & sender_ip)
 {
@@ -96,79 +143,92 @@ void ContinentalARS548HwInterface::ReceiveSensorPacketCallbackWithSender(
 }
 void ContinentalARS548HwInterface::ReceiveSensorPacketCallback(const std::vector<uint8_t> & buffer)
 {
-  if (buffer.size() < sizeof(HeaderPacket)) {
+  ReceiveSensorPacket(buffer.data(), buffer.size(), 0);
+}
+
+PacketReceiveStatistics::Summary ContinentalARS548HwInterface::GetReceiveStatistics()
+{
+  if (sensor_batch_receiver_) {
+    receive_statistics_.setKernelDrops(sensor_batch_receiver_->kernelDrops());
+  }
+  return receive_statistics_.collect();
+}
+
+void ContinentalARS548HwInterface::ReceiveSensorPacket(
+  const uint8_t * buffer, size_t size, uint64_t receive_time_ns)
+{
+  if (size < sizeof(HeaderPacket)) {
     PrintError("Unrecognized packet. Too short");
     return;
   }
 
   HeaderPacket header_packet{};
-  std::memcpy(&header_packet, buffer.data(), sizeof(HeaderPacket));
+  std::memcpy(&header_packet, buffer, sizeof(HeaderPacket));
 
   if (header_packet.service_id.value() != 0) {
     PrintError("Invalid service id");
     return;
   } else if (header_packet.method_id.value() == SENSOR_STATUS_METHOD_ID) {
     if (
-      buffer.size() != SENSOR_STATUS_UDP_PAYLOAD ||
+      size != SENSOR_STATUS_UDP_PAYLOAD ||
       header_packet.length.value() != SENSOR_STATUS_PDU_LENGTH) {
       PrintError("SensorStatus message with invalid size");
       return;
     }
-    ProcessDataPacket(buffer);
+    ProcessDataPacket(buffer, size, receive_time_ns);
   } else if (header_packet.method_id.value() == FILTER_STATUS_METHOD_ID) {
     if (
-      buffer.size() != FILTER_STATUS_UDP_PAYLOAD ||
+      size != FILTER_STATUS_UDP_PAYLOAD ||
       header_packet.length.value() != FILTER_STATUS_PDU_LENGTH) {
       PrintError("FilterStatus message with invalid size");
       return;
     }
 
-    ProcessFilterStatusPacket(buffer);
+    ProcessFilterStatusPacket(buffer, size);
   } else if (header_packet.method_id.value() == DETECTION_LIST_METHOD_ID) {
     if (
-      buffer.size() != DETECTION_LIST_UDP_PAYLOAD ||
+      size != DETECTION_LIST_UDP_PAYLOAD ||
       header_packet.length.value() != DETECTION_LIST_PDU_LENGTH) {
       PrintError("DetectionList message with invalid size");
       return;
     }
 
-    ProcessDataPacket(buffer);
+    ProcessDataPacket(buffer, size, receive_time_ns);
   } else if (header_packet.method_id.value() == OBJECT_LIST_METHOD_ID) {
     if (
-      buffer.size() != OBJECT_LIST_UDP_PAYLOAD ||
+      size != OBJECT_LIST_UDP_PAYLOAD ||
       header_packet.length.value() != OBJECT_LIST_PDU_LENGTH) {
       PrintError("ObjectList message with invalid size");
       return;
     }
 
-    ProcessDataPacket(buffer);
+    ProcessDataPacket(buffer, size, receive_time_ns);
   }
 }
 
-void ContinentalARS548HwInterface::ProcessFilterStatusPacket(const std::vector<uint8_t> & buffer)
+void ContinentalARS548HwInterface::ProcessFilterStatusPacket(const uint8_t * buffer, size_t size)
 {
-  assert(buffer.size() == sizeof(FilterStatusPacket));
-  std::memcpy(&filter_status_, buffer.data(), sizeof(FilterStatusPacket));
+  assert(size == sizeof(FilterStatusPacket));
+  std::memcpy(&filter_status_, buffer, sizeof(FilterStatusPacket));
 }
 
-void ContinentalARS548HwInterface::ProcessDataPacket(const std::vector<uint8_t> & buffer)
+void ContinentalARS548HwInterface::ProcessDataPacket(
+  const uint8_t * buffer, size_t size, uint64_t receive_time_ns)
 {
-  nebula_msgs::msg::NebulaPacket nebula_packet;
-  nebula_packet.data = buffer;
-  auto now = std::chrono::system_clock::now();
+  auto nebula_packets = packets_arena_.acquireScan();
+  auto & nebula_packet = packets_arena_.append(*nebula_packets, buffer, size);
+  auto now = receive_statistics_.stampPacket(receive_time_ns);
   auto now_secs = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
   auto now_nanosecs =
     std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
   nebula_packet.stamp.sec = static_cast<int>(now_secs);
   nebula_packet.stamp.nanosec =
     static_cast<int>((now_nanosecs / 1000000000.0 - static_cast<double>(now_secs)) * 1000000000);
-  nebula_packets_ptr_->packets.emplace_back(nebula_packet);
 
-  nebula_packets_ptr_->header.stamp = nebula_packets_ptr_->packets.front().stamp;
-  nebula_packets_ptr_->header.frame_id = sensor_configuration_->frame_id;
+  nebula_packets->header.stamp = nebula_packet.stamp;
+  nebula_packets->header.frame_id = sensor_configuration_->frame_id;
 
-  nebula_packets_reception_callback_(std::move(nebula_packets_ptr_));
-  nebula_packets_ptr_ = std::make_unique<nebula_msgs::msg::NebulaPackets>();
+  nebula_packets_reception_callback_(std::move(nebula_packets));
 }
 
 Status ContinentalARS548HwInterface::SensorInterfaceStop()
@@ -220,7 +280,7 @@ Status ContinentalARS548HwInterface::SetSensorMounting(
   PrintInfo("pitch_autosar = " + std::to_string(pitch_autosar));
   PrintInfo("plug_orientation = " + std::to_string(plug_orientation));
 
-  if (!sensor_udp_driver_->sender()->isOpen()) {
+  if (!sensor_udp_driver_->sender() || !sensor_udp_driver_->sender()->isOpen()) {
     return Status::ERROR_1;
   }
 
@@ -259,7 +319,7 @@ Status ContinentalARS548HwInterface::SetVehicleParameters(
   PrintInfo("height_autosar = " + std::to_string(height_autosar));
   PrintInfo("wheel_base_autosar = " + std::to_string(wheel_base_autosar));
 
-  if (!sensor_udp_driver_->sender()->isOpen()) {
+  if (!sensor_udp_driver_->sender() || !sensor_udp_driver_->sender()->isOpen()) {
     return Status::ERROR_1;
   }
 
@@ -303,7 +363,7 @@ Status ContinentalARS548HwInterface::SetRadarParameters(
   PrintInfo("hcc = " + std::to_string(hcc));
   PrintInfo("power_save_standstill = " + std::to_string(power_save_standstill));
 
-  if (!sensor_udp_driver_->sender()->isOpen()) {
+  if (!sensor_udp_driver_->sender() || !sensor_udp_driver_->sender()->isOpen()) {
     return Status::ERROR_1;
   }
 
@@ -344,7 +404,7 @@ Status ContinentalARS548HwInterface::SetSensorIPAddress(const std::string & sens
   std::vector<uint8_t> send_vector(sizeof(ConfigurationPacket));
   std::memcpy(send_vector.data(), &configuration, sizeof(ConfigurationPacket));
 
-  if (!sensor_udp_driver_->sender()->isOpen()) {
+  if (!sensor_udp_driver_->sender() || !sensor_udp_driver_->sender()->isOpen()) {
     return Status::ERROR_1;
   }
 
@@ -375,7 +435,7 @@ Status ContinentalARS548HwInterface::SetAccelerationLateralCog(float lateral_acc
   std::vector<uint8_t> send_vector(sizeof(AccelerationLateralCoGPacket));
   std::memcpy(send_vector.data(), &acceleration_lateral_cog, sizeof(AccelerationLateralCoGPacket));
 
-  if (!sensor_udp_driver_->sender()->isOpen()) {
+  if (!sensor_udp_driver_->sender() || !sensor_udp_driver_->sender()->isOpen()) {
     return Status::ERROR_1;
   }
 
@@ -408,7 +468,7 @@ Status ContinentalARS548HwInterface::SetAccelerationLongitudinalCog(float longit
   std::memcpy(
     send_vector.data(), &acceleration_longitudinal_cog, sizeof(AccelerationLongitudinalCoGPacket));
 
-  if (!sensor_udp_driver_->sender()->isOpen()) {
+  if (!sensor_udp_driver_->sender() || !sensor_udp_driver_->sender()->isOpen()) {
     return Status::ERROR_1;
   }
 
@@ -439,7 +499,7 @@ Status ContinentalARS548HwInterface::SetCharacteristicSpeed(float characteristic
   std::vector<uint8_t> send_vector(sizeof(CharacteristicSpeedPacket));
   std::memcpy(send_vector.data(), &characteristic_speed_packet, sizeof(CharacteristicSpeedPacket));
 
-  if (!sensor_udp_driver_->sender()->isOpen()) {
+  if (!sensor_udp_driver_->sender() || !sensor_udp_driver_->sender()->isOpen()) {
     return Status::ERROR_1;
   }
 
@@ -475,7 +535,7 @@ Status ContinentalARS548HwInterface::SetDrivingDirection(int direction)
   std::vector<uint8_t> send_vector(sizeof(DrivingDirectionPacket));
   std::memcpy(send_vector.data(), &driving_direction_packet, sizeof(DrivingDirectionPacket));
 
-  if (!sensor_udp_driver_->sender()->isOpen()) {
+  if (!sensor_udp_driver_->sender() || !sensor_udp_driver_->sender()->isOpen()) {
     return Status::ERROR_1;
   }
 
@@ -507,7 +567,7 @@ Status ContinentalARS548HwInterface::SetSteeringAngleFrontAxle(float angle_rad)
   std::memcpy(
     send_vector.data(), &steering_angle_front_axle_packet, sizeof(SteeringAngleFrontAxlePacket));
 
-  if (!sensor_udp_driver_->sender()->isOpen()) {
+  if (!sensor_udp_driver_->sender() || !sensor_udp_driver_->sender()->isOpen()) {
     return Status::ERROR_1;
   }
 
@@ -538,7 +598,7 @@ Status ContinentalARS548HwInterface::SetVelocityVehicle(float velocity_kmh)
   std::vector<uint8_t> send_vector(sizeof(VelocityVehiclePacket));
   std::memcpy(send_vector.data(), &steering_angle_front_axle_packet, sizeof(VelocityVehiclePacket));
 
-  if (!sensor_udp_driver_->sender()->isOpen()) {
+  if (!sensor_udp_driver_->sender() || !sensor_udp_driver_->sender()->isOpen()) {
     return Status::ERROR_1;
   }
 
@@ -569,7 +629,7 @@ Status ContinentalARS548HwInterface::SetYawRate(float yaw_rate)
   std::vector<uint8_t> send_vector(sizeof(YawRatePacket));
   std::memcpy(send_vector.data(), &yaw_rate_packet, sizeof(YawRatePacket));
 
-  if (!sensor_udp_driver_->sender()->isOpen()) {
+  if (!sensor_udp_driver_->sender() || !sensor_udp_driver_->sender()->isOpen()) {
     return Status::ERROR_1;
   }
 
@@ -25,8 +25,7 @@ namespace drivers
 namespace continental_ars548
 {
 MultiContinentalARS548HwInterface::MultiContinentalARS548HwInterface()
-: sensor_io_context_{new ::drivers::common::IoContext(1)},
-  nebula_packets_ptr_{std::make_unique<nebula_msgs::msg::NebulaPackets>()}
+: sensor_io_context_{new ::drivers::common::IoContext(1)}
 {
 }
 
@@ -49,6 +48,31 @@ Status MultiContinentalARS548HwInterface::SetSensorConfiguration(
 
 Status MultiContinentalARS548HwInterface::SensorInterfaceStart()
 {
+  if (!sensor_configuration_->pcap_file.empty()) {
+    for (std::size_t sensor_id = 0; sensor_id < sensor_configuration_->sensor_ips.size();
+         sensor_id++) {
+      sensor_ip_to_frame_[sensor_configuration_->sensor_ips[sensor_id]] =
+        sensor_configuration_->frame_ids[sensor_id];
+    }
+
+    // There are no sensors to configure, so no configuration senders are opened
+    try {
+      pcap_replayer_ = std::make_unique<PcapReplayer>(
+        sensor_configuration_->pcap_file, sensor_configuration_->pcap_replay_speed);
+    } catch (const std::exception & ex) {
+      std::cerr << ex.what() << std::endl;
+      return Status::ERROR_1;
+    }
+    pcap_replayer_->setPortFilter(sensor_configuration_->data_port);
+    pcap_replayer_->start([this](const UdpPacketView * packets, size_t n_packets) {
+      for (size_t i = 0; i < n_packets; ++i) {
+        ReceiveSensorPacketCallback(
+          packets[i].data, packets[i].size, senderIp(packets[i]), packets[i].receive_time_ns);
+      }
+    });
+    return Status::OK;
+  }
+
   for (std::size_t sensor_id = 0; sensor_id < sensor_configuration_->sensor_ips.size();
        sensor_id++) {
     auto udp_driver = std::make_unique<::drivers::udp_driver::UdpDriver>(*sensor_io_context_);
@@ -56,16 +80,43 @@ Status MultiContinentalARS548HwInterface::SensorInterfaceStart()
       sensor_configuration_->frame_ids[sensor_id];
 
     try {
-      if (sensor_id == 0) {
+      if (
+        sensor_id == 0 && (sensor_configuration_->use_kernel_timestamps ||
+                           sensor_configuration_->receive_buffer_size > 0)) {
+        // Packets are delivered one by one, as they are not split into scans
+        sensor_batch_receiver_ = std::make_unique<UdpBatchReceiver>(
+          1, std::chrono::microseconds::zero(), DETECTION_LIST_UDP_PAYLOAD);
+        sensor_batch_receiver_->open(
+          sensor_configuration_->multicast_ip, sensor_configuration_->data_port);
+        sensor_batch_receiver_->joinMulticast(
+          sensor_configuration_->multicast_ip, sensor_configuration_->host_ip);
+        if (sensor_configuration_->receive_buffer_size > 0) {
+          sensor_batch_receiver_->setReceiveBufferSize(
+            sensor_configuration_->receive_buffer_size,
+            [this](const std::string & warning) { PrintError(warning); });
+        }
+        sensor_batch_receiver_->enableDropCounter();
+        if (sensor_configuration_->use_kernel_timestamps) {
+          sensor_batch_receiver_->enableKernelTimestamps();
+        }
+        sensor_batch_receiver_->start([this](const UdpPacketView * packets, size_t n_packets) {
+          for (size_t i = 0; i < n_packets; ++i) {
+            ReceiveSensorPacketCallback(
+              packets[i].data, packets[i].size, senderIp(packets[i]),
+              packets[i].receive_time_ns);
+          }
+        });
+      } else if (sensor_id == 0) {
         udp_driver->init_receiver(
           sensor_configuration_->multicast_ip, sensor_configuration_->data_port,
           sensor_configuration_->host_ip, sensor_configuration_->data_port, 2 << 16);
         udp_driver->receiver()->setMulticast(true);
         udp_driver->receiver()->open();
         udp_driver->receiver()->bind();
-        udp_driver->receiver()->asyncReceiveWithSender(std::bind(
-          &MultiContinentalARS548HwInterface::ReceiveSensorPacketCallback, this,
-          std::placeholders::_1, std::placeholders::_2));
+        udp_driver->receiver()->asyncReceiveWithSender(
+          [this](const std::vector<uint8_t> & buffer, const std::string & sender_ip) {
+            ReceiveSensorPacketCallback(buffer.data(), buffer.size(), sender_ip);
+          });
       }
 
       udp_driver->init_sender(
@@ -92,6 +143,14 @@ Status MultiContinentalARS548HwInterface::SensorInterfaceStart()
   return Status::OK;
 }
 
+PacketReceiveStatistics::Summary MultiContinentalARS548HwInterface::GetReceiveStatistics()
+{
+  if (sensor_batch_receiver_) {
+    receive_statistics_.setKernelDrops(sensor_batch_receiver_->kernelDrops());
+  }
+  return receive_statistics_.collect();
+}
+
 Status MultiContinentalARS548HwInterface::RegisterScanCallback(
   std::function<void(std::unique_ptr<nebula_msgs::msg::NebulaPackets>, const std::string &)>
     callback)
@@ -100,84 +159,88 @@ Status MultiContinentalARS548HwInterface::RegisterScanCallback(
   return Status::OK;
 }
 
+void MultiContinentalARS548HwInterface::RecycleScan(
+  std::unique_ptr<nebula_msgs::msg::NebulaPackets> scan)
+{
+  packets_arena_.recycle(std::move(scan));
+}
+
 void MultiContinentalARS548HwInterface::ReceiveSensorPacketCallback(
-  const std::vector<uint8_t> & buffer, const std::string & sender_ip)
+  const uint8_t * buffer, size_t size, const std::string & sender_ip, uint64_t receive_time_ns)
 {
-  if (buffer.size() < sizeof(HeaderPacket)) {
+  if (size < sizeof(HeaderPacket)) {
     PrintError("Unrecognized packet. Too short");
     return;
   }
 
   HeaderPacket header_packet{};
-  std::memcpy(&header_packet, buffer.data(), sizeof(HeaderPacket));
+  std::memcpy(&header_packet, buffer, sizeof(HeaderPacket));
 
   if (header_packet.service_id.value() != 0) {
     PrintError("Invalid service id");
     return;
   } else if (header_packet.method_id.value() == SENSOR_STATUS_METHOD_ID) {
     if (
-      buffer.size() != SENSOR_STATUS_UDP_PAYLOAD ||
+      size != SENSOR_STATUS_UDP_PAYLOAD ||
       header_packet.length.value() != SENSOR_STATUS_PDU_LENGTH) {
       PrintError("SensorStatus message with invalid size");
       return;
     }
-    ProcessDataPacket(buffer, sender_ip);
+    ProcessDataPacket(buffer, size, sender_ip, receive_time_ns);
   } else if (header_packet.method_id.value() == FILTER_STATUS_METHOD_ID) {
     if (
-      buffer.size() != FILTER_STATUS_UDP_PAYLOAD ||
+      size != FILTER_STATUS_UDP_PAYLOAD ||
       header_packet.length.value() != FILTER_STATUS_PDU_LENGTH) {
       PrintError("FilterStatus message with invalid size");
       return;
     }
 
-    ProcessFilterStatusPacket(buffer);
+    ProcessFilterStatusPacket(buffer, size);
   } else if (header_packet.method_id.value() == DETECTION_LIST_METHOD_ID) {
     if (
-      buffer.size() != DETECTION_LIST_UDP_PAYLOAD ||
+      size != DETECTION_LIST_UDP_PAYLOAD ||
       header_packet.length.value() != DETECTION_LIST_PDU_LENGTH) {
       PrintError("DetectionList message with invalid size");
       return;
     }
 
-    ProcessDataPacket(buffer, sender_ip);
+    ProcessDataPacket(buffer, size, sender_ip, receive_time_ns);
   } else if (header_packet.method_id.value() == OBJECT_LIST_METHOD_ID) {
     if (
-      buffer.size() != OBJECT_LIST_UDP_PAYLOAD ||
+      size != OBJECT_LIST_UDP_PAYLOAD ||
       header_packet.length.value() != OBJECT_LIST_PDU_LENGTH) {
       PrintError("ObjectList message with invalid size");
       return;
     }
 
-    ProcessDataPacket(buffer, sender_ip);
+    ProcessDataPacket(buffer, size, sender_ip, receive_time_ns);
   }
 }
 
 void MultiContinentalARS548HwInterface::ProcessFilterStatusPacket(
-  const std::vector<uint8_t> & buffer)
+  const uint8_t * buffer, size_t size)
 {
-  assert(buffer.size() == sizeof(FilterStatusPacket));
-  std::memcpy(&filter_status_, buffer.data(), sizeof(FilterStatusPacket));
+  assert(size == sizeof(FilterStatusPacket));
+  std::memcpy(&filter_status_, buffer, sizeof(FilterStatusPacket));
 }
 
 void MultiContinentalARS548HwInterface::ProcessDataPacket(
-  const std::vector<uint8_t> & buffer, const std::string & sensor_ip)
+  const uint8_t * buffer, size_t size, const std::string & sensor_ip, uint64_t receive_time_ns)
 {
-  nebula_msgs::msg::NebulaPacket nebula_packet;
-  nebula_packet.data = buffer;
-  auto now = std::chrono::system_clock::now();
+  auto nebula_packets = packets_arena_.acquireScan();
+  auto & nebula_packet = packets_arena_.append(*nebula_packets, buffer, size);
+  auto now = receive_statistics_.stampPacket(receive_time_ns);
   auto now_secs = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
   auto now_nanosecs =
     std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
   nebula_packet.stamp.sec = static_cast<int>(now_secs);
   nebula_packet.stamp.nanosec =
     static_cast<int>((now_nanosecs / 1000000000.0 - static_cast<double>(now_secs)) * 1000000000);
-  nebula_packets_ptr_->packets.emplace_back(nebula_packet);
 
-  nebula_packets_ptr_->header.stamp = nebula_packets_ptr_->packets.front().stamp;
-  nebula_packets_ptr_->header.frame_id = sensor_configuration_->frame_id;
+  nebula_packets->header.stamp = nebula_packet.stamp;
+  nebula_packets->header.frame_id = sensor_configuration_->frame_id;
 
-  nebula_packets_reception_callback_(std::move(nebula_packets_ptr_), sensor_ip);
-  nebula_packets_ptr_ = std::make_unique<nebula_msgs::msg::NebulaPackets>();
+  nebula_packets_reception_callback_(std::move(nebula_packets), sensor_ip);
 }
 
 Status MultiContinentalARS548HwInterface::SensorInterfaceStop()
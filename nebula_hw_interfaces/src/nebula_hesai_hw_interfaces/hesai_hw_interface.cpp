@@ -18,7 +18,8 @@ HesaiHwInterface::HesaiHwInterface()
   m_owned_ctx{new boost::asio::io_context(1)},
   cloud_udp_driver_{new ::drivers::udp_driver::UdpDriver(*cloud_io_context_)},
   tcp_driver_{new ::drivers::tcp_driver::TcpDriver(m_owned_ctx)},
-  scan_cloud_ptr_{std::make_unique<pandar_msgs::msg::PandarScan>()}
+  scan_cloud_ptr_{packets_arena_.acquireScan()},
+  scan_tracer_{std::make_shared<ScanLatencyTracer>("")}
 {
 }
 HesaiHwInterface::~HesaiHwInterface()
@@ -189,6 +190,56 @@ Status HesaiHwInterface::SensorInterfaceStart()
 {
   try {
     std::cout << "Starting UDP server on: " << *sensor_configuration_ << std::endl;
+    if (trace_scans_) {
+      scan_tracer_ = ScanLatencyTracer::forSensor(sensor_configuration_->frame_id);
+    }
+    if (sensor_configuration_->packet_ring_size > 0) {
+      packet_ring_ = std::make_unique<PacketRingWorker>(
+        sensor_configuration_->packet_ring_size, sensor_configuration_->packet_overflow_policy,
+        MTU_SIZE);
+      packet_ring_->start([this](const uint8_t * buffer, size_t size, uint64_t receive_time_ns) {
+        ReceiveSensorPacket(buffer, size, receive_time_ns);
+      });
+    }
+
+    if (!sensor_configuration_->pcap_file.empty()) {
+      pcap_replayer_ = std::make_unique<PcapReplayer>(
+        sensor_configuration_->pcap_file, sensor_configuration_->pcap_replay_speed);
+      pcap_replayer_->setPortFilter(sensor_configuration_->data_port);
+      pcap_replayer_->setSenderFilter(sensor_configuration_->sensor_ip);
+      pcap_replayer_->start([this](const UdpPacketView * packets, size_t n_packets) {
+        for (size_t i = 0; i < n_packets; ++i) {
+          EnqueueSensorPacket(packets[i].data, packets[i].size, packets[i].receive_time_ns);
+        }
+      });
+      return Status::OK;
+    }
+
+    if (
+      sensor_configuration_->receive_batch_size > 1 ||
+      sensor_configuration_->use_kernel_timestamps ||
+      sensor_configuration_->receive_buffer_size > 0) {
+      cloud_batch_receiver_ = std::make_unique<UdpBatchReceiver>(
+        sensor_configuration_->receive_batch_size,
+        std::chrono::microseconds(sensor_configuration_->receive_batch_timeout_us), MTU_SIZE);
+      cloud_batch_receiver_->open(sensor_configuration_->host_ip, sensor_configuration_->data_port);
+      if (sensor_configuration_->receive_buffer_size > 0) {
+        cloud_batch_receiver_->setReceiveBufferSize(
+          sensor_configuration_->receive_buffer_size,
+          [this](const std::string & warning) { PrintError(warning); });
+      }
+      cloud_batch_receiver_->enableDropCounter();
+      if (sensor_configuration_->use_kernel_timestamps) {
+        cloud_batch_receiver_->enableKernelTimestamps();
+      }
+      cloud_batch_receiver_->start([this](const UdpPacketView * packets, size_t n_packets) {
+        for (size_t i = 0; i < n_packets; ++i) {
+          EnqueueSensorPacket(packets[i].data, packets[i].size, packets[i].receive_time_ns);
+        }
+      });
+      return Status::OK;
+    }
+
     cloud_udp_driver_->init_receiver(
       sensor_configuration_->host_ip, sensor_configuration_->data_port);
 #ifdef WITH_DEBUG_STDOUT_HESAI_HW_INTERFACE
@@ -218,35 +269,109 @@ Status HesaiHwInterface::SensorInterfaceStart()
 }
 
 Status HesaiHwInterface::RegisterScanCallback(
-  std::function<void(std::unique_ptr<pandar_msgs::msg::PandarScan>)> scan_callback)
+  std::function<void(std::unique_ptr<nebula_msgs::msg::NebulaPackets>)> scan_callback)
 {
   scan_reception_callback_ = std::move(scan_callback);
   return Status::OK;
 }
 
+Status HesaiHwInterface::RegisterPacketCallback(
+  std::function<void(const nebula_msgs::msg::NebulaPacket &)> packet_callback)
+{
+  packet_reception_callback_ = std::move(packet_callback);
+  return Status::OK;
+}
+
+void HesaiHwInterface::RecycleScan(std::unique_ptr<nebula_msgs::msg::NebulaPackets> scan)
+{
+  packets_arena_.recycle(std::move(scan));
+}
+
+void HesaiHwInterface::SetScanTracing(bool enabled)
+{
+  trace_scans_ = enabled;
+}
+
 void HesaiHwInterface::ReceiveSensorPacketCallback(const std::vector<uint8_t> & buffer)
+{
+  EnqueueSensorPacket(buffer.data(), buffer.size(), 0);
+}
+
+PacketReceiveStatistics::Summary HesaiHwInterface::GetReceiveStatistics()
+{
+  if (cloud_batch_receiver_) {
+    receive_statistics_.setKernelDrops(cloud_batch_receiver_->kernelDrops());
+  }
+  auto summary = receive_statistics_.collect();
+  if (packet_ring_) {
+    summary.n_dropped_packets = packet_ring_->takeDropped();
+  }
+  return summary;
+}
+
+uint64_t HesaiHwInterface::GetKernelDrops() const
+{
+  return cloud_batch_receiver_ ? cloud_batch_receiver_->kernelDrops() : 0;
+}
+
+void HesaiHwInterface::EnqueueSensorPacket(
+  const uint8_t * buffer, size_t size, uint64_t receive_time_ns)
+{
+  if (!packet_ring_) {
+    ReceiveSensorPacket(buffer, size, receive_time_ns);
+    return;
+  }
+
+  if (receive_time_ns == 0) {
+    // Stamp the packet before it waits in the ring
+    receive_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+  }
+  packet_ring_->push(buffer, size, receive_time_ns);
+}
+
+void HesaiHwInterface::ReceiveSensorPacket(
+  const uint8_t * buffer, size_t size, uint64_t receive_time_ns)
 {
   int scan_phase = static_cast<int>(sensor_configuration_->scan_phase * 100.0);
-  if (!is_valid_packet_(buffer.size())) {
-    PrintDebug("Invalid Packet: " + std::to_string(buffer.size()));
+  if (!is_valid_packet_(size)) {
+    PrintDebug("Invalid Packet: " + std::to_string(size));
     return;
   }
-  const uint32_t buffer_size = buffer.size();
-  pandar_msgs::msg::PandarPacket pandar_packet;
-  std::copy_n(std::make_move_iterator(buffer.begin()), buffer_size, pandar_packet.data.begin());
-  pandar_packet.size = buffer_size;
-  auto now = std::chrono::system_clock::now();
+
+  // Only buffer packets if there is someone to receive the completed scan
+  nebula_msgs::msg::NebulaPacket * packet = &unbuffered_packet_;
+  if (scan_reception_callback_) {
+    packet = &packets_arena_.append(*scan_cloud_ptr_, buffer, size);
+  } else {
+    unbuffered_packet_.data.assign(buffer, buffer + size);
+  }
+
+  auto now = receive_statistics_.stampPacket(receive_time_ns);
   auto now_secs = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
   auto now_nanosecs =
     std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
-  pandar_packet.stamp.sec = static_cast<int>(now_secs);
-  pandar_packet.stamp.nanosec = static_cast<std::uint32_t>(now_nanosecs % 1'000'000'000);
-  scan_cloud_ptr_->packets.emplace_back(pandar_packet);
+  packet->stamp.sec = static_cast<int>(now_secs);
+  packet->stamp.nanosec = static_cast<std::uint32_t>(now_nanosecs % 1'000'000'000);
+
+  if (packet_reception_callback_) {
+    packet_reception_callback_(*packet);
+  }
+
+  if (!scan_reception_callback_) {
+    return;
+  }
+
+  const uint64_t scan_id = ScanIdFromStamp(scan_cloud_ptr_->packets.front().stamp);
+  if (scan_cloud_ptr_->packets.size() == 1) {
+    scan_tracer_->record(ScanStage::FIRST_PACKET_RECEIVED, scan_id, scan_id);
+  }
 
   int current_phase = 0;
   bool comp_flg = false;
 
-  const auto & data = scan_cloud_ptr_->packets.back().data;
+  const auto & data = packet->data;
   current_phase = (data[azimuth_index_] & 0xff) + ((data[azimuth_index_ + 1] & 0xff) << 8);
   if (is_solid_state) {
     current_phase = (static_cast<int>(current_phase) + 36000 - 0) % 12000;
@@ -266,11 +391,14 @@ void HesaiHwInterface::ReceiveSensorPacketCallback(const std::vector<uint8_t> &
   }
 
   if (comp_flg) {  // Scan complete
+    scan_tracer_->record(ScanStage::LAST_PACKET_RECEIVED, scan_id, ScanIdFromStamp(packet->stamp));
+    scan_tracer_->record(ScanStage::SCAN_COMPLETED, scan_id);
     if (scan_reception_callback_) {
       scan_cloud_ptr_->header.stamp = scan_cloud_ptr_->packets.front().stamp;
       // Callback
+      packets_arena_.completeScan(*scan_cloud_ptr_);
       scan_reception_callback_(std::move(scan_cloud_ptr_));
-      scan_cloud_ptr_ = std::make_unique<pandar_msgs::msg::PandarScan>();
+      scan_cloud_ptr_ = packets_arena_.acquireScan();
     }
   }
 }
@@ -323,7 +451,9 @@ Status HesaiHwInterface::InitializeTcpDriver()
 Status HesaiHwInterface::FinalizeTcpDriver()
 {
   try {
-    tcp_driver_->close();
+    if (tcp_driver_) {
+      tcp_driver_->close();
+    }
   } catch (std::exception & e) {
     PrintError("Error while finalizing the TcpDriver");
     return Status::UDP_CONNECTION_ERROR;
@@ -0,0 +1,90 @@
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/packet_ring_worker.hpp"
+
+#include <chrono>
+
+namespace nebula
+{
+namespace drivers
+{
+
+namespace
+{
+/// @brief The longest the worker thread sleeps without checking the ring. `push` does not take the
+/// mutex, so a notification can get lost in the instant before the worker starts waiting; this
+/// bounds the added latency in that case
+constexpr std::chrono::milliseconds MAX_SLEEP{1};
+}  // namespace
+
+PacketRingWorker::PacketRingWorker(
+  size_t capacity, PacketOverflowPolicy overflow_policy, size_t max_packet_size)
+: ring_(capacity, max_packet_size, overflow_policy)
+{
+}
+
+PacketRingWorker::~PacketRingWorker()
+{
+  stop();
+}
+
+void PacketRingWorker::start(PacketCallback callback)
+{
+  stop();
+  callback_ = std::move(callback);
+  running_ = true;
+  thread_ = std::thread(&PacketRingWorker::processLoop, this);
+}
+
+void PacketRingWorker::stop()
+{
+  if (!thread_.joinable()) {
+    return;
+  }
+
+  running_ = false;
+  wakeup_.notify_one();
+  thread_.join();
+}
+
+bool PacketRingWorker::push(const uint8_t * data, size_t size, uint64_t receive_time_ns)
+{
+  const bool queued = ring_.push(data, size, receive_time_ns);
+  // Pairs with the fence in processLoop: either the worker sees the packet before sleeping, or
+  // this thread sees that it is sleeping
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (queued && sleeping_.load(std::memory_order_relaxed)) {
+    wakeup_.notify_one();
+  }
+  return queued;
+}
+
+uint64_t PacketRingWorker::takeDropped()
+{
+  const uint64_t dropped = ring_.dropped();
+  const uint64_t n_new_drops = dropped - n_reported_drops_;
+  n_reported_drops_ = dropped;
+  return n_new_drops;
+}
+
+void PacketRingWorker::processLoop()
+{
+  const auto process = [this](const RingPacketView & packet) {
+    callback_(packet.data, packet.size, packet.receive_time_ns);
+  };
+
+  while (running_) {
+    if (ring_.pop(process)) {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(wakeup_mutex_);
+    sleeping_.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (ring_.empty() && running_) {
+      wakeup_.wait_for(lock, MAX_SLEEP);
+    }
+    sleeping_.store(false, std::memory_order_relaxed);
+  }
+}
+
+}  // namespace drivers
+}  // namespace nebula
@@ -0,0 +1,373 @@
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/pcap_replayer.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+namespace nebula
+{
+namespace drivers
+{
+
+namespace
+{
+constexpr uint32_t PCAP_MAGIC_US = 0xa1b2c3d4;
+constexpr uint32_t PCAP_MAGIC_NS = 0xa1b23c4d;
+constexpr uint32_t PCAPNG_MAGIC = 0x0a0d0d0a;
+
+constexpr uint32_t LINKTYPE_NULL = 0;
+constexpr uint32_t LINKTYPE_ETHERNET = 1;
+constexpr uint32_t LINKTYPE_RAW = 101;
+constexpr uint32_t LINKTYPE_LINUX_SLL = 113;
+constexpr uint32_t LINKTYPE_IPV4 = 228;
+constexpr uint32_t LINKTYPE_LINUX_SLL2 = 276;
+
+constexpr uint16_t ETHERTYPE_IPV4 = 0x0800;
+constexpr uint16_t ETHERTYPE_VLAN = 0x8100;
+constexpr uint16_t ETHERTYPE_QINQ = 0x88a8;
+
+constexpr size_t IPV4_MIN_HEADER_SIZE = 20;
+constexpr size_t UDP_HEADER_SIZE = 8;
+constexpr uint8_t IP_PROTOCOL_UDP = 17;
+constexpr uint16_t IP_MORE_FRAGMENTS = 0x2000;
+constexpr uint16_t IP_FRAGMENT_OFFSET_MASK = 0x1fff;
+
+/// @brief Waiting closer than this to a datagram's time is done by spinning, as sleeping is not
+/// accurate enough to preserve the spacing of packets only tens of microseconds apart
+constexpr std::chrono::microseconds SPIN_THRESHOLD{200};
+
+struct PcapGlobalHeader
+{
+  uint32_t magic;
+  uint16_t version_major;
+  uint16_t version_minor;
+  int32_t thiszone;
+  uint32_t sigfigs;
+  uint32_t snaplen;
+  uint32_t network;
+};
+
+struct PcapRecordHeader
+{
+  uint32_t ts_sec;
+  uint32_t ts_frac;
+  uint32_t incl_len;
+  uint32_t orig_len;
+};
+
+uint16_t readBe16(const uint8_t * data)
+{
+  return static_cast<uint16_t>((data[0] << 8) | data[1]);
+}
+
+uint32_t swap32(uint32_t value, bool swapped)
+{
+  return swapped ? __builtin_bswap32(value) : value;
+}
+}  // namespace
+
+PcapReplayer::PcapReplayer(const std::string & pcap_file, double speed)
+: speed_(std::max(speed, 0.))
+{
+  file_ = std::fopen(pcap_file.c_str(), "rb");
+  if (file_ == nullptr) {
+    throw std::runtime_error("Could not open " + pcap_file + ": " + std::strerror(errno));
+  }
+  // Captures are read sequentially, a large buffer keeps replaying as fast as possible cheap
+  std::setvbuf(file_, nullptr, _IOFBF, 1 << 20);
+
+  PcapGlobalHeader header{};
+  if (std::fread(&header, sizeof(header), 1, file_) != 1) {
+    std::fclose(file_);
+    throw std::runtime_error(pcap_file + " is too short to be a PCAP capture");
+  }
+
+  if (header.magic == PCAPNG_MAGIC) {
+    std::fclose(file_);
+    throw std::runtime_error(
+      pcap_file + " is a pcapng capture, convert it with `editcap -F pcap` first");
+  }
+
+  swapped_ = header.magic == __builtin_bswap32(PCAP_MAGIC_US) ||
+             header.magic == __builtin_bswap32(PCAP_MAGIC_NS);
+  const uint32_t magic = swap32(header.magic, swapped_);
+  if (magic != PCAP_MAGIC_US && magic != PCAP_MAGIC_NS) {
+    std::fclose(file_);
+    throw std::runtime_error(pcap_file + " is not a PCAP capture");
+  }
+  nanosecond_timestamps_ = magic == PCAP_MAGIC_NS;
+
+  link_type_ = swap32(header.network, swapped_) & 0xffff;
+  switch (link_type_) {
+    case LINKTYPE_NULL:
+    case LINKTYPE_ETHERNET:
+    case LINKTYPE_RAW:
+    case LINKTYPE_LINUX_SLL:
+    case LINKTYPE_IPV4:
+    case LINKTYPE_LINUX_SLL2:
+      break;
+    default:
+      std::fclose(file_);
+      throw std::runtime_error(
+        pcap_file + " has unsupported link type " + std::to_string(link_type_));
+  }
+
+  first_record_offset_ = std::ftell(file_);
+  record_.reserve(std::max<uint32_t>(swap32(header.snaplen, swapped_), 1 << 16));
+}
+
+PcapReplayer::~PcapReplayer()
+{
+  stop();
+  if (file_ != nullptr) {
+    std::fclose(file_);
+  }
+}
+
+void PcapReplayer::setSenderFilter(const std::string & sender_ip)
+{
+  if (sender_ip.empty()) {
+    sender_filter_ = 0;
+    return;
+  }
+  in_addr address{};
+  if (inet_pton(AF_INET, sender_ip.c_str(), &address) != 1) {
+    throw std::runtime_error(sender_ip + " is not a valid IPv4 address");
+  }
+  sender_filter_ = address.s_addr;
+}
+
+void PcapReplayer::start(BatchCallback callback)
+{
+  stop();
+  std::fseek(file_, first_record_offset_, SEEK_SET);
+  reassembling_ = false;
+  finished_ = false;
+  callback_ = std::move(callback);
+  running_ = true;
+  thread_ = std::thread(&PcapReplayer::replayLoop, this);
+}
+
+void PcapReplayer::stop()
+{
+  if (!thread_.joinable()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(wait_mutex_);
+    running_ = false;
+  }
+  wait_cv_.notify_all();
+  thread_.join();
+}
+
+void PcapReplayer::replayLoop()
+{
+  UdpPacketView packet{};
+  uint64_t capture_time_ns = 0;
+  uint64_t first_capture_time_ns = 0;
+  bool has_first_capture_time = false;
+  std::chrono::steady_clock::time_point replay_start;
+
+  while (running_) {
+    if (!readDatagram(packet, capture_time_ns)) {
+      finished_ = true;
+      return;
+    }
+
+    if (!has_first_capture_time) {
+      first_capture_time_ns = capture_time_ns;
+      has_first_capture_time = true;
+      replay_start = std::chrono::steady_clock::now();
+    }
+
+    if (speed_ > 0) {
+      // Captures are not necessarily ordered by time, earlier datagrams are delivered right away
+      const auto capture_offset_ns =
+        static_cast<double>(static_cast<int64_t>(capture_time_ns - first_capture_time_ns));
+      const auto replay_offset =
+        std::chrono::nanoseconds(static_cast<int64_t>(std::max(capture_offset_ns, 0.) / speed_));
+      if (!waitUntil(replay_start + replay_offset)) {
+        return;
+      }
+    }
+
+    packet.receive_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                               std::chrono::system_clock::now().time_since_epoch())
+                               .count();
+    callback_(&packet, 1);
+    n_packets_++;
+  }
+}
+
+bool PcapReplayer::waitUntil(std::chrono::steady_clock::time_point time)
+{
+  {
+    std::unique_lock<std::mutex> lock(wait_mutex_);
+    wait_cv_.wait_until(lock, time - SPIN_THRESHOLD, [this] { return !running_; });
+  }
+  while (running_ && std::chrono::steady_clock::now() < time) {
+  }
+  return running_;
+}
+
+bool PcapReplayer::readDatagram(UdpPacketView & packet, uint64_t & capture_time_ns)
+{
+  PcapRecordHeader header{};
+  while (std::fread(&header, sizeof(header), 1, file_) == 1) {
+    const uint32_t incl_len = swap32(header.incl_len, swapped_);
+    record_.resize(incl_len);
+    if (incl_len > 0 && std::fread(record_.data(), incl_len, 1, file_) != 1) {
+      // The capture was cut off in the middle of a record
+      return false;
+    }
+
+    const uint64_t ts_frac = swap32(header.ts_frac, swapped_);
+    capture_time_ns = static_cast<uint64_t>(swap32(header.ts_sec, swapped_)) * 1'000'000'000 +
+                      (nanosecond_timestamps_ ? ts_frac : ts_frac * 1000);
+
+    const uint8_t * data = record_.data();
+    size_t size = record_.size();
+    size_t ip_offset = 0;
+    switch (link_type_) {
+      case LINKTYPE_ETHERNET: {
+        size_t ethertype_offset = 12;
+        while (size >= ethertype_offset + 2 &&
+               (readBe16(data + ethertype_offset) == ETHERTYPE_VLAN ||
+                readBe16(data + ethertype_offset) == ETHERTYPE_QINQ)) {
+          ethertype_offset += 4;
+        }
+        if (size < ethertype_offset + 2 || readBe16(data + ethertype_offset) != ETHERTYPE_IPV4) {
+          continue;
+        }
+        ip_offset = ethertype_offset + 2;
+        break;
+      }
+      case LINKTYPE_LINUX_SLL:
+        if (size < 16 || readBe16(data + 14) != ETHERTYPE_IPV4) {
+          continue;
+        }
+        ip_offset = 16;
+        break;
+      case LINKTYPE_LINUX_SLL2:
+        if (size < 20 || readBe16(data) != ETHERTYPE_IPV4) {
+          continue;
+        }
+        ip_offset = 20;
+        break;
+      case LINKTYPE_NULL: {
+        // The address family is stored in the byte order of the capturing host
+        uint32_t family;
+        if (size < 4) {
+          continue;
+        }
+        std::memcpy(&family, data, sizeof(family));
+        if (family != AF_INET && __builtin_bswap32(family) != AF_INET) {
+          continue;
+        }
+        ip_offset = 4;
+        break;
+      }
+      default:
+        ip_offset = 0;
+        break;
+    }
+
+    if (parseIpv4(data + ip_offset, size - std::min(size, ip_offset), packet)) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool PcapReplayer::parseIpv4(const uint8_t * ip, size_t size, UdpPacketView & packet)
+{
+  if (size < IPV4_MIN_HEADER_SIZE || (ip[0] >> 4) != 4 || ip[9] != IP_PROTOCOL_UDP) {
+    return false;
+  }
+
+  const size_t header_size = (ip[0] & 0x0f) * 4;
+  const size_t total_size = std::min<size_t>(readBe16(ip + 2), size);
+  if (header_size < IPV4_MIN_HEADER_SIZE || total_size < header_size) {
+    return false;
+  }
+
+  uint32_t source;
+  std::memcpy(&source, ip + 12, sizeof(source));
+  // Filtered before reassembly, so that other senders' fragments do not interrupt the sensor's
+  if (sender_filter_ != 0 && source != sender_filter_) {
+    return false;
+  }
+  const uint16_t id = readBe16(ip + 4);
+  const uint16_t flags_and_offset = readBe16(ip + 6);
+  const bool more_fragments = flags_and_offset & IP_MORE_FRAGMENTS;
+  const size_t fragment_offset = (flags_and_offset & IP_FRAGMENT_OFFSET_MASK) * 8;
+  const uint8_t * ip_payload = ip + header_size;
+  const size_t ip_payload_size = total_size - header_size;
+
+  const uint8_t * udp = ip_payload;
+  size_t udp_size = ip_payload_size;
+
+  if (more_fragments || fragment_offset > 0) {
+    if (fragment_offset == 0) {
+      if (reassembling_) {
+        n_incomplete_++;
+      }
+      reassembling_ = true;
+      reassembly_source_ = source;
+      reassembly_id_ = id;
+      reassembly_offset_ = 0;
+      reassembly_.clear();
+    } else if (
+      !reassembling_ || source != reassembly_source_ || id != reassembly_id_ ||
+      fragment_offset != reassembly_offset_) {
+      // A fragment is missing or out of order, the datagram cannot be reassembled
+      if (reassembling_ || !more_fragments) {
+        n_incomplete_++;
+      }
+      reassembling_ = false;
+      return false;
+    }
+
+    reassembly_.insert(reassembly_.end(), ip_payload, ip_payload + ip_payload_size);
+    reassembly_offset_ += ip_payload_size;
+    if (more_fragments) {
+      return false;
+    }
+
+    reassembling_ = false;
+    udp = reassembly_.data();
+    udp_size = reassembly_.size();
+  }
+
+  if (udp_size < UDP_HEADER_SIZE) {
+    return false;
+  }
+
+  const uint16_t destination_port = readBe16(udp + 2);
+  if (port_filter_ != 0 && destination_port != port_filter_) {
+    return false;
+  }
+
+  const size_t udp_length = std::min<size_t>(readBe16(udp + 4), udp_size);
+  if (udp_length < UDP_HEADER_SIZE) {
+    return false;
+  }
+
+  packet.data = udp + UDP_HEADER_SIZE;
+  packet.size = udp_length - UDP_HEADER_SIZE;
+  packet.sender = sockaddr_in{};
+  packet.sender.sin_family = AF_INET;
+  packet.sender.sin_port = htons(readBe16(udp));
+  packet.sender.sin_addr.s_addr = source;
+  return true;
+}
+
+}  // namespace drivers
+}  // namespace nebula
@@ -0,0 +1,326 @@
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/udp_batch_receiver.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace nebula
+{
+namespace drivers
+{
+
+namespace
+{
+/// @brief How long the receiver thread waits for the first datagram of a batch. Only bounds the
+/// latency of noticing a closed socket, `stop` wakes the thread up immediately
+constexpr std::chrono::milliseconds IDLE_POLL_TIMEOUT{100};
+
+/// @brief Room for all ancillary data the receiver can request per datagram
+constexpr size_t CONTROL_SLOT_SIZE = CMSG_SPACE(sizeof(timespec)) + CMSG_SPACE(sizeof(uint32_t));
+
+timespec toTimespec(std::chrono::nanoseconds duration)
+{
+  timespec ts{};
+  ts.tv_sec = std::chrono::duration_cast<std::chrono::seconds>(duration).count();
+  ts.tv_nsec = (duration - std::chrono::seconds(ts.tv_sec)).count();
+  return ts;
+}
+
+std::runtime_error socketError(const std::string & what)
+{
+  return std::runtime_error(what + ": " + std::strerror(errno));
+}
+}  // namespace
+
+std::string senderIp(const UdpPacketView & packet)
+{
+  char ip[INET_ADDRSTRLEN];
+  if (inet_ntop(AF_INET, &packet.sender.sin_addr, ip, sizeof(ip)) == nullptr) {
+    return "";
+  }
+  return ip;
+}
+
+UdpBatchReceiver::UdpBatchReceiver(
+  size_t batch_size, std::chrono::microseconds batch_timeout, size_t max_packet_size)
+: batch_size_(std::max<size_t>(batch_size, 1)),
+  batch_timeout_(std::max(batch_timeout, std::chrono::microseconds::zero())),
+  max_packet_size_(max_packet_size),
+  slots_(batch_size_ * max_packet_size_),
+  iovecs_(batch_size_),
+  headers_(batch_size_),
+  control_(batch_size_ * CONTROL_SLOT_SIZE),
+  senders_(batch_size_),
+  batch_(batch_size_)
+{
+  for (size_t i = 0; i < batch_size_; ++i) {
+    iovecs_[i].iov_base = slots_.data() + i * max_packet_size_;
+    iovecs_[i].iov_len = max_packet_size_;
+  }
+}
+
+UdpBatchReceiver::~UdpBatchReceiver()
+{
+  stop();
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+  if (wakeup_fd_ >= 0) {
+    close(wakeup_fd_);
+  }
+}
+
+void UdpBatchReceiver::open(const std::string & host_ip, uint16_t port)
+{
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = htons(port);
+  if (inet_pton(AF_INET, host_ip.c_str(), &address.sin_addr) != 1) {
+    throw std::runtime_error("Invalid host IP: " + host_ip);
+  }
+
+  fd_ = socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+  if (fd_ < 0) {
+    throw socketError("Could not open UDP socket");
+  }
+
+  int enable = 1;
+  if (setsockopt(fd_, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable)) < 0) {
+    throw socketError("Could not set SO_REUSEADDR");
+  }
+
+  if (bind(fd_, reinterpret_cast<sockaddr *>(&address), sizeof(address)) < 0) {
+    throw socketError("Could not bind to " + host_ip + ":" + std::to_string(port));
+  }
+
+  wakeup_fd_ = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+  if (wakeup_fd_ < 0) {
+    throw socketError("Could not create eventfd");
+  }
+}
+
+void UdpBatchReceiver::joinMulticast(
+  const std::string & group_ip, const std::string & interface_ip)
+{
+  ip_mreq request{};
+  if (
+    inet_pton(AF_INET, group_ip.c_str(), &request.imr_multiaddr) != 1 ||
+    inet_pton(AF_INET, interface_ip.c_str(), &request.imr_interface) != 1) {
+    throw std::runtime_error(
+      "Invalid multicast group or interface IP: " + group_ip + ", " + interface_ip);
+  }
+
+  if (setsockopt(fd_, IPPROTO_IP, IP_ADD_MEMBERSHIP, &request, sizeof(request)) < 0) {
+    throw socketError("Could not join multicast group " + group_ip);
+  }
+}
+
+void UdpBatchReceiver::enableKernelTimestamps()
+{
+  int enable = 1;
+  if (setsockopt(fd_, SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) < 0) {
+    throw socketError("Could not set SO_TIMESTAMPNS");
+  }
+}
+
+size_t UdpBatchReceiver::setReceiveBufferSize(size_t size, const WarningCallback & warn)
+{
+  const int requested = static_cast<int>(std::min<size_t>(size, std::numeric_limits<int>::max()));
+  if (
+    setsockopt(fd_, SOL_SOCKET, SO_RCVBUFFORCE, &requested, sizeof(requested)) < 0 &&
+    setsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &requested, sizeof(requested)) < 0) {
+    throw socketError("Could not set SO_RCVBUF");
+  }
+
+  const size_t granted_size = receiveBufferSize() / 2;
+  if (granted_size < size && warn) {
+    warn(
+      "Receive buffer size capped at " + std::to_string(granted_size) + " instead of " +
+      std::to_string(size) + " bytes, raise net.core.rmem_max or grant CAP_NET_ADMIN");
+  }
+  return granted_size;
+}
+
+size_t UdpBatchReceiver::receiveBufferSize() const
+{
+  int size = 0;
+  socklen_t length = sizeof(size);
+  if (getsockopt(fd_, SOL_SOCKET, SO_RCVBUF, &size, &length) < 0) {
+    throw socketError("Could not get SO_RCVBUF");
+  }
+  return static_cast<size_t>(size);
+}
+
+void UdpBatchReceiver::enableDropCounter()
+{
+  int enable = 1;
+  if (setsockopt(fd_, SOL_SOCKET, SO_RXQ_OVFL, &enable, sizeof(enable)) < 0) {
+    throw socketError("Could not set SO_RXQ_OVFL");
+  }
+}
+
+void UdpBatchReceiver::start(BatchCallback callback)
+{
+  if (fd_ < 0) {
+    throw std::runtime_error("UdpBatchReceiver has to be opened before it is started");
+  }
+
+  stop();
+  callback_ = std::move(callback);
+  running_ = true;
+  thread_ = std::thread(&UdpBatchReceiver::receiveLoop, this);
+}
+
+void UdpBatchReceiver::stop()
+{
+  if (!thread_.joinable()) {
+    return;
+  }
+
+  running_ = false;
+  uint64_t one = 1;
+  [[maybe_unused]] ssize_t written = write(wakeup_fd_, &one, sizeof(one));
+  thread_.join();
+
+  uint64_t counter;
+  [[maybe_unused]] ssize_t n_read = read(wakeup_fd_, &counter, sizeof(counter));
+}
+
+void UdpBatchReceiver::receiveLoop()
+{
+  while (running_) {
+    const size_t n_received = receiveBatch();
+    if (n_received > 0) {
+      deliverBatch(n_received);
+    }
+  }
+}
+
+size_t UdpBatchReceiver::receiveBatch()
+{
+  pollfd poll_fds[2] = {{fd_, POLLIN, 0}, {wakeup_fd_, POLLIN, 0}};
+
+  size_t n_received = 0;
+  std::chrono::steady_clock::time_point deadline;
+
+  while (n_received < batch_size_ && running_) {
+    std::chrono::nanoseconds timeout = IDLE_POLL_TIMEOUT;
+    if (n_received > 0) {
+      timeout = std::max(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+          deadline - std::chrono::steady_clock::now()),
+        std::chrono::nanoseconds::zero());
+    }
+
+    // With a zero timeout, the partial batch is delivered without waiting for more datagrams
+    if (n_received > 0 && timeout.count() == 0) {
+      break;
+    }
+
+    const timespec poll_timeout = toTimespec(timeout);
+    const int n_ready = ppoll(poll_fds, 2, &poll_timeout, nullptr);
+    if (n_ready < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      running_ = false;
+      break;
+    }
+    if (n_ready == 0) {
+      if (n_received > 0) {
+        break;
+      }
+      continue;
+    }
+    if (poll_fds[1].revents & POLLIN) {
+      break;
+    }
+    if (poll_fds[0].revents & (POLLERR | POLLNVAL)) {
+      running_ = false;
+      break;
+    }
+
+    for (size_t i = n_received; i < batch_size_; ++i) {
+      headers_[i] = {};
+      headers_[i].msg_hdr.msg_iov = &iovecs_[i];
+      headers_[i].msg_hdr.msg_iovlen = 1;
+      headers_[i].msg_hdr.msg_name = &senders_[i];
+      headers_[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+      headers_[i].msg_hdr.msg_control = control_.data() + i * CONTROL_SLOT_SIZE;
+      headers_[i].msg_hdr.msg_controllen = CONTROL_SLOT_SIZE;
+    }
+
+    const int n_new = recvmmsg(
+      fd_, headers_.data() + n_received, batch_size_ - n_received, MSG_DONTWAIT, nullptr);
+    if (n_new < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+        continue;
+      }
+      running_ = false;
+      break;
+    }
+
+    if (n_received == 0 && n_new > 0) {
+      deadline = std::chrono::steady_clock::now() + batch_timeout_;
+    }
+    n_received += n_new;
+  }
+
+  return n_received;
+}
+
+void UdpBatchReceiver::deliverBatch(size_t n_received)
+{
+  size_t n_packets = 0;
+  for (size_t i = 0; i < n_received; ++i) {
+    uint64_t receive_time_ns = 0;
+    msghdr & header = headers_[i].msg_hdr;
+    for (cmsghdr * cmsg = CMSG_FIRSTHDR(&header); cmsg; cmsg = CMSG_NXTHDR(&header, cmsg)) {
+      if (cmsg->cmsg_level != SOL_SOCKET) {
+        continue;
+      }
+      if (cmsg->cmsg_type == SCM_TIMESTAMPNS) {
+        timespec stamp;
+        std::memcpy(&stamp, CMSG_DATA(cmsg), sizeof(stamp));
+        receive_time_ns = static_cast<uint64_t>(stamp.tv_sec) * 1'000'000'000 + stamp.tv_nsec;
+      } else if (cmsg->cmsg_type == SO_RXQ_OVFL) {
+        uint32_t drop_counter;
+        std::memcpy(&drop_counter, CMSG_DATA(cmsg), sizeof(drop_counter));
+        // Unsigned subtraction handles the counter wrapping around
+        n_kernel_drops_ += static_cast<uint32_t>(drop_counter - last_drop_counter_);
+        last_drop_counter_ = drop_counter;
+      }
+    }
+
+    if (header.msg_flags & MSG_TRUNC) {
+      n_truncated_++;
+      continue;
+    }
+
+    UdpPacketView & packet = batch_[n_packets];
+    packet.data = static_cast<const uint8_t *>(iovecs_[i].iov_base);
+    packet.size = headers_[i].msg_len;
+    packet.receive_time_ns = receive_time_ns;
+    packet.sender = senders_[i];
+    n_packets++;
+  }
+
+  if (n_packets == 0) {
+    return;
+  }
+
+  callback_(batch_.data(), n_packets);
+  n_packets_ += n_packets;
+  n_batches_++;
+}
+
+}  // namespace drivers
+}  // namespace nebula
@@ -13,23 +13,58 @@ RobosenseHwInterface::RobosenseHwInterface()
 }
 
 void RobosenseHwInterface::ReceiveSensorPacketCallback(const std::vector<uint8_t> & buffer)
+{
+  EnqueueSensorPacket(buffer.data(), buffer.size(), 0);
+}
+
+PacketReceiveStatistics::Summary RobosenseHwInterface::GetReceiveStatistics()
+{
+  if (cloud_batch_receiver_) {
+    receive_statistics_.setKernelDrops(cloud_batch_receiver_->kernelDrops());
+  }
+  auto summary = receive_statistics_.collect();
+  if (packet_ring_) {
+    summary.n_dropped_packets = packet_ring_->takeDropped();
+  }
+  return summary;
+}
+
+void RobosenseHwInterface::EnqueueSensorPacket(
+  const uint8_t * buffer, size_t size, uint64_t receive_time_ns)
+{
+  if (!packet_ring_) {
+    ReceiveSensorPacket(buffer, size, receive_time_ns);
+    return;
+  }
+
+  if (receive_time_ns == 0) {
+    // Stamp the packet before it waits in the ring
+    receive_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+  }
+  packet_ring_->push(buffer, size, receive_time_ns);
+}
+
+void RobosenseHwInterface::ReceiveSensorPacket(
+  const uint8_t * buffer, size_t size, uint64_t receive_time_ns)
 {
   int scan_phase = static_cast<int>(sensor_configuration_->scan_phase * 100.0);
-  if (!is_valid_packet_(buffer.size())) {
-    PrintDebug("Invalid Packet: " + std::to_string(buffer.size()));
+  if (!is_valid_packet_(size)) {
+    PrintDebug("Invalid Packet: " + std::to_string(size));
     return;
   }
   // Copy data
-  uint32_t buffer_size = buffer.size();
+  uint32_t buffer_size = size;
   std::array<uint8_t, MTU_SIZE> packet_data{};
-  std::copy_n(std::make_move_iterator(buffer.begin()), buffer_size, packet_data.begin());
+  std::copy_n(buffer, buffer_size, packet_data.begin());
   robosense_msgs::msg::RobosensePacket msop_packet;
   msop_packet.data = packet_data;
 
   // Add timestamp (Sensor timestamp will be handled by decoder)
-  const auto now = std::chrono::system_clock::now();
+  const auto receive_time = receive_statistics_.stampPacket(receive_time_ns);
   const auto timestamp_ns =
-    std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
+    std::chrono::duration_cast<std::chrono::nanoseconds>(receive_time.time_since_epoch()).count();
 
   constexpr int nanosec_per_sec = 1000000000;
   msop_packet.stamp.sec = static_cast<int>(timestamp_ns / nanosec_per_sec);
@@ -103,6 +138,52 @@ Status RobosenseHwInterface::SensorInterfaceStart()
 {
   try {
     std::cout << "Starting UDP server for data packets on: " << *sensor_configuration_ << std::endl;
+    if (sensor_configuration_->packet_ring_size > 0) {
+      packet_ring_ = std::make_unique<PacketRingWorker>(
+        sensor_configuration_->packet_ring_size, sensor_configuration_->packet_overflow_policy);
+      packet_ring_->start([this](const uint8_t * buffer, size_t size, uint64_t receive_time_ns) {
+        ReceiveSensorPacket(buffer, size, receive_time_ns);
+      });
+    }
+
+    if (!sensor_configuration_->pcap_file.empty()) {
+      pcap_replayer_ = std::make_unique<PcapReplayer>(
+        sensor_configuration_->pcap_file, sensor_configuration_->pcap_replay_speed);
+      pcap_replayer_->setPortFilter(sensor_configuration_->data_port);
+      pcap_replayer_->setSenderFilter(sensor_configuration_->sensor_ip);
+      pcap_replayer_->start([this](const UdpPacketView * packets, size_t n_packets) {
+        for (size_t i = 0; i < n_packets; ++i) {
+          EnqueueSensorPacket(packets[i].data, packets[i].size, packets[i].receive_time_ns);
+        }
+      });
+      return Status::OK;
+    }
+
+    if (
+      sensor_configuration_->receive_batch_size > 1 ||
+      sensor_configuration_->use_kernel_timestamps ||
+      sensor_configuration_->receive_buffer_size > 0) {
+      cloud_batch_receiver_ = std::make_unique<UdpBatchReceiver>(
+        sensor_configuration_->receive_batch_size,
+        std::chrono::microseconds(sensor_configuration_->receive_batch_timeout_us));
+      cloud_batch_receiver_->open(sensor_configuration_->host_ip, sensor_configuration_->data_port);
+      if (sensor_configuration_->receive_buffer_size > 0) {
+        cloud_batch_receiver_->setReceiveBufferSize(
+          sensor_configuration_->receive_buffer_size,
+          [this](const std::string & warning) { PrintError(warning); });
+      }
+      cloud_batch_receiver_->enableDropCounter();
+      if (sensor_configuration_->use_kernel_timestamps) {
+        cloud_batch_receiver_->enableKernelTimestamps();
+      }
+      cloud_batch_receiver_->start([this](const UdpPacketView * packets, size_t n_packets) {
+        for (size_t i = 0; i < n_packets; ++i) {
+          EnqueueSensorPacket(packets[i].data, packets[i].size, packets[i].receive_time_ns);
+        }
+      });
+      return Status::OK;
+    }
+
     cloud_udp_driver_->init_receiver(
       sensor_configuration_->host_ip, sensor_configuration_->data_port);
     cloud_udp_driver_->receiver()->open();
@@ -126,6 +207,22 @@ Status RobosenseHwInterface::InfoInterfaceStart()
     PrintInfo(
       "Starting UDP server for info packets on: " + sensor_configuration_->sensor_ip + ":" +
       std::to_string(sensor_configuration_->gnss_port));
+    if (!sensor_configuration_->pcap_file.empty()) {
+      // Info packets are rare, so they are simply copied like the UDP driver would
+      info_pcap_replayer_ = std::make_unique<PcapReplayer>(
+        sensor_configuration_->pcap_file, sensor_configuration_->pcap_replay_speed);
+      info_pcap_replayer_->setPortFilter(sensor_configuration_->gnss_port);
+      info_pcap_replayer_->setSenderFilter(sensor_configuration_->sensor_ip);
+      info_pcap_replayer_->start([this](const UdpPacketView * packets, size_t n_packets) {
+        for (size_t i = 0; i < n_packets; ++i) {
+          ReceiveInfoPacketCallback(
+            std::vector<uint8_t>(packets[i].data, packets[i].data + packets[i].size));
+        }
+      });
+      std::this_thread::sleep_for(std::chrono::seconds(1));
+      return Status::OK;
+    }
+
     info_udp_driver_->init_receiver(
       sensor_configuration_->host_ip, sensor_configuration_->gnss_port);
     info_udp_driver_->receiver()->open();
@@ -232,6 +329,15 @@ void RobosenseHwInterface::PrintInfo(std::string info)
   }
 }
 
+void RobosenseHwInterface::PrintError(std::string error)
+{
+  if (parent_node_logger_) {
+    RCLCPP_ERROR_STREAM((*parent_node_logger_), error);
+  } else {
+    std::cerr << error << std::endl;
+  }
+}
+
 void RobosenseHwInterface::SetLogger(std::shared_ptr<rclcpp::Logger> logger)
 {
   parent_node_logger_ = logger;
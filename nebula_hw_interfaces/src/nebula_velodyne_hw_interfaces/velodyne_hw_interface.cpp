@@ -20,8 +20,11 @@ Status VelodyneHwInterface::InitializeSensorConfiguration(
     std::static_pointer_cast<VelodyneSensorConfiguration>(sensor_configuration);
   phase_ = (uint16_t)round(sensor_configuration_->scan_phase * 100);
 
-  GetDiagAsync();
-  GetStatusAsync();
+  // There is no sensor to query when replaying a capture
+  if (sensor_configuration_->pcap_file.empty()) {
+    GetDiagAsync();
+    GetStatusAsync();
+  }
   Status status = Status::OK;
   return status;
 }
@@ -39,6 +42,52 @@ Status VelodyneHwInterface::SetSensorConfiguration(
 Status VelodyneHwInterface::SensorInterfaceStart()
 {
   try {
+    if (sensor_configuration_->packet_ring_size > 0) {
+      packet_ring_ = std::make_unique<PacketRingWorker>(
+        sensor_configuration_->packet_ring_size, sensor_configuration_->packet_overflow_policy);
+      packet_ring_->start([this](const uint8_t * buffer, size_t size, uint64_t receive_time_ns) {
+        ReceiveSensorPacket(buffer, size, receive_time_ns);
+      });
+    }
+
+    if (!sensor_configuration_->pcap_file.empty()) {
+      pcap_replayer_ = std::make_unique<PcapReplayer>(
+        sensor_configuration_->pcap_file, sensor_configuration_->pcap_replay_speed);
+      pcap_replayer_->setPortFilter(sensor_configuration_->data_port);
+      pcap_replayer_->setSenderFilter(sensor_configuration_->sensor_ip);
+      pcap_replayer_->start([this](const UdpPacketView * packets, size_t n_packets) {
+        for (size_t i = 0; i < n_packets; ++i) {
+          EnqueueSensorPacket(packets[i].data, packets[i].size, packets[i].receive_time_ns);
+        }
+      });
+      return Status::OK;
+    }
+
+    if (
+      sensor_configuration_->receive_batch_size > 1 ||
+      sensor_configuration_->use_kernel_timestamps ||
+      sensor_configuration_->receive_buffer_size > 0) {
+      cloud_batch_receiver_ = std::make_unique<UdpBatchReceiver>(
+        sensor_configuration_->receive_batch_size,
+        std::chrono::microseconds(sensor_configuration_->receive_batch_timeout_us));
+      cloud_batch_receiver_->open(sensor_configuration_->host_ip, sensor_configuration_->data_port);
+      if (sensor_configuration_->receive_buffer_size > 0) {
+        cloud_batch_receiver_->setReceiveBufferSize(
+          sensor_configuration_->receive_buffer_size,
+          [this](const std::string & warning) { PrintError(warning); });
+      }
+      cloud_batch_receiver_->enableDropCounter();
+      if (sensor_configuration_->use_kernel_timestamps) {
+        cloud_batch_receiver_->enableKernelTimestamps();
+      }
+      cloud_batch_receiver_->start([this](const UdpPacketView * packets, size_t n_packets) {
+        for (size_t i = 0; i < n_packets; ++i) {
+          EnqueueSensorPacket(packets[i].data, packets[i].size, packets[i].receive_time_ns);
+        }
+      });
+      return Status::OK;
+    }
+
     cloud_udp_driver_->init_receiver(
       sensor_configuration_->host_ip, sensor_configuration_->data_port);
     cloud_udp_driver_->receiver()->open();
@@ -62,12 +111,47 @@ Status VelodyneHwInterface::RegisterScanCallback(
 }
 
 void VelodyneHwInterface::ReceiveSensorPacketCallback(const std::vector<uint8_t> & buffer)
+{
+  EnqueueSensorPacket(buffer.data(), buffer.size(), 0);
+}
+
+PacketReceiveStatistics::Summary VelodyneHwInterface::GetReceiveStatistics()
+{
+  if (cloud_batch_receiver_) {
+    receive_statistics_.setKernelDrops(cloud_batch_receiver_->kernelDrops());
+  }
+  auto summary = receive_statistics_.collect();
+  if (packet_ring_) {
+    summary.n_dropped_packets = packet_ring_->takeDropped();
+  }
+  return summary;
+}
+
+void VelodyneHwInterface::EnqueueSensorPacket(
+  const uint8_t * buffer, size_t size, uint64_t receive_time_ns)
+{
+  if (!packet_ring_) {
+    ReceiveSensorPacket(buffer, size, receive_time_ns);
+    return;
+  }
+
+  if (receive_time_ns == 0) {
+    // Stamp the packet before it waits in the ring
+    receive_time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                        std::chrono::system_clock::now().time_since_epoch())
+                        .count();
+  }
+  packet_ring_->push(buffer, size, receive_time_ns);
+}
+
+void VelodyneHwInterface::ReceiveSensorPacket(
+  const uint8_t * buffer, size_t size, uint64_t receive_time_ns)
 {
   // Process current packet
-  const uint32_t buffer_size = buffer.size();
+  const uint32_t buffer_size = size;
   velodyne_msgs::msg::VelodynePacket velodyne_packet;
-  std::copy_n(std::make_move_iterator(buffer.begin()), buffer_size, velodyne_packet.data.begin());
-  auto now = std::chrono::system_clock::now();
+  std::copy_n(buffer, buffer_size, velodyne_packet.data.begin());
+  auto now = receive_statistics_.stampPacket(receive_time_ns);
   auto now_secs = std::chrono::duration_cast<std::chrono::seconds>(now.time_since_epoch()).count();
   auto now_nanosecs =
     std::chrono::duration_cast<std::chrono::nanoseconds>(now.time_since_epoch()).count();
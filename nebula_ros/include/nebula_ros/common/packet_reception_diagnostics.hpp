@@ -0,0 +1,65 @@
+#ifndef NEBULA_PACKET_RECEPTION_DIAGNOSTICS_H
+#define NEBULA_PACKET_RECEPTION_DIAGNOSTICS_H
+
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/packet_receive_statistics.hpp"
+
+#include <diagnostic_updater/diagnostic_updater.hpp>
+
+#include <chrono>
+#include <string>
+
+namespace nebula
+{
+namespace ros
+{
+
+/// @brief Report the packet reception statistics of a hardware interface since the last update,
+/// including packets dropped by the kernel and by its packet ring
+/// @param summary The statistics collected from the hardware interface
+/// @param use_kernel_timestamps Whether kernel timestamps are enabled, the queueing delay is only
+/// known if they are
+/// @param diagnostics The diagnostic status to fill
+inline void AddPacketReceptionDiagnostics(
+  const drivers::PacketReceiveStatistics::Summary & summary, bool use_kernel_timestamps,
+  diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+{
+  using Microseconds = std::chrono::duration<double, std::micro>;
+
+  diagnostics.add("use_kernel_timestamps", use_kernel_timestamps ? "true" : "false");
+  diagnostics.add("kernel_dropped_packets", std::to_string(summary.n_kernel_dropped_packets));
+  diagnostics.add("dropped_packets", std::to_string(summary.n_dropped_packets));
+
+  if (use_kernel_timestamps) {
+    diagnostics.add("timestamped_packets", std::to_string(summary.n_timestamped_packets));
+    diagnostics.add(
+      "mean_queueing_delay_us",
+      std::to_string(Microseconds(summary.mean_queueing_delay).count()));
+    diagnostics.add(
+      "max_queueing_delay_us", std::to_string(Microseconds(summary.max_queueing_delay).count()));
+  }
+
+  if (use_kernel_timestamps && summary.n_timestamped_packets == 0) {
+    diagnostics.summary(diagnostic_msgs::msg::DiagnosticStatus::WARN, "No packets received");
+    return;
+  }
+  if (summary.n_kernel_dropped_packets > 0) {
+    diagnostics.summary(
+      diagnostic_msgs::msg::DiagnosticStatus::WARN, "Packets dropped by the kernel");
+    return;
+  }
+  if (summary.n_dropped_packets > 0) {
+    diagnostics.summary(
+      diagnostic_msgs::msg::DiagnosticStatus::WARN, "Packets dropped by the packet ring");
+    return;
+  }
+  if (!use_kernel_timestamps) {
+    diagnostics.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "Kernel timestamps disabled");
+    return;
+  }
+  diagnostics.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "");
+}
+
+}  // namespace ros
+}  // namespace nebula
+
+#endif  // NEBULA_PACKET_RECEPTION_DIAGNOSTICS_H
@@ -0,0 +1,222 @@
+#ifndef NEBULA_POINT_CLOUD_PUBLISHER_H
+#define NEBULA_POINT_CLOUD_PUBLISHER_H
+
+#include <diagnostic_updater/diagnostic_updater.hpp>
+#include <rclcpp/rclcpp.hpp>
+
+#include <sensor_msgs/msg/point_cloud2.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace nebula
+{
+namespace ros
+{
+
+/// @brief How the messages of a PointCloudPublisher are obtained
+enum class PointCloudOutputMode {
+  /// @brief Allocate a new message for every scan
+  ALLOCATE,
+  /// @brief Borrow messages from the middleware if it supports loans, otherwise RECYCLE
+  LOAN,
+  /// @brief Reuse the same message and its buffers for every scan
+  RECYCLE
+};
+
+/// @brief Converts String to PointCloudOutputMode
+/// @param output_mode Output mode name ("allocate", "loan" or "recycle")
+/// @return Corresponding PointCloudOutputMode
+inline PointCloudOutputMode PointCloudOutputModeFromString(const std::string & output_mode)
+{
+  if (output_mode == "allocate") return PointCloudOutputMode::ALLOCATE;
+  if (output_mode == "loan") return PointCloudOutputMode::LOAN;
+  if (output_mode == "recycle") return PointCloudOutputMode::RECYCLE;
+  throw std::invalid_argument("Unknown point cloud output mode: " + output_mode);
+}
+
+inline std::ostream & operator<<(std::ostream & os, PointCloudOutputMode const & arg)
+{
+  switch (arg) {
+    case PointCloudOutputMode::ALLOCATE:
+      os << "allocate";
+      break;
+    case PointCloudOutputMode::LOAN:
+      os << "loan";
+      break;
+    case PointCloudOutputMode::RECYCLE:
+      os << "recycle";
+      break;
+  }
+  return os;
+}
+
+/// @brief Declare a read-only parameter selecting the output mode of a point cloud topic
+/// @param node The node to declare the parameter on
+/// @param name The parameter name
+/// @return The configured output mode
+inline PointCloudOutputMode DeclarePointCloudOutputModeParameter(
+  rclcpp::Node & node, const std::string & name)
+{
+  rcl_interfaces::msg::ParameterDescriptor descriptor;
+  descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_STRING;
+  descriptor.read_only = true;
+  descriptor.dynamic_typing = false;
+  descriptor.additional_constraints = "allocate, loan or recycle";
+  node.declare_parameter<std::string>(name, "allocate", descriptor);
+  return PointCloudOutputModeFromString(node.get_parameter(name).as_string());
+}
+
+/// @brief A PointCloud2 publisher that avoids allocating a new multi-megabyte message per scan if
+/// configured to do so. Messages are filled in place: call `acquire()`, write to the returned
+/// message and then call `publish()`.
+///
+/// In LOAN mode, messages are borrowed from the middleware, which avoids all copies if it supports
+/// loans for PointCloud2. In RECYCLE mode, the same message is published by reference every scan,
+/// so its buffers are only allocated when the cloud grows. Intra-process subscribers still receive
+/// a copy in this mode, which is counted as an allocation.
+class PointCloudPublisher
+{
+private:
+  rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr publisher_;
+  PointCloudOutputMode mode_;
+
+  std::unique_ptr<sensor_msgs::msg::PointCloud2> allocated_msg_;
+  std::optional<rclcpp::LoanedMessage<sensor_msgs::msg::PointCloud2>> loaned_msg_;
+  sensor_msgs::msg::PointCloud2 recycled_msg_;
+  size_t recycled_capacity_{0};
+  sensor_msgs::msg::PointCloud2 * current_msg_{nullptr};
+
+  std::atomic<uint64_t> n_published_{0};
+  std::atomic<uint64_t> n_allocations_{0};
+
+  uint64_t last_reported_n_allocations_{0};
+  std::chrono::steady_clock::time_point last_report_time_{std::chrono::steady_clock::now()};
+
+public:
+  /// @brief Constructor
+  /// @param node The node to create the publisher on
+  /// @param topic The topic name
+  /// @param mode The requested output mode. LOAN falls back to RECYCLE if the middleware cannot
+  /// loan messages
+  PointCloudPublisher(rclcpp::Node & node, const std::string & topic, PointCloudOutputMode mode)
+  : publisher_(node.create_publisher<sensor_msgs::msg::PointCloud2>(topic, rclcpp::SensorDataQoS())),
+    mode_(mode)
+  {
+    if (mode_ == PointCloudOutputMode::LOAN && !publisher_->can_loan_messages()) {
+      RCLCPP_WARN_STREAM(
+        node.get_logger(),
+        "Middleware cannot loan messages on " << topic << ", recycling messages instead.");
+      mode_ = PointCloudOutputMode::RECYCLE;
+    }
+  }
+
+  PointCloudPublisher(const PointCloudPublisher &) = delete;
+  PointCloudPublisher & operator=(const PointCloudPublisher &) = delete;
+
+  /// @brief Whether the topic has any (intra- or inter-process) subscribers
+  bool hasSubscribers() const
+  {
+    return publisher_->get_subscription_count() > 0 ||
+           publisher_->get_intra_process_subscription_count() > 0;
+  }
+
+  /// @brief Obtain the message to be filled for the next `publish()` call. A previously acquired
+  /// message that has not been published is discarded.
+  /// @return The message. Only valid until `publish()` is called
+  sensor_msgs::msg::PointCloud2 & acquire()
+  {
+    switch (mode_) {
+      case PointCloudOutputMode::ALLOCATE:
+        allocated_msg_ = std::make_unique<sensor_msgs::msg::PointCloud2>();
+        n_allocations_++;
+        current_msg_ = allocated_msg_.get();
+        break;
+      case PointCloudOutputMode::LOAN:
+        loaned_msg_.emplace(publisher_->borrow_loaned_message());
+        current_msg_ = &loaned_msg_->get();
+        break;
+      case PointCloudOutputMode::RECYCLE:
+        current_msg_ = &recycled_msg_;
+        break;
+    }
+
+    return *current_msg_;
+  }
+
+  /// @brief The message obtained by the last `acquire()` call. Must not be called before
+  /// `acquire()` or after `publish()`
+  sensor_msgs::msg::PointCloud2 & acquired() { return *current_msg_; }
+
+  /// @brief Publish the message obtained by the last `acquire()` call
+  void publish()
+  {
+    if (!current_msg_) {
+      return;
+    }
+
+    switch (mode_) {
+      case PointCloudOutputMode::ALLOCATE:
+        publisher_->publish(std::move(allocated_msg_));
+        break;
+      case PointCloudOutputMode::LOAN:
+        publisher_->publish(std::move(*loaned_msg_));
+        loaned_msg_.reset();
+        break;
+      case PointCloudOutputMode::RECYCLE:
+        if (recycled_msg_.data.capacity() != recycled_capacity_) {
+          recycled_capacity_ = recycled_msg_.data.capacity();
+          n_allocations_++;
+        }
+        if (publisher_->get_intra_process_subscription_count() > 0) {
+          n_allocations_++;
+        }
+        publisher_->publish(recycled_msg_);
+        break;
+    }
+
+    current_msg_ = nullptr;
+    n_published_++;
+  }
+
+  /// @brief The effective output mode
+  PointCloudOutputMode mode() const { return mode_; }
+
+  /// @brief The total number of point cloud buffers allocated for this topic
+  uint64_t allocations() const { return n_allocations_; }
+
+  /// @brief The total number of messages published on this topic
+  uint64_t published() const { return n_published_; }
+
+  /// @brief Add the output mode and the allocations per second since the last call to the given
+  /// diagnostics
+  /// @param diagnostics The diagnostics to add to
+  void addDiagnostics(diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+  {
+    const auto now = std::chrono::steady_clock::now();
+    const uint64_t n_allocations = n_allocations_;
+    const double elapsed_s = std::chrono::duration<double>(now - last_report_time_).count();
+    const double allocations_per_s =
+      elapsed_s > 0 ? (n_allocations - last_reported_n_allocations_) / elapsed_s : 0.;
+
+    last_report_time_ = now;
+    last_reported_n_allocations_ = n_allocations;
+
+    const std::string topic = publisher_->get_topic_name();
+    std::ostringstream mode;
+    mode << mode_;
+    diagnostics.add(topic + " output_mode", mode.str());
+    diagnostics.add(topic + " published", std::to_string(n_published_));
+    diagnostics.add(topic + " allocations_per_s", std::to_string(allocations_per_s));
+  }
+};
+
+}  // namespace ros
+}  // namespace nebula
+#endif  // NEBULA_POINT_CLOUD_PUBLISHER_H
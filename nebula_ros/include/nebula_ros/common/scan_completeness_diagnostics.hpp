@@ -0,0 +1,87 @@
+#ifndef NEBULA_SCAN_COMPLETENESS_DIAGNOSTICS_H
+#define NEBULA_SCAN_COMPLETENESS_DIAGNOSTICS_H
+
+#include "nebula_decoders/nebula_decoders_common/scan_gap_detector.hpp"
+
+#include <diagnostic_updater/diagnostic_updater.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace nebula
+{
+namespace ros
+{
+
+/// @brief Accumulates the packet loss of decoded scans between diagnostics updates, so that
+/// downstream consumers can tell an empty region of a point cloud apart from missing data.
+///
+/// `addScan` is called by the thread decoding the scans, `addDiagnostics` by the diagnostics
+/// updater. Neither allocates once the first scan with gaps has been added.
+class ScanCompletenessDiagnostics
+{
+private:
+  std::mutex mutex_;
+  uint64_t n_scans_{0};
+  uint64_t n_incomplete_scans_{0};
+  uint64_t n_missing_packets_{0};
+  double min_completeness_{1.};
+  /// @brief The gaps of the last incomplete scan
+  std::vector<drivers::AzimuthGap> last_gaps_;
+
+public:
+  ScanCompletenessDiagnostics() { last_gaps_.reserve(drivers::ScanGapDetector::MAX_REPORTED_GAPS); }
+
+  /// @brief Add the statistics of a completed scan
+  /// @param scan The statistics returned by the decoder along with the scan's point cloud
+  void addScan(const drivers::ScanCompleteness & scan)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    n_scans_++;
+    if (scan.n_gaps == 0) {
+      return;
+    }
+
+    n_incomplete_scans_++;
+    n_missing_packets_ += scan.n_missing_packets;
+    min_completeness_ = std::min(min_completeness_, scan.completeness);
+    last_gaps_.assign(scan.gaps.begin(), scan.gaps.end());
+  }
+
+  /// @brief Report the scans added since the last update and reset the statistics
+  /// @param diagnostics The diagnostic status to fill
+  void addDiagnostics(diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    diagnostics.add("scans", std::to_string(n_scans_));
+    diagnostics.add("incomplete_scans", std::to_string(n_incomplete_scans_));
+    diagnostics.add("missing_packets", std::to_string(n_missing_packets_));
+    diagnostics.add("min_completeness", std::to_string(min_completeness_));
+
+    if (n_incomplete_scans_ > 0) {
+      std::stringstream gaps;
+      for (const auto & gap : last_gaps_) {
+        gaps << "[" << gap.start_azimuth_deg << ", " << gap.end_azimuth_deg << "] ";
+      }
+      diagnostics.add("last_gaps_deg", gaps.str());
+      diagnostics.summary(
+        diagnostic_msgs::msg::DiagnosticStatus::WARN, "Scans with missing packets");
+    } else {
+      diagnostics.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "");
+    }
+
+    n_scans_ = 0;
+    n_incomplete_scans_ = 0;
+    n_missing_packets_ = 0;
+    min_completeness_ = 1.;
+  }
+};
+
+}  // namespace ros
+}  // namespace nebula
+
+#endif  // NEBULA_SCAN_COMPLETENESS_DIAGNOSTICS_H
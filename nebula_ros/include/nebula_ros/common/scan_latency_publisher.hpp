@@ -0,0 +1,114 @@
+#ifndef NEBULA_SCAN_LATENCY_PUBLISHER_H
+#define NEBULA_SCAN_LATENCY_PUBLISHER_H
+
+#include "nebula_common/scan_latency_tracer.hpp"
+
+#include <rclcpp/rclcpp.hpp>
+
+#include "nebula_msgs/msg/latency_histogram.hpp"
+#include "nebula_msgs/msg/scan_latency.hpp"
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+namespace nebula
+{
+namespace ros
+{
+
+/// @brief Enables the scan latency tracer of a sensor if the node's `trace_scan_latency` parameter
+/// is set, and then publishes its histograms on the `scan_latency` topic every second.
+///
+/// All nodes of a sensor running in the same process share its tracer, so tracing only has to be
+/// enabled on one of them to trace the whole pipeline of that process. If it is enabled on several
+/// of them, only the first to publish collects and publishes the histograms, and another one takes
+/// over once it is destroyed.
+class ScanLatencyPublisher
+{
+private:
+  std::shared_ptr<drivers::ScanLatencyTracer> tracer_;
+  std::string frame_id_;
+  rclcpp::Node & node_;
+  rclcpp::Publisher<nebula_msgs::msg::ScanLatency>::SharedPtr publisher_;
+  rclcpp::TimerBase::SharedPtr timer_;
+
+  static nebula_msgs::msg::LatencyHistogram toMsg(
+    const std::string & stage, const drivers::ScanLatencyTracer::Histogram & histogram)
+  {
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+
+    nebula_msgs::msg::LatencyHistogram msg;
+    msg.stage = stage;
+    msg.count = histogram.count;
+    if (histogram.count > 0) {
+      msg.mean_ms = Milliseconds(histogram.sum).count() / histogram.count;
+    }
+    msg.max_ms = Milliseconds(histogram.max).count();
+    for (const auto & bound : drivers::ScanLatencyTracer::BIN_UPPER_BOUNDS) {
+      msg.bin_upper_bounds_ms.push_back(Milliseconds(bound).count());
+    }
+    msg.bin_counts.assign(histogram.bin_counts.begin(), histogram.bin_counts.end());
+    return msg;
+  }
+
+  void publish()
+  {
+    // Collecting resets the shared histograms, so they would be split between the nodes otherwise
+    if (!tracer_->claimCollection(this)) {
+      return;
+    }
+    if (!publisher_) {
+      publisher_ = node_.create_publisher<nebula_msgs::msg::ScanLatency>("scan_latency", 10);
+    }
+
+    const auto summary = tracer_->collect();
+
+    nebula_msgs::msg::ScanLatency msg;
+    msg.header.stamp = node_.now();
+    msg.header.frame_id = frame_id_;
+    // FIRST_PACKET_RECEIVED is the origin of the other stages and has no latency of its own
+    for (size_t stage = 1; stage < drivers::N_SCAN_STAGES; ++stage) {
+      msg.stages.push_back(toMsg(
+        drivers::ScanStageToString(static_cast<drivers::ScanStage>(stage)),
+        summary.stages[stage]));
+    }
+    msg.end_to_end = toMsg("end_to_end", summary.end_to_end);
+    publisher_->publish(msg);
+  }
+
+public:
+  /// @brief Declare the `trace_scan_latency` parameter and start publishing if it is set
+  /// @param node The node to declare the parameter and topic on
+  /// @param frame_id The sensor's frame ID, which its tracer is looked up by
+  ScanLatencyPublisher(rclcpp::Node & node, const std::string & frame_id)
+  : tracer_(drivers::ScanLatencyTracer::forSensor(frame_id)), frame_id_(frame_id), node_(node)
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_BOOL;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Trace the latency of every scan and publish it on scan_latency";
+    node.declare_parameter<bool>("trace_scan_latency", false, descriptor);
+    if (!node.get_parameter("trace_scan_latency").as_bool()) {
+      return;
+    }
+
+    tracer_->setEnabled(true);
+    timer_ = node.create_wall_timer(std::chrono::seconds(1), [this]() { publish(); });
+  }
+
+  ScanLatencyPublisher(const ScanLatencyPublisher &) = delete;
+  ScanLatencyPublisher & operator=(const ScanLatencyPublisher &) = delete;
+
+  ~ScanLatencyPublisher() { tracer_->releaseCollection(this); }
+
+  /// @brief The sensor's tracer, to record the stages passed in the node with
+  drivers::ScanLatencyTracer & tracer() { return *tracer_; }
+};
+
+}  // namespace ros
+}  // namespace nebula
+
+#endif  // NEBULA_SCAN_LATENCY_PUBLISHER_H
@@ -19,6 +19,7 @@
 #include <nebula_common/continental/continental_ars548.hpp>
 #include <nebula_common/nebula_common.hpp>
 #include <nebula_common/nebula_status.hpp>
+#include <nebula_decoders/nebula_decoders_common/point_cloud2_builder.hpp>
 #include <nebula_decoders/nebula_decoders_continental/decoders/continental_ars548_decoder.hpp>
 #include <nebula_hw_interfaces/nebula_hw_interfaces_continental/continental_ars548_hw_interface.hpp>
 #include <nebula_ros/common/nebula_driver_ros_wrapper_base.hpp>
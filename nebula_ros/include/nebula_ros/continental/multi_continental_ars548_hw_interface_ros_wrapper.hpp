@@ -20,6 +20,7 @@
 #include <nebula_common/nebula_common.hpp>
 #include <nebula_hw_interfaces/nebula_hw_interfaces_continental/multi_continental_ars548_hw_interface.hpp>
 #include <nebula_ros/common/nebula_hw_interface_ros_wrapper_base.hpp>
+#include <nebula_ros/common/packet_reception_diagnostics.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <rclcpp_components/register_node_macro.hpp>
 
@@ -71,6 +72,7 @@ class MultiContinentalARS548HwInterfaceRosWrapper final : public rclcpp::Node,
                                                           NebulaHwInterfaceWrapperBase
 {
   drivers::continental_ars548::MultiContinentalARS548HwInterface hw_interface_;
+  diagnostic_updater::Updater diagnostics_updater_;
   Status interface_status_;
 
   drivers::continental_ars548::MultiContinentalARS548SensorConfiguration sensor_configuration_;
@@ -89,6 +91,9 @@ class MultiContinentalARS548HwInterfaceRosWrapper final : public rclcpp::Node,
   /// @return Resulting status
   Status InitializeHwInterface(
     const drivers::SensorConfigurationBase & sensor_configuration) override;
+  /// @brief Report packet reception statistics of the hardware interface
+  /// @param diagnostics The diagnostic status to fill
+  void CheckPacketReception(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
   /// @brief Callback for receiving NebulaPackets
   /// @param packets_buffer Received NebulaPackets
   void ReceivePacketsDataCallback(
@@ -4,9 +4,15 @@
 #include "nebula_common/hesai/hesai_common.hpp"
 #include "nebula_common/nebula_common.hpp"
 #include "nebula_common/nebula_status.hpp"
+#include "nebula_decoders/nebula_decoders_common/point_cloud2_builder.hpp"
 #include "nebula_decoders/nebula_decoders_hesai/hesai_driver.hpp"
 #include "nebula_hw_interfaces/nebula_hw_interfaces_hesai/hesai_hw_interface.hpp"
 #include "nebula_ros/common/nebula_driver_ros_wrapper_base.hpp"
+#include "nebula_ros/common/packet_reception_diagnostics.hpp"
+#include "nebula_ros/common/point_cloud_publisher.hpp"
+#include "nebula_ros/common/scan_completeness_diagnostics.hpp"
+#include "nebula_ros/common/scan_latency_publisher.hpp"
+#include "nebula_ros/hesai/hesai_packets_publisher.hpp"
 
 #include <ament_index_cpp/get_package_prefix.hpp>
 #include <diagnostic_updater/diagnostic_updater.hpp>
@@ -14,8 +20,10 @@
 #include <rclcpp_components/register_node_macro.hpp>
 
 #include <chrono>
+#include <utility>
 
-#include "pandar_msgs/msg/pandar_packet.hpp"
+#include "nebula_msgs/msg/nebula_packet.hpp"
+#include "nebula_msgs/msg/nebula_packets.hpp"
 #include "pandar_msgs/msg/pandar_scan.hpp"
 
 namespace nebula
@@ -28,14 +36,37 @@ class HesaiDriverRosWrapper final : public rclcpp::Node, NebulaDriverRosWrapperB
   std::shared_ptr<drivers::HesaiDriver> driver_ptr_;
   Status wrapper_status_;
   rclcpp::Subscription<pandar_msgs::msg::PandarScan>::SharedPtr pandar_scan_sub_;
-  rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr nebula_points_pub_;
-  rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr aw_points_ex_pub_;
-  rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr aw_points_base_pub_;
+  rclcpp::Subscription<nebula_msgs::msg::NebulaPackets>::SharedPtr nebula_packets_sub_;
+  std::unique_ptr<PointCloudPublisher> nebula_points_pub_;
+  std::unique_ptr<PointCloudPublisher> aw_points_ex_pub_;
+  std::unique_ptr<PointCloudPublisher> aw_points_base_pub_;
+  diagnostic_updater::Updater diagnostics_updater_;
+  /// @brief Packet loss of the published scans since the last diagnostics update
+  ScanCompletenessDiagnostics scan_completeness_diagnostics_;
+  /// @brief Publisher of the raw packets received by this node (only if publish_packets is set)
+  std::unique_ptr<HesaiPacketsPublisher> packets_pub_;
+  /// @brief Publishes the scan latency histograms if trace_scan_latency is set
+  std::unique_ptr<ScanLatencyPublisher> scan_latency_pub_;
 
   std::shared_ptr<drivers::HesaiCalibrationConfiguration> calibration_cfg_ptr_;
   std::shared_ptr<drivers::SensorConfigurationBase> sensor_cfg_ptr_;
   std::shared_ptr<drivers::HesaiCorrection> correction_cfg_ptr_;
 
+  /// @brief Whether this node receives packets from the sensor itself instead of subscribing to
+  /// NebulaPackets or PandarScans
+  bool receive_packets_{false};
+  /// @brief Whether received packets are published for recording
+  bool publish_packets_{false};
+  /// @brief Whether received packets are published as NebulaPackets instead of PandarScans
+  bool publish_nebula_packets_{false};
+  /// @brief The kernel drop count of the hardware interface when the last scan was completed
+  uint64_t kernel_drops_at_last_scan_{0};
+  /// @brief The ID of the scan being decoded packet by packet, i.e. the receive time of the packet
+  /// that completed the previous scan, or 0 before the first packet
+  uint64_t packet_scan_id_{0};
+
+  /// @brief Declared last so that its receiver thread is stopped before the publishers and driver
+  /// it calls into are destroyed
   drivers::HesaiHwInterface hw_interface_;
 
   /// @brief Initializing ros wrapper
@@ -76,21 +107,56 @@ class HesaiDriverRosWrapper final : public rclcpp::Node, NebulaDriverRosWrapperB
   }
 
   /***
-   * Publishes a sensor_msgs::msg::PointCloud2 to the specified publisher
-   * @param pointcloud unique pointer containing the point cloud to publish
+   * Publishes the point cloud last acquired from the specified publisher
    * @param publisher
    */
-  void PublishCloud(
-    std::unique_ptr<sensor_msgs::msg::PointCloud2> pointcloud,
-    const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher);
+  void PublishCloud(PointCloudPublisher & publisher);
+
+  /// @brief Report the output mode and allocation rate of the point cloud publishers
+  /// @param diagnostics The diagnostics to fill
+  void CheckPointCloudOutput(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
+  /// @brief Report packet reception statistics of the hardware interface, if it is used
+  /// @param diagnostics The diagnostic status to fill
+  void CheckPacketReception(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
+  /// @brief Report the packets missing from the published scans
+  /// @param diagnostics The diagnostic status to fill
+  void CheckScanCompleteness(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
+
+  /// @brief Convert a decoded scan to all point cloud formats that have subscribers and publish
+  /// them
+  /// @param pointcloud The decoded scan
+  /// @param scan_timestamp_s The timestamp of the scan in seconds
+  /// @param scan_id The ID the scan is traced by, see `drivers::ScanIdFromStamp`
+  void PublishClouds(
+    const nebula::drivers::NebulaPointCloudPtr & pointcloud, double scan_timestamp_s,
+    uint64_t scan_id);
+
+  /// @brief Publish a scan decoded from a scan message and update the scan diagnostics
+  /// @param pointcloud_ts The decoded scan and its timestamp in seconds
+  /// @param t_start The time the scan message was received, for profiling
+  /// @param scan_id The ID the scan is traced by, see `drivers::ScanIdFromStamp`
+  void PublishScan(
+    const std::tuple<nebula::drivers::NebulaPointCloudPtr, double> & pointcloud_ts,
+    std::chrono::high_resolution_clock::time_point t_start, uint64_t scan_id);
 
 public:
   explicit HesaiDriverRosWrapper(const rclcpp::NodeOptions & options);
 
-  /// @brief Callback for PandarScan subscriber
+  /// @brief Callback for PandarScan subscriber, for recordings made before packets were
+  /// published as NebulaPackets
   /// @param scan_msg Received PandarScan
   void ReceiveScanMsgCallback(const pandar_msgs::msg::PandarScan::SharedPtr scan_msg);
 
+  /// @brief Callback for NebulaPackets subscriber
+  /// @param scan_msg Received NebulaPackets
+  void ReceiveNebulaPacketsCallback(const nebula_msgs::msg::NebulaPackets::SharedPtr scan_msg);
+
+  /// @brief Callback for packets received directly from the sensor (if receive_packets is set).
+  /// Each packet is decoded immediately and the point cloud is published as soon as the scan is
+  /// complete
+  /// @param packet Received NebulaPacket
+  void ReceiveCloudPacketCallback(const nebula_msgs::msg::NebulaPacket & packet);
+
   /// @brief Get current status of this driver
   /// @return Current status
   Status GetStatus();
@@ -5,14 +5,17 @@
 #include "nebula_common/nebula_common.hpp"
 #include "nebula_hw_interfaces/nebula_hw_interfaces_hesai/hesai_hw_interface.hpp"
 #include "nebula_ros/common/nebula_hw_interface_ros_wrapper_base.hpp"
+#include "nebula_ros/common/packet_reception_diagnostics.hpp"
+#include "nebula_ros/common/scan_latency_publisher.hpp"
+#include "nebula_ros/hesai/hesai_packets_publisher.hpp"
 #include "boost_tcp_driver/tcp_driver.hpp"
 
 #include <ament_index_cpp/get_package_prefix.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <rclcpp_components/register_node_macro.hpp>
 
-#include "pandar_msgs/msg/pandar_packet.hpp"
-#include "pandar_msgs/msg/pandar_scan.hpp"
+#include "nebula_msgs/msg/nebula_packet.hpp"
+#include "nebula_msgs/msg/nebula_packets.hpp"
 
 #include <boost/asio.hpp>
 
@@ -46,21 +49,29 @@ bool get_param(const std::vector<rclcpp::Parameter> & p, const std::string & nam
 class HesaiHwInterfaceRosWrapper final : public rclcpp::Node, NebulaHwInterfaceWrapperBase
 {
   drivers::HesaiHwInterface hw_interface_;
+  diagnostic_updater::Updater diagnostics_updater_;
   Status interface_status_;
 
   drivers::HesaiSensorConfiguration sensor_configuration_;
 
   /// @brief Received Hesai message publisher
-  rclcpp::Publisher<pandar_msgs::msg::PandarScan>::SharedPtr pandar_scan_pub_;
+  std::unique_ptr<HesaiPacketsPublisher> packets_pub_;
+  /// @brief Whether scans are published as NebulaPackets instead of PandarScans
+  bool publish_nebula_packets_{false};
+  /// @brief Publishes the scan latency histograms if trace_scan_latency is set
+  std::unique_ptr<ScanLatencyPublisher> scan_latency_pub_;
 
   /// @brief Initializing hardware interface ros wrapper
   /// @param sensor_configuration SensorConfiguration for this driver
   /// @return Resulting status
   Status InitializeHwInterface(
     const drivers::SensorConfigurationBase & sensor_configuration) override;
-  /// @brief Callback for receiving PandarScan
-  /// @param scan_buffer Received PandarScan
-  void ReceiveScanDataCallback(std::unique_ptr<pandar_msgs::msg::PandarScan> scan_buffer);
+  /// @brief Report packet reception statistics of the hardware interface
+  /// @param diagnostics The diagnostic status to fill
+  void CheckPacketReception(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
+  /// @brief Callback for receiving NebulaPackets
+  /// @param scan_buffer Received NebulaPackets
+  void ReceiveScanDataCallback(std::unique_ptr<nebula_msgs::msg::NebulaPackets> scan_buffer);
 
 public:
   explicit HesaiHwInterfaceRosWrapper(const rclcpp::NodeOptions & options);
@@ -0,0 +1,74 @@
+#ifndef NEBULA_HESAI_PACKETS_PUBLISHER_H
+#define NEBULA_HESAI_PACKETS_PUBLISHER_H
+
+#include <rclcpp/rclcpp.hpp>
+
+#include "nebula_msgs/msg/nebula_packets.hpp"
+#include "pandar_msgs/msg/pandar_scan.hpp"
+
+#include <algorithm>
+#include <cstddef>
+
+namespace nebula
+{
+namespace ros
+{
+
+/// @brief Publishes the Hesai packet scans assembled by the hardware interface.
+///
+/// By default, scans are published as `pandar_msgs/PandarScan` on `pandar_packets`, which is what
+/// existing recordings, the offline extraction tools and other consumers expect. With
+/// `nebula_packets` set, they are published as size-exact `nebula_msgs/NebulaPackets` on
+/// `nebula_packets` instead, which carry no padding and are published without conversion.
+class HesaiPacketsPublisher
+{
+private:
+  rclcpp::Publisher<nebula_msgs::msg::NebulaPackets>::SharedPtr nebula_packets_pub_;
+  rclcpp::Publisher<pandar_msgs::msg::PandarScan>::SharedPtr pandar_scan_pub_;
+  /// @brief Reused for every scan, so that its packet vector is only allocated when it grows
+  pandar_msgs::msg::PandarScan pandar_scan_;
+
+public:
+  /// @brief Constructor
+  /// @param node The node to create the publisher on
+  /// @param nebula_packets Whether to publish NebulaPackets instead of PandarScans
+  HesaiPacketsPublisher(rclcpp::Node & node, bool nebula_packets)
+  {
+    if (nebula_packets) {
+      nebula_packets_pub_ = node.create_publisher<nebula_msgs::msg::NebulaPackets>(
+        "nebula_packets", rclcpp::SensorDataQoS());
+    } else {
+      pandar_scan_pub_ = node.create_publisher<pandar_msgs::msg::PandarScan>(
+        "pandar_packets", rclcpp::SensorDataQoS());
+    }
+  }
+
+  HesaiPacketsPublisher(const HesaiPacketsPublisher &) = delete;
+  HesaiPacketsPublisher & operator=(const HesaiPacketsPublisher &) = delete;
+
+  /// @brief Publish a scan. The scan is published by reference, so it can be recycled afterwards
+  /// @param scan The scan, with its header already filled
+  void publish(const nebula_msgs::msg::NebulaPackets & scan)
+  {
+    if (nebula_packets_pub_) {
+      nebula_packets_pub_->publish(scan);
+      return;
+    }
+
+    pandar_scan_.header = scan.header;
+    pandar_scan_.packets.resize(scan.packets.size());
+    for (size_t i = 0; i < scan.packets.size(); ++i) {
+      const auto & packet = scan.packets[i];
+      auto & pandar_packet = pandar_scan_.packets[i];
+      pandar_packet.stamp = packet.stamp;
+      pandar_packet.size = std::min(packet.data.size(), pandar_packet.data.size());
+      std::copy_n(packet.data.begin(), pandar_packet.size, pandar_packet.data.begin());
+    }
+    pandar_scan_pub_->publish(pandar_scan_);
+  }
+};
+
+}  // namespace ros
+}  // namespace nebula
+
+#endif  // NEBULA_HESAI_PACKETS_PUBLISHER_H
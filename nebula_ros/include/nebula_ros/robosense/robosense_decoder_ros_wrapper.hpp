@@ -3,10 +3,13 @@
 #include "nebula_common/nebula_common.hpp"
 #include "nebula_common/nebula_status.hpp"
 #include "nebula_common/robosense/robosense_common.hpp"
+#include "nebula_decoders/nebula_decoders_common/point_cloud2_builder.hpp"
 #include "nebula_decoders/nebula_decoders_robosense/robosense_driver.hpp"
 #include "nebula_decoders/nebula_decoders_robosense/robosense_info_driver.hpp"
 #include "nebula_hw_interfaces/nebula_hw_interfaces_robosense/robosense_hw_interface.hpp"
 #include "nebula_ros/common/nebula_driver_ros_wrapper_base.hpp"
+#include "nebula_ros/common/point_cloud_publisher.hpp"
+#include "nebula_ros/common/scan_completeness_diagnostics.hpp"
 
 #include <ament_index_cpp/get_package_prefix.hpp>
 #include <diagnostic_updater/diagnostic_updater.hpp>
@@ -32,9 +35,12 @@ class RobosenseDriverRosWrapper final : public rclcpp::Node, NebulaDriverRosWrap
   bool is_received_info{false};
   rclcpp::Subscription<robosense_msgs::msg::RobosenseScan>::SharedPtr robosense_scan_sub_;
   rclcpp::Subscription<robosense_msgs::msg::RobosenseInfoPacket>::SharedPtr robosense_info_sub_;
-  rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr nebula_points_pub_;
-  rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr aw_points_ex_pub_;
-  rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr aw_points_base_pub_;
+  std::unique_ptr<PointCloudPublisher> nebula_points_pub_;
+  std::unique_ptr<PointCloudPublisher> aw_points_ex_pub_;
+  std::unique_ptr<PointCloudPublisher> aw_points_base_pub_;
+  diagnostic_updater::Updater diagnostics_updater_;
+  /// @brief Packet loss of the published scans since the last diagnostics update
+  ScanCompletenessDiagnostics scan_completeness_diagnostics_;
 
   std::shared_ptr<drivers::RobosenseCalibrationConfiguration> calibration_cfg_ptr_;
   std::shared_ptr<drivers::RobosenseSensorConfiguration> sensor_cfg_ptr_;
@@ -71,13 +77,17 @@ class RobosenseDriverRosWrapper final : public rclcpp::Node, NebulaDriverRosWrap
   }
 
   /***
-   * Publishes a sensor_msgs::msg::PointCloud2 to the specified publisher
-   * @param pointcloud unique pointer containing the point cloud to publish
+   * Publishes the point cloud last acquired from the specified publisher
    * @param publisher
    */
-  void PublishCloud(
-    std::unique_ptr<sensor_msgs::msg::PointCloud2> pointcloud,
-    const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher);
+  void PublishCloud(PointCloudPublisher & publisher);
+
+  /// @brief Report the output mode and allocation rate of the point cloud publishers
+  /// @param diagnostics The diagnostics to fill
+  void CheckPointCloudOutput(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
+  /// @brief Report the packets missing from the published scans
+  /// @param diagnostics The diagnostic status to fill
+  void CheckScanCompleteness(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
 
 public:
   explicit RobosenseDriverRosWrapper(const rclcpp::NodeOptions & options);
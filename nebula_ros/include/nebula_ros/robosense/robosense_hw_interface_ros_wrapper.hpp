@@ -4,6 +4,7 @@
 #include "nebula_common/robosense/robosense_common.hpp"
 #include "nebula_hw_interfaces/nebula_hw_interfaces_robosense/robosense_hw_interface.hpp"
 #include "nebula_ros/common/nebula_hw_interface_ros_wrapper_base.hpp"
+#include "nebula_ros/common/packet_reception_diagnostics.hpp"
 
 #include <rclcpp/rclcpp.hpp>
 #include <rclcpp_components/register_node_macro.hpp>
@@ -60,6 +61,7 @@ public:
 
 private:
   drivers::RobosenseHwInterface hw_interface_;
+  diagnostic_updater::Updater diagnostics_updater_;
   drivers::RobosenseSensorConfiguration sensor_configuration_;
   Status interface_status_;
 
@@ -74,6 +76,9 @@ private:
   /// @return Resulting status
   Status InitializeHwInterface(
     const drivers::SensorConfigurationBase & sensor_configuration) override;
+  /// @brief Report packet reception statistics of the hardware interface
+  /// @param diagnostics The diagnostic status to fill
+  void CheckPacketReception(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
 
   /// @brief Callback for receiving RobosenseScan
   /// @param scan_buffer Received RobosenseScan
@@ -4,8 +4,10 @@
 #include "nebula_common/nebula_common.hpp"
 #include "nebula_common/nebula_status.hpp"
 #include "nebula_common/velodyne/velodyne_common.hpp"
+#include "nebula_decoders/nebula_decoders_common/point_cloud2_builder.hpp"
 #include "nebula_decoders/nebula_decoders_velodyne/velodyne_driver.hpp"
 #include "nebula_ros/common/nebula_driver_ros_wrapper_base.hpp"
+#include "nebula_ros/common/point_cloud_publisher.hpp"
 
 #include <ament_index_cpp/get_package_prefix.hpp>
 #include <diagnostic_updater/diagnostic_updater.hpp>
@@ -25,9 +27,10 @@ class VelodyneDriverRosWrapper final : public rclcpp::Node, NebulaDriverRosWrapp
   std::shared_ptr<drivers::VelodyneDriver> driver_ptr_;
   Status wrapper_status_;
   rclcpp::Subscription<velodyne_msgs::msg::VelodyneScan>::SharedPtr velodyne_scan_sub_;
-  rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr nebula_points_pub_;
-  rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr aw_points_ex_pub_;
-  rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr aw_points_base_pub_;
+  std::unique_ptr<PointCloudPublisher> nebula_points_pub_;
+  std::unique_ptr<PointCloudPublisher> aw_points_ex_pub_;
+  std::unique_ptr<PointCloudPublisher> aw_points_base_pub_;
+  diagnostic_updater::Updater diagnostics_updater_;
 
   std::shared_ptr<drivers::CalibrationConfigurationBase> calibration_cfg_ptr_;
   std::shared_ptr<drivers::SensorConfigurationBase> sensor_cfg_ptr_;
@@ -58,13 +61,14 @@ class VelodyneDriverRosWrapper final : public rclcpp::Node, NebulaDriverRosWrapp
   }
 
   /***
-   * Publishes a sensor_msgs::msg::PointCloud2 to the specified publisher
-   * @param pointcloud unique pointer containing the point cloud to publish
+   * Publishes the point cloud last acquired from the specified publisher
    * @param publisher
    */
-  void PublishCloud(
-    std::unique_ptr<sensor_msgs::msg::PointCloud2> pointcloud,
-    const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher);
+  void PublishCloud(PointCloudPublisher & publisher);
+
+  /// @brief Report the output mode and allocation rate of the point cloud publishers
+  /// @param diagnostics The diagnostics to fill
+  void CheckPointCloudOutput(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
 
 public:
   explicit VelodyneDriverRosWrapper(const rclcpp::NodeOptions & options);
@@ -5,6 +5,7 @@
 #include "nebula_common/velodyne/velodyne_common.hpp"
 #include "nebula_hw_interfaces/nebula_hw_interfaces_velodyne/velodyne_hw_interface.hpp"
 #include "nebula_ros/common/nebula_hw_interface_ros_wrapper_base.hpp"
+#include "nebula_ros/common/packet_reception_diagnostics.hpp"
 
 #include <ament_index_cpp/get_package_prefix.hpp>
 #include <rclcpp/rclcpp.hpp>
@@ -45,6 +46,7 @@ bool get_param(const std::vector<rclcpp::Parameter> & p, const std::string & nam
 class VelodyneHwInterfaceRosWrapper final : public rclcpp::Node, NebulaHwInterfaceWrapperBase
 {
   drivers::VelodyneHwInterface hw_interface_;
+  diagnostic_updater::Updater diagnostics_updater_;
   Status interface_status_;
 
   drivers::VelodyneSensorConfiguration sensor_configuration_;
@@ -58,6 +60,9 @@ class VelodyneHwInterfaceRosWrapper final : public rclcpp::Node, NebulaHwInterfa
   /// @return Resulting status
   Status InitializeHwInterface(
     const drivers::SensorConfigurationBase & sensor_configuration) override;
+  /// @brief Report packet reception statistics of the hardware interface
+  /// @param diagnostics The diagnostic status to fill
+  void CheckPacketReception(diagnostic_updater::DiagnosticStatusWrapper & diagnostics);
   /// @brief Callback for receiving VelodyneScan
   /// @param scan_buffer Received VelodyneScan
   void ReceiveScanDataCallback(std::unique_ptr<velodyne_msgs::msg::VelodyneScan> scan_buffer);
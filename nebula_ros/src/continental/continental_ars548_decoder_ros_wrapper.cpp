@@ -243,7 +243,7 @@ void ContinentalARS548DriverRosWrapper::DetectionListCallback(
     detection_pointcloud_pub_->get_intra_process_subscription_count() > 0) {
     const auto detection_pointcloud_ptr = ConvertToPointcloud(*msg);
     auto detection_pointcloud_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*detection_pointcloud_ptr, *detection_pointcloud_msg_ptr);
+    drivers::toPointCloud2(*detection_pointcloud_ptr, *detection_pointcloud_msg_ptr);
 
     detection_pointcloud_msg_ptr->header = msg->header;
     detection_pointcloud_pub_->publish(std::move(detection_pointcloud_msg_ptr));
@@ -272,7 +272,7 @@ void ContinentalARS548DriverRosWrapper::ObjectListCallback(
     object_pointcloud_pub_->get_intra_process_subscription_count() > 0) {
     const auto object_pointcloud_ptr = ConvertToPointcloud(*msg);
     auto object_pointcloud_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*object_pointcloud_ptr, *object_pointcloud_msg_ptr);
+    drivers::toPointCloud2(*object_pointcloud_ptr, *object_pointcloud_msg_ptr);
 
     object_pointcloud_msg_ptr->header = msg->header;
     object_pointcloud_pub_->publish(std::move(object_pointcloud_msg_ptr));
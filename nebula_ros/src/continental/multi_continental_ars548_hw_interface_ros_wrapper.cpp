@@ -26,7 +26,9 @@ namespace ros
 {
 MultiContinentalARS548HwInterfaceRosWrapper::MultiContinentalARS548HwInterfaceRosWrapper(
   const rclcpp::NodeOptions & options)
-: rclcpp::Node("multi_continental_ars548_hw_interface_ros_wrapper", options), hw_interface_()
+: rclcpp::Node("multi_continental_ars548_hw_interface_ros_wrapper", options),
+  hw_interface_(),
+  diagnostics_updater_(this)
 {
   if (mtx_config_.try_lock()) {
     interface_status_ = GetParameters(sensor_configuration_);
@@ -49,6 +51,10 @@ MultiContinentalARS548HwInterfaceRosWrapper::MultiContinentalARS548HwInterfaceRo
     &MultiContinentalARS548HwInterfaceRosWrapper::ReceivePacketsDataCallback, this,
     std::placeholders::_1, std::placeholders::_2));
 
+  diagnostics_updater_.setHardwareID(sensor_configuration_.multicast_ip);
+  diagnostics_updater_.add(
+    "packet_reception", this, &MultiContinentalARS548HwInterfaceRosWrapper::CheckPacketReception);
+
   for (std::size_t sensor_id = 0; sensor_id < sensor_configuration_.sensor_ips.size();
        sensor_id++) {
     const std::string sensor_ip = sensor_configuration_.sensor_ips[sensor_id];
@@ -67,6 +73,13 @@ MultiContinentalARS548HwInterfaceRosWrapper::~MultiContinentalARS548HwInterfaceR
 {
 }
 
+void MultiContinentalARS548HwInterfaceRosWrapper::CheckPacketReception(
+  diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+{
+  AddPacketReceptionDiagnostics(
+    hw_interface_.GetReceiveStatistics(), sensor_configuration_.use_kernel_timestamps, diagnostics);
+}
+
 Status MultiContinentalARS548HwInterfaceRosWrapper::StreamStart()
 {
   if (Status::OK == interface_status_) {
@@ -191,6 +204,51 @@ Status MultiContinentalARS548HwInterfaceRosWrapper::GetParameters(
     this->declare_parameter<uint16_t>("data_port", descriptor);
     sensor_configuration.data_port = this->get_parameter("data_port").as_int();
   }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_BOOL;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Stamp packets with their kernel receive time instead of the time they were processed";
+    this->declare_parameter<bool>("use_kernel_timestamps", false, descriptor);
+    sensor_configuration.use_kernel_timestamps =
+      this->get_parameter("use_kernel_timestamps").as_bool();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Receive buffer size of the data socket in bytes, 0 keeps the system default";
+    this->declare_parameter<uint32_t>("receive_buffer_size", 0, descriptor);
+    sensor_configuration.receive_buffer_size = this->get_parameter("receive_buffer_size").as_int();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_STRING;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "PCAP capture to replay data packets from instead of the sensor, empty receives from the "
+      "sensor";
+    this->declare_parameter<std::string>("pcap_file", "", descriptor);
+    sensor_configuration.pcap_file = this->get_parameter("pcap_file").as_string();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_DOUBLE;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "PCAP replay speed as a multiple of the recorded speed, 0 replays as fast as possible";
+    rcl_interfaces::msg::FloatingPointRange range;
+    range.set__from_value(0).set__to_value(1000).set__step(0);
+    descriptor.floating_point_range = {range};
+    this->declare_parameter<double>("pcap_replay_speed", 1., descriptor);
+    sensor_configuration.pcap_replay_speed = this->get_parameter("pcap_replay_speed").as_double();
+  }
   {
     rcl_interfaces::msg::ParameterDescriptor descriptor;
     descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
@@ -232,7 +290,9 @@ Status MultiContinentalARS548HwInterfaceRosWrapper::GetParameters(
 void MultiContinentalARS548HwInterfaceRosWrapper::ReceivePacketsDataCallback(
   std::unique_ptr<nebula_msgs::msg::NebulaPackets> scan_buffer, const std::string & sensor_ip)
 {
-  packets_pub_map_[sensor_ip]->publish(std::move(scan_buffer));
+  // Publish by reference so that the packet's buffer can be recycled afterwards
+  packets_pub_map_[sensor_ip]->publish(*scan_buffer);
+  hw_interface_.RecycleScan(std::move(scan_buffer));
 }
 
 rcl_interfaces::msg::SetParametersResult MultiContinentalARS548HwInterfaceRosWrapper::paramCallback(
@@ -5,7 +5,7 @@ namespace nebula
 namespace ros
 {
 HesaiDriverRosWrapper::HesaiDriverRosWrapper(const rclcpp::NodeOptions & options)
-: rclcpp::Node("hesai_driver_ros_wrapper", options), hw_interface_()
+: rclcpp::Node("hesai_driver_ros_wrapper", options), diagnostics_updater_(this), hw_interface_()
 {
   drivers::HesaiCalibrationConfiguration calibration_configuration;
   drivers::HesaiSensorConfiguration sensor_configuration;
@@ -45,74 +45,211 @@ HesaiDriverRosWrapper::HesaiDriverRosWrapper(const rclcpp::NodeOptions & options
   rmw_qos_profile_t qos_profile = rmw_qos_profile_sensor_data;
   auto qos = rclcpp::QoS(rclcpp::QoSInitialization(qos_profile.history, 10),
                          qos_profile);
-  pandar_scan_sub_ = create_subscription<pandar_msgs::msg::PandarScan>(
-    "pandar_packets", qos,
-    std::bind(&HesaiDriverRosWrapper::ReceiveScanMsgCallback, this, std::placeholders::_1));
-  nebula_points_pub_ =
-    this->create_publisher<sensor_msgs::msg::PointCloud2>("pandar_points", rclcpp::SensorDataQoS());
-  aw_points_base_pub_ =
-    this->create_publisher<sensor_msgs::msg::PointCloud2>("aw_points", rclcpp::SensorDataQoS());
-  aw_points_ex_pub_ =
-    this->create_publisher<sensor_msgs::msg::PointCloud2>("aw_points_ex", rclcpp::SensorDataQoS());
+  nebula_points_pub_ = std::make_unique<PointCloudPublisher>(
+    *this, "pandar_points",
+    DeclarePointCloudOutputModeParameter(*this, "nebula_points_output_mode"));
+  aw_points_base_pub_ = std::make_unique<PointCloudPublisher>(
+    *this, "aw_points", DeclarePointCloudOutputModeParameter(*this, "aw_points_output_mode"));
+  aw_points_ex_pub_ = std::make_unique<PointCloudPublisher>(
+    *this, "aw_points_ex", DeclarePointCloudOutputModeParameter(*this, "aw_points_ex_output_mode"));
+  scan_latency_pub_ = std::make_unique<ScanLatencyPublisher>(*this, sensor_cfg_ptr_->frame_id);
+
+  diagnostics_updater_.setHardwareID(sensor_cfg_ptr_->frame_id);
+  diagnostics_updater_.add(
+    "pointcloud_output", this, &HesaiDriverRosWrapper::CheckPointCloudOutput);
+  diagnostics_updater_.add(
+    "scan_completeness", this, &HesaiDriverRosWrapper::CheckScanCompleteness);
+
+  if (!receive_packets_) {
+    nebula_packets_sub_ = create_subscription<nebula_msgs::msg::NebulaPackets>(
+      "nebula_packets", qos,
+      std::bind(&HesaiDriverRosWrapper::ReceiveNebulaPacketsCallback, this, std::placeholders::_1));
+    pandar_scan_sub_ = create_subscription<pandar_msgs::msg::PandarScan>(
+      "pandar_packets", qos,
+      std::bind(&HesaiDriverRosWrapper::ReceiveScanMsgCallback, this, std::placeholders::_1));
+    return;
+  }
+
+  // Receive and decode packets in this node, so that decoding is spread over the whole rotation
+  // and the point cloud can be published as soon as the last packet of a scan has arrived
+  if (publish_packets_) {
+    packets_pub_ = std::make_unique<HesaiPacketsPublisher>(*this, publish_nebula_packets_);
+    hw_interface_.RegisterScanCallback(
+      [this](std::unique_ptr<nebula_msgs::msg::NebulaPackets> scan_buffer) {
+        // Publish by reference so that the scan's buffers can be recycled afterwards
+        scan_buffer->header.frame_id = sensor_cfg_ptr_->frame_id;
+        packets_pub_->publish(*scan_buffer);
+        hw_interface_.RecycleScan(std::move(scan_buffer));
+      });
+  }
+  // Scans are traced in ReceiveCloudPacketCallback as this node cuts them while decoding. The
+  // published packet scans are cut by the hardware interface one packet later, so neither their
+  // reception nor their publication can be correlated with the decoded scans
+  hw_interface_.SetScanTracing(false);
+  hw_interface_.RegisterPacketCallback(
+    std::bind(&HesaiDriverRosWrapper::ReceiveCloudPacketCallback, this, std::placeholders::_1));
+  diagnostics_updater_.add("packet_reception", this, &HesaiDriverRosWrapper::CheckPacketReception);
+
+  if (Status::OK == wrapper_status_) {
+    wrapper_status_ = hw_interface_.SensorInterfaceStart();
+    if (Status::OK != wrapper_status_) {
+      RCLCPP_ERROR_STREAM(this->get_logger(), this->get_name() << " Error:" << wrapper_status_);
+    }
+  }
 }
 
 void HesaiDriverRosWrapper::ReceiveScanMsgCallback(
   const pandar_msgs::msg::PandarScan::SharedPtr scan_msg)
 {
   auto t_start = std::chrono::high_resolution_clock::now();
-  std::tuple<nebula::drivers::NebulaPointCloudPtr, double> pointcloud_ts =
-    driver_ptr_->ConvertScanToPointcloud(scan_msg);
+  PublishScan(
+    driver_ptr_->ConvertScanToPointcloud(scan_msg), t_start,
+    drivers::ScanIdFromStamp(scan_msg->header.stamp));
+}
+
+void HesaiDriverRosWrapper::ReceiveNebulaPacketsCallback(
+  const nebula_msgs::msg::NebulaPackets::SharedPtr scan_msg)
+{
+  auto t_start = std::chrono::high_resolution_clock::now();
+  PublishScan(
+    driver_ptr_->ConvertScanToPointcloud(scan_msg), t_start,
+    drivers::ScanIdFromStamp(scan_msg->header.stamp));
+}
+
+void HesaiDriverRosWrapper::PublishScan(
+  const std::tuple<nebula::drivers::NebulaPointCloudPtr, double> & pointcloud_ts,
+  std::chrono::high_resolution_clock::time_point t_start, uint64_t scan_id)
+{
   nebula::drivers::NebulaPointCloudPtr pointcloud = std::get<0>(pointcloud_ts);
 
   if (pointcloud == nullptr) {
     RCLCPP_WARN_STREAM(get_logger(), "Empty cloud parsed.");
     return;
   };
-  if (
-    nebula_points_pub_->get_subscription_count() > 0 ||
-    nebula_points_pub_->get_intra_process_subscription_count() > 0) {
-    auto ros_pc_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*pointcloud, *ros_pc_msg_ptr);
-    ros_pc_msg_ptr->header.stamp =
-      rclcpp::Time(SecondsToChronoNanoSeconds(std::get<1>(pointcloud_ts)).count());
-    PublishCloud(std::move(ros_pc_msg_ptr), nebula_points_pub_);
-  }
-  if (
-    aw_points_base_pub_->get_subscription_count() > 0 ||
-    aw_points_base_pub_->get_intra_process_subscription_count() > 0) {
-    const auto autoware_cloud_xyzi =
-      nebula::drivers::convertPointXYZIRCAEDTToPointXYZIR(pointcloud);
-    auto ros_pc_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*autoware_cloud_xyzi, *ros_pc_msg_ptr);
-    ros_pc_msg_ptr->header.stamp =
-      rclcpp::Time(SecondsToChronoNanoSeconds(std::get<1>(pointcloud_ts)).count());
-    PublishCloud(std::move(ros_pc_msg_ptr), aw_points_base_pub_);
-  }
-  if (
-    aw_points_ex_pub_->get_subscription_count() > 0 ||
-    aw_points_ex_pub_->get_intra_process_subscription_count() > 0) {
-    const auto autoware_ex_cloud =
-      nebula::drivers::convertPointXYZIRCAEDTToPointXYZIRADT(pointcloud, std::get<1>(pointcloud_ts));
-    auto ros_pc_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*autoware_ex_cloud, *ros_pc_msg_ptr);
-    ros_pc_msg_ptr->header.stamp =
-      rclcpp::Time(SecondsToChronoNanoSeconds(std::get<1>(pointcloud_ts)).count());
-    PublishCloud(std::move(ros_pc_msg_ptr), aw_points_ex_pub_);
-  }
+
+  PublishClouds(pointcloud, std::get<1>(pointcloud_ts), scan_id);
+  scan_completeness_diagnostics_.addScan(driver_ptr_->GetScanCompleteness());
 
   auto runtime = std::chrono::high_resolution_clock::now() - t_start;
   RCLCPP_DEBUG(get_logger(), "PROFILING {'d_total': %lu, 'n_out': %lu}", runtime.count(), pointcloud->size());
 }
 
-void HesaiDriverRosWrapper::PublishCloud(
-  std::unique_ptr<sensor_msgs::msg::PointCloud2> pointcloud,
-  const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher)
+void HesaiDriverRosWrapper::ReceiveCloudPacketCallback(
+  const nebula_msgs::msg::NebulaPacket & packet)
+{
+  auto t_start = std::chrono::high_resolution_clock::now();
+  auto & scan_tracer = scan_latency_pub_->tracer();
+  const uint64_t packet_time_ns = drivers::ScanIdFromStamp(packet.stamp);
+  if (packet_scan_id_ == 0) {
+    packet_scan_id_ = packet_time_ns;
+    scan_tracer.record(drivers::ScanStage::FIRST_PACKET_RECEIVED, packet_scan_id_, packet_time_ns);
+  }
+
+  // Scans are decoded packet by packet, so the decode stage of a scan is that of its last packet.
+  // Whether a packet completes a scan is only known after decoding it, so the start is read before
+  const uint64_t decode_start_ns =
+    scan_tracer.isEnabled() ? drivers::ScanLatencyTracer::nowNs() : 0;
+  std::tuple<nebula::drivers::NebulaPointCloudPtr, double> pointcloud_ts =
+    driver_ptr_->ParseCloudPacket(packet);
+  nebula::drivers::NebulaPointCloudPtr pointcloud = std::get<0>(pointcloud_ts);
+
+  // Most packets do not complete a scan
+  if (pointcloud == nullptr) {
+    return;
+  }
+
+  // The packet completing a scan is the last packet of that scan and the first of the next one
+  const uint64_t scan_id = std::exchange(packet_scan_id_, packet_time_ns);
+  scan_tracer.record(drivers::ScanStage::LAST_PACKET_RECEIVED, scan_id, packet_time_ns);
+  scan_tracer.record(drivers::ScanStage::DECODE_STARTED, scan_id, decode_start_ns);
+  scan_tracer.record(drivers::ScanStage::DECODE_FINISHED, scan_id);
+  scan_tracer.record(drivers::ScanStage::FIRST_PACKET_RECEIVED, packet_time_ns, packet_time_ns);
+
+  PublishClouds(pointcloud, std::get<1>(pointcloud_ts), scan_id);
+  const auto & scan_completeness = driver_ptr_->GetScanCompleteness();
+  scan_completeness_diagnostics_.addScan(scan_completeness);
+
+  const uint64_t kernel_drops = hw_interface_.GetKernelDrops();
+  const uint64_t scan_kernel_drops = kernel_drops - kernel_drops_at_last_scan_;
+  kernel_drops_at_last_scan_ = kernel_drops;
+  if (scan_kernel_drops > 0) {
+    RCLCPP_WARN_THROTTLE(
+      get_logger(), *get_clock(), 1000, "%lu packets of the last scan were dropped by the kernel",
+      scan_kernel_drops);
+  }
+
+  auto runtime = std::chrono::high_resolution_clock::now() - t_start;
+  RCLCPP_DEBUG(
+    get_logger(),
+    "PROFILING {'d_publish': %lu, 'n_out': %lu, 'n_kernel_drops': %lu, 'n_missing': %u}",
+    runtime.count(), pointcloud->size(), scan_kernel_drops, scan_completeness.n_missing_packets);
+}
+
+void HesaiDriverRosWrapper::PublishClouds(
+  const nebula::drivers::NebulaPointCloudPtr & pointcloud, double scan_timestamp_s,
+  uint64_t scan_id)
 {
-  if (pointcloud->header.stamp.sec < 0) {
+  nebula::drivers::PointCloud2Outputs outputs;
+  if (nebula_points_pub_->hasSubscribers()) {
+    outputs.nebula_points = &nebula_points_pub_->acquire();
+  }
+  if (aw_points_base_pub_->hasSubscribers()) {
+    outputs.xyzir = &aw_points_base_pub_->acquire();
+  }
+  if (aw_points_ex_pub_->hasSubscribers()) {
+    outputs.xyziradt = &aw_points_ex_pub_->acquire();
+  }
+
+  // Only the layouts with subscribers are serialized, all in a single pass over the points
+  std_msgs::msg::Header header;
+  header.stamp = rclcpp::Time(SecondsToChronoNanoSeconds(scan_timestamp_s).count());
+  header.frame_id = sensor_cfg_ptr_->frame_id;
+  nebula::drivers::toPointCloud2FanOut(*pointcloud, scan_timestamp_s, header, outputs);
+  auto & scan_tracer = scan_latency_pub_->tracer();
+  scan_tracer.record(drivers::ScanStage::CLOUD_SERIALIZED, scan_id);
+
+  if (outputs.nebula_points) {
+    PublishCloud(*nebula_points_pub_);
+  }
+  if (outputs.xyzir) {
+    PublishCloud(*aw_points_base_pub_);
+  }
+  if (outputs.xyziradt) {
+    PublishCloud(*aw_points_ex_pub_);
+  }
+  scan_tracer.record(drivers::ScanStage::CLOUD_PUBLISHED, scan_id);
+}
+
+void HesaiDriverRosWrapper::PublishCloud(PointCloudPublisher & publisher)
+{
+  auto & pointcloud = publisher.acquired();
+  if (pointcloud.header.stamp.sec < 0) {
     RCLCPP_WARN_STREAM(this->get_logger(), "Timestamp error, verify clock source.");
   }
-  pointcloud->header.frame_id = sensor_cfg_ptr_->frame_id;
-  publisher->publish(std::move(pointcloud));
+  pointcloud.header.frame_id = sensor_cfg_ptr_->frame_id;
+  publisher.publish();
+}
+
+void HesaiDriverRosWrapper::CheckPointCloudOutput(
+  diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+{
+  nebula_points_pub_->addDiagnostics(diagnostics);
+  aw_points_base_pub_->addDiagnostics(diagnostics);
+  aw_points_ex_pub_->addDiagnostics(diagnostics);
+  diagnostics.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "");
+}
+
+void HesaiDriverRosWrapper::CheckPacketReception(
+  diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+{
+  AddPacketReceptionDiagnostics(
+    hw_interface_.GetReceiveStatistics(), sensor_cfg_ptr_->use_kernel_timestamps, diagnostics);
+}
+
+void HesaiDriverRosWrapper::CheckScanCompleteness(
+  diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+{
+  scan_completeness_diagnostics_.addDiagnostics(diagnostics);
 }
 
 Status HesaiDriverRosWrapper::InitializeDriver(
@@ -172,6 +309,102 @@ Status HesaiDriverRosWrapper::GetParameters(
     this->declare_parameter<uint16_t>("data_port", 2368, descriptor);
     sensor_configuration.data_port = this->get_parameter("data_port").as_int();
   }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Maximum number of packets received per syscall, 1 receives packets one by one";
+    rcl_interfaces::msg::IntegerRange range;
+    range.set__from_value(1).set__to_value(1024).set__step(1);
+    descriptor.integer_range = {range};
+    this->declare_parameter<uint16_t>("receive_batch_size", 1, descriptor);
+    sensor_configuration.receive_batch_size = this->get_parameter("receive_batch_size").as_int();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Maximum time in microseconds to wait for a batch of packets to fill up";
+    this->declare_parameter<uint32_t>("receive_batch_timeout_us", 1000, descriptor);
+    sensor_configuration.receive_batch_timeout_us =
+      this->get_parameter("receive_batch_timeout_us").as_int();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_BOOL;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Stamp packets with their kernel receive time instead of the time they were processed";
+    this->declare_parameter<bool>("use_kernel_timestamps", false, descriptor);
+    sensor_configuration.use_kernel_timestamps =
+      this->get_parameter("use_kernel_timestamps").as_bool();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Receive buffer size of the data socket in bytes, 0 keeps the system default";
+    this->declare_parameter<uint32_t>("receive_buffer_size", 0, descriptor);
+    sensor_configuration.receive_buffer_size = this->get_parameter("receive_buffer_size").as_int();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_STRING;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "PCAP capture to replay data packets from instead of the sensor, empty receives from the "
+      "sensor";
+    this->declare_parameter<std::string>("pcap_file", "", descriptor);
+    sensor_configuration.pcap_file = this->get_parameter("pcap_file").as_string();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_DOUBLE;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "PCAP replay speed as a multiple of the recorded speed, 0 replays as fast as possible";
+    rcl_interfaces::msg::FloatingPointRange range;
+    range.set__from_value(0).set__to_value(1000).set__step(0);
+    descriptor.floating_point_range = {range};
+    this->declare_parameter<double>("pcap_replay_speed", 1., descriptor);
+    sensor_configuration.pcap_replay_speed = this->get_parameter("pcap_replay_speed").as_double();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Number of packets buffered between the receive thread and the thread assembling scans, 0 "
+      "assembles scans on the receive thread";
+    this->declare_parameter<uint32_t>("packet_ring_size", 0, descriptor);
+    sensor_configuration.packet_ring_size = this->get_parameter("packet_ring_size").as_int();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_STRING;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints = "Packet to drop when the packet ring is full: "
+                                        "drop_oldest or drop_newest";
+    this->declare_parameter<std::string>("packet_overflow_policy", "drop_oldest", descriptor);
+    sensor_configuration.packet_overflow_policy = drivers::PacketOverflowPolicyFromString(
+      this->get_parameter("packet_overflow_policy").as_string());
+    if (
+      sensor_configuration.packet_overflow_policy ==
+      drivers::PacketOverflowPolicy::UNKNOWN_POLICY) {
+      return Status::SENSOR_CONFIG_ERROR;
+    }
+  }
   {
     rcl_interfaces::msg::ParameterDescriptor descriptor;
     descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_STRING;
@@ -263,6 +496,18 @@ Status HesaiDriverRosWrapper::GetParameters(
     sensor_configuration.dual_return_distance_threshold =
       this->get_parameter("dual_return_distance_threshold").as_double();
   }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints = "Number of threads decoding a scan, 1 decodes serially";
+    rcl_interfaces::msg::IntegerRange range;
+    range.set__from_value(1).set__to_value(64).set__step(1);
+    descriptor.integer_range = {range};
+    this->declare_parameter<uint16_t>("decode_threads", 1, descriptor);
+    sensor_configuration.decode_threads = this->get_parameter("decode_threads").as_int();
+  }
   bool launch_hw;
   {
     rcl_interfaces::msg::ParameterDescriptor descriptor;
@@ -273,6 +518,34 @@ Status HesaiDriverRosWrapper::GetParameters(
     this->declare_parameter<bool>("launch_hw", "", descriptor);
     launch_hw = this->get_parameter("launch_hw").as_bool();
   }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_BOOL;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints = "Receive and decode UDP packets in this node";
+    this->declare_parameter<bool>("receive_packets", false, descriptor);
+    receive_packets_ = this->get_parameter("receive_packets").as_bool();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_BOOL;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints = "Publish received packets (only with receive_packets)";
+    this->declare_parameter<bool>("publish_packets", false, descriptor);
+    publish_packets_ = this->get_parameter("publish_packets").as_bool();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_BOOL;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Publish size-exact nebula_packets instead of pandar_packets";
+    this->declare_parameter<bool>("publish_nebula_packets", false, descriptor);
+    publish_nebula_packets_ = this->get_parameter("publish_nebula_packets").as_bool();
+  }
   if (sensor_configuration.sensor_model == nebula::drivers::SensorModel::UNKNOWN) {
     return Status::INVALID_SENSOR_MODEL;
   }
@@ -289,6 +562,10 @@ Status HesaiDriverRosWrapper::GetParameters(
   hw_interface_.SetSensorConfiguration(
     std::static_pointer_cast<drivers::SensorConfigurationBase>(sensor_cfg_ptr));
   
+  // There is no sensor to acquire the calibration from when replaying a capture
+  if (!sensor_configuration.pcap_file.empty()) {
+    launch_hw = false;
+  }
   bool run_local = !launch_hw;
   if (sensor_configuration.sensor_model != drivers::SensorModel::HESAI_PANDARAT128) {
     std::string calibration_file_path_from_sensor;
@@ -477,8 +754,13 @@ Status HesaiDriverRosWrapper::GetParameters(
       }
     }
   } // end AT128
-  // Do not use outside of this location
-  hw_interface_.~HesaiHwInterface();
+  if (receive_packets_) {
+    // The UDP receiver is still needed, only release the TCP connection
+    hw_interface_.FinalizeTcpDriver();
+  } else {
+    // Do not use outside of this location
+    hw_interface_.~HesaiHwInterface();
+  }
   RCLCPP_INFO_STREAM(this->get_logger(), "SensorConfig:" << sensor_configuration);
   return Status::OK;
 }
@@ -5,7 +5,9 @@ namespace nebula
 namespace ros
 {
 HesaiHwInterfaceRosWrapper::HesaiHwInterfaceRosWrapper(const rclcpp::NodeOptions & options)
-: rclcpp::Node("hesai_hw_interface_ros_wrapper", options), hw_interface_()
+: rclcpp::Node("hesai_hw_interface_ros_wrapper", options),
+  hw_interface_(),
+  diagnostics_updater_(this)
 {
   if (mtx_config_.try_lock()) {
     interface_status_ = GetParameters(sensor_configuration_);
@@ -22,57 +24,67 @@ HesaiHwInterfaceRosWrapper::HesaiHwInterfaceRosWrapper(const rclcpp::NodeOptions
   hw_interface_.SetSensorConfiguration(
     std::static_pointer_cast<drivers::SensorConfigurationBase>(sensor_cfg_ptr));
 #if not defined(TEST_PCAP)
-  Status rt = hw_interface_.InitializeTcpDriver();
-  if(this->retry_hw_)
-  {
-    int cnt = 0;
-    RCLCPP_INFO_STREAM(this->get_logger(), this->get_name() << " Retry: " << cnt);
-    while(rt == Status::ERROR_1)
+  if (!sensor_configuration_.pcap_file.empty()) {
+    // There is no sensor to connect to or configure when replaying a capture
+    RCLCPP_INFO_STREAM(get_logger(), "Replaying " << sensor_configuration_.pcap_file);
+    hw_interface_.SetTargetModel(sensor_cfg_ptr->sensor_model);
+  } else {
+    Status rt = hw_interface_.InitializeTcpDriver();
+    if(this->retry_hw_)
     {
-      cnt++;
-      std::this_thread::sleep_for(std::chrono::milliseconds(8000));// >5000
-      RCLCPP_ERROR_STREAM(this->get_logger(), this->get_name() << " Retry: " << cnt);
-      rt = hw_interface_.InitializeTcpDriver();
+      int cnt = 0;
+      RCLCPP_INFO_STREAM(this->get_logger(), this->get_name() << " Retry: " << cnt);
+      while(rt == Status::ERROR_1)
+      {
+        cnt++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(8000));// >5000
+        RCLCPP_ERROR_STREAM(this->get_logger(), this->get_name() << " Retry: " << cnt);
+        rt = hw_interface_.InitializeTcpDriver();
+      }
     }
-  }
 
-  if(rt != Status::ERROR_1){
-    try{
-      std::vector<std::thread> thread_pool{};
-        thread_pool.emplace_back([this] {
-          auto result = hw_interface_.GetInventory();
-          RCLCPP_INFO_STREAM(get_logger(), result);
-          hw_interface_.SetTargetModel(result.model);
-        });
-        for (std::thread & th : thread_pool) {
-          th.join();
-        }
+    if(rt != Status::ERROR_1){
+      try{
+        std::vector<std::thread> thread_pool{};
+          thread_pool.emplace_back([this] {
+            auto result = hw_interface_.GetInventory();
+            RCLCPP_INFO_STREAM(get_logger(), result);
+            hw_interface_.SetTargetModel(result.model);
+          });
+          for (std::thread & th : thread_pool) {
+            th.join();
+          }
 
+      }
+      catch (...)
+      {
+        std::cout << "catch (...) in parent" << std::endl;
+        RCLCPP_ERROR_STREAM(get_logger(), "Failed to get model from sensor...");
+      }
+      if (this->setup_sensor) {
+        hw_interface_.CheckAndSetConfig();
+        updateParameters();
+      }
     }
-    catch (...)
+    else
     {
-      std::cout << "catch (...) in parent" << std::endl;
-      RCLCPP_ERROR_STREAM(get_logger(), "Failed to get model from sensor...");
-    }
-    if (this->setup_sensor) {
-      hw_interface_.CheckAndSetConfig();
-      updateParameters();
+      RCLCPP_ERROR_STREAM(get_logger(), "Failed to get model from sensor... Set from config: " << sensor_cfg_ptr->sensor_model);
+      hw_interface_.SetTargetModel(sensor_cfg_ptr->sensor_model);
     }
   }
-  else
-  {
-    RCLCPP_ERROR_STREAM(get_logger(), "Failed to get model from sensor... Set from config: " << sensor_cfg_ptr->sensor_model);
-    hw_interface_.SetTargetModel(sensor_cfg_ptr->sensor_model);
-  }
 #endif
 
+  scan_latency_pub_ = std::make_unique<ScanLatencyPublisher>(*this, sensor_configuration_.frame_id);
   hw_interface_.RegisterScanCallback(
     std::bind(&HesaiHwInterfaceRosWrapper::ReceiveScanDataCallback, this, std::placeholders::_1));
-  pandar_scan_pub_ =
-    this->create_publisher<pandar_msgs::msg::PandarScan>("pandar_packets", rclcpp::SensorDataQoS());
+  diagnostics_updater_.setHardwareID(sensor_configuration_.frame_id);
+  diagnostics_updater_.add(
+    "packet_reception", this, &HesaiHwInterfaceRosWrapper::CheckPacketReception);
+
+  packets_pub_ = std::make_unique<HesaiPacketsPublisher>(*this, publish_nebula_packets_);
 
 #if not defined(TEST_PCAP)
-  if (this->setup_sensor) {
+  if (this->setup_sensor && sensor_configuration_.pcap_file.empty()) {
     set_param_res_ = this->add_on_set_parameters_callback(
       std::bind(&HesaiHwInterfaceRosWrapper::paramCallback, this, std::placeholders::_1));
   }
@@ -151,6 +163,13 @@ HesaiHwInterfaceRosWrapper::~HesaiHwInterfaceRosWrapper() {
   hw_interface_.FinalizeTcpDriver();
 }
 
+void HesaiHwInterfaceRosWrapper::CheckPacketReception(
+  diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+{
+  AddPacketReceptionDiagnostics(
+    hw_interface_.GetReceiveStatistics(), sensor_configuration_.use_kernel_timestamps, diagnostics);
+}
+
 Status HesaiHwInterfaceRosWrapper::StreamStart()
 {
   if (Status::OK == interface_status_) {
@@ -230,6 +249,112 @@ Status HesaiHwInterfaceRosWrapper::GetParameters(
     this->declare_parameter<uint16_t>("data_port", 2368, descriptor);
     sensor_configuration.data_port = this->get_parameter("data_port").as_int();
   }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Maximum number of packets received per syscall, 1 receives packets one by one";
+    rcl_interfaces::msg::IntegerRange range;
+    range.set__from_value(1).set__to_value(1024).set__step(1);
+    descriptor.integer_range = {range};
+    this->declare_parameter<uint16_t>("receive_batch_size", 1, descriptor);
+    sensor_configuration.receive_batch_size = this->get_parameter("receive_batch_size").as_int();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Maximum time in microseconds to wait for a batch of packets to fill up";
+    this->declare_parameter<uint32_t>("receive_batch_timeout_us", 1000, descriptor);
+    sensor_configuration.receive_batch_timeout_us =
+      this->get_parameter("receive_batch_timeout_us").as_int();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_BOOL;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Stamp packets with their kernel receive time instead of the time they were processed";
+    this->declare_parameter<bool>("use_kernel_timestamps", false, descriptor);
+    sensor_configuration.use_kernel_timestamps =
+      this->get_parameter("use_kernel_timestamps").as_bool();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Receive buffer size of the data socket in bytes, 0 keeps the system default";
+    this->declare_parameter<uint32_t>("receive_buffer_size", 0, descriptor);
+    sensor_configuration.receive_buffer_size = this->get_parameter("receive_buffer_size").as_int();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_STRING;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "PCAP capture to replay data packets from instead of the sensor, empty receives from the "
+      "sensor";
+    this->declare_parameter<std::string>("pcap_file", "", descriptor);
+    sensor_configuration.pcap_file = this->get_parameter("pcap_file").as_string();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_DOUBLE;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "PCAP replay speed as a multiple of the recorded speed, 0 replays as fast as possible";
+    rcl_interfaces::msg::FloatingPointRange range;
+    range.set__from_value(0).set__to_value(1000).set__step(0);
+    descriptor.floating_point_range = {range};
+    this->declare_parameter<double>("pcap_replay_speed", 1., descriptor);
+    sensor_configuration.pcap_replay_speed = this->get_parameter("pcap_replay_speed").as_double();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Number of packets buffered between the receive thread and the thread assembling scans, 0 "
+      "assembles scans on the receive thread";
+    this->declare_parameter<uint32_t>("packet_ring_size", 0, descriptor);
+    sensor_configuration.packet_ring_size = this->get_parameter("packet_ring_size").as_int();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_STRING;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints = "Packet to drop when the packet ring is full: "
+                                        "drop_oldest or drop_newest";
+    this->declare_parameter<std::string>("packet_overflow_policy", "drop_oldest", descriptor);
+    sensor_configuration.packet_overflow_policy = drivers::PacketOverflowPolicyFromString(
+      this->get_parameter("packet_overflow_policy").as_string());
+    if (
+      sensor_configuration.packet_overflow_policy ==
+      drivers::PacketOverflowPolicy::UNKNOWN_POLICY) {
+      return Status::SENSOR_CONFIG_ERROR;
+    }
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_BOOL;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Publish size-exact nebula_packets instead of pandar_packets";
+    this->declare_parameter<bool>("publish_nebula_packets", false, descriptor);
+    publish_nebula_packets_ = this->get_parameter("publish_nebula_packets").as_bool();
+  }
   {
     rcl_interfaces::msg::ParameterDescriptor descriptor;
     descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
@@ -419,12 +544,15 @@ Status HesaiHwInterfaceRosWrapper::GetParameters(
 }
 
 void HesaiHwInterfaceRosWrapper::ReceiveScanDataCallback(
-  std::unique_ptr<pandar_msgs::msg::PandarScan> scan_buffer)
+  std::unique_ptr<nebula_msgs::msg::NebulaPackets> scan_buffer)
 {
-  // Publish
+  // Publish by reference so that the scan's buffers can be recycled afterwards
   scan_buffer->header.frame_id = sensor_configuration_.frame_id;
   scan_buffer->header.stamp = scan_buffer->packets.front().stamp;
-  pandar_scan_pub_->publish(std::move(scan_buffer));
+  packets_pub_->publish(*scan_buffer);
+  scan_latency_pub_->tracer().record(
+    drivers::ScanStage::PACKETS_PUBLISHED, drivers::ScanIdFromStamp(scan_buffer->header.stamp));
+  hw_interface_.RecycleScan(std::move(scan_buffer));
 }
 
 rcl_interfaces::msg::SetParametersResult HesaiHwInterfaceRosWrapper::paramCallback(
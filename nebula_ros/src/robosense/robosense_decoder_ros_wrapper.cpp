@@ -5,7 +5,7 @@ namespace nebula
 namespace ros
 {
 RobosenseDriverRosWrapper::RobosenseDriverRosWrapper(const rclcpp::NodeOptions & options)
-: rclcpp::Node("robosense_driver_ros_wrapper", options)
+: rclcpp::Node("robosense_driver_ros_wrapper", options), diagnostics_updater_(this)
 {
   RCLCPP_WARN_STREAM(this->get_logger(), "RobosenseDriverRosWrapper");
   drivers::RobosenseCalibrationConfiguration calibration_configuration;
@@ -33,12 +33,19 @@ RobosenseDriverRosWrapper::RobosenseDriverRosWrapper(const rclcpp::NodeOptions &
   robosense_info_sub_ = create_subscription<robosense_msgs::msg::RobosenseInfoPacket>(
     "robosense_difop_packets", rclcpp::SensorDataQoS(),
     std::bind(&RobosenseDriverRosWrapper::ReceiveInfoMsgCallback, this, std::placeholders::_1));
-  nebula_points_pub_ = this->create_publisher<sensor_msgs::msg::PointCloud2>(
-    "robosense_points", rclcpp::SensorDataQoS());
-  aw_points_base_pub_ =
-    this->create_publisher<sensor_msgs::msg::PointCloud2>("aw_points", rclcpp::SensorDataQoS());
-  aw_points_ex_pub_ =
-    this->create_publisher<sensor_msgs::msg::PointCloud2>("aw_points_ex", rclcpp::SensorDataQoS());
+  nebula_points_pub_ = std::make_unique<PointCloudPublisher>(
+    *this, "robosense_points",
+    DeclarePointCloudOutputModeParameter(*this, "nebula_points_output_mode"));
+  aw_points_base_pub_ = std::make_unique<PointCloudPublisher>(
+    *this, "aw_points", DeclarePointCloudOutputModeParameter(*this, "aw_points_output_mode"));
+  aw_points_ex_pub_ = std::make_unique<PointCloudPublisher>(
+    *this, "aw_points_ex", DeclarePointCloudOutputModeParameter(*this, "aw_points_ex_output_mode"));
+
+  diagnostics_updater_.setHardwareID(sensor_cfg_ptr_->frame_id);
+  diagnostics_updater_.add(
+    "pointcloud_output", this, &RobosenseDriverRosWrapper::CheckPointCloudOutput);
+  diagnostics_updater_.add(
+    "scan_completeness", this, &RobosenseDriverRosWrapper::CheckScanCompleteness);
 
   RCLCPP_WARN_STREAM(this->get_logger(), "Initialized decoder ros wrapper.");
 }
@@ -78,38 +85,34 @@ void RobosenseDriverRosWrapper::ReceiveScanMsgCallback(
     RCLCPP_WARN_STREAM(get_logger(), "Empty cloud parsed.");
     return;
   };
-  if (
-    nebula_points_pub_->get_subscription_count() > 0 ||
-    nebula_points_pub_->get_intra_process_subscription_count() > 0) {
-    auto ros_pc_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*pointcloud, *ros_pc_msg_ptr);
-    ros_pc_msg_ptr->header.stamp =
-      rclcpp::Time(SecondsToChronoNanoSeconds(std::get<1>(pointcloud_ts)).count());
-    PublishCloud(std::move(ros_pc_msg_ptr), nebula_points_pub_);
+  nebula::drivers::PointCloud2Outputs outputs;
+  if (nebula_points_pub_->hasSubscribers()) {
+    outputs.nebula_points = &nebula_points_pub_->acquire();
   }
-  if (
-    aw_points_base_pub_->get_subscription_count() > 0 ||
-    aw_points_base_pub_->get_intra_process_subscription_count() > 0) {
-    const auto autoware_cloud_xyzi =
-      nebula::drivers::convertPointXYZIRCAEDTToPointXYZIR(pointcloud);
-    auto ros_pc_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*autoware_cloud_xyzi, *ros_pc_msg_ptr);
-    ros_pc_msg_ptr->header.stamp =
-      rclcpp::Time(SecondsToChronoNanoSeconds(std::get<1>(pointcloud_ts)).count());
-    PublishCloud(std::move(ros_pc_msg_ptr), aw_points_base_pub_);
+  if (aw_points_base_pub_->hasSubscribers()) {
+    outputs.xyzir = &aw_points_base_pub_->acquire();
   }
-  if (
-    aw_points_ex_pub_->get_subscription_count() > 0 ||
-    aw_points_ex_pub_->get_intra_process_subscription_count() > 0) {
-    const auto autoware_ex_cloud = nebula::drivers::convertPointXYZIRCAEDTToPointXYZIRADT(
-      pointcloud, std::get<1>(pointcloud_ts));
-    auto ros_pc_msg_ptr = std::make_unique<sensor_msgs::msg::PointCloud2>();
-    pcl::toROSMsg(*autoware_ex_cloud, *ros_pc_msg_ptr);
-    ros_pc_msg_ptr->header.stamp =
-      rclcpp::Time(SecondsToChronoNanoSeconds(std::get<1>(pointcloud_ts)).count());
-    PublishCloud(std::move(ros_pc_msg_ptr), aw_points_ex_pub_);
+  if (aw_points_ex_pub_->hasSubscribers()) {
+    outputs.xyziradt = &aw_points_ex_pub_->acquire();
   }
 
+  // Only the layouts with subscribers are serialized, all in a single pass over the points
+  std_msgs::msg::Header header;
+  header.stamp = rclcpp::Time(SecondsToChronoNanoSeconds(std::get<1>(pointcloud_ts)).count());
+  header.frame_id = sensor_cfg_ptr_->frame_id;
+  nebula::drivers::toPointCloud2FanOut(*pointcloud, std::get<1>(pointcloud_ts), header, outputs);
+
+  if (outputs.nebula_points) {
+    PublishCloud(*nebula_points_pub_);
+  }
+  if (outputs.xyzir) {
+    PublishCloud(*aw_points_base_pub_);
+  }
+  if (outputs.xyziradt) {
+    PublishCloud(*aw_points_ex_pub_);
+  }
+  scan_completeness_diagnostics_.addScan(driver_ptr_->GetScanCompleteness());
+
   auto runtime = std::chrono::high_resolution_clock::now() - t_start;
   RCLCPP_DEBUG(
     get_logger(), "PROFILING {'d_total': %lu, 'n_out': %lu}", runtime.count(), pointcloud->size());
@@ -156,19 +159,33 @@ void RobosenseDriverRosWrapper::ReceiveInfoMsgCallback(
   robosense_info_sub_.reset();
 }
 
-void RobosenseDriverRosWrapper::PublishCloud(
-  std::unique_ptr<sensor_msgs::msg::PointCloud2> pointcloud,
-  const rclcpp::Publisher<sensor_msgs::msg::PointCloud2>::SharedPtr & publisher)
+void RobosenseDriverRosWrapper::PublishCloud(PointCloudPublisher & publisher)
 {
+  auto & pointcloud = publisher.acquired();
   if (!sensor_cfg_ptr_->use_sensor_time) {
-    pointcloud->header.stamp = this->now();
+    pointcloud.header.stamp = this->now();
   }
-  if (pointcloud->header.stamp.sec < 0) {
+  if (pointcloud.header.stamp.sec < 0) {
     RCLCPP_WARN_STREAM(this->get_logger(), "Timestamp error, verify clock source.");
     return;
   }
-  pointcloud->header.frame_id = sensor_cfg_ptr_->frame_id;
-  publisher->publish(std::move(pointcloud));
+  pointcloud.header.frame_id = sensor_cfg_ptr_->frame_id;
+  publisher.publish();
+}
+
+void RobosenseDriverRosWrapper::CheckPointCloudOutput(
+  diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+{
+  nebula_points_pub_->addDiagnostics(diagnostics);
+  aw_points_base_pub_->addDiagnostics(diagnostics);
+  aw_points_ex_pub_->addDiagnostics(diagnostics);
+  diagnostics.summary(diagnostic_msgs::msg::DiagnosticStatus::OK, "");
+}
+
+void RobosenseDriverRosWrapper::CheckScanCompleteness(
+  diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+{
+  scan_completeness_diagnostics_.addDiagnostics(diagnostics);
 }
 
 Status RobosenseDriverRosWrapper::InitializeDriver(
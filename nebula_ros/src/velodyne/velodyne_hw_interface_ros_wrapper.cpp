@@ -5,7 +5,9 @@ namespace nebula
 namespace ros
 {
 VelodyneHwInterfaceRosWrapper::VelodyneHwInterfaceRosWrapper(const rclcpp::NodeOptions & options)
-: rclcpp::Node("velodyne_hw_interface_ros_wrapper", options), hw_interface_()
+: rclcpp::Node("velodyne_hw_interface_ros_wrapper", options),
+  hw_interface_(),
+  diagnostics_updater_(this)
 {
   not_supported_message = "Not supported";
 
@@ -27,7 +29,9 @@ VelodyneHwInterfaceRosWrapper::VelodyneHwInterfaceRosWrapper(const rclcpp::NodeO
   hw_interface_.InitializeSensorConfiguration(
     std::static_pointer_cast<drivers::SensorConfigurationBase>(sensor_cfg_ptr));
 
-  if (this->setup_sensor) {
+  // There is no sensor to configure when replaying a capture
+  const bool configure_sensor = this->setup_sensor && sensor_configuration_.pcap_file.empty();
+  if (configure_sensor) {
     RCLCPP_INFO_STREAM(this->get_logger(), "hw_interface_.SetSensorConfiguration");
     hw_interface_.SetSensorConfiguration(
       std::static_pointer_cast<drivers::SensorConfigurationBase>(sensor_cfg_ptr));
@@ -37,11 +41,15 @@ VelodyneHwInterfaceRosWrapper::VelodyneHwInterfaceRosWrapper(const rclcpp::NodeO
   // register scan callback and publisher
   hw_interface_.RegisterScanCallback(std::bind(
     &VelodyneHwInterfaceRosWrapper::ReceiveScanDataCallback, this, std::placeholders::_1));
+  diagnostics_updater_.setHardwareID(sensor_configuration_.frame_id);
+  diagnostics_updater_.add(
+    "packet_reception", this, &VelodyneHwInterfaceRosWrapper::CheckPacketReception);
+
   velodyne_scan_pub_ = this->create_publisher<velodyne_msgs::msg::VelodyneScan>(
     "velodyne_packets",
     rclcpp::SensorDataQoS(rclcpp::KeepLast(10)).best_effort().durability_volatile());
 
-  if (this->setup_sensor) {
+  if (configure_sensor) {
     set_param_res_ = this->add_on_set_parameters_callback(
       std::bind(&VelodyneHwInterfaceRosWrapper::paramCallback, this, std::placeholders::_1));
   }
@@ -54,6 +62,13 @@ VelodyneHwInterfaceRosWrapper::VelodyneHwInterfaceRosWrapper(const rclcpp::NodeO
   }
 }
 
+void VelodyneHwInterfaceRosWrapper::CheckPacketReception(
+  diagnostic_updater::DiagnosticStatusWrapper & diagnostics)
+{
+  AddPacketReceptionDiagnostics(
+    hw_interface_.GetReceiveStatistics(), sensor_configuration_.use_kernel_timestamps, diagnostics);
+}
+
 Status VelodyneHwInterfaceRosWrapper::StreamStart()
 {
   if (Status::OK == interface_status_) {
@@ -133,6 +148,102 @@ Status VelodyneHwInterfaceRosWrapper::GetParameters(
     this->declare_parameter<uint16_t>("data_port", 2368, descriptor);
     sensor_configuration.data_port = this->get_parameter("data_port").as_int();
   }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Maximum number of packets received per syscall, 1 receives packets one by one";
+    rcl_interfaces::msg::IntegerRange range;
+    range.set__from_value(1).set__to_value(1024).set__step(1);
+    descriptor.integer_range = {range};
+    this->declare_parameter<uint16_t>("receive_batch_size", 1, descriptor);
+    sensor_configuration.receive_batch_size = this->get_parameter("receive_batch_size").as_int();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Maximum time in microseconds to wait for a batch of packets to fill up";
+    this->declare_parameter<uint32_t>("receive_batch_timeout_us", 1000, descriptor);
+    sensor_configuration.receive_batch_timeout_us =
+      this->get_parameter("receive_batch_timeout_us").as_int();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_BOOL;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Stamp packets with their kernel receive time instead of the time they were processed";
+    this->declare_parameter<bool>("use_kernel_timestamps", false, descriptor);
+    sensor_configuration.use_kernel_timestamps =
+      this->get_parameter("use_kernel_timestamps").as_bool();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Receive buffer size of the data socket in bytes, 0 keeps the system default";
+    this->declare_parameter<uint32_t>("receive_buffer_size", 0, descriptor);
+    sensor_configuration.receive_buffer_size = this->get_parameter("receive_buffer_size").as_int();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_STRING;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "PCAP capture to replay data packets from instead of the sensor, empty receives from the "
+      "sensor";
+    this->declare_parameter<std::string>("pcap_file", "", descriptor);
+    sensor_configuration.pcap_file = this->get_parameter("pcap_file").as_string();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_DOUBLE;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "PCAP replay speed as a multiple of the recorded speed, 0 replays as fast as possible";
+    rcl_interfaces::msg::FloatingPointRange range;
+    range.set__from_value(0).set__to_value(1000).set__step(0);
+    descriptor.floating_point_range = {range};
+    this->declare_parameter<double>("pcap_replay_speed", 1., descriptor);
+    sensor_configuration.pcap_replay_speed = this->get_parameter("pcap_replay_speed").as_double();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints =
+      "Number of packets buffered between the receive thread and the thread assembling scans, 0 "
+      "assembles scans on the receive thread";
+    this->declare_parameter<uint32_t>("packet_ring_size", 0, descriptor);
+    sensor_configuration.packet_ring_size = this->get_parameter("packet_ring_size").as_int();
+  }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_STRING;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints = "Packet to drop when the packet ring is full: "
+                                        "drop_oldest or drop_newest";
+    this->declare_parameter<std::string>("packet_overflow_policy", "drop_oldest", descriptor);
+    sensor_configuration.packet_overflow_policy = drivers::PacketOverflowPolicyFromString(
+      this->get_parameter("packet_overflow_policy").as_string());
+    if (
+      sensor_configuration.packet_overflow_policy ==
+      drivers::PacketOverflowPolicy::UNKNOWN_POLICY) {
+      return Status::SENSOR_CONFIG_ERROR;
+    }
+  }
   {
     rcl_interfaces::msg::ParameterDescriptor descriptor;
     descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
@@ -0,0 +1,206 @@
+#include "allocation_counter.hpp"
+
+#include <cassert>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+thread_local bool g_counting = false;
+thread_local size_t g_allocations = 0;
+
+inline void record_allocation()
+{
+  if (g_counting) {
+    ++g_allocations;
+  }
+}
+
+}  // namespace
+
+#ifdef __GLIBC__
+
+// The underlying glibc implementations, used so that allocations are only counted once when
+// operator new would otherwise call malloc
+extern "C" {
+void * __libc_malloc(size_t size);
+void * __libc_calloc(size_t n, size_t size);
+void * __libc_realloc(void * ptr, size_t size);
+void * __libc_memalign(size_t alignment, size_t size);
+void __libc_free(void * ptr);
+
+void * malloc(size_t size)
+{
+  record_allocation();
+  return __libc_malloc(size);
+}
+
+void * calloc(size_t n, size_t size)
+{
+  record_allocation();
+  return __libc_calloc(n, size);
+}
+
+void * realloc(void * ptr, size_t size)
+{
+  record_allocation();
+  return __libc_realloc(ptr, size);
+}
+
+void free(void * ptr)
+{
+  __libc_free(ptr);
+}
+}
+
+namespace
+{
+
+inline void * allocate(size_t size)
+{
+  return __libc_malloc(size == 0 ? 1 : size);
+}
+
+inline void * allocate_aligned(size_t size, size_t alignment)
+{
+  return __libc_memalign(alignment, size == 0 ? 1 : size);
+}
+
+inline void deallocate(void * ptr)
+{
+  __libc_free(ptr);
+}
+
+}  // namespace
+
+#else
+
+namespace
+{
+
+inline void * allocate(size_t size)
+{
+  return std::malloc(size == 0 ? 1 : size);
+}
+
+inline void * allocate_aligned(size_t size, size_t alignment)
+{
+  // aligned_alloc requires the size to be a multiple of the alignment
+  return std::aligned_alloc(alignment, (size + alignment - 1) / alignment * alignment);
+}
+
+inline void deallocate(void * ptr)
+{
+  std::free(ptr);
+}
+
+}  // namespace
+
+#endif
+
+void * operator new(size_t size)
+{
+  record_allocation();
+  void * ptr = allocate(size);
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void * operator new[](size_t size)
+{
+  return operator new(size);
+}
+
+void * operator new(size_t size, const std::nothrow_t &) noexcept
+{
+  record_allocation();
+  return allocate(size);
+}
+
+void * operator new[](size_t size, const std::nothrow_t &) noexcept
+{
+  return operator new(size, std::nothrow);
+}
+
+void * operator new(size_t size, std::align_val_t alignment)
+{
+  record_allocation();
+  void * ptr = allocate_aligned(size, static_cast<size_t>(alignment));
+  if (!ptr) {
+    throw std::bad_alloc();
+  }
+  return ptr;
+}
+
+void * operator new[](size_t size, std::align_val_t alignment)
+{
+  return operator new(size, alignment);
+}
+
+void operator delete(void * ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void * ptr) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void * ptr, size_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void * ptr, size_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void * ptr, std::align_val_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void * ptr, std::align_val_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete(void * ptr, size_t, std::align_val_t) noexcept
+{
+  deallocate(ptr);
+}
+
+void operator delete[](void * ptr, size_t, std::align_val_t) noexcept
+{
+  deallocate(ptr);
+}
+
+namespace nebula
+{
+namespace test
+{
+
+AllocationCounter::AllocationCounter()
+{
+  assert(!g_counting);
+  g_allocations = 0;
+  g_counting = true;
+}
+
+AllocationCounter::~AllocationCounter()
+{
+  g_counting = false;
+}
+
+size_t AllocationCounter::count() const
+{
+  return g_allocations;
+}
+
+}  // namespace test
+}  // namespace nebula
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+
+namespace nebula
+{
+namespace test
+{
+
+/// @brief Counts the heap allocations made by the current thread during its lifetime.
+///
+/// Allocations are intercepted by replacing the global `operator new` family and, on glibc, the
+/// `malloc` family, so that allocations made by C libraries and custom allocators (e.g. Eigen's
+/// aligned allocator used by PCL) are counted as well. Only one counter can be active per thread.
+class AllocationCounter
+{
+public:
+  AllocationCounter();
+  ~AllocationCounter();
+
+  AllocationCounter(const AllocationCounter &) = delete;
+  AllocationCounter & operator=(const AllocationCounter &) = delete;
+
+  /// @brief The number of allocations made by the current thread since construction
+  size_t count() const;
+};
+
+}  // namespace test
+}  // namespace nebula
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <random>
+#include <type_traits>
+
+namespace nebula
+{
+namespace test
+{
+
+/// @brief Number of random inputs each vectorized kernel is compared with its scalar reference on
+constexpr int KERNEL_TEST_ITERATIONS = 1000;
+
+/// @brief Random inputs for comparing the vectorized kernels of a decoder with its scalar
+/// reference. The generator has a fixed seed, so that failures are reproducible
+class RandomKernelInputs
+{
+public:
+  /// @brief A random sine or cosine in [-1, 1)
+  float trig() { return uniform(-1.f, 1.f); }
+
+  /// @brief A random value, uniformly distributed between `min` and `max`
+  template <typename T>
+  T uniform(T min, T max)
+  {
+    if constexpr (std::is_integral_v<T>) {
+      return std::uniform_int_distribution<T>(min, max)(rng_);
+    } else {
+      return std::uniform_real_distribution<T>(min, max)(rng_);
+    }
+  }
+
+  /// @brief Fill the distances of all channels with random values up to `max`. Every 7th channel
+  /// has no return, so that the handling of empty returns is covered as well
+  template <typename T, size_t N>
+  void fillDistances(std::array<T, N> & distances, T max)
+  {
+    for (size_t i = 0; i < N; ++i) {
+      distances[i] = (i % 7 == 0) ? T{0} : uniform(T{0}, max);
+    }
+  }
+
+private:
+  std::mt19937 rng_{42};
+};
+
+/// @brief Expect each vectorized kernel supported by the CPU to produce bit-identical output to the
+/// scalar kernel. Call with `ASSERT_NO_FATAL_FAILURE`
+/// @param isas The instruction sets of the vectorized kernels
+/// @param is_supported Whether the CPU supports an instruction set
+/// @param expected The buffers converted by the scalar kernel
+/// @param actual The buffers converted by each vectorized kernel, with the inputs of `expected`
+/// @param convert Converts `actual` with the kernel of the given instruction set
+template <typename Isa, typename Buffers, typename IsSupported, typename Convert>
+void expectKernelsMatchScalar(
+  std::initializer_list<Isa> isas, IsSupported is_supported, const Buffers & expected,
+  const Buffers & actual, Convert convert)
+{
+  for (Isa isa : isas) {
+    if (!is_supported(isa)) {
+      continue;
+    }
+
+    convert(isa);
+    ASSERT_EQ(std::memcmp(&expected, &actual, sizeof(Buffers)), 0)
+      << "Kernel " << static_cast<int>(isa) << " deviates from scalar reference";
+  }
+}
+
+}  // namespace test
+}  // namespace nebula
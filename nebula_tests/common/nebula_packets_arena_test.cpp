@@ -0,0 +1,90 @@
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/nebula_packets_arena.hpp"
+
+#include "allocation_counter.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace nebula
+{
+namespace test
+{
+
+constexpr size_t MAX_PACKET_SIZE = 1500;
+constexpr size_t PACKETS_PER_SCAN = 60;
+
+/// @brief Assemble a scan of `n_packets` packets of alternating sizes
+std::unique_ptr<nebula_msgs::msg::NebulaPackets> assembleScan(
+  drivers::NebulaPacketsArena & arena, size_t n_packets)
+{
+  static const std::array<uint8_t, MAX_PACKET_SIZE> datagram{};
+  auto scan = arena.acquireScan();
+  for (size_t i = 0; i < n_packets; ++i) {
+    arena.append(*scan, datagram.data(), i % 2 ? 1080 : 861);
+  }
+  arena.completeScan(*scan);
+  return scan;
+}
+
+TEST(NebulaPacketsArenaTest, PacketsAreSizeExact)
+{
+  drivers::NebulaPacketsArena arena(MAX_PACKET_SIZE);
+  const std::array<uint8_t, 4> datagram{1, 2, 3, 4};
+
+  auto scan = arena.acquireScan();
+  auto & packet = arena.append(*scan, datagram.data(), datagram.size());
+  packet.stamp.sec = 42;
+
+  ASSERT_EQ(scan->packets.size(), 1U);
+  EXPECT_EQ(scan->packets[0].data.size(), datagram.size());
+  EXPECT_EQ(scan->packets[0].data[3], 4);
+  EXPECT_EQ(scan->packets[0].stamp.sec, 42);
+}
+
+TEST(NebulaPacketsArenaTest, ReservesForLargestScan)
+{
+  drivers::NebulaPacketsArena arena(MAX_PACKET_SIZE);
+  EXPECT_EQ(arena.expectedPacketsPerScan(), 0U);
+
+  assembleScan(arena, PACKETS_PER_SCAN);
+  assembleScan(arena, PACKETS_PER_SCAN - 10);
+  EXPECT_EQ(arena.expectedPacketsPerScan(), PACKETS_PER_SCAN);
+  EXPECT_GE(arena.acquireScan()->packets.capacity(), PACKETS_PER_SCAN);
+}
+
+TEST(NebulaPacketsArenaTest, RecycledScansDoNotAllocate)
+{
+  drivers::NebulaPacketsArena arena(MAX_PACKET_SIZE);
+  // Warm up: one scan to learn the scan size, two more to fill the free lists
+  for (int i = 0; i < 3; ++i) {
+    arena.recycle(assembleScan(arena, PACKETS_PER_SCAN));
+  }
+
+  size_t n_allocations = 0;
+  {
+    AllocationCounter allocation_counter;
+    for (int i = 0; i < 10; ++i) {
+      auto scan = assembleScan(arena, PACKETS_PER_SCAN);
+      ASSERT_EQ(scan->packets.size(), PACKETS_PER_SCAN);
+      arena.recycle(std::move(scan));
+    }
+    n_allocations = allocation_counter.count();
+  }
+  EXPECT_EQ(n_allocations, 0U);
+}
+
+TEST(NebulaPacketsArenaTest, RecycledScansAreEmpty)
+{
+  drivers::NebulaPacketsArena arena(MAX_PACKET_SIZE);
+  arena.recycle(assembleScan(arena, PACKETS_PER_SCAN));
+  arena.recycle(nullptr);
+
+  auto scan = arena.acquireScan();
+  EXPECT_TRUE(scan->packets.empty());
+}
+
+}  // namespace test
+}  // namespace nebula
@@ -0,0 +1,238 @@
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/pcap_replayer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nebula
+{
+namespace test
+{
+
+constexpr uint16_t DATA_PORT = 2368;
+constexpr uint16_t OTHER_PORT = 2369;
+constexpr std::chrono::seconds REPLAY_TIMEOUT{2};
+
+/// @brief Writes a microsecond PCAP capture of Ethernet frames carrying IPv4/UDP datagrams
+class PcapWriter
+{
+public:
+  explicit PcapWriter(const std::string & path) : file_(std::fopen(path.c_str(), "wb"))
+  {
+    const uint32_t magic = 0xa1b2c3d4;
+    const uint16_t version[2] = {2, 4};
+    const uint32_t zone_sigfigs_snaplen_network[4] = {0, 0, 65535, 1};
+    std::fwrite(&magic, sizeof(magic), 1, file_);
+    std::fwrite(version, sizeof(version), 1, file_);
+    std::fwrite(zone_sigfigs_snaplen_network, sizeof(zone_sigfigs_snaplen_network), 1, file_);
+  }
+
+  ~PcapWriter() { std::fclose(file_); }
+
+  /// @brief Send the following datagrams from 192.168.1.`host`
+  void setSourceHost(uint8_t host) { source_host_ = host; }
+
+  /// @brief Write a datagram, fragmented into IP packets carrying at most `fragment_size` bytes of
+  /// the UDP datagram each
+  void writeDatagram(
+    uint64_t time_us, uint16_t port, const std::vector<uint8_t> & payload,
+    size_t fragment_size = 65535)
+  {
+    std::vector<uint8_t> udp(8 + payload.size());
+    putBe16(&udp[0], 10000);
+    putBe16(&udp[2], port);
+    putBe16(&udp[4], udp.size());
+    std::copy(payload.begin(), payload.end(), udp.begin() + 8);
+
+    for (size_t offset = 0; offset < udp.size(); offset += fragment_size) {
+      const size_t size = std::min(fragment_size, udp.size() - offset);
+      const bool more_fragments = offset + size < udp.size();
+
+      std::vector<uint8_t> frame(14 + 20 + size);
+      putBe16(&frame[12], 0x0800);
+      uint8_t * ip = &frame[14];
+      ip[0] = 0x45;
+      putBe16(ip + 2, 20 + size);
+      putBe16(ip + 4, id_);
+      putBe16(ip + 6, (more_fragments ? 0x2000 : 0) | (offset / 8));
+      ip[8] = 64;
+      ip[9] = 17;
+      const uint8_t source[4] = {192, 168, 1, source_host_};
+      std::copy(source, source + 4, ip + 12);
+      std::copy(udp.begin() + offset, udp.begin() + offset + size, ip + 20);
+
+      const uint32_t record_header[4] = {
+        static_cast<uint32_t>(time_us / 1000000), static_cast<uint32_t>(time_us % 1000000),
+        static_cast<uint32_t>(frame.size()), static_cast<uint32_t>(frame.size())};
+      std::fwrite(record_header, sizeof(record_header), 1, file_);
+      std::fwrite(frame.data(), frame.size(), 1, file_);
+    }
+    id_++;
+  }
+
+private:
+  std::FILE * file_;
+  uint16_t id_{1};
+  uint8_t source_host_{201};
+
+  static void putBe16(uint8_t * data, size_t value)
+  {
+    data[0] = static_cast<uint8_t>(value >> 8);
+    data[1] = static_cast<uint8_t>(value);
+  }
+};
+
+class PcapReplayerTest : public ::testing::Test
+{
+protected:
+  std::string path_;
+  std::mutex mutex_;
+  std::vector<std::vector<uint8_t>> received_;
+  std::vector<std::string> senders_;
+
+  void SetUp() override
+  {
+    char path[] = "/tmp/pcap_replayer_test_XXXXXX";
+    const int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    close(fd);
+    path_ = path;
+  }
+
+  void TearDown() override { std::remove(path_.c_str()); }
+
+  /// @brief Replay the capture and wait until it is finished
+  /// @return The replay duration
+  std::chrono::steady_clock::duration replay(drivers::PcapReplayer & replayer)
+  {
+    const auto start = std::chrono::steady_clock::now();
+    replayer.start([this](const drivers::UdpPacketView * packets, size_t n_packets) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (size_t i = 0; i < n_packets; ++i) {
+        received_.emplace_back(packets[i].data, packets[i].data + packets[i].size);
+        senders_.push_back(drivers::senderIp(packets[i]));
+      }
+    });
+    while (!replayer.finished() && std::chrono::steady_clock::now() - start < REPLAY_TIMEOUT) {
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    }
+    const auto duration = std::chrono::steady_clock::now() - start;
+    replayer.stop();
+    return duration;
+  }
+};
+
+TEST_F(PcapReplayerTest, ReplaysDatagramsToFilteredPort)
+{
+  {
+    PcapWriter writer(path_);
+    writer.writeDatagram(0, DATA_PORT, std::vector<uint8_t>(1080, 1));
+    writer.writeDatagram(10, OTHER_PORT, std::vector<uint8_t>(100, 2));
+    writer.writeDatagram(20, DATA_PORT, std::vector<uint8_t>(861, 3));
+  }
+
+  drivers::PcapReplayer replayer(path_, 0.);
+  replayer.setPortFilter(DATA_PORT);
+  replay(replayer);
+
+  ASSERT_TRUE(replayer.finished());
+  ASSERT_EQ(received_.size(), 2U);
+  EXPECT_EQ(received_[0], std::vector<uint8_t>(1080, 1));
+  EXPECT_EQ(received_[1], std::vector<uint8_t>(861, 3));
+  EXPECT_EQ(senders_[0], "192.168.1.201");
+  EXPECT_EQ(replayer.packets(), 2U);
+}
+
+TEST_F(PcapReplayerTest, ReplaysDatagramsFromFilteredSender)
+{
+  {
+    PcapWriter writer(path_);
+    writer.writeDatagram(0, DATA_PORT, std::vector<uint8_t>(100, 1));
+    writer.setSourceHost(202);
+    writer.writeDatagram(10, DATA_PORT, std::vector<uint8_t>(100, 2));
+    // Fragmented datagrams of other senders are skipped as well
+    writer.writeDatagram(20, DATA_PORT, std::vector<uint8_t>(4000, 3), 1480);
+    writer.setSourceHost(201);
+    writer.writeDatagram(30, DATA_PORT, std::vector<uint8_t>(4000, 4), 1480);
+  }
+
+  drivers::PcapReplayer replayer(path_, 0.);
+  replayer.setSenderFilter("192.168.1.201");
+  replay(replayer);
+
+  ASSERT_EQ(received_.size(), 2U);
+  EXPECT_EQ(received_[0], std::vector<uint8_t>(100, 1));
+  EXPECT_EQ(received_[1], std::vector<uint8_t>(4000, 4));
+  EXPECT_EQ(senders_[0], "192.168.1.201");
+  EXPECT_EQ(senders_[1], "192.168.1.201");
+  EXPECT_EQ(replayer.incomplete(), 0U);
+
+  EXPECT_THROW(replayer.setSenderFilter("192.168.1"), std::runtime_error);
+}
+
+TEST_F(PcapReplayerTest, ReassemblesFragmentedDatagrams)
+{
+  std::vector<uint8_t> payload(40000);
+  for (size_t i = 0; i < payload.size(); ++i) {
+    payload[i] = static_cast<uint8_t>(i);
+  }
+  {
+    PcapWriter writer(path_);
+    writer.writeDatagram(0, DATA_PORT, payload, 1480);
+  }
+
+  drivers::PcapReplayer replayer(path_, 0.);
+  replay(replayer);
+
+  ASSERT_EQ(received_.size(), 1U);
+  EXPECT_EQ(received_[0], payload);
+  EXPECT_EQ(replayer.incomplete(), 0U);
+}
+
+TEST_F(PcapReplayerTest, KeepsRecordedTiming)
+{
+  {
+    PcapWriter writer(path_);
+    for (uint64_t i = 0; i < 5; ++i) {
+      writer.writeDatagram(i * 50000, DATA_PORT, std::vector<uint8_t>(10, 0));
+    }
+  }
+
+  // The capture spans 200 ms
+  drivers::PcapReplayer realtime_replayer(path_, 1.);
+  EXPECT_GE(replay(realtime_replayer), std::chrono::milliseconds(200));
+
+  drivers::PcapReplayer fast_replayer(path_, 4.);
+  const auto fast_duration = replay(fast_replayer);
+  EXPECT_GE(fast_duration, std::chrono::milliseconds(50));
+  EXPECT_LT(fast_duration, std::chrono::milliseconds(200));
+
+  drivers::PcapReplayer unthrottled_replayer(path_, 0.);
+  EXPECT_LT(replay(unthrottled_replayer), std::chrono::milliseconds(50));
+  EXPECT_EQ(received_.size(), 15U);
+}
+
+TEST_F(PcapReplayerTest, RejectsOtherFiles)
+{
+  {
+    std::FILE * file = std::fopen(path_.c_str(), "wb");
+    std::fputs("not a capture, but long enough to have a header", file);
+    std::fclose(file);
+  }
+
+  EXPECT_THROW(drivers::PcapReplayer(path_, 1.), std::runtime_error);
+  EXPECT_THROW(drivers::PcapReplayer("/nonexistent.pcap", 1.), std::runtime_error);
+}
+
+}  // namespace test
+}  // namespace nebula
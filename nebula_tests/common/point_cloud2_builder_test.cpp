@@ -0,0 +1,209 @@
+#include "nebula_common/nebula_common.hpp"
+#include "nebula_common/point_types.hpp"
+#include "nebula_decoders/nebula_decoders_common/point_cloud2_builder.hpp"
+
+#include <gtest/gtest.h>
+#include <pcl_conversions/pcl_conversions.h>
+
+#include <cstring>
+#include <random>
+#include <stdexcept>
+
+namespace nebula
+{
+namespace test
+{
+
+drivers::NebulaPointCloudPtr makeRandomCloud(size_t n_points)
+{
+  std::mt19937 rng(42);
+  std::uniform_real_distribution<float> coordinate(-200.f, 200.f);
+  std::uniform_real_distribution<float> angle(0.f, 6.28f);
+  std::uniform_int_distribution<uint32_t> integer(0, 100'000'000);
+
+  auto cloud = std::make_shared<drivers::NebulaPointCloud>();
+  for (size_t i = 0; i < n_points; ++i) {
+    drivers::NebulaPoint point{};
+    point.x = coordinate(rng);
+    point.y = coordinate(rng);
+    point.z = coordinate(rng);
+    point.intensity = integer(rng) % 256;
+    point.return_type = integer(rng) % 8;
+    point.channel = integer(rng) % 128;
+    point.azimuth = angle(rng);
+    point.elevation = angle(rng);
+    point.distance = coordinate(rng);
+    point.time_stamp = integer(rng);
+    cloud->push_back(point);
+  }
+  return cloud;
+}
+
+size_t fieldSize(uint8_t datatype)
+{
+  switch (datatype) {
+    case sensor_msgs::msg::PointField::INT8:
+    case sensor_msgs::msg::PointField::UINT8:
+      return 1;
+    case sensor_msgs::msg::PointField::INT16:
+    case sensor_msgs::msg::PointField::UINT16:
+      return 2;
+    case sensor_msgs::msg::PointField::INT32:
+    case sensor_msgs::msg::PointField::UINT32:
+    case sensor_msgs::msg::PointField::FLOAT32:
+      return 4;
+    case sensor_msgs::msg::PointField::FLOAT64:
+      return 8;
+    default:
+      throw std::runtime_error("Unknown point field datatype");
+  }
+}
+
+// Compares layout and field values. Padding bytes are not compared as they are not guaranteed to
+// be initialized by either implementation.
+void expectEqual(
+  const sensor_msgs::msg::PointCloud2 & expected, const sensor_msgs::msg::PointCloud2 & actual)
+{
+  ASSERT_EQ(expected.height, actual.height);
+  ASSERT_EQ(expected.width, actual.width);
+  ASSERT_EQ(expected.point_step, actual.point_step);
+  ASSERT_EQ(expected.row_step, actual.row_step);
+  ASSERT_EQ(expected.is_bigendian, actual.is_bigendian);
+  ASSERT_EQ(expected.is_dense, actual.is_dense);
+  ASSERT_EQ(expected.data.size(), actual.data.size());
+  ASSERT_EQ(expected.fields.size(), actual.fields.size());
+
+  for (size_t i = 0; i < expected.fields.size(); ++i) {
+    ASSERT_EQ(expected.fields[i].name, actual.fields[i].name);
+    ASSERT_EQ(expected.fields[i].offset, actual.fields[i].offset);
+    ASSERT_EQ(expected.fields[i].datatype, actual.fields[i].datatype);
+    ASSERT_EQ(expected.fields[i].count, actual.fields[i].count);
+  }
+
+  for (size_t point_offset = 0; point_offset < expected.data.size();
+       point_offset += expected.point_step) {
+    for (const auto & field : expected.fields) {
+      size_t field_size = fieldSize(field.datatype) * field.count;
+      ASSERT_EQ(
+        std::memcmp(
+          &expected.data[point_offset + field.offset], &actual.data[point_offset + field.offset],
+          field_size),
+        0)
+        << "Mismatch in field " << field.name << " at offset " << point_offset;
+    }
+  }
+}
+
+TEST(PointCloud2BuilderTest, NebulaPointsMatchToROSMsg)
+{
+  for (size_t n_points : {0, 1, 1000}) {
+    auto cloud = makeRandomCloud(n_points);
+
+    sensor_msgs::msg::PointCloud2 expected;
+    pcl::toROSMsg(*cloud, expected);
+    sensor_msgs::msg::PointCloud2 actual;
+    drivers::toPointCloud2(*cloud, actual);
+
+    expectEqual(expected, actual);
+  }
+}
+
+TEST(PointCloud2BuilderTest, XYZIRMatchesToROSMsg)
+{
+  for (size_t n_points : {0, 1, 1000}) {
+    auto cloud = makeRandomCloud(n_points);
+
+    sensor_msgs::msg::PointCloud2 expected;
+    pcl::toROSMsg(*drivers::convertPointXYZIRCAEDTToPointXYZIR(cloud), expected);
+    sensor_msgs::msg::PointCloud2 actual;
+    drivers::toPointCloud2XYZIR(*cloud, actual);
+
+    expectEqual(expected, actual);
+  }
+}
+
+TEST(PointCloud2BuilderTest, XYZIRADTMatchesToROSMsg)
+{
+  const double stamp = 1700000000.123456;
+  for (size_t n_points : {0, 1, 1000}) {
+    auto cloud = makeRandomCloud(n_points);
+
+    sensor_msgs::msg::PointCloud2 expected;
+    pcl::toROSMsg(*drivers::convertPointXYZIRCAEDTToPointXYZIRADT(cloud, stamp), expected);
+    sensor_msgs::msg::PointCloud2 actual;
+    drivers::toPointCloud2XYZIRADT(*cloud, stamp, actual);
+
+    expectEqual(expected, actual);
+  }
+}
+
+// Writing more points than reserved has to grow the buffer without losing points
+TEST(PointCloud2BuilderTest, GrowsBeyondCapacity)
+{
+  auto cloud = makeRandomCloud(100);
+
+  sensor_msgs::msg::PointCloud2 msg;
+  drivers::PointCloud2Builder<drivers::NebulaPoint> builder(msg, 3);
+  for (const auto & point : cloud->points) {
+    builder.push_back(point);
+  }
+  builder.finalize();
+
+  sensor_msgs::msg::PointCloud2 expected;
+  drivers::toPointCloud2(*cloud, expected);
+  ASSERT_EQ(msg.width, 100u);
+  ASSERT_EQ(msg.data, expected.data);
+}
+
+// The fan-out serializer has to produce the same messages as the individual conversions, for all
+// combinations of requested layouts
+TEST(PointCloud2BuilderTest, FanOutMatchesSeparateConversions)
+{
+  const double stamp = 1700000000.123456;
+  auto cloud = makeRandomCloud(1000);
+
+  sensor_msgs::msg::PointCloud2 expected_nebula_points;
+  drivers::toPointCloud2(*cloud, expected_nebula_points);
+  sensor_msgs::msg::PointCloud2 expected_xyzir;
+  drivers::toPointCloud2XYZIR(*cloud, expected_xyzir);
+  sensor_msgs::msg::PointCloud2 expected_xyziradt;
+  drivers::toPointCloud2XYZIRADT(*cloud, stamp, expected_xyziradt);
+
+  std_msgs::msg::Header header;
+  header.frame_id = "test_frame";
+  header.stamp.sec = 1700000000;
+
+  for (int mask = 0; mask < 8; ++mask) {
+    sensor_msgs::msg::PointCloud2 nebula_points;
+    sensor_msgs::msg::PointCloud2 xyzir;
+    sensor_msgs::msg::PointCloud2 xyziradt;
+
+    drivers::PointCloud2Outputs outputs;
+    outputs.nebula_points = (mask & 1) ? &nebula_points : nullptr;
+    outputs.xyzir = (mask & 2) ? &xyzir : nullptr;
+    outputs.xyziradt = (mask & 4) ? &xyziradt : nullptr;
+    drivers::toPointCloud2FanOut(*cloud, stamp, header, outputs);
+
+    if (mask & 1) {
+      expectEqual(expected_nebula_points, nebula_points);
+      EXPECT_EQ(nebula_points.header.frame_id, header.frame_id);
+    } else {
+      EXPECT_TRUE(nebula_points.data.empty());
+    }
+    if (mask & 2) {
+      expectEqual(expected_xyzir, xyzir);
+      EXPECT_EQ(xyzir.header.frame_id, header.frame_id);
+    } else {
+      EXPECT_TRUE(xyzir.data.empty());
+    }
+    if (mask & 4) {
+      expectEqual(expected_xyziradt, xyziradt);
+      EXPECT_EQ(xyziradt.header.stamp.sec, header.stamp.sec);
+    } else {
+      EXPECT_TRUE(xyziradt.data.empty());
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace nebula
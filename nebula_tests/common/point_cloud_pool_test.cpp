@@ -0,0 +1,94 @@
+#include "nebula_common/point_types.hpp"
+#include "nebula_decoders/nebula_decoders_common/point_cloud_pool.hpp"
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace nebula
+{
+namespace test
+{
+
+TEST(PointCloudPoolTest, ReusesReleasedClouds)
+{
+  drivers::PointCloudPool pool(2, 100);
+
+  auto cloud = pool.acquire();
+  const auto * address = cloud.get();
+  cloud->emplace_back(drivers::NebulaPoint{});
+  cloud.reset();
+
+  auto reused = pool.acquire();
+  EXPECT_EQ(reused.get(), address);
+  EXPECT_TRUE(reused->empty());
+  EXPECT_GE(reused->points.capacity(), 100U);
+  EXPECT_EQ(pool.overflows(), 0U);
+}
+
+TEST(PointCloudPoolTest, ReservesPerAcquisition)
+{
+  drivers::PointCloudPool pool(2, 100);
+
+  auto small = pool.acquire(10);
+  EXPECT_GE(small->points.capacity(), 10U);
+  EXPECT_LT(small->points.capacity(), 100U);
+  small.reset();
+
+  // Reused clouds keep their capacity
+  auto large = pool.acquire(1000);
+  EXPECT_GE(large->points.capacity(), 1000U);
+  large.reset();
+  EXPECT_GE(pool.acquire(10)->points.capacity(), 1000U);
+}
+
+TEST(PointCloudPoolTest, NeverHandsOutCloudsInUse)
+{
+  drivers::PointCloudPool pool(2, 0);
+
+  auto first = pool.acquire();
+  first->emplace_back(drivers::NebulaPoint{});
+  auto second = pool.acquire();
+  auto third = pool.acquire();
+
+  EXPECT_NE(first.get(), second.get());
+  EXPECT_NE(first.get(), third.get());
+  EXPECT_NE(second.get(), third.get());
+  EXPECT_EQ(first->size(), 1U);
+  EXPECT_EQ(pool.overflows(), 1U);
+}
+
+// Consumers release clouds on other threads while the producer keeps acquiring and filling them.
+// Clouds must only be reused after their consumer is done with them.
+TEST(PointCloudPoolTest, ReleasesFromOtherThreads)
+{
+  drivers::PointCloudPool pool(drivers::POINT_CLOUD_POOL_SIZE, 1000);
+
+  std::vector<std::thread> consumers;
+  for (size_t i = 0; i < 100; ++i) {
+    auto cloud = pool.acquire();
+    for (size_t j = 0; j < 1000; ++j) {
+      cloud->emplace_back(drivers::NebulaPoint{});
+    }
+
+    consumers.emplace_back([cloud = std::move(cloud)]() mutable {
+      EXPECT_EQ(cloud->size(), 1000U);
+      cloud.reset();
+    });
+
+    if (consumers.size() == drivers::POINT_CLOUD_POOL_SIZE) {
+      for (auto & consumer : consumers) {
+        consumer.join();
+      }
+      consumers.clear();
+    }
+  }
+
+  for (auto & consumer : consumers) {
+    consumer.join();
+  }
+}
+
+}  // namespace test
+}  // namespace nebula
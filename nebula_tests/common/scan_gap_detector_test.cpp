@@ -0,0 +1,112 @@
+#include "nebula_decoders/nebula_decoders_common/scan_gap_detector.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+
+namespace nebula
+{
+namespace test
+{
+
+/// @brief One rotation in azimuth units, for a sensor with 100 subdivisions per degree
+constexpr uint32_t MAX_AZIMUTH = 36000;
+/// @brief The step of a sensor at 600 RPM with a 55.56 us firing cycle, i.e. 0.2 degrees
+constexpr double EXPECTED_STEP = 20.;
+constexpr uint32_t GROUPS_PER_PACKET = 6;
+
+/// @brief Feed whole packets from `start_azimuth` up to (excluding) `end_azimuth`, skipping the
+/// packets starting in [skip_begin, skip_end)
+void addPackets(
+  drivers::ScanGapDetector & detector, uint32_t start_azimuth, uint32_t end_azimuth,
+  uint32_t skip_begin = 0, uint32_t skip_end = 0)
+{
+  const uint32_t packet_span = GROUPS_PER_PACKET * EXPECTED_STEP;
+  for (uint32_t packet_azimuth = start_azimuth; packet_azimuth < end_azimuth;
+       packet_azimuth += packet_span) {
+    if (packet_azimuth >= skip_begin && packet_azimuth < skip_end) {
+      continue;
+    }
+    detector.addPacket();
+    for (uint32_t group = 0; group < GROUPS_PER_PACKET; ++group) {
+      detector.addReturnGroup(
+        (packet_azimuth + group * packet_span / GROUPS_PER_PACKET) % MAX_AZIMUTH, EXPECTED_STEP,
+        GROUPS_PER_PACKET);
+    }
+  }
+}
+
+TEST(ScanGapDetectorTest, ComputesExpectedStepFromRotationSpeed)
+{
+  EXPECT_NEAR(drivers::ScanGapDetector::expectedAzimuthStep(600, 55556, 100), 20., 0.01);
+  EXPECT_EQ(drivers::ScanGapDetector::expectedAzimuthStep(0, 55556, 100), 0.);
+}
+
+TEST(ScanGapDetectorTest, ReportsCompleteScan)
+{
+  drivers::ScanGapDetector detector(MAX_AZIMUTH);
+  addPackets(detector, 0, MAX_AZIMUTH);
+  detector.completeScan();
+
+  const auto & scan = detector.completedScan();
+  EXPECT_EQ(scan.n_received_packets, MAX_AZIMUTH / (GROUPS_PER_PACKET * EXPECTED_STEP));
+  EXPECT_EQ(scan.n_missing_packets, 0U);
+  EXPECT_EQ(scan.n_gaps, 0U);
+  EXPECT_TRUE(scan.gaps.empty());
+  EXPECT_DOUBLE_EQ(scan.completeness, 1.);
+}
+
+TEST(ScanGapDetectorTest, ReportsMissingPackets)
+{
+  drivers::ScanGapDetector detector(MAX_AZIMUTH);
+  // Lose the 3 packets covering 36 to 39.6 degrees
+  addPackets(detector, 0, MAX_AZIMUTH, 3600, 3960);
+  detector.completeScan();
+
+  const auto & scan = detector.completedScan();
+  EXPECT_EQ(scan.n_received_packets, 297U);
+  EXPECT_EQ(scan.n_missing_packets, 3U);
+  ASSERT_EQ(scan.n_gaps, 1U);
+  ASSERT_EQ(scan.gaps.size(), 1U);
+  EXPECT_FLOAT_EQ(scan.gaps[0].start_azimuth_deg, 35.8f);
+  EXPECT_FLOAT_EQ(scan.gaps[0].end_azimuth_deg, 39.6f);
+  EXPECT_EQ(scan.gaps[0].n_missing_packets, 3U);
+  EXPECT_NEAR(scan.completeness, 297. / 300., 1e-3);
+
+  // The next scan starts without gaps
+  addPackets(detector, 0, MAX_AZIMUTH);
+  detector.completeScan();
+  EXPECT_EQ(detector.completedScan().n_gaps, 0U);
+  EXPECT_TRUE(detector.completedScan().gaps.empty());
+}
+
+TEST(ScanGapDetectorTest, DetectsGapsAcrossZeroAzimuth)
+{
+  drivers::ScanGapDetector detector(MAX_AZIMUTH);
+  addPackets(detector, 18000, MAX_AZIMUTH, 35880, MAX_AZIMUTH);
+  addPackets(detector, 0, 18000, 0, 120);
+  detector.completeScan();
+
+  const auto & scan = detector.completedScan();
+  EXPECT_EQ(scan.n_missing_packets, 2U);
+  ASSERT_EQ(scan.gaps.size(), 1U);
+  EXPECT_FLOAT_EQ(scan.gaps[0].start_azimuth_deg, 358.6f);
+  EXPECT_FLOAT_EQ(scan.gaps[0].end_azimuth_deg, 1.2f);
+}
+
+TEST(ScanGapDetectorTest, IgnoresRestartsAndUnknownRotationSpeed)
+{
+  drivers::ScanGapDetector detector(MAX_AZIMUTH);
+  addPackets(detector, 0, 1200);
+  // Jumping by more than half a rotation, e.g. because a rosbag was looped
+  addPackets(detector, 30000, 31200);
+  // Without a rotation speed, the expected step is unknown
+  detector.addReturnGroup(0, 0., GROUPS_PER_PACKET);
+  detector.completeScan();
+
+  EXPECT_EQ(detector.completedScan().n_gaps, 0U);
+  EXPECT_DOUBLE_EQ(detector.completedScan().completeness, 1.);
+}
+
+}  // namespace test
+}  // namespace nebula
@@ -0,0 +1,134 @@
+#include "nebula_common/scan_latency_tracer.hpp"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+
+namespace nebula
+{
+namespace test
+{
+
+using drivers::ScanLatencyTracer;
+using drivers::ScanStage;
+
+constexpr uint64_t MS = 1'000'000;
+constexpr uint64_t SCAN_ID = 1'700'000'000'000'000'000;
+
+const ScanLatencyTracer::Histogram & stageHistogram(
+  const ScanLatencyTracer::Summary & summary, ScanStage stage)
+{
+  return summary.stages[static_cast<size_t>(stage)];
+}
+
+TEST(ScanLatencyTracerTest, IgnoresStagesWhileDisabled)
+{
+  ScanLatencyTracer tracer("sensor");
+  tracer.record(ScanStage::FIRST_PACKET_RECEIVED, SCAN_ID, SCAN_ID);
+  tracer.record(ScanStage::CLOUD_PUBLISHED, SCAN_ID, SCAN_ID + 50 * MS);
+
+  const auto summary = tracer.collect();
+  EXPECT_EQ(stageHistogram(summary, ScanStage::CLOUD_PUBLISHED).count, 0U);
+  EXPECT_EQ(summary.end_to_end.count, 0U);
+}
+
+TEST(ScanLatencyTracerTest, MeasuresTimeSincePreviousStage)
+{
+  ScanLatencyTracer tracer("sensor");
+  tracer.setEnabled(true);
+  tracer.record(ScanStage::FIRST_PACKET_RECEIVED, SCAN_ID, SCAN_ID);
+  tracer.record(ScanStage::LAST_PACKET_RECEIVED, SCAN_ID, SCAN_ID + 100 * MS);
+  tracer.record(ScanStage::DECODE_STARTED, SCAN_ID, SCAN_ID + 103 * MS);
+  tracer.record(ScanStage::DECODE_FINISHED, SCAN_ID, SCAN_ID + 110 * MS);
+  tracer.record(ScanStage::CLOUD_PUBLISHED, SCAN_ID, SCAN_ID + 111 * MS);
+
+  const auto summary = tracer.collect();
+  EXPECT_EQ(stageHistogram(summary, ScanStage::FIRST_PACKET_RECEIVED).count, 0U);
+  EXPECT_EQ(
+    stageHistogram(summary, ScanStage::LAST_PACKET_RECEIVED).max, std::chrono::milliseconds(100));
+  EXPECT_EQ(stageHistogram(summary, ScanStage::DECODE_STARTED).max, std::chrono::milliseconds(3));
+  EXPECT_EQ(stageHistogram(summary, ScanStage::DECODE_FINISHED).max, std::chrono::milliseconds(7));
+  EXPECT_EQ(stageHistogram(summary, ScanStage::CLOUD_PUBLISHED).max, std::chrono::milliseconds(1));
+  EXPECT_EQ(stageHistogram(summary, ScanStage::SCAN_COMPLETED).count, 0U);
+  EXPECT_EQ(summary.end_to_end.count, 1U);
+  EXPECT_EQ(summary.end_to_end.max, std::chrono::milliseconds(111));
+}
+
+TEST(ScanLatencyTracerTest, MeasuresFirstTracedStageFromFirstPacket)
+{
+  // A decoder in another process than the hardware interface only sees the later stages
+  ScanLatencyTracer tracer("sensor");
+  tracer.setEnabled(true);
+  tracer.record(ScanStage::DECODE_STARTED, SCAN_ID, SCAN_ID + 104 * MS);
+
+  const auto summary = tracer.collect();
+  EXPECT_EQ(stageHistogram(summary, ScanStage::DECODE_STARTED).max, std::chrono::milliseconds(104));
+}
+
+TEST(ScanLatencyTracerTest, CorrelatesOverlappingScans)
+{
+  ScanLatencyTracer tracer("sensor");
+  tracer.setEnabled(true);
+  const uint64_t next_scan_id = SCAN_ID + 100 * MS;
+  tracer.record(ScanStage::DECODE_STARTED, SCAN_ID, SCAN_ID + 101 * MS);
+  tracer.record(ScanStage::FIRST_PACKET_RECEIVED, next_scan_id, next_scan_id);
+  tracer.record(ScanStage::DECODE_FINISHED, SCAN_ID, SCAN_ID + 109 * MS);
+
+  const auto summary = tracer.collect();
+  EXPECT_EQ(stageHistogram(summary, ScanStage::DECODE_FINISHED).max, std::chrono::milliseconds(8));
+}
+
+TEST(ScanLatencyTracerTest, BinsLatencies)
+{
+  ScanLatencyTracer::Histogram histogram;
+  histogram.add(std::chrono::microseconds(50));
+  histogram.add(std::chrono::microseconds(100));
+  histogram.add(std::chrono::milliseconds(3));
+  histogram.add(std::chrono::seconds(1));
+  histogram.add(std::chrono::milliseconds(-1));
+
+  EXPECT_EQ(histogram.count, 5U);
+  EXPECT_EQ(histogram.bin_counts[0], 3U);  // 50 us, 100 us and the clamped negative latency
+  EXPECT_EQ(histogram.bin_counts[5], 1U);  // (2 ms, 5 ms]
+  EXPECT_EQ(histogram.bin_counts[ScanLatencyTracer::N_BINS - 1], 1U);
+  EXPECT_EQ(histogram.max, std::chrono::seconds(1));
+}
+
+TEST(ScanLatencyTracerTest, ResetsOnCollect)
+{
+  ScanLatencyTracer tracer("sensor");
+  tracer.setEnabled(true);
+  tracer.record(ScanStage::CLOUD_PUBLISHED, SCAN_ID, SCAN_ID + 50 * MS);
+  EXPECT_EQ(tracer.collect().end_to_end.count, 1U);
+  EXPECT_EQ(tracer.collect().end_to_end.count, 0U);
+}
+
+TEST(ScanLatencyTracerTest, HasOneCollectorAtATime)
+{
+  ScanLatencyTracer tracer("sensor");
+  int first_collector = 0;
+  int second_collector = 0;
+  EXPECT_TRUE(tracer.claimCollection(&first_collector));
+  EXPECT_FALSE(tracer.claimCollection(&second_collector));
+  EXPECT_TRUE(tracer.claimCollection(&first_collector));
+
+  // Releasing a claim that is not held has no effect
+  tracer.releaseCollection(&second_collector);
+  EXPECT_FALSE(tracer.claimCollection(&second_collector));
+
+  tracer.releaseCollection(&first_collector);
+  EXPECT_TRUE(tracer.claimCollection(&second_collector));
+  EXPECT_FALSE(tracer.claimCollection(&first_collector));
+}
+
+TEST(ScanLatencyTracerTest, SharesTracerPerSensor)
+{
+  auto tracer = ScanLatencyTracer::forSensor("shared_sensor");
+  EXPECT_EQ(tracer, ScanLatencyTracer::forSensor("shared_sensor"));
+  EXPECT_NE(tracer, ScanLatencyTracer::forSensor("other_sensor"));
+  EXPECT_FALSE(tracer->isEnabled());
+}
+
+}  // namespace test
+}  // namespace nebula
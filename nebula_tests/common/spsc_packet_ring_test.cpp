@@ -0,0 +1,152 @@
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/packet_ring_worker.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/spsc_packet_ring.hpp"
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace nebula
+{
+namespace test
+{
+
+constexpr size_t SLOT_SIZE = 16;
+
+/// @brief Push a packet containing only `value`, with `value` as its receive time
+bool pushValue(drivers::SpscPacketRing & ring, uint64_t value)
+{
+  return ring.push(reinterpret_cast<const uint8_t *>(&value), sizeof(value), value);
+}
+
+/// @brief Pop all queued packets and return their values
+std::vector<uint64_t> popAll(drivers::SpscPacketRing & ring)
+{
+  std::vector<uint64_t> values;
+  while (ring.pop([&values](const drivers::RingPacketView & packet) {
+    uint64_t value;
+    std::memcpy(&value, packet.data, sizeof(value));
+    EXPECT_EQ(packet.size, sizeof(value));
+    EXPECT_EQ(packet.receive_time_ns, value);
+    values.push_back(value);
+  })) {
+  }
+  return values;
+}
+
+TEST(SpscPacketRingTest, PopsPacketsInOrder)
+{
+  drivers::SpscPacketRing ring(4, SLOT_SIZE, drivers::PacketOverflowPolicy::DROP_NEWEST);
+  EXPECT_TRUE(ring.empty());
+  EXPECT_TRUE(popAll(ring).empty());
+
+  for (uint64_t i = 1; i <= 3; ++i) {
+    EXPECT_TRUE(pushValue(ring, i));
+  }
+  EXPECT_EQ(ring.size(), 3U);
+  EXPECT_EQ(popAll(ring), (std::vector<uint64_t>{1, 2, 3}));
+
+  // Wrap around the index rings several times
+  for (uint64_t i = 4; i <= 40; ++i) {
+    EXPECT_TRUE(pushValue(ring, i));
+    EXPECT_EQ(popAll(ring), std::vector<uint64_t>{i});
+  }
+  EXPECT_EQ(ring.dropped(), 0U);
+}
+
+TEST(SpscPacketRingTest, DropNewestKeepsQueuedPackets)
+{
+  drivers::SpscPacketRing ring(3, SLOT_SIZE, drivers::PacketOverflowPolicy::DROP_NEWEST);
+  for (uint64_t i = 1; i <= 5; ++i) {
+    EXPECT_EQ(pushValue(ring, i), i <= 3);
+  }
+  EXPECT_EQ(ring.dropped(), 2U);
+  EXPECT_EQ(popAll(ring), (std::vector<uint64_t>{1, 2, 3}));
+}
+
+TEST(SpscPacketRingTest, DropOldestKeepsNewestPackets)
+{
+  drivers::SpscPacketRing ring(3, SLOT_SIZE, drivers::PacketOverflowPolicy::DROP_OLDEST);
+  for (uint64_t i = 1; i <= 5; ++i) {
+    EXPECT_TRUE(pushValue(ring, i));
+  }
+  EXPECT_EQ(ring.dropped(), 2U);
+  EXPECT_EQ(ring.size(), 3U);
+  EXPECT_EQ(popAll(ring), (std::vector<uint64_t>{3, 4, 5}));
+}
+
+TEST(SpscPacketRingTest, DropOldestDoesNotOverwriteThePacketBeingProcessed)
+{
+  drivers::SpscPacketRing ring(2, SLOT_SIZE, drivers::PacketOverflowPolicy::DROP_OLDEST);
+  pushValue(ring, 1);
+  pushValue(ring, 2);
+
+  ring.pop([&](const drivers::RingPacketView & packet) {
+    // Overflow the ring many times while the consumer holds packet 1
+    for (uint64_t i = 3; i <= 20; ++i) {
+      pushValue(ring, i);
+    }
+    uint64_t value;
+    std::memcpy(&value, packet.data, sizeof(value));
+    EXPECT_EQ(value, 1U);
+  });
+  EXPECT_EQ(popAll(ring), (std::vector<uint64_t>{19, 20}));
+}
+
+TEST(SpscPacketRingTest, DropsOversizedPackets)
+{
+  drivers::SpscPacketRing ring(2, 4, drivers::PacketOverflowPolicy::DROP_OLDEST);
+  const std::vector<uint8_t> packet(5, 0);
+  EXPECT_FALSE(ring.push(packet.data(), packet.size(), 0));
+  EXPECT_TRUE(ring.push(packet.data(), 4, 0));
+  EXPECT_EQ(ring.dropped(), 1U);
+  EXPECT_EQ(ring.size(), 1U);
+}
+
+TEST(PacketRingWorkerTest, ProcessesPacketsOnWorkerThread)
+{
+  constexpr uint64_t n_packets = 100000;
+  drivers::PacketRingWorker worker(
+    64, drivers::PacketOverflowPolicy::DROP_OLDEST, sizeof(uint64_t));
+
+  std::atomic<uint64_t> n_processed{0};
+  std::atomic<bool> in_order{true};
+  std::atomic<bool> on_worker_thread{true};
+  uint64_t last_value = 0;
+  const auto producer_id = std::this_thread::get_id();
+  worker.start([&](const uint8_t * data, size_t size, uint64_t receive_time_ns) {
+    uint64_t value;
+    std::memcpy(&value, data, sizeof(value));
+    if (size != sizeof(value) || value != receive_time_ns || value <= last_value) {
+      in_order = false;
+    }
+    if (std::this_thread::get_id() == producer_id) {
+      on_worker_thread = false;
+    }
+    last_value = value;
+    n_processed++;
+  });
+
+  for (uint64_t i = 1; i <= n_packets; ++i) {
+    worker.push(reinterpret_cast<const uint8_t *>(&i), sizeof(i), i);
+  }
+
+  const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (n_processed + worker.dropped() < n_packets &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  worker.stop();
+
+  EXPECT_TRUE(in_order);
+  EXPECT_TRUE(on_worker_thread);
+  EXPECT_EQ(n_processed + worker.dropped(), n_packets);
+  EXPECT_EQ(worker.takeDropped(), worker.dropped());
+  EXPECT_EQ(worker.takeDropped(), 0U);
+}
+
+}  // namespace test
+}  // namespace nebula
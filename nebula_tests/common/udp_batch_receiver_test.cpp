@@ -0,0 +1,237 @@
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/packet_receive_statistics.hpp"
+#include "nebula_hw_interfaces/nebula_hw_interfaces_common/udp_batch_receiver.hpp"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace nebula
+{
+namespace test
+{
+
+constexpr char HOST_IP[] = "127.0.0.1";
+constexpr std::chrono::seconds RECEIVE_TIMEOUT{2};
+
+/// @brief Send one datagram per entry of `sizes` to the given local port
+void sendPackets(uint16_t port, const std::vector<size_t> & sizes)
+{
+  const int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  ASSERT_GE(fd, 0);
+
+  sockaddr_in destination{};
+  destination.sin_family = AF_INET;
+  destination.sin_port = htons(port);
+  inet_pton(AF_INET, HOST_IP, &destination.sin_addr);
+
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    std::vector<uint8_t> payload(sizes[i], static_cast<uint8_t>(i));
+    sendto(
+      fd, payload.data(), payload.size(), 0, reinterpret_cast<sockaddr *>(&destination),
+      sizeof(destination));
+  }
+  close(fd);
+}
+
+struct ReceivedPacket
+{
+  std::vector<uint8_t> data;
+  uint64_t receive_time_ns;
+  std::string sender_ip;
+};
+
+class UdpBatchReceiverTest : public ::testing::Test
+{
+protected:
+  std::mutex mutex_;
+  std::vector<ReceivedPacket> received_;
+  std::atomic<size_t> n_received_{0};
+
+  void start(drivers::UdpBatchReceiver & receiver)
+  {
+    receiver.start([this](const drivers::UdpPacketView * packets, size_t n_packets) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      for (size_t i = 0; i < n_packets; ++i) {
+        received_.push_back(
+          {std::vector<uint8_t>(packets[i].data, packets[i].data + packets[i].size),
+           packets[i].receive_time_ns, drivers::senderIp(packets[i])});
+      }
+      n_received_ += n_packets;
+    });
+  }
+
+  bool waitFor(size_t n_packets)
+  {
+    const auto deadline = std::chrono::steady_clock::now() + RECEIVE_TIMEOUT;
+    while (n_received_ < n_packets && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return n_received_ >= n_packets;
+  }
+};
+
+TEST_F(UdpBatchReceiverTest, ReceivesPacketsInOrder)
+{
+  constexpr uint16_t port = 23691;
+  drivers::UdpBatchReceiver receiver(8, std::chrono::microseconds(1000));
+  receiver.open(HOST_IP, port);
+  start(receiver);
+
+  const std::vector<size_t> sizes{100, 1000, 1200, 1, 1500};
+  sendPackets(port, sizes);
+  ASSERT_TRUE(waitFor(sizes.size()));
+  receiver.stop();
+
+  ASSERT_EQ(received_.size(), sizes.size());
+  for (size_t i = 0; i < sizes.size(); ++i) {
+    EXPECT_EQ(received_[i].data.size(), sizes[i]);
+    EXPECT_EQ(received_[i].data.front(), static_cast<uint8_t>(i));
+    EXPECT_EQ(received_[i].receive_time_ns, 0U);
+    EXPECT_EQ(received_[i].sender_ip, HOST_IP);
+  }
+  EXPECT_EQ(receiver.packets(), sizes.size());
+  EXPECT_EQ(receiver.truncated(), 0U);
+}
+
+TEST_F(UdpBatchReceiverTest, DropsTruncatedPackets)
+{
+  constexpr uint16_t port = 23692;
+  drivers::UdpBatchReceiver receiver(4, std::chrono::microseconds(0), 1000);
+  receiver.open(HOST_IP, port);
+  start(receiver);
+
+  sendPackets(port, {1000, 1001, 10});
+  ASSERT_TRUE(waitFor(2));
+  receiver.stop();
+
+  ASSERT_EQ(received_.size(), 2U);
+  EXPECT_EQ(received_[0].data.size(), 1000U);
+  EXPECT_EQ(received_[1].data.size(), 10U);
+  EXPECT_EQ(receiver.truncated(), 1U);
+}
+
+TEST_F(UdpBatchReceiverTest, StampsPacketsWithKernelTime)
+{
+  constexpr uint16_t port = 23693;
+  drivers::UdpBatchReceiver receiver(1, std::chrono::microseconds(0));
+  receiver.open(HOST_IP, port);
+  receiver.enableKernelTimestamps();
+  start(receiver);
+
+  const auto before = std::chrono::system_clock::now();
+  sendPackets(port, {100, 100});
+  ASSERT_TRUE(waitFor(2));
+  const auto after = std::chrono::system_clock::now();
+  receiver.stop();
+
+  const auto to_ns = [](std::chrono::system_clock::time_point t) {
+    return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count());
+  };
+  for (const auto & packet : received_) {
+    EXPECT_GE(packet.receive_time_ns, to_ns(before));
+    EXPECT_LE(packet.receive_time_ns, to_ns(after));
+  }
+  EXPECT_LE(received_[0].receive_time_ns, received_[1].receive_time_ns);
+}
+
+TEST_F(UdpBatchReceiverTest, SetsReceiveBufferSize)
+{
+  constexpr uint16_t port = 23694;
+  drivers::UdpBatchReceiver receiver(1, std::chrono::microseconds(0));
+  receiver.open(HOST_IP, port);
+
+  // The kernel doubles the requested size, small sizes are well below net.core.rmem_max
+  constexpr size_t requested_size = 16384;
+  bool warned = false;
+  EXPECT_EQ(
+    receiver.setReceiveBufferSize(requested_size, [&](const std::string &) { warned = true; }),
+    requested_size);
+  EXPECT_EQ(receiver.receiveBufferSize(), 2 * requested_size);
+  EXPECT_FALSE(warned);
+}
+
+TEST_F(UdpBatchReceiverTest, WarnsIfReceiveBufferSizeIsCapped)
+{
+  constexpr uint16_t port = 23696;
+  drivers::UdpBatchReceiver receiver(1, std::chrono::microseconds(0));
+  receiver.open(HOST_IP, port);
+
+  // Even with CAP_NET_ADMIN, the kernel caps the size at half of INT_MAX
+  const size_t requested_size = std::numeric_limits<int>::max();
+  std::string warning;
+  const size_t granted_size = receiver.setReceiveBufferSize(
+    requested_size, [&](const std::string & message) { warning = message; });
+  EXPECT_LT(granted_size, requested_size);
+  EXPECT_NE(warning.find(std::to_string(granted_size)), std::string::npos);
+}
+
+TEST_F(UdpBatchReceiverTest, CountsKernelDrops)
+{
+  constexpr uint16_t port = 23695;
+  drivers::UdpBatchReceiver receiver(16, std::chrono::microseconds(0));
+  receiver.open(HOST_IP, port);
+  receiver.setReceiveBufferSize(4096);
+  receiver.enableDropCounter();
+
+  // Overflow the socket buffer before anything is received
+  sendPackets(port, std::vector<size_t>(100, 1000));
+  start(receiver);
+  ASSERT_TRUE(waitFor(1));
+  EXPECT_EQ(receiver.kernelDrops(), 0U);
+
+  // The drop count is reported with the first datagram queued after the drops
+  const size_t n_buffered = n_received_;
+  sendPackets(port, {10});
+  ASSERT_TRUE(waitFor(n_buffered + 1));
+  receiver.stop();
+
+  EXPECT_GT(receiver.kernelDrops(), 0U);
+  EXPECT_EQ(receiver.kernelDrops() + n_received_, 101U);
+}
+
+TEST(PacketReceiveStatisticsTest, AccumulatesQueueingDelayUntilCollected)
+{
+  drivers::PacketReceiveStatistics statistics;
+
+  const auto now = std::chrono::system_clock::now();
+  EXPECT_GE(statistics.stampPacket(0), now);
+  EXPECT_EQ(statistics.collect().n_timestamped_packets, 0U);
+
+  const auto receive_time = now - std::chrono::milliseconds(5);
+  const uint64_t receive_time_ns =
+    std::chrono::duration_cast<std::chrono::nanoseconds>(receive_time.time_since_epoch()).count();
+  EXPECT_EQ(statistics.stampPacket(receive_time_ns), receive_time);
+  statistics.addQueueingDelay(std::chrono::milliseconds(1));
+
+  const auto summary = statistics.collect();
+  EXPECT_EQ(summary.n_timestamped_packets, 2U);
+  EXPECT_GE(summary.max_queueing_delay, std::chrono::milliseconds(5));
+  EXPECT_LT(summary.mean_queueing_delay, summary.max_queueing_delay);
+
+  EXPECT_EQ(statistics.collect().n_timestamped_packets, 0U);
+}
+
+TEST(PacketReceiveStatisticsTest, ReportsKernelDropsSinceLastCollect)
+{
+  drivers::PacketReceiveStatistics statistics;
+  statistics.setKernelDrops(5);
+  EXPECT_EQ(statistics.collect().n_kernel_dropped_packets, 5U);
+  EXPECT_EQ(statistics.collect().n_kernel_dropped_packets, 0U);
+  statistics.setKernelDrops(7);
+  EXPECT_EQ(statistics.collect().n_kernel_dropped_packets, 2U);
+}
+
+}  // namespace test
+}  // namespace nebula
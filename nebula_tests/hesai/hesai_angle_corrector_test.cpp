@@ -0,0 +1,50 @@
+#include "nebula_common/hesai/hesai_common.hpp"
+#include "nebula_decoders/nebula_decoders_hesai/decoders/angle_corrector_calibration_based.hpp"
+#include "nebula_decoders/nebula_decoders_hesai/decoders/angle_corrector_calibration_based_compact.hpp"
+
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+
+namespace nebula
+{
+namespace test
+{
+
+constexpr size_t N_CHANNELS = 128;
+constexpr size_t ANGLE_UNIT = 100;
+
+// The compact corrector has to yield the same angles as the full-table one, and sin/cos values
+// that only differ by rounding errors
+TEST(AngleCorrectorTest, CompactMatchesFullTable)
+{
+  auto calibration = std::make_shared<drivers::HesaiCalibrationConfiguration>();
+  ASSERT_EQ(
+    calibration->LoadFromFile(std::string(_SRC_CALIBRATION_DIR_PATH) + "hesai/Pandar128E4X.csv"),
+    Status::OK);
+
+  auto full =
+    std::make_unique<drivers::AngleCorrectorCalibrationBased<N_CHANNELS, ANGLE_UNIT>>(
+      calibration, nullptr);
+  auto compact =
+    std::make_unique<drivers::AngleCorrectorCalibrationBasedCompact<N_CHANNELS, ANGLE_UNIT>>(
+      calibration, nullptr);
+
+  for (uint32_t azimuth = 0; azimuth < 360 * ANGLE_UNIT; azimuth += 7) {
+    for (uint32_t channel_id = 0; channel_id < N_CHANNELS; ++channel_id) {
+      auto expected = full->getCorrectedAngleData(azimuth, channel_id);
+      auto actual = compact->getCorrectedAngleData(azimuth, channel_id);
+
+      ASSERT_EQ(expected.azimuth_rad, actual.azimuth_rad);
+      ASSERT_EQ(expected.elevation_rad, actual.elevation_rad);
+      ASSERT_EQ(expected.sin_elevation, actual.sin_elevation);
+      ASSERT_EQ(expected.cos_elevation, actual.cos_elevation);
+      ASSERT_NEAR(expected.sin_azimuth, actual.sin_azimuth, 1e-6);
+      ASSERT_NEAR(expected.cos_azimuth, actual.cos_azimuth, 1e-6);
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace nebula
@@ -0,0 +1,88 @@
+#include "kernel_test_inputs.hpp"
+#include "nebula_decoders/nebula_decoders_hesai/decoders/block_conversion_kernel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace nebula
+{
+namespace test
+{
+
+using drivers::block_conversion::BlockAngles;
+using drivers::block_conversion::ConvertedBlock;
+using drivers::block_conversion::Isa;
+using drivers::block_conversion::KernelArgs;
+
+// Not a multiple of any vector width, so that the scalar remainder handling is covered as well
+constexpr size_t N_CHANNELS = 131;
+
+KernelArgs makeArgs(
+  const BlockAngles<N_CHANNELS> & angles, ConvertedBlock<N_CHANNELS> & block, double dis_unit)
+{
+  return {
+    block.raw_distance.data(),
+    angles.sin_azimuth.data(),
+    angles.cos_azimuth.data(),
+    angles.sin_elevation.data(),
+    angles.cos_elevation.data(),
+    block.distance.data(),
+    block.x.data(),
+    block.y.data(),
+    block.z.data(),
+    block.valid.data(),
+    dis_unit,
+    drivers::block_conversion::range_lower_bound(0.3),
+    drivers::block_conversion::range_upper_bound(120.1)};
+}
+
+// All vectorized kernels have to produce bit-identical output to the scalar reference
+TEST(BlockConversionTest, KernelsMatchScalar)
+{
+  RandomKernelInputs inputs;
+  BlockAngles<N_CHANNELS> angles{};
+  ConvertedBlock<N_CHANNELS> expected{};
+  ConvertedBlock<N_CHANNELS> actual{};
+
+  for (int iteration = 0; iteration < KERNEL_TEST_ITERATIONS; ++iteration) {
+    for (size_t i = 0; i < N_CHANNELS; ++i) {
+      angles.sin_azimuth[i] = inputs.trig();
+      angles.cos_azimuth[i] = inputs.trig();
+      angles.sin_elevation[i] = inputs.trig();
+      angles.cos_elevation[i] = inputs.trig();
+    }
+    inputs.fillDistances(expected.raw_distance, static_cast<uint16_t>(UINT16_MAX));
+    actual.raw_distance = expected.raw_distance;
+    double dis_unit = (1 + iteration % 4) / 1000.;
+
+    drivers::block_conversion::convert_block_scalar(
+      makeArgs(angles, expected, dis_unit), 0, N_CHANNELS);
+
+    ASSERT_NO_FATAL_FAILURE(expectKernelsMatchScalar(
+      {Isa::SSE2, Isa::AVX2, Isa::NEON}, drivers::block_conversion::is_supported, expected, actual,
+      [&](Isa isa) {
+        drivers::block_conversion::get_kernel(isa)(
+          makeArgs(angles, actual, dis_unit), 0, N_CHANNELS);
+      }));
+  }
+}
+
+// Single-precision range checks have to agree with the double-precision configuration limits
+TEST(BlockConversionTest, RangeBounds)
+{
+  for (double limit : {0.05, 0.1, 0.3, 1.0, 120.1, 200.0, 230.0}) {
+    float lower = drivers::block_conversion::range_lower_bound(limit);
+    float upper = drivers::block_conversion::range_upper_bound(limit);
+
+    for (float d : {std::nextafter(lower, 0.f), lower, std::nextafter(lower, INFINITY)}) {
+      EXPECT_EQ(d < limit, d < lower) << d << " vs. " << limit;
+    }
+    for (float d : {std::nextafter(upper, 0.f), upper, std::nextafter(upper, INFINITY)}) {
+      EXPECT_EQ(limit < d, upper < d) << d << " vs. " << limit;
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace nebula
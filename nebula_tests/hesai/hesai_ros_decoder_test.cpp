@@ -228,6 +228,15 @@ Status HesaiRosDecoderTest::GetParameters(
     sensor_configuration.dual_return_distance_threshold =
       this->get_parameter("dual_return_distance_threshold").as_double();
   }
+  {
+    rcl_interfaces::msg::ParameterDescriptor descriptor;
+    descriptor.type = rcl_interfaces::msg::ParameterType::PARAMETER_INTEGER;
+    descriptor.read_only = true;
+    descriptor.dynamic_typing = false;
+    descriptor.additional_constraints = "";
+    this->declare_parameter<uint16_t>("decode_threads", params_.decode_threads, descriptor);
+    sensor_configuration.decode_threads = this->get_parameter("decode_threads").as_int();
+  }
 
   if (sensor_configuration.sensor_model == nebula::drivers::SensorModel::UNKNOWN) {
     return Status::INVALID_SENSOR_MODEL;
@@ -270,6 +279,21 @@ Status HesaiRosDecoderTest::GetParameters(
 
 void HesaiRosDecoderTest::ReadBag(
   std::function<void(uint64_t, uint64_t, nebula::drivers::NebulaPointCloudPtr)> scan_callback)
+{
+  ReadScans([&](
+              uint64_t bag_timestamp,
+              const std::shared_ptr<pandar_msgs::msg::PandarScan> & extracted_msg_ptr) {
+    auto pointcloud_ts = driver_ptr_->ConvertScanToPointcloud(extracted_msg_ptr);
+    auto scan_timestamp = std::get<1>(pointcloud_ts);
+    auto pointcloud = std::get<0>(pointcloud_ts);
+
+    scan_callback(bag_timestamp, scan_timestamp, pointcloud);
+  });
+}
+
+void HesaiRosDecoderTest::ReadScans(
+  std::function<void(uint64_t, const std::shared_ptr<pandar_msgs::msg::PandarScan> &)>
+    scan_callback)
 {
   rosbag2_storage::StorageOptions storage_options;
   rosbag2_cpp::ConverterOptions converter_options;
@@ -291,7 +315,6 @@ void HesaiRosDecoderTest::ReadBag(
   storage_options.storage_id = params_.storage_id;
   converter_options.output_serialization_format = params_.format;  //"cdr";
   rclcpp::Serialization<pandar_msgs::msg::PandarScan> serialization;
-  nebula::drivers::NebulaPointCloudPtr pointcloud(new nebula::drivers::NebulaPointCloud);
 
   rosbag2_cpp::Reader bag_reader(std::make_unique<rosbag2_cpp::readers::SequentialReader>());
   bag_reader.open(storage_options, converter_options);
@@ -310,15 +333,16 @@ void HesaiRosDecoderTest::ReadBag(
         "Found data in topic " << bag_message->topic_name << ": " << bag_message->time_stamp);
 
       auto extracted_msg_ptr = std::make_shared<pandar_msgs::msg::PandarScan>(extracted_msg);
-      auto pointcloud_ts = driver_ptr_->ConvertScanToPointcloud(extracted_msg_ptr);
-      auto scan_timestamp = std::get<1>(pointcloud_ts);
-      pointcloud = std::get<0>(pointcloud_ts);
-
-      scan_callback(bag_message->time_stamp, scan_timestamp, pointcloud);
-      pointcloud.reset(new nebula::drivers::NebulaPointCloud);
+      scan_callback(bag_message->time_stamp, extracted_msg_ptr);
     }
   }
 }
 
+std::tuple<drivers::NebulaPointCloudPtr, double> HesaiRosDecoderTest::ConvertScanToPointcloud(
+  const std::shared_ptr<pandar_msgs::msg::PandarScan> & scan)
+{
+  return driver_ptr_->ConvertScanToPointcloud(scan);
+}
+
 }  // namespace ros
 }  // namespace nebula
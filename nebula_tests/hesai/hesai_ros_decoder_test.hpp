@@ -46,6 +46,7 @@ struct HesaiRosDecoderTestParams
   std::string format = "cdr";
   std::string target_topic = "/pandar_packets";
   double dual_return_distance_threshold = 0.1;
+  uint16_t decode_threads = 1;
 };
 
 /// @brief Testing decoder of pandar 40p (Keeps HesaiDriverRosWrapper structure as much as
@@ -113,6 +114,18 @@ public:
   void ReadBag(
     std::function<void(uint64_t, uint64_t, nebula::drivers::NebulaPointCloudPtr)> scan_callback);
 
+  /// @brief Read the scan messages of the specified bag file without decoding them
+  /// @param scan_callback Called with the bag timestamp and the deserialized message of each scan
+  void ReadScans(
+    std::function<void(uint64_t, const std::shared_ptr<pandar_msgs::msg::PandarScan> &)>
+      scan_callback);
+
+  /// @brief Decode a single scan message with the driver under test
+  /// @param scan The scan message to decode
+  /// @return The decoded pointcloud and its timestamp in seconds
+  std::tuple<drivers::NebulaPointCloudPtr, double> ConvertScanToPointcloud(
+    const std::shared_ptr<pandar_msgs::msg::PandarScan> & scan);
+
   HesaiRosDecoderTestParams params_;
 };
 
@@ -1,5 +1,6 @@
 #include "hesai_ros_decoder_test_main.hpp"
 
+#include "allocation_counter.hpp"
 #include "hesai_common.hpp"
 #include "hesai_ros_decoder_test.hpp"
 
@@ -12,6 +13,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <vector>
 
 namespace nebula
 {
@@ -168,6 +170,84 @@ TEST_P(DecoderTest, TestTimezone)
   EXPECT_EQ(decoded_timestamps.back(), decoded_timestamps_cmp.back());
 }
 
+// Tests that decoding is free of heap allocations once the decoder's buffers have grown to their
+// steady-state size, so that the driver can run on real-time threads.
+TEST_P(DecoderTest, TestAllocations)
+{
+  // Scans needed to grow both the decode and the output buffer of the decoder
+  constexpr size_t n_warmup_scans = 2;
+
+  std::vector<std::shared_ptr<pandar_msgs::msg::PandarScan>> scans;
+  hesai_driver_->ReadScans(
+    [&](uint64_t /*msg_timestamp*/, const std::shared_ptr<pandar_msgs::msg::PandarScan> & scan) {
+      scans.push_back(scan);
+    });
+  ASSERT_GT(scans.size(), n_warmup_scans);
+
+  for (size_t i = 0; i < n_warmup_scans; ++i) {
+    hesai_driver_->ConvertScanToPointcloud(scans[i]);
+  }
+
+  size_t n_decoded = 0;
+  size_t n_allocations;
+  {
+    test::AllocationCounter allocation_counter;
+    for (size_t i = n_warmup_scans; i < scans.size(); ++i) {
+      auto pointcloud = std::get<0>(hesai_driver_->ConvertScanToPointcloud(scans[i]));
+      if (pointcloud) {
+        n_decoded++;
+      }
+    }
+    n_allocations = allocation_counter.count();
+  }
+
+  EXPECT_GT(n_decoded, 0U);
+  EXPECT_EQ(n_allocations, 0U);
+}
+
+// Tests that decoding scans on multiple threads yields exactly the same pointclouds and timestamps
+// as decoding them serially.
+TEST_P(DecoderTest, TestParallelDecoding)
+{
+  auto parallel_params = GetParam();
+  parallel_params.decode_threads = 4;
+  auto parallel_driver = std::make_shared<nebula::ros::HesaiRosDecoderTest>(
+    rclcpp::NodeOptions(), "nebula_hesai_parallel_decoder_test", parallel_params);
+  ASSERT_EQ(parallel_driver->GetStatus(), nebula::Status::OK);
+
+  size_t n_compared = 0;
+  hesai_driver_->ReadScans(
+    [&](uint64_t /*msg_timestamp*/, const std::shared_ptr<pandar_msgs::msg::PandarScan> & scan) {
+      auto serial_result = hesai_driver_->ConvertScanToPointcloud(scan);
+      auto parallel_result = parallel_driver->ConvertScanToPointcloud(scan);
+
+      auto serial_pointcloud = std::get<0>(serial_result);
+      auto parallel_pointcloud = std::get<0>(parallel_result);
+      ASSERT_EQ(serial_pointcloud == nullptr, parallel_pointcloud == nullptr);
+      if (!serial_pointcloud) return;
+
+      EXPECT_EQ(std::get<1>(serial_result), std::get<1>(parallel_result));
+      ASSERT_EQ(serial_pointcloud->size(), parallel_pointcloud->size());
+      for (size_t i = 0; i < serial_pointcloud->size(); ++i) {
+        const auto & expected = serial_pointcloud->points[i];
+        const auto & actual = parallel_pointcloud->points[i];
+        ASSERT_EQ(expected.x, actual.x);
+        ASSERT_EQ(expected.y, actual.y);
+        ASSERT_EQ(expected.z, actual.z);
+        ASSERT_EQ(expected.distance, actual.distance);
+        ASSERT_EQ(expected.azimuth, actual.azimuth);
+        ASSERT_EQ(expected.elevation, actual.elevation);
+        ASSERT_EQ(expected.intensity, actual.intensity);
+        ASSERT_EQ(expected.return_type, actual.return_type);
+        ASSERT_EQ(expected.channel, actual.channel);
+        ASSERT_EQ(expected.time_stamp, actual.time_stamp);
+      }
+      n_compared++;
+    });
+
+  EXPECT_GT(n_compared, 0U);
+}
+
 void DecoderTest::SetUp()
 {
   auto decoder_params = GetParam();
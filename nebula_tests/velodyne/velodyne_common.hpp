@@ -0,0 +1,97 @@
+#pragma once
+
+#include "nebula_common/point_types.hpp"
+
+#include <pcl/point_cloud.h>
+#include <pcl/point_types.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstddef>
+
+namespace nebula
+{
+namespace test
+{
+
+/// @brief The rotation of a point since the scan phase in degrees, in [0, 360)
+/// @param azimuth The point's azimuth in radians
+/// @param scan_phase The scan phase in degrees
+inline double phaseRotation(float azimuth, double scan_phase)
+{
+  const double rotation = std::fmod(azimuth * 180. / M_PI - scan_phase, 360.);
+  return rotation < 0 ? rotation + 360. : rotation;
+}
+
+inline bool samePosition(const drivers::NebulaPoint & p, const pcl::PointXYZ & p_ref)
+{
+  return p.x == p_ref.x && p.y == p_ref.y && p.z == p_ref.z;
+}
+
+/// @brief Compare a decoded scan with a reference scan recorded before scans were cut at the scan
+/// phase, when they followed the message boundaries of the bag.
+///
+/// All points of the reference have to be decoded in the same order. Only where the reference was
+/// cut at a message boundary instead of the scan phase, points may have moved between scans:
+/// - Points in front of the reference belong to the half rotation following the scan phase, which
+///   the reference left in the previous scan.
+/// - Points at the end of the reference that are missing from the scan were past the scan phase,
+///   so they have to start the next scan.
+/// @param scan The decoded scan
+/// @param next_scan The scan decoded after it, or null if there is none
+/// @param reference The reference scan
+/// @param scan_phase The scan phase in degrees
+inline void checkScanAgainstReference(
+  const drivers::NebulaPointCloudPtr & scan, const drivers::NebulaPointCloudPtr & next_scan,
+  const pcl::PointCloud<pcl::PointXYZ>::Ptr & reference, double scan_phase)
+{
+  ASSERT_FALSE(reference->points.empty());
+
+  size_t added = 0;
+  while (added < scan->points.size() && !samePosition(scan->points[added], reference->points[0])) {
+    ++added;
+  }
+  ASSERT_LT(added, scan->points.size()) << "The reference's first point was not decoded";
+  for (size_t i = 0; i < added; ++i) {
+    EXPECT_LT(phaseRotation(scan->points[i].azimuth, scan_phase), 180.)
+      << "Point " << i << " is in front of the reference but precedes the scan phase";
+  }
+
+  const size_t matched = scan->points.size() - added;
+  ASSERT_LE(matched, reference->points.size()) << "Points were decoded past the reference";
+  for (size_t i = 0; i < matched; ++i) {
+    const auto & p = scan->points[added + i];
+    const auto & p_ref = reference->points[i];
+    EXPECT_FLOAT_EQ(p.x, p_ref.x);
+    EXPECT_FLOAT_EQ(p.y, p_ref.y);
+    EXPECT_FLOAT_EQ(p.z, p_ref.z);
+
+    // Prevent thousands of outputs when point clouds do not align
+    if (!samePosition(p, p_ref)) {
+      return;
+    }
+  }
+
+  const size_t removed = reference->points.size() - matched;
+  if (removed == 0) {
+    return;
+  }
+  ASSERT_TRUE(next_scan) << removed << " points of the reference are missing";
+  ASSERT_GE(next_scan->points.size(), removed);
+  for (size_t i = 0; i < removed; ++i) {
+    const auto & p = next_scan->points[i];
+    const auto & p_ref = reference->points[matched + i];
+    EXPECT_FLOAT_EQ(p.x, p_ref.x);
+    EXPECT_FLOAT_EQ(p.y, p_ref.y);
+    EXPECT_FLOAT_EQ(p.z, p_ref.z);
+    if (!samePosition(p, p_ref)) {
+      return;
+    }
+    EXPECT_LT(phaseRotation(p.azimuth, scan_phase), 180.)
+      << "Point " << i << " of the next scan precedes the scan phase";
+  }
+}
+
+}  // namespace test
+}  // namespace nebula
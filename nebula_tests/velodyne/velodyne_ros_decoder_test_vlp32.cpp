@@ -1,4 +1,5 @@
 #include "velodyne_ros_decoder_test_vlp32.hpp"
+#include "velodyne_common.hpp"
 
 #include "rclcpp/serialization.hpp"
 #include "rclcpp/serialized_message.hpp"
@@ -282,18 +283,6 @@ void checkPCDs(nebula::drivers::NebulaPointCloudPtr pp1, nebula::drivers::Nebula
   }
 }
 
-void checkPCDs(nebula::drivers::NebulaPointCloudPtr pp1, pcl::PointCloud<pcl::PointXYZ>::Ptr pp2)
-{
-  EXPECT_EQ(pp1->points.size(), pp2->points.size());
-  for (uint32_t i = 0; i < pp1->points.size(); i++) {
-    auto p1 = pp1->points[i];
-    auto p2 = pp2->points[i];
-    EXPECT_FLOAT_EQ(p1.x, p2.x);
-    EXPECT_FLOAT_EQ(p1.y, p2.y);
-    EXPECT_FLOAT_EQ(p1.z, p2.z);
-  }
-}
-
 void VelodyneRosDecoderTest::ReadBag()
 {
   rosbag2_storage::StorageOptions storage_options;
@@ -315,6 +304,11 @@ void VelodyneRosDecoderTest::ReadBag()
   rcpputils::fs::path bag_dir(bag_path);
   rcpputils::fs::path pcd_dir = bag_dir.parent_path();
   int check_cnt = 0;
+  const double scan_phase =
+    std::static_pointer_cast<drivers::VelodyneSensorConfiguration>(sensor_cfg_ptr_)->scan_phase;
+  // The reference scans are checked against the scan decoded after them as well, because points
+  // past the scan phase may have moved there
+  nebula::drivers::NebulaPointCloudPtr reference_scan;
 
   storage_options.uri = bag_path;
   storage_options.storage_id = storage_id;
@@ -347,6 +341,13 @@ void VelodyneRosDecoderTest::ReadBag()
         // whether it is because of decoder or deserialize_message.
         if (!pointcloud) continue;
 
+        if (reference_scan) {
+          test::checkScanAgainstReference(reference_scan, pointcloud, ref_pointcloud, scan_phase);
+          check_cnt++;
+          reference_scan.reset();
+          ref_pointcloud.reset(new pcl::PointCloud<pcl::PointXYZ>);
+        }
+
         auto fn = std::to_string(bag_message->time_stamp) + ".pcd";
 
         auto target_pcd_path = (pcd_dir / fn);
@@ -356,14 +357,15 @@ void VelodyneRosDecoderTest::ReadBag()
           std::cout << "exists: " << target_pcd_path << std::endl;
           auto rt = pcd_reader.read(target_pcd_path.string(), *ref_pointcloud);
           std::cout << rt << " loaded: " << target_pcd_path << std::endl;
-          checkPCDs(pointcloud, ref_pointcloud);
-          check_cnt++;
-          // ref_pointcloud.reset(new nebula::drivers::NebulaPointCloud);
-          ref_pointcloud.reset(new pcl::PointCloud<pcl::PointXYZ>);
+          reference_scan = pointcloud;
         }
         pointcloud.reset(new nebula::drivers::NebulaPointCloud);
       }
     }
+    if (reference_scan) {
+      test::checkScanAgainstReference(reference_scan, nullptr, ref_pointcloud, scan_phase);
+      check_cnt++;
+    }
     EXPECT_GT(check_cnt, 0);
     // close on scope exit
   }
@@ -0,0 +1,261 @@
+#include "nebula_common/velodyne/velodyne_common.hpp"
+#include "nebula_decoders/nebula_decoders_velodyne/velodyne_driver.hpp"
+
+#include "rclcpp/serialization.hpp"
+#include "rclcpp/serialized_message.hpp"
+#include "rosbag2_cpp/reader.hpp"
+#include "rosbag2_cpp/readers/sequential_reader.hpp"
+#include "rosbag2_storage/storage_options.hpp"
+
+#include <velodyne_msgs/msg/velodyne_scan.hpp>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace nebula
+{
+namespace test
+{
+
+/// @brief A recording in nebula_tests/data/velodyne and the configuration it is decoded with
+struct VelodyneBag
+{
+  std::string bag;
+  std::string topic;
+  drivers::SensorModel sensor_model;
+  drivers::ReturnMode return_mode;
+  std::string calibration_file;
+  double scan_phase;
+  double min_range;
+  double max_range;
+  uint16_t cloud_min_angle;
+  uint16_t cloud_max_angle;
+};
+
+const VelodyneBag VLP16_BAG{
+  "vlp16/1673400471837873222", "/velodyne_packets", drivers::SensorModel::VELODYNE_VLP16,
+  drivers::ReturnMode::DUAL, "VLP16.yaml", 0., 0.3, 300., 0, 359};
+const VelodyneBag VLP32_BAG{
+  "vlp32/1713492677464078412", "/sensing/lidar/front/velodyne_packets",
+  drivers::SensorModel::VELODYNE_VLP32, drivers::ReturnMode::SINGLE_STRONGEST, "VLP32.yaml",
+  180., 0.4, 50., 270, 90};
+const VelodyneBag VLS128_BAG{
+  "vls128/1614315746471294674", "/velodyne_packets", drivers::SensorModel::VELODYNE_VLS128,
+  drivers::ReturnMode::DUAL, "VLS128.yaml", 0., 0.3, 300., 0, 359};
+
+/// @brief A decoded scan and its timestamp
+typedef std::tuple<drivers::NebulaPointCloudPtr, double> Scan;
+
+std::vector<velodyne_msgs::msg::VelodyneScan> readScanMsgs(const VelodyneBag & bag)
+{
+  rosbag2_storage::StorageOptions storage_options;
+  storage_options.uri = std::string(_SRC_RESOURCES_DIR_PATH) + "velodyne/" + bag.bag;
+  storage_options.storage_id = "sqlite3";
+  rosbag2_cpp::ConverterOptions converter_options;
+  converter_options.output_serialization_format = "cdr";
+
+  rosbag2_cpp::Reader bag_reader(std::make_unique<rosbag2_cpp::readers::SequentialReader>());
+  bag_reader.open(storage_options, converter_options);
+  rclcpp::Serialization<velodyne_msgs::msg::VelodyneScan> serialization;
+  std::vector<velodyne_msgs::msg::VelodyneScan> scan_msgs;
+  while (bag_reader.has_next()) {
+    auto bag_message = bag_reader.read_next();
+    if (bag_message->topic_name != bag.topic) {
+      continue;
+    }
+    rclcpp::SerializedMessage serialized_msg(*bag_message->serialized_data);
+    serialization.deserialize_message(&serialized_msg, &scan_msgs.emplace_back());
+  }
+  return scan_msgs;
+}
+
+/// @brief Split the packets of the messages into messages of `n_packets` packets each
+std::vector<velodyne_msgs::msg::VelodyneScan> resplit(
+  const std::vector<velodyne_msgs::msg::VelodyneScan> & scan_msgs, size_t n_packets)
+{
+  std::vector<velodyne_msgs::msg::VelodyneScan> resplit_msgs;
+  for (const auto & scan_msg : scan_msgs) {
+    for (const auto & packet : scan_msg.packets) {
+      if (resplit_msgs.empty() || resplit_msgs.back().packets.size() == n_packets) {
+        resplit_msgs.emplace_back().header = scan_msg.header;
+      }
+      resplit_msgs.back().packets.push_back(packet);
+    }
+  }
+  return resplit_msgs;
+}
+
+std::shared_ptr<drivers::VelodyneDriver> makeDriver(const VelodyneBag & bag)
+{
+  auto sensor_configuration = std::make_shared<drivers::VelodyneSensorConfiguration>();
+  sensor_configuration->sensor_model = bag.sensor_model;
+  sensor_configuration->return_mode = bag.return_mode;
+  sensor_configuration->scan_phase = bag.scan_phase;
+  sensor_configuration->min_range = bag.min_range;
+  sensor_configuration->max_range = bag.max_range;
+  sensor_configuration->cloud_min_angle = bag.cloud_min_angle;
+  sensor_configuration->cloud_max_angle = bag.cloud_max_angle;
+
+  auto calibration_configuration = std::make_shared<drivers::VelodyneCalibrationConfiguration>();
+  EXPECT_EQ(
+    calibration_configuration->LoadFromFile(
+      std::string(_SRC_CALIBRATION_DIR_PATH) + "velodyne/" + bag.calibration_file),
+    Status::OK);
+
+  auto driver =
+    std::make_shared<drivers::VelodyneDriver>(sensor_configuration, calibration_configuration);
+  EXPECT_EQ(driver->GetStatus(), Status::OK);
+  return driver;
+}
+
+/// @brief Decode the messages, returning the scan of each message, which is null if the message
+/// did not complete a scan
+std::vector<Scan> decode(
+  const VelodyneBag & bag, const std::vector<velodyne_msgs::msg::VelodyneScan> & scan_msgs)
+{
+  auto driver = makeDriver(bag);
+  std::vector<Scan> scans;
+  for (const auto & scan_msg : scan_msgs) {
+    scans.push_back(driver->ConvertScanToPointcloud(
+      std::make_shared<velodyne_msgs::msg::VelodyneScan>(scan_msg)));
+  }
+  return scans;
+}
+
+/// @brief The azimuth of a point in 1/100 degrees, as compared to the field of view
+uint32_t centidegrees(float azimuth)
+{
+  return static_cast<uint32_t>(std::lround(azimuth * 18000. / M_PI));
+}
+
+void expectSamePoints(
+  const drivers::NebulaPointCloud & expected, const drivers::NebulaPointCloud & actual)
+{
+  ASSERT_EQ(expected.points.size(), actual.points.size());
+  for (size_t i = 0; i < expected.points.size(); ++i) {
+    const auto & p_expected = expected.points[i];
+    const auto & p = actual.points[i];
+    ASSERT_EQ(p_expected.x, p.x) << "Point " << i;
+    ASSERT_EQ(p_expected.y, p.y) << "Point " << i;
+    ASSERT_EQ(p_expected.z, p.z) << "Point " << i;
+    ASSERT_EQ(p_expected.intensity, p.intensity) << "Point " << i;
+    ASSERT_EQ(p_expected.return_type, p.return_type) << "Point " << i;
+    ASSERT_EQ(p_expected.channel, p.channel) << "Point " << i;
+    ASSERT_EQ(p_expected.azimuth, p.azimuth) << "Point " << i;
+    ASSERT_EQ(p_expected.elevation, p.elevation) << "Point " << i;
+    ASSERT_EQ(p_expected.distance, p.distance) << "Point " << i;
+    ASSERT_EQ(p_expected.time_stamp, p.time_stamp) << "Point " << i;
+  }
+}
+
+// Scans are cut at the scan phase, so they must not depend on how the packets are split into
+// messages, e.g. by the hardware interface or by a recorder cutting by packet count
+TEST(VelodyneScanCutTest, SameScansForAnyMessageSize)
+{
+  for (const auto & bag : {VLP16_BAG, VLP32_BAG, VLS128_BAG}) {
+    SCOPED_TRACE(bag.bag);
+    const auto scan_msgs = readScanMsgs(bag);
+    ASSERT_FALSE(scan_msgs.empty());
+
+    std::vector<Scan> expected_scans;
+    for (const auto & scan : decode(bag, scan_msgs)) {
+      if (std::get<0>(scan)) {
+        expected_scans.push_back(scan);
+      }
+    }
+    ASSERT_GT(expected_scans.size(), 1u);
+
+    // All sizes are below the packets per rotation, so that no message completes several scans
+    for (size_t n_packets : {1, 7, 50}) {
+      SCOPED_TRACE(std::to_string(n_packets) + " packets per message");
+      std::vector<Scan> scans;
+      for (const auto & scan : decode(bag, resplit(scan_msgs, n_packets))) {
+        if (std::get<0>(scan)) {
+          scans.push_back(scan);
+        }
+      }
+
+      ASSERT_EQ(scans.size(), expected_scans.size());
+      for (size_t i = 0; i < scans.size(); ++i) {
+        SCOPED_TRACE("Scan " + std::to_string(i));
+        EXPECT_EQ(std::get<1>(scans[i]), std::get<1>(expected_scans[i]));
+        expectSamePoints(*std::get<0>(expected_scans[i]), *std::get<0>(scans[i]));
+      }
+    }
+  }
+}
+
+// Scans are cut by the azimuth of the firings, so they are completed even if no point near the
+// scan phase passes the field of view, e.g. if it excludes the scan phase or half of the rotation
+TEST(VelodyneScanCutTest, RestrictedFieldOfView)
+{
+  const auto scan_msgs = readScanMsgs(VLP16_BAG);
+  VelodyneBag full_bag = VLP16_BAG;
+  full_bag.cloud_max_angle = 360;
+  const auto full_scans = decode(full_bag, scan_msgs);
+
+  for (auto [cloud_min_angle, cloud_max_angle] :
+       std::vector<std::pair<uint16_t, uint16_t>>{{0, 180}, {90, 270}, {270, 90}}) {
+    SCOPED_TRACE(
+      "Field of view " + std::to_string(cloud_min_angle) + " to " +
+      std::to_string(cloud_max_angle));
+    VelodyneBag bag = VLP16_BAG;
+    bag.cloud_min_angle = cloud_min_angle;
+    bag.cloud_max_angle = cloud_max_angle;
+    const auto scans = decode(bag, scan_msgs);
+    ASSERT_EQ(scans.size(), full_scans.size());
+
+    for (size_t i = 0; i < scans.size(); ++i) {
+      SCOPED_TRACE("Message " + std::to_string(i));
+      const auto & full_scan = std::get<0>(full_scans[i]);
+      const auto & scan = std::get<0>(scans[i]);
+      ASSERT_EQ(static_cast<bool>(scan), static_cast<bool>(full_scan));
+      if (!scan) {
+        continue;
+      }
+
+      // The scan holds the same points as the unrestricted one, minus those outside of the field
+      // of view. Blocks are filtered by their own azimuth as well, so points within a degree of
+      // the field of view's edges are not compared. Point times may differ if the scan phase is
+      // outside of the field of view, as scans are then stamped with their first packet holding a
+      // point
+      auto inFieldOfView = [&](uint32_t azimuth, uint32_t margin) {
+        const uint32_t min_azimuth = cloud_min_angle * 100u + margin;
+        const uint32_t max_azimuth = cloud_max_angle * 100u - margin;
+        return cloud_min_angle < cloud_max_angle
+                 ? azimuth >= min_azimuth && azimuth <= max_azimuth
+                 : azimuth >= min_azimuth || azimuth <= max_azimuth;
+      };
+      std::vector<drivers::NebulaPoint> points;
+      for (const auto & point : scan->points) {
+        const uint32_t azimuth = centidegrees(point.azimuth);
+        ASSERT_TRUE(inFieldOfView(azimuth, 0)) << "Azimuth " << azimuth;
+        if (inFieldOfView(azimuth, 100)) {
+          points.push_back(point);
+        }
+      }
+      std::vector<drivers::NebulaPoint> expected_points;
+      for (const auto & point : full_scan->points) {
+        if (inFieldOfView(centidegrees(point.azimuth), 100)) {
+          expected_points.push_back(point);
+        }
+      }
+      ASSERT_FALSE(expected_points.empty());
+      ASSERT_EQ(points.size(), expected_points.size());
+      for (size_t j = 0; j < expected_points.size(); ++j) {
+        ASSERT_EQ(points[j].x, expected_points[j].x) << "Point " << j;
+        ASSERT_EQ(points[j].y, expected_points[j].y) << "Point " << j;
+        ASSERT_EQ(points[j].z, expected_points[j].z) << "Point " << j;
+      }
+    }
+  }
+}
+
+}  // namespace test
+}  // namespace nebula
@@ -0,0 +1,220 @@
+#include "kernel_test_inputs.hpp"
+#include "nebula_common/velodyne/velodyne_common.hpp"
+#include "nebula_decoders/nebula_decoders_velodyne/decoders/two_point_correction_kernel.hpp"
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <cmath>
+#include <string>
+#include <tuple>
+
+namespace nebula
+{
+namespace test
+{
+
+using drivers::two_point_correction::ConvertedFiring;
+using drivers::two_point_correction::Isa;
+using drivers::two_point_correction::LaserCalibration;
+
+// Not a multiple of any vector width, so that the scalar remainder handling is covered as well
+constexpr size_t N_CHANNELS = 43;
+
+/// @brief The per-point conversion of a return with the full calibration model, as the VLP32
+/// decoder computed it before firings were converted by kernels
+/// @return The point's x, y and z in the ROS coordinate system
+std::tuple<float, float, float> convertPoint(
+  const drivers::VelodyneLaserCorrection & corrections, float distance, float cos_azimuth,
+  float sin_azimuth)
+{
+  const float cos_vert_angle = corrections.cos_vert_correction;
+  const float sin_vert_angle = corrections.sin_vert_correction;
+  const float cos_rot_correction = corrections.cos_rot_correction;
+  const float sin_rot_correction = corrections.sin_rot_correction;
+
+  const float cos_rot_angle = cos_azimuth * cos_rot_correction + sin_azimuth * sin_rot_correction;
+  const float sin_rot_angle = sin_azimuth * cos_rot_correction - cos_azimuth * sin_rot_correction;
+
+  const float horiz_offset = corrections.horiz_offset_correction;
+  const float vert_offset = corrections.vert_offset_correction;
+
+  float xy_distance = distance * cos_vert_angle - vert_offset * sin_vert_angle;
+
+  float xx = xy_distance * sin_rot_angle - horiz_offset * cos_rot_angle;
+  float yy = xy_distance * cos_rot_angle + horiz_offset * sin_rot_angle;
+  if (xx < 0) {
+    xx = -xx;
+  }
+  if (yy < 0) {
+    yy = -yy;
+  }
+
+  float distance_corr_x = 0;
+  float distance_corr_y = 0;
+  if (corrections.two_pt_correction_available) {
+    distance_corr_x = (corrections.dist_correction - corrections.dist_correction_x) *
+                        (xx - 2.4) / (25.04 - 2.4) +
+                      corrections.dist_correction_x;
+    distance_corr_x -= corrections.dist_correction;
+    distance_corr_y = (corrections.dist_correction - corrections.dist_correction_y) *
+                        (yy - 1.93) / (25.04 - 1.93) +
+                      corrections.dist_correction_y;
+    distance_corr_y -= corrections.dist_correction;
+  }
+
+  const float distance_x = distance + distance_corr_x;
+  xy_distance = distance_x * cos_vert_angle - vert_offset * sin_vert_angle;
+  const float x = xy_distance * sin_rot_angle - horiz_offset * cos_rot_angle;
+
+  const float distance_y = distance + distance_corr_y;
+  xy_distance = distance_y * cos_vert_angle - vert_offset * sin_vert_angle;
+  const float y = xy_distance * cos_rot_angle + horiz_offset * sin_rot_angle;
+  const float z = distance_y * sin_vert_angle + vert_offset * cos_vert_angle;
+
+  return {y, -x, z};
+}
+
+// All vectorized kernels have to produce bit-identical output to the scalar reference
+TEST(TwoPointCorrectionTest, KernelsMatchScalar)
+{
+  RandomKernelInputs inputs;
+  LaserCalibration<N_CHANNELS> calibration{};
+  ConvertedFiring<N_CHANNELS> expected{};
+  ConvertedFiring<N_CHANNELS> actual{};
+
+  for (int iteration = 0; iteration < KERNEL_TEST_ITERATIONS; ++iteration) {
+    for (size_t i = 0; i < N_CHANNELS; ++i) {
+      calibration.cos_rot_correction[i] = inputs.trig();
+      calibration.sin_rot_correction[i] = inputs.trig();
+      calibration.cos_vert_correction[i] = inputs.trig();
+      calibration.sin_vert_correction[i] = inputs.trig();
+      calibration.horiz_offset_correction[i] = inputs.uniform(-0.2f, 0.2f);
+      calibration.vert_offset_correction[i] = inputs.uniform(-0.2f, 0.2f);
+      calibration.dist_correction[i] = inputs.uniform(-0.2f, 0.2f);
+      calibration.dist_correction_x[i] = inputs.uniform(-0.2f, 0.2f);
+      calibration.dist_correction_y[i] = inputs.uniform(-0.2f, 0.2f);
+      calibration.dist_correction_diff_x[i] =
+        calibration.dist_correction[i] - calibration.dist_correction_x[i];
+      calibration.dist_correction_diff_y[i] =
+        calibration.dist_correction[i] - calibration.dist_correction_y[i];
+      calibration.two_pt_correction_mask[i] = (i % 5 == 0) ? 0 : UINT32_MAX;
+    }
+    inputs.fillDistances(expected.distance, 130.f);
+    actual.distance = expected.distance;
+    const float cos_azimuth = inputs.trig();
+    const float sin_azimuth = inputs.trig();
+
+    drivers::two_point_correction::convert_scalar(
+      drivers::two_point_correction::make_kernel_args(
+        calibration, 0, expected, cos_azimuth, sin_azimuth),
+      0, N_CHANNELS);
+
+    ASSERT_NO_FATAL_FAILURE(expectKernelsMatchScalar(
+      {Isa::SSE2, Isa::AVX2}, drivers::two_point_correction::is_supported, expected, actual,
+      [&](Isa isa) {
+        drivers::two_point_correction::get_kernel(isa)(
+          drivers::two_point_correction::make_kernel_args(
+            calibration, 0, actual, cos_azimuth, sin_azimuth),
+          0, N_CHANNELS);
+      }));
+  }
+}
+
+// The kernels have to reproduce the per-point conversion for a real calibration, packed like the
+// decoder packs it. The HDL-64E S3 calibration has distinct X and Y distance corrections for all
+// lasers, but the calibration file does not enable them, so they are enabled here
+TEST(TwoPointCorrectionTest, MatchesPerPointConversion)
+{
+  constexpr size_t N_LASERS = 64;
+  constexpr size_t LASERS_PER_FIRING = 32;
+
+  drivers::VelodyneCalibrationConfiguration calibration_configuration;
+  ASSERT_EQ(
+    calibration_configuration.LoadFromFile(
+      std::string(_SRC_CALIBRATION_DIR_PATH) + "velodyne/HDL64e_s3.yaml"),
+    Status::OK);
+  auto & calibration = calibration_configuration.velodyne_calibration;
+  ASSERT_EQ(calibration.laser_corrections.size(), N_LASERS);
+  for (auto & corrections : calibration.laser_corrections) {
+    corrections.two_pt_correction_available = true;
+  }
+  const auto laser_calibration =
+    drivers::two_point_correction::pack_calibration<N_LASERS>(calibration.laser_corrections);
+
+  RandomKernelInputs inputs;
+  size_t n_corrected = 0;
+  for (int iteration = 0; iteration < KERNEL_TEST_ITERATIONS; ++iteration) {
+    const float azimuth = inputs.uniform(0, 35999) * static_cast<float>(M_PI / 18000.);
+    const float cos_azimuth = std::cos(azimuth);
+    const float sin_azimuth = std::sin(azimuth);
+
+    for (size_t first_laser : {size_t{0}, LASERS_PER_FIRING}) {
+      ConvertedFiring<LASERS_PER_FIRING> firing{};
+      ConvertedFiring<LASERS_PER_FIRING> expected{};
+      std::array<uint16_t, LASERS_PER_FIRING> raw_distances{};
+      inputs.fillDistances(raw_distances, static_cast<uint16_t>(UINT16_MAX));
+      for (size_t channel = 0; channel < LASERS_PER_FIRING; ++channel) {
+        auto corrections = calibration.laser_corrections[first_laser + channel];
+        float distance = raw_distances[channel] * calibration.distance_resolution_m;
+        if (distance > 1e-6) {
+          distance += corrections.dist_correction;
+        }
+        firing.distance[channel] = distance;
+        expected.distance[channel] = distance;
+        std::tie(expected.x[channel], expected.y[channel], expected.z[channel]) =
+          convertPoint(corrections, distance, cos_azimuth, sin_azimuth);
+
+        corrections.two_pt_correction_available = false;
+        const auto [x, y, z] = convertPoint(corrections, distance, cos_azimuth, sin_azimuth);
+        n_corrected += x != expected.x[channel] || y != expected.y[channel] ||
+                       z != expected.z[channel];
+      }
+
+      for (Isa isa : {Isa::SCALAR, Isa::SSE2, Isa::AVX2}) {
+        if (!drivers::two_point_correction::is_supported(isa)) {
+          continue;
+        }
+        SCOPED_TRACE("Kernel " + std::to_string(static_cast<int>(isa)));
+        drivers::two_point_correction::get_kernel(isa)(
+          drivers::two_point_correction::make_kernel_args(
+            laser_calibration, first_laser, firing, cos_azimuth, sin_azimuth),
+          0, LASERS_PER_FIRING);
+
+        for (size_t channel = 0; channel < LASERS_PER_FIRING; ++channel) {
+          ASSERT_EQ(firing.x[channel], expected.x[channel]) << "Laser " << first_laser + channel;
+          ASSERT_EQ(firing.y[channel], expected.y[channel]) << "Laser " << first_laser + channel;
+          ASSERT_EQ(firing.z[channel], expected.z[channel]) << "Laser " << first_laser + channel;
+        }
+      }
+    }
+  }
+
+  // The two-point correction moved the points, so that it was exercised
+  EXPECT_GT(n_corrected, 0U);
+}
+
+// Lasers without a two-point correction are only corrected by their offsets
+TEST(TwoPointCorrectionTest, WithoutTwoPointCorrection)
+{
+  LaserCalibration<1> calibration{};
+  calibration.cos_rot_correction[0] = 1.f;
+  calibration.cos_vert_correction[0] = 1.f;
+  calibration.horiz_offset_correction[0] = 0.5f;
+  calibration.dist_correction[0] = 1.f;
+  calibration.dist_correction_diff_x[0] = 1.f;
+  calibration.dist_correction_diff_y[0] = 1.f;
+
+  ConvertedFiring<1> firing{};
+  firing.distance[0] = 10.f;
+
+  // Azimuth 0: the laser points along the sensor's Y axis, which is the ROS X axis
+  drivers::two_point_correction::convert_scalar(
+    drivers::two_point_correction::make_kernel_args(calibration, 0, firing, 1.f, 0.f), 0, 1);
+  EXPECT_EQ(firing.x[0], 10.f);
+  EXPECT_EQ(firing.y[0], 0.5f);
+  EXPECT_EQ(firing.z[0], 0.f);
+}
+
+}  // namespace test
+}  // namespace nebula
@@ -0,0 +1,97 @@
+#!/usr/bin/env python3
+"""Compare Google Benchmark results against a stored baseline and flag regressions.
+
+Both files are produced by running a benchmark with
+`--benchmark_out=<file>.json --benchmark_out_format=json`. If the benchmarks were repeated, the
+medians are compared. Exits with 1 if any benchmark regressed by more than the threshold.
+"""
+
+import argparse
+import json
+import sys
+
+# Metrics compared, in order of preference, and whether higher values are better
+METRICS = [
+    ("ns_per_point", False),
+    ("real_time", False),
+]
+THROUGHPUT_METRICS = ["packets_per_second", "points_per_second"]
+
+
+def load_results(path):
+    with open(path) as f:
+        benchmarks = json.load(f)["benchmarks"]
+
+    results = {}
+    has_aggregates = any(b.get("run_type") == "aggregate" for b in benchmarks)
+    for b in benchmarks:
+        if has_aggregates:
+            if b.get("aggregate_name") != "median":
+                continue
+            name = b["run_name"]
+        else:
+            name = b["name"]
+        results[name] = b
+    return results
+
+
+def compare(baseline, current, threshold):
+    rows = []
+    n_regressions = 0
+    for name, base in baseline.items():
+        if name not in current:
+            rows.append((name, "-", "-", "-", "missing"))
+            continue
+        cur = current[name]
+
+        metric, higher_is_better = next(
+            (m, h) for m, h in METRICS if m in base and m in cur)
+        if base[metric] == 0:
+            continue
+        change = cur[metric] / base[metric] - 1
+        regression = -change if higher_is_better else change
+        status = "ok"
+        if regression > threshold:
+            status = "REGRESSION"
+            n_regressions += 1
+        elif regression < -threshold:
+            status = "improved"
+
+        rows.append((name, metric, f"{base[metric]:.4g}", f"{cur[metric]:.4g}",
+                     f"{change * 100:+.1f} % {status}"))
+
+        for throughput in THROUGHPUT_METRICS:
+            if throughput in base and throughput in cur and base[throughput] > 0:
+                change = cur[throughput] / base[throughput] - 1
+                rows.append(("", throughput, f"{base[throughput]:.4g}", f"{cur[throughput]:.4g}",
+                             f"{change * 100:+.1f} %"))
+
+    for name in current.keys() - baseline.keys():
+        rows.append((name, "-", "-", "-", "new"))
+
+    return rows, n_regressions
+
+
+def print_table(rows):
+    header = ("benchmark", "metric", "baseline", "current", "change")
+    widths = [max(len(str(row[i])) for row in rows + [header]) for i in range(len(header))]
+    for row in [header] + rows:
+        print("  ".join(str(cell).ljust(width) for cell, width in zip(row, widths)))
+
+
+if __name__ == "__main__":
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline", help="Baseline results JSON")
+    parser.add_argument("current", help="Current results JSON")
+    parser.add_argument("-t", "--threshold", type=float, default=0.1,
+                        help="Relative slowdown flagged as a regression (default 0.1, i.e. 10 %%)")
+    args = parser.parse_args()
+
+    rows, n_regressions = compare(
+        load_results(args.baseline), load_results(args.current), args.threshold)
+    print_table(rows)
+
+    if n_regressions > 0:
+        print(f"\n{n_regressions} benchmark(s) regressed by more than {args.threshold * 100:.0f} %")
+        sys.exit(1)